@@ -1,29 +1,37 @@
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
+#include <atomic>
+
 #include "mubot.h"
 #include "imgui_hook.h"
 
 static HMODULE g_hModule = nullptr;
-static bool g_isDetached = false;
+static std::atomic<bool> g_isUnloading{ false };
 
 DWORD WINAPI MainThread(LPVOID lpThreadParameter)
 {
-    g_hModule = (HMODULE)lpThreadParameter;
     MuBot::Initialize();
     return S_OK;
 }
 
-DWORD WINAPI ExitThread(LPVOID lpThreadParameter)
+// Stops the bot and the hook's threads, then unloads the DLL. Never from DllMain: joining threads under the loader lock
+// deadlocks, since exiting threads need the lock too
+DWORD WINAPI UnloadThread(LPVOID lpThreadParameter)
+{
+    MuBot::Shutdown();
+    ImGuiHook::Unload();
+    FreeLibraryAndExitThread(g_hModule, TRUE);
+    return S_OK;
+}
+
+namespace MuBot
 {
-    if (!g_isDetached)
+    void RequestUnload()
     {
-        g_isDetached = true;
-        MuBot::Shutdown();
-        ImGuiHook::Unload();
-        FreeLibraryAndExitThread(g_hModule, TRUE);
+        if (!g_isUnloading.exchange(true))
+            CreateThread(nullptr, 0, UnloadThread, nullptr, 0, nullptr);
     }
-    return S_OK;
 }
 
 BOOL WINAPI DllMain(HMODULE hMod, DWORD dwReason, LPVOID lpReserved)
@@ -31,11 +39,16 @@ BOOL WINAPI DllMain(HMODULE hMod, DWORD dwReason, LPVOID lpReserved)
     switch (dwReason)
     {
     case DLL_PROCESS_ATTACH:
+        g_hModule = hMod;
         DisableThreadLibraryCalls(hMod);
         CreateThread(nullptr, 0, MainThread, hMod, 0, nullptr);
         break;
     case DLL_PROCESS_DETACH:
-        CreateThread(nullptr, 0, ExitThread, nullptr, 0, nullptr);
+        // Nothing to stop here: RequestUnload() already did on an explicit unload, and on process exit the threads
+        // are gone. Static destructors don't join either (see SettingsWriter::~SettingsWriter). Settings the writer
+        // thread didn't get to are written here, on this thread.
+        if (!g_isUnloading)
+            ImGuiHook::FlushSettings();
         break;
     case DLL_THREAD_ATTACH:
         break;
@@ -0,0 +1,346 @@
+#include "draw_data_recorder.h"
+
+#include <cstring>
+
+static const char MBDD_MAGIC[4] = { 'M', 'B', 'D', 'D' };
+static const uint32_t MBDD_VERSION = 1;
+static const size_t MBDD_CMD_SIZE = 4 * 4 + 8 + 4 * 4;
+static const uint32_t MBDD_MAX_FRAME_SIZE = 256 * 1024 * 1024;     // Larger sizes are read as corruption
+
+enum DrawCallback : uint32_t
+{
+    DrawCallback_None = 0,
+    DrawCallback_ResetRenderState = 1,
+    DrawCallback_Other = 2,     // Not replayable, dropped on playback
+};
+
+template <typename T>
+static void Put(std::string& out, const T& value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Bounds-checked reads from a frame payload
+struct PayloadReader
+{
+    const char* cursor;
+    const char* end;
+
+    template <typename T>
+    bool Get(T& value)
+    {
+        if ((size_t)(end - cursor) < sizeof(T))
+            return false;
+        memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool GetArray(ImVector<T>& values, uint32_t count)
+    {
+        if ((size_t)(end - cursor) / sizeof(T) < count)
+            return false;
+        values.resize((int)count);
+        if (count > 0)
+            memcpy(values.Data, cursor, count * sizeof(T));
+        cursor += count * sizeof(T);
+        return true;
+    }
+};
+
+DrawDataStats DrawDataStats::Measure(const ImDrawData* drawData)
+{
+    DrawDataStats stats;
+    if (drawData == nullptr)
+        return stats;
+    stats.listCount = drawData->CmdListsCount;
+    for (const ImDrawList* drawList : drawData->CmdLists)
+    {
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+            if (cmd.UserCallback == nullptr && cmd.ElemCount > 0)
+                stats.drawCalls++;
+        stats.vtxCount += drawList->VtxBuffer.Size;
+        stats.idxCount += drawList->IdxBuffer.Size;
+    }
+    return stats;
+}
+
+DrawDataRecorder::~DrawDataRecorder()
+{
+    // No join in DllMain, as ~SettingsWriter()
+    if (m_thread.joinable())
+        m_thread.detach();
+}
+
+bool DrawDataRecorder::Start(const std::string& path)
+{
+    Stop();
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        return false;
+    std::string header;
+    header.append(MBDD_MAGIC, sizeof(MBDD_MAGIC));
+    Put(header, MBDD_VERSION);
+    Put(header, (uint32_t)sizeof(ImDrawVert));
+    Put(header, (uint32_t)sizeof(ImDrawIdx));
+    if (!m_file.write(header.data(), header.size()))
+    {
+        m_file.close();
+        return false;
+    }
+
+    m_frameCount = 0;
+    m_writtenBytes = header.size();
+    m_failed = false;
+    m_stopping = false;
+    m_recording = true;
+    m_thread = std::thread(&DrawDataRecorder::ThreadMain, this);
+    return true;
+}
+
+void DrawDataRecorder::Stop()
+{
+    m_recording = false;
+    if (!m_thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+    m_file.close();
+}
+
+void DrawDataRecorder::Record(const ImDrawData* drawData)
+{
+    if (!m_recording || drawData == nullptr || !drawData->Valid)
+        return;
+    if (m_failed)
+    {
+        Stop();
+        return;
+    }
+
+    std::string frame;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_freeBuffers.empty())
+        {
+            frame.swap(m_freeBuffers.back());
+            m_freeBuffers.pop_back();
+        }
+    }
+
+    size_t payloadSize = 6 * sizeof(float) + sizeof(uint32_t);
+    for (const ImDrawList* drawList : drawData->CmdLists)
+        payloadSize += 3 * sizeof(uint32_t) + drawList->CmdBuffer.Size * MBDD_CMD_SIZE
+            + drawList->VtxBuffer.Size * sizeof(ImDrawVert) + drawList->IdxBuffer.Size * sizeof(ImDrawIdx);
+    frame.clear();
+    frame.reserve(sizeof(uint32_t) + payloadSize);
+
+    Put(frame, (uint32_t)payloadSize);
+    Put(frame, drawData->DisplayPos);
+    Put(frame, drawData->DisplaySize);
+    Put(frame, drawData->FramebufferScale);
+    Put(frame, (uint32_t)drawData->CmdLists.Size);
+    for (const ImDrawList* drawList : drawData->CmdLists)
+    {
+        Put(frame, (uint32_t)drawList->CmdBuffer.Size);
+        Put(frame, (uint32_t)drawList->VtxBuffer.Size);
+        Put(frame, (uint32_t)drawList->IdxBuffer.Size);
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+        {
+            Put(frame, cmd.ClipRect);
+            Put(frame, (uint64_t)cmd.TextureId);
+            Put(frame, (uint32_t)cmd.VtxOffset);
+            Put(frame, (uint32_t)cmd.IdxOffset);
+            Put(frame, (uint32_t)cmd.ElemCount);
+            const uint32_t callback = cmd.UserCallback == nullptr ? DrawCallback_None
+                : cmd.UserCallback == ImDrawCallback_ResetRenderState ? DrawCallback_ResetRenderState : DrawCallback_Other;
+            Put(frame, callback);
+        }
+        frame.append(reinterpret_cast<const char*>(drawList->VtxBuffer.Data), drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+        frame.append(reinterpret_cast<const char*>(drawList->IdxBuffer.Data), drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+    }
+    IM_ASSERT(frame.size() == sizeof(uint32_t) + payloadSize);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(frame));
+    }
+    m_condition.notify_one();
+    m_frameCount++;
+}
+
+void DrawDataRecorder::ThreadMain()
+{
+    std::string frame;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!frame.empty())
+                m_freeBuffers.push_back(std::move(frame));
+            m_condition.wait(lock, [this]() { return !m_queue.empty() || m_stopping; });
+            if (m_queue.empty())
+                break;
+            frame.swap(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        if (!m_failed && m_file.write(frame.data(), frame.size()))
+            m_writtenBytes += frame.size();
+        else
+            m_failed = true;
+    }
+    if (!m_file.flush())
+        m_failed = true;
+}
+
+bool DrawDataPlayer::Open(const std::string& path)
+{
+    m_file.close();
+    m_file.clear();
+    m_error.clear();
+    m_frameIndex = 0;
+    m_file.open(path, std::ios::binary);
+    if (!m_file)
+    {
+        m_error = "Failed to open " + path;
+        return false;
+    }
+
+    char magic[sizeof(MBDD_MAGIC)];
+    uint32_t version = 0, vtxSize = 0, idxSize = 0;
+    m_file.read(magic, sizeof(magic));
+    m_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    m_file.read(reinterpret_cast<char*>(&vtxSize), sizeof(vtxSize));
+    m_file.read(reinterpret_cast<char*>(&idxSize), sizeof(idxSize));
+    if (!m_file || memcmp(magic, MBDD_MAGIC, sizeof(magic)) != 0)
+        m_error = path + " is not a draw data recording";
+    else if (version != MBDD_VERSION)
+        m_error = "Unsupported recording version " + std::to_string(version);
+    else if (vtxSize != sizeof(ImDrawVert) || idxSize != sizeof(ImDrawIdx))
+        m_error = "Recording uses " + std::to_string(vtxSize) + " bytes vertices and " + std::to_string(idxSize)
+            + " bytes indices, this build uses " + std::to_string(sizeof(ImDrawVert)) + " and " + std::to_string(sizeof(ImDrawIdx));
+    if (!m_error.empty())
+    {
+        m_file.close();
+        return false;
+    }
+    m_firstFrame = m_file.tellg();
+    return true;
+}
+
+void DrawDataPlayer::Rewind()
+{
+    if (!m_file.is_open())
+        return;
+    m_file.clear();
+    m_file.seekg(m_firstFrame);
+    m_frameIndex = 0;
+}
+
+void DrawDataPlayer::SetTextureRemap(ImTextureID recorded, ImTextureID replayed)
+{
+    for (int n = 0; n < m_remapFrom.Size; n++)
+    {
+        if (m_remapFrom[n] == recorded)
+        {
+            m_remapTo[n] = replayed;
+            return;
+        }
+    }
+    m_remapFrom.push_back(recorded);
+    m_remapTo.push_back(replayed);
+}
+
+ImDrawData* DrawDataPlayer::NextFrame()
+{
+    if (!m_file.is_open() || !m_error.empty())
+        return nullptr;
+    uint32_t payloadSize = 0;
+    if (!m_file.read(reinterpret_cast<char*>(&payloadSize), sizeof(payloadSize)))
+        return nullptr;     // End of the recording
+    if (payloadSize > MBDD_MAX_FRAME_SIZE)
+    {
+        m_error = "Frame " + std::to_string(m_frameIndex) + " has an invalid size";
+        return nullptr;
+    }
+    m_payload.resize(payloadSize);
+    if (!m_file.read(&m_payload[0], payloadSize) || !ParseFrame())
+    {
+        if (m_error.empty())
+            m_error = "Frame " + std::to_string(m_frameIndex) + " is truncated or malformed";
+        return nullptr;
+    }
+    m_frameIndex++;
+    return &m_drawData;
+}
+
+bool DrawDataPlayer::ParseFrame()
+{
+    PayloadReader reader = { m_payload.data(), m_payload.data() + m_payload.size() };
+    ImDrawData& drawData = m_drawData;
+    drawData.Clear();
+    uint32_t listCount = 0;
+    if (!reader.Get(drawData.DisplayPos) || !reader.Get(drawData.DisplaySize) || !reader.Get(drawData.FramebufferScale) || !reader.Get(listCount))
+        return false;
+
+    for (uint32_t l = 0; l < listCount; l++)
+    {
+        if (l == m_lists.size())
+            m_lists.push_back(std::unique_ptr<ImDrawList>(new ImDrawList(&m_sharedData)));
+        ImDrawList& drawList = *m_lists[l];
+        uint32_t cmdCount = 0, vtxCount = 0, idxCount = 0;
+        if (!reader.Get(cmdCount) || !reader.Get(vtxCount) || !reader.Get(idxCount))
+            return false;
+
+        drawList.CmdBuffer.resize(0);
+        for (uint32_t c = 0; c < cmdCount; c++)
+        {
+            ImDrawCmd cmd;
+            uint64_t textureId = 0;
+            uint32_t vtxOffset = 0, idxOffset = 0, elemCount = 0, callback = 0;
+            if (!reader.Get(cmd.ClipRect) || !reader.Get(textureId) || !reader.Get(vtxOffset) || !reader.Get(idxOffset)
+                || !reader.Get(elemCount) || !reader.Get(callback))
+                return false;
+            if ((uint64_t)idxOffset + elemCount > idxCount || vtxOffset > vtxCount)
+                return false;
+            if (callback == DrawCallback_Other)
+                continue;
+            cmd.TextureId = (ImTextureID)textureId;
+            for (int n = 0; n < m_remapFrom.Size; n++)
+                if (m_remapFrom[n] == cmd.TextureId)
+                    cmd.TextureId = m_remapTo[n];
+            cmd.VtxOffset = vtxOffset;
+            cmd.IdxOffset = idxOffset;
+            cmd.ElemCount = elemCount;
+            cmd.UserCallback = callback == DrawCallback_ResetRenderState ? ImDrawCallback_ResetRenderState : nullptr;
+            drawList.CmdBuffer.push_back(cmd);
+        }
+        if (!reader.GetArray(drawList.VtxBuffer, vtxCount) || !reader.GetArray(drawList.IdxBuffer, idxCount))
+            return false;
+
+        // Backends index vertices without checking, a bad recording must not make them read out of bounds
+        for (const ImDrawCmd& cmd : drawList.CmdBuffer)
+        {
+            const ImDrawIdx* idx = drawList.IdxBuffer.Data + cmd.IdxOffset;
+            const unsigned int vtxAvailable = vtxCount - cmd.VtxOffset;
+            for (unsigned int i = 0; i < cmd.ElemCount; i++)
+                if (idx[i] >= vtxAvailable)
+                    return false;
+        }
+
+        drawData.CmdLists.push_back(&drawList);
+        drawData.TotalVtxCount += drawList.VtxBuffer.Size;
+        drawData.TotalIdxCount += drawList.IdxBuffer.Size;
+    }
+    if (reader.cursor != reader.end)
+        return false;
+    drawData.CmdListsCount = drawData.CmdLists.Size;
+    drawData.Valid = true;
+    return true;
+}
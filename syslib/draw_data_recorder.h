@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+// Recorded ImDrawData streams (.mbdd), to compare the cost of the overlay between builds without the game or a GPU.
+// Little-endian, no padding:
+//   file:  "MBDD", u32 version, u32 sizeof(ImDrawVert), u32 sizeof(ImDrawIdx), then frames until the end of the file
+//   frame: u32 payload size, f32 DisplayPos.xy, DisplaySize.xy, FramebufferScale.xy, u32 list count, lists
+//   list:  u32 command count, u32 vertex count, u32 index count, commands, vertices, indices (raw ImDrawVert/ImDrawIdx)
+//   cmd:   f32 ClipRect.xyzw, u64 TextureId, u32 VtxOffset, u32 IdxOffset, u32 ElemCount, u32 callback (0: none, 1: ResetRenderState, 2: other)
+// Callbacks are pointers into the recording process, so only ImDrawCallback_ResetRenderState survives playback.
+
+// Draw call counts of a frame, as a backend would see them
+struct DrawDataStats
+{
+    int listCount = 0;
+    int drawCalls = 0;          // Commands with elements, callbacks excluded
+    int vtxCount = 0;
+    int idxCount = 0;
+
+    static DrawDataStats Measure(const ImDrawData* drawData);
+};
+
+// Serializes each frame on the render thread and writes it on a background thread, so recording never waits for the disk.
+class DrawDataRecorder
+{
+public:
+    ~DrawDataRecorder();
+
+    bool Start(const std::string& path);
+    void Stop();            // Writes the queued frames, then closes the file. Not from DllMain, as SettingsWriter::Stop()
+    bool IsRecording() const { return m_recording; }
+
+    void Record(const ImDrawData* drawData);   // After ImGui::Render(), no-op when not recording
+
+    int GetFrameCount() const { return m_frameCount; }
+    uint64_t GetWrittenBytes() const { return m_writtenBytes; }
+    bool HasFailed() const { return m_failed; }      // A write failed, recording stopped queueing frames
+
+private:
+    void ThreadMain();
+
+    bool m_recording = false;                   // Render thread only
+    std::ofstream m_file;                       // Writer thread only once started
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::string> m_queue;            // Serialized frames not written yet
+    std::vector<std::string> m_freeBuffers;     // Written frames, reused so steady recording doesn't allocate
+    bool m_stopping = false;
+
+    std::atomic<int> m_frameCount{ 0 };
+    std::atomic<uint64_t> m_writtenBytes{ 0 };
+    std::atomic<bool> m_failed{ false };
+};
+
+// Reads a recording back one frame at a time. The ImDrawData returned by NextFrame() can be given to any renderer
+// backend (texture ids are the recording process' ids: remap them with SetTextureRemap() for a real backend).
+// Doesn't need an ImGui context.
+class DrawDataPlayer
+{
+public:
+    bool Open(const std::string& path);
+    void Rewind();
+
+    // Next frame, valid until the next call. nullptr at the end of the recording or on a malformed frame (see GetError()).
+    ImDrawData* NextFrame();
+
+    int GetFrameIndex() const { return m_frameIndex; }     // Frames read since Open() or Rewind()
+    const std::string& GetError() const { return m_error; }
+
+    // Texture ids of replayed commands: recorded id -> id to draw with. Ids without entry are kept
+    void SetTextureRemap(ImTextureID recorded, ImTextureID replayed);
+
+private:
+    bool ParseFrame();
+
+    std::ifstream m_file;
+    std::streampos m_firstFrame;
+    std::string m_error;
+    int m_frameIndex = 0;
+
+    std::string m_payload;
+    ImDrawListSharedData m_sharedData;                  // Unused by playback, but draw lists need one
+    std::vector<std::unique_ptr<ImDrawList>> m_lists;   // Kept across frames, so playback stops allocating once warm
+    ImDrawData m_drawData;
+    ImVector<ImTextureID> m_remapFrom, m_remapTo;
+};
@@ -65,6 +65,9 @@
 //---- Use legacy CRC32-adler tables (used before 1.91.6), in order to preserve old .ini data that you cannot afford to invalidate.
 //#define IMGUI_USE_LEGACY_CRC32_ADLER
 
+//---- Use a hash index in ImGuiStorage instead of a sorted array: O(1) instead of O(log N) lookups and O(N) insertions. Worth it for windows/tables holding many thousands of IDs.
+//#define IMGUI_USE_HASHED_STORAGE
+
 //---- Use 32-bit for ImWchar (default is 16-bit) to support Unicode planes 1-16. (e.g. point beyond 0xFFFF like emoticons, dingbats, symbols, shapes, ancient languages, etc...)
 //#define IMGUI_USE_WCHAR32
 
@@ -98,6 +101,9 @@
 // The only purpose of this define is if you want force compilation of the stb_truetype backend ALONG with the FreeType backend.
 //#define IMGUI_ENABLE_STB_TRUETYPE
 
+//---- Rasterize glyphs on multiple threads in ImFontAtlas::Build() (stb_truetype builder only, uses std::thread). See ImFontAtlas::FontBuilderThreadCount.
+#define IMGUI_ENABLE_FONT_BUILD_THREADS
+
 //---- Define constructor and implicit cast operators to convert back<>forth between your math types and ImVec2/ImVec4.
 // This will be inlined as part of ImVec2 and ImVec4 class declarations.
 /*
@@ -72,6 +72,7 @@ CODE
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
 // [SECTION] ImGuiTextBuffer, ImGuiTextIndex
+// [SECTION] ImGuiTextMeasureCache
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -1126,6 +1127,14 @@ CODE
 #include <TargetConditionals.h>
 #endif
 
+// [POSIX] OS specific includes (for ImFileMap)
+#if !defined(_WIN32) && !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>          // open
+#include <sys/mman.h>       // mmap, munmap
+#include <sys/stat.h>       // fstat
+#include <unistd.h>         // close
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (disable: 4127)             // condition expression is constant
@@ -1318,6 +1327,11 @@ static ImGuiMemAllocFunc    GImAllocatorAllocFunc = MallocWrapper;
 static ImGuiMemFreeFunc     GImAllocatorFreeFunc = FreeWrapper;
 static void*                GImAllocatorUserData = NULL;
 
+// Threads which allocate without owning the context (e.g. building standalone ImDrawList) must not update its debug allocation counters.
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+static thread_local bool    GImDebugAllocHookDisabled = false;
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] USER FACING STRUCTURES (ImGuiStyle, ImGuiIO, ImGuiPlatformIO)
 //-----------------------------------------------------------------------------
@@ -1467,6 +1481,7 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsCopyContentsWithCtrlC = false;
     ConfigScrollbarScrollByPage = true;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigIniSaveIncremental = false;
     ConfigDebugIsDebuggerPresent = false;
     ConfigDebugHighlightIdConflicts = true;
     ConfigDebugHighlightIdConflictsShowItemPicker = true;
@@ -2059,6 +2074,56 @@ const char* ImStristr(const char* haystack, const char* haystack_end, const char
     return NULL;
 }
 
+// Same as ImStristr() with a lowercase needle, which is only compared against haystack characters after folding them to lowercase.
+// With SSE2, 16 positions are tested at a time for both first and last characters of needle, and only candidates are fully compared.
+const char* ImStristrLower(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
+{
+    if (!haystack_end)
+        haystack_end = haystack + ImStrlen(haystack);
+    if (!needle_end)
+        needle_end = needle + ImStrlen(needle);
+    const int needle_len = (int)(needle_end - needle);
+    if (needle_len == 0 || haystack_end - haystack < needle_len)
+        return NULL;
+
+    const char* haystack_last = haystack_end - needle_len; // Last position where needle may start
+    const char n_first = needle[0];
+    const char n_last = needle[needle_len - 1];
+#ifdef IMGUI_ENABLE_SSE2
+    const __m128i first_lower = _mm_set1_epi8(n_first);
+    const __m128i first_upper = _mm_set1_epi8(ImToUpper(n_first));
+    const __m128i last_lower = _mm_set1_epi8(n_last);
+    const __m128i last_upper = _mm_set1_epi8(ImToUpper(n_last));
+    for (; haystack + 16 <= haystack_last + 1; haystack += 16)
+    {
+        const __m128i block_first = _mm_loadu_si128((const __m128i*)haystack);
+        const __m128i block_last = _mm_loadu_si128((const __m128i*)(haystack + needle_len - 1));
+        const __m128i eq_first = _mm_or_si128(_mm_cmpeq_epi8(block_first, first_lower), _mm_cmpeq_epi8(block_first, first_upper));
+        const __m128i eq_last = _mm_or_si128(_mm_cmpeq_epi8(block_last, last_lower), _mm_cmpeq_epi8(block_last, last_upper));
+        for (unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)); mask != 0; mask &= mask - 1)
+        {
+            const char* candidate = haystack + ImCountTrailingZeroes(mask);
+            int n = 1;
+            while (n < needle_len - 1 && ImToLower(candidate[n]) == needle[n])
+                n++;
+            if (n >= needle_len - 1)
+                return candidate;
+        }
+    }
+#endif
+    for (; haystack <= haystack_last; haystack++)
+    {
+        if (ImToLower(haystack[0]) != n_first || ImToLower(haystack[needle_len - 1]) != n_last)
+            continue;
+        int n = 1;
+        while (n < needle_len - 1 && ImToLower(haystack[n]) == needle[n])
+            n++;
+        if (n >= needle_len - 1)
+            return haystack;
+    }
+    return NULL;
+}
+
 // Trim str by offsetting contents when there's leading data + writing a \0 at the trailing position. We use this in situation where the cost is negligible.
 void ImStrTrimBlanks(char* buf)
 {
@@ -2229,18 +2294,139 @@ static const ImU32 GCrc32LookupTable[256] =
 };
 #endif
 
+#ifndef IMGUI_ENABLE_SSE4_2_CRC
+// Slice-by-8: T[0] is GCrc32LookupTable, T[n] advances a CRC by n extra zero bytes, so 8 input bytes are consumed with 8 independent lookups.
+// Built on first use (function-local static: thread-safe and usable by static constructors), instead of adding 7KB of const tables per CRC variant.
+struct ImCrc32SliceTables
+{
+    ImU32 T[8][256];
+    ImCrc32SliceTables()
+    {
+        memcpy(T[0], GCrc32LookupTable, sizeof(T[0]));
+        for (int n = 1; n < 8; n++)
+            for (int i = 0; i < 256; i++)
+                T[n][i] = (T[n - 1][i] >> 8) ^ T[0][T[n - 1][i] & 0xFF];
+    }
+};
+
+static const ImCrc32SliceTables& ImCrc32GetSliceTables()
+{
+    static const ImCrc32SliceTables tables;
+    return tables;
+}
+
+// ImHashStrSlices() may read past a terminator, within its page (see there)
+#if defined(__clang__) || defined(__GNUC__)
+#define IM_CRC32_NO_SANITIZE_ADDRESS    __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER) && _MSC_VER >= 1928
+#define IM_CRC32_NO_SANITIZE_ADDRESS    __declspec(no_sanitize_address)
+#else
+#define IM_CRC32_NO_SANITIZE_ADDRESS
+#endif
+
+IM_CRC32_NO_SANITIZE_ADDRESS
+static inline ImU32 ImCrc32Read32(const unsigned char* p)        { return (ImU32)p[0] | ((ImU32)p[1] << 8) | ((ImU32)p[2] << 16) | ((ImU32)p[3] << 24); }
+static inline bool  ImCrc32HasZeroByte(ImU32 v)                  { return ((v - 0x01010101) & ~v & 0x80808080) != 0; }
+static inline bool  ImCrc32HasHashChar(ImU32 v)                  { return ImCrc32HasZeroByte(v ^ 0x23232323); } // Any byte == '#'
+
+static inline ImU32 ImCrc32Slice8(const ImU32 (*lut)[256], ImU32 crc, ImU32 lo, ImU32 hi)
+{
+    lo ^= crc;
+    return lut[7][lo & 0xFF] ^ lut[6][(lo >> 8) & 0xFF] ^ lut[5][(lo >> 16) & 0xFF] ^ lut[4][lo >> 24] ^
+           lut[3][hi & 0xFF] ^ lut[2][(hi >> 8) & 0xFF] ^ lut[1][(hi >> 16) & 0xFF] ^ lut[0][hi >> 24];
+}
+
+// Sliced tails of ImHashData() and ImHashStr(). Out of line and tail-called, so the short-key paths stay leaf functions
+// (the tables' initialization guard is a call, which would otherwise give every hash a stack frame).
+static ImGuiID ImHashDataSlices(const unsigned char* data, const unsigned char* data_end, ImU32 crc)
+{
+    const ImU32 (*crc32_lut)[256] = ImCrc32GetSliceTables().T;
+    for (; data_end - data >= 8; data += 8)
+        crc = ImCrc32Slice8(crc32_lut, crc, ImCrc32Read32(data), ImCrc32Read32(data + 4));
+    while (data < data_end)
+        crc = (crc >> 8) ^ GCrc32LookupTable[(crc & 0xFF) ^ *data++];
+    return ~crc;
+}
+
+// With data_size == 0, 'data' is zero-terminated: 8 bytes are read at a time when they don't cross a page boundary, which is
+// safe even past the terminator (as in strlen), but not for AddressSanitizer. 4KB is the smallest page size of the targets.
+#define IM_CRC32_PAGE_SIZE  4096
+IM_CRC32_NO_SANITIZE_ADDRESS
+static ImGuiID ImHashStrSlices(const unsigned char* data, size_t data_size, ImU32 crc, ImU32 seed)
+{
+    const ImU32 (*crc32_lut)[256] = ImCrc32GetSliceTables().T;
+    if (data_size != 0)
+    {
+        while (data_size != 0)
+        {
+            if (data_size >= 8)
+            {
+                const ImU32 lo = ImCrc32Read32(data);
+                const ImU32 hi = ImCrc32Read32(data + 4);
+                if (!ImCrc32HasHashChar(lo) && !ImCrc32HasHashChar(hi))
+                {
+                    crc = ImCrc32Slice8(crc32_lut, crc, lo, hi);
+                    data += 8;
+                    data_size -= 8;
+                    continue;
+                }
+            }
+
+            // The next 8 bytes (or fewer at the end) hold a '#': all of them byte per byte, before reading 8 again
+            for (size_t n = ImMin(data_size, (size_t)8); n != 0; n--)
+            {
+                unsigned char c = *data++;
+                data_size--;
+                if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+                    crc = seed;
+                crc = (crc >> 8) ^ GCrc32LookupTable[(crc & 0xFF) ^ c];
+            }
+        }
+    }
+    else
+    {
+        while (true)
+        {
+            if (((size_t)data & (IM_CRC32_PAGE_SIZE - 1)) <= IM_CRC32_PAGE_SIZE - 8)
+            {
+                const ImU32 lo = ImCrc32Read32(data);
+                const ImU32 hi = ImCrc32Read32(data + 4);
+                if (!ImCrc32HasZeroByte(lo) && !ImCrc32HasZeroByte(hi) && !ImCrc32HasHashChar(lo) && !ImCrc32HasHashChar(hi))
+                {
+                    crc = ImCrc32Slice8(crc32_lut, crc, lo, hi);
+                    data += 8;
+                    continue;
+                }
+            }
+
+            // The 8 bytes hold the terminator or a '#' (or end a page): all of them byte per byte, before reading 8 again
+            for (const unsigned char* data_bytes_end = data + 8; data != data_bytes_end; )
+            {
+                unsigned char c = *data++;
+                if (c == 0)
+                    return ~crc;
+                if (c == '#' && data[0] == '#' && data[1] == '#')
+                    crc = seed;
+                crc = (crc >> 8) ^ GCrc32LookupTable[(crc & 0xFF) ^ c];
+            }
+        }
+    }
+    return ~crc;
+}
+#endif
+
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
 ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 {
     ImU32 crc = ~seed;
     const unsigned char* data = (const unsigned char*)data_p;
     const unsigned char *data_end = (const unsigned char*)data_p + data_size;
 #ifndef IMGUI_ENABLE_SSE4_2_CRC
-    const ImU32* crc32_lut = GCrc32LookupTable;
+    if (data_size >= 8)
+        return ImHashDataSlices(data, data_end, crc);
     while (data < data_end)
-        crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
+        crc = (crc >> 8) ^ GCrc32LookupTable[(crc & 0xFF) ^ *data++];
     return ~crc;
 #else
     while (data + 4 <= data_end)
@@ -2259,15 +2445,16 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
 // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - Table path: under 8 bytes, the byte loop below. Longer strings go on in ImHashStrSlices(), 8 bytes at a time while they
+//   contain no '#', byte per byte otherwise. Zero-terminated strings are hashed in one pass, handed over after their first 8 bytes.
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
 {
     seed = ~seed;
     ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
 #ifndef IMGUI_ENABLE_SSE4_2_CRC
-    const ImU32* crc32_lut = GCrc32LookupTable;
-#endif
+    if (data_size >= 8)
+        return ImHashStrSlices(data, data_size, crc, seed);
     if (data_size != 0)
     {
         while (data_size-- != 0)
@@ -2275,11 +2462,30 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
             unsigned char c = *data++;
             if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
                 crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
+            crc = (crc >> 8) ^ GCrc32LookupTable[(crc & 0xFF) ^ c];
+        }
+    }
+    else
+    {
+        const unsigned char* data_slices = data + 8;
+        while (unsigned char c = *data++)
+        {
+            if (c == '#' && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = (crc >> 8) ^ GCrc32LookupTable[(crc & 0xFF) ^ c];
+            if (data == data_slices && *data != 0)
+                return ImHashStrSlices(data, 0, crc, seed);
+        }
+    }
 #else
+    if (data_size != 0)
+    {
+        while (data_size-- != 0)
+        {
+            unsigned char c = *data++;
+            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+                crc = seed;
             crc = _mm_crc32_u8(crc, c);
-#endif
         }
     }
     else
@@ -2288,13 +2494,10 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
         {
             if (c == '#' && data[0] == '#' && data[1] == '#')
                 crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-#else
             crc = _mm_crc32_u8(crc, c);
-#endif
         }
     }
+#endif
     return ~crc;
 }
 
@@ -2336,6 +2539,62 @@ ImU64   ImFileRead(void* data, ImU64 sz, ImU64 count, ImFileHandle f)
 ImU64   ImFileWrite(const void* data, ImU64 sz, ImU64 count, ImFileHandle f)    { return fwrite(data, (size_t)sz, (size_t)count, f); }
 #endif // #ifndef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
 
+// Helper: Map file content into memory (read-only). Must be released with ImFileUnmap().
+// Uses the OS file mapping when available (Win32, POSIX), otherwise falls back to ImFileLoadToMemory().
+#if !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) && defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS) && (defined(__MINGW32__) || (!defined(__CYGWIN__) && !defined(__GNUC__)))
+const void* ImFileMap(const char* filename, size_t* out_file_size)
+{
+    IM_ASSERT(filename && out_file_size);
+    *out_file_size = 0;
+    const int filename_wsize = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+    ImVector<wchar_t> filename_wbuf;
+    filename_wbuf.resize(filename_wsize);
+    ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_wbuf.Data, filename_wsize);
+
+    HANDLE file = ::CreateFileW(filename_wbuf.Data, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+    LARGE_INTEGER file_size;
+    const void* data = NULL;
+    if (::GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0 && (ImU64)file_size.QuadPart <= (size_t)-1)
+        if (HANDLE mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL))
+        {
+            data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping); // The view keeps the mapping alive
+        }
+    ::CloseHandle(file);
+    if (data != NULL)
+        *out_file_size = (size_t)file_size.QuadPart;
+    return data;
+}
+void    ImFileUnmap(const void* data, size_t)   { if (data) ::UnmapViewOfFile(data); }
+#elif !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) && (defined(__unix__) || defined(__APPLE__))
+const void* ImFileMap(const char* filename, size_t* out_file_size)
+{
+    IM_ASSERT(filename && out_file_size);
+    *out_file_size = 0;
+    int fd = ::open(filename, O_RDONLY);
+    if (fd == -1)
+        return NULL;
+    struct stat st;
+    void* data = NULL;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        data = ::mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+            data = NULL;
+    }
+    ::close(fd); // The mapping keeps the file alive
+    if (data != NULL)
+        *out_file_size = (size_t)st.st_size;
+    return data;
+}
+void    ImFileUnmap(const void* data, size_t file_size) { if (data) ::munmap((void*)data, file_size); }
+#else
+const void* ImFileMap(const char* filename, size_t* out_file_size)  { return ImFileLoadToMemory(filename, "rb", out_file_size); }
+void    ImFileUnmap(const void* data, size_t)                       { if (data) IM_FREE((void*)data); }
+#endif
+
 // Helper: Load file content into memory
 // Memory allocated with IM_ALLOC(), must be freed by user using IM_FREE() == ImGui::MemFree()
 // This can't really be used with "rt" because fseek size won't match read size.
@@ -2703,18 +2962,104 @@ static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
     return (lhs_v > rhs_v ? +1 : lhs_v < rhs_v ? -1 : 0);
 }
 
+#ifdef IMGUI_USE_HASHED_STORAGE
+static inline ImU32 ImGuiStorageHashKey(ImGuiID key)
+{
+    // IDs are mostly hashes already, but some are small sequential integers (e.g. ImGuiSelectionBasicStorage indices): spread them
+    ImU32 h = key * 0x9E3779B1u;
+    return h ^ (h >> 16);
+}
+
+// Add Data[IndexedCount..Size) to the index. Caller ensures load factor stays <= 0.5
+static void ImGuiStorageIndexTail(const ImGuiStorage* storage)
+{
+    const int mask = storage->Index.Size - 1;
+    int* index = storage->Index.Data;
+    for (int n = storage->IndexedCount; n < storage->Data.Size; n++)
+    {
+        int slot = (int)(ImGuiStorageHashKey(storage->Data.Data[n].key) & mask);
+        while (index[slot] != 0)
+            slot = (slot + 1) & mask;
+        index[slot] = n + 1;
+    }
+    storage->IndexedCount = storage->Data.Size;
+}
+
+static inline void ImGuiStorageSyncIndex(const ImGuiStorage* storage)
+{
+    if (storage->IndexedCount == storage->Data.Size)
+        return;
+    if (storage->IndexedCount > storage->Data.Size || storage->Data.Size * 2 > storage->Index.Size)
+        storage->BuildIndex();
+    else
+        ImGuiStorageIndexTail(storage);
+}
+
+void ImGuiStorage::BuildIndex() const
+{
+    int capacity = 16;
+    while (capacity < Data.Size * 2)
+        capacity *= 2;
+    Index.resize(capacity);
+    memset(Index.Data, 0, (size_t)Index.size_in_bytes());
+    IndexedCount = 0;
+    ImGuiStorageIndexTail(this);
+}
+
+static ImGuiStoragePair* ImGuiStorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStorageSyncIndex(storage);
+    if (storage->Index.Size == 0)
+        return NULL;
+    const int mask = storage->Index.Size - 1;
+    for (int slot = (int)(ImGuiStorageHashKey(key) & mask); storage->Index.Data[slot] != 0; slot = (slot + 1) & mask)
+    {
+        ImGuiStoragePair* it = const_cast<ImGuiStoragePair*>(&storage->Data.Data[storage->Index.Data[slot] - 1]);
+        if (it->key == key)
+            return it;
+    }
+    return NULL;
+}
+
+static ImGuiStoragePair* ImGuiStorageFindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& default_pair)
+{
+    if (ImGuiStoragePair* it = ImGuiStorageFind(storage, default_pair.key))
+        return it;
+    storage->Data.push_back(default_pair);
+    ImGuiStorageSyncIndex(storage);
+    return &storage->Data.back();
+}
+#else
+static ImGuiStoragePair* ImGuiStorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(storage->Data.Data), const_cast<ImGuiStoragePair*>(storage->Data.Data + storage->Data.Size), key);
+    if (it == storage->Data.Data + storage->Data.Size || it->key != key)
+        return NULL;
+    return it;
+}
+
+static ImGuiStoragePair* ImGuiStorageFindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& default_pair)
+{
+    ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + storage->Data.Size, default_pair.key);
+    if (it == storage->Data.Data + storage->Data.Size || it->key != default_pair.key)
+        it = storage->Data.insert(it, default_pair);
+    return it;
+}
+#endif
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), PairComparerByID);
+#ifdef IMGUI_USE_HASHED_STORAGE
+    BuildIndex();
+#endif
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2724,27 +3069,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2754,28 +3092,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_i = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2785,20 +3112,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_f = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_p = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -2815,7 +3134,7 @@ IM_MSVC_RUNTIME_CHECKS_RESTORE
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 ImGuiTextFilter::ImGuiTextFilter(const char* default_filter) //-V1077
 {
-    InputBuf[0] = 0;
+    InputBuf[0] = InputBufLower[0] = 0;
     CountGrep = 0;
     if (default_filter)
     {
@@ -2870,6 +3189,11 @@ void ImGuiTextFilter::Build()
         if (f.b[0] != '-')
             CountGrep += 1;
     }
+
+    // Lowercase once here rather than folding case of both sides for each compared character
+    for (int n = 0; n < IM_ARRAYSIZE(InputBuf); n++)
+        if ((InputBufLower[n] = ImToLower(InputBuf[n])) == 0)
+            break;
 }
 
 bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
@@ -2879,21 +3203,25 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 
     if (text == NULL)
         text = text_end = "";
+    if (text_end == NULL)
+        text_end = text + ImStrlen(text);
 
     for (const ImGuiTextRange& f : Filters)
     {
         if (f.b == f.e)
             continue;
+        const char* needle = InputBufLower + (f.b - InputBuf);
+        const char* needle_end = InputBufLower + (f.e - InputBuf);
         if (f.b[0] == '-')
         {
             // Subtract
-            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
+            if (ImStristrLower(text, text_end, needle + 1, needle_end) != NULL)
                 return false;
         }
         else
         {
             // Grep
-            if (ImStristr(text, text_end, f.b, f.e) != NULL)
+            if (ImStristrLower(text, text_end, needle, needle_end) != NULL)
                 return true;
         }
     }
@@ -2988,6 +3316,178 @@ void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
     EndOffset = ImMax(EndOffset, new_size);
 }
 
+// Bulk version of ImGuiTextFilter::PassFilter(). Grep terms are searched over the whole range, and each hit skips the rest of its line.
+int ImTextFilterPassLines(const ImGuiTextFilter* filter, const char* buf, ImGuiTextIndex* index, int line_begin, int line_end, ImBitVector* out_matches)
+{
+    IM_ASSERT(line_begin >= 0 && line_end <= index->size() && (line_end - line_begin) <= (out_matches->Storage.Size << 5));
+    int count = 0;
+    bool has_subtract = false;
+    for (const ImGuiTextFilter::ImGuiTextRange& f : filter->Filters)
+        if (!f.empty() && f.b[0] == '-')
+            has_subtract = true;
+    if (has_subtract || filter->CountGrep == 0)
+    {
+        for (int line = line_begin; line < line_end; line++)
+            if (filter->PassFilter(index->get_line_begin(buf, line), index->get_line_end(buf, line)))
+            {
+                out_matches->SetBit(line - line_begin);
+                count++;
+            }
+        return count;
+    }
+    if (line_begin >= line_end)
+        return 0;
+
+    for (const ImGuiTextFilter::ImGuiTextRange& f : filter->Filters)
+    {
+        if (f.empty())
+            continue;
+        const char* needle = filter->InputBufLower + (f.b - filter->InputBuf);
+        const char* needle_end = filter->InputBufLower + (f.e - filter->InputBuf);
+
+        // Lines matched by a previous term are not searched again: search each run of unmatched lines (the whole range for the first term).
+        for (int line = line_begin; line < line_end; )
+        {
+            while (line < line_end && out_matches->TestBit(line - line_begin))
+                line++;
+            int run_end = line;
+            while (run_end < line_end && !out_matches->TestBit(run_end - line_begin))
+                run_end++;
+            if (line == run_end)
+                break;
+
+            const char* range_end = index->get_line_end(buf, run_end - 1);
+            for (const char* p = index->get_line_begin(buf, line); (p = ImStristrLower(p, range_end, needle, needle_end)) != NULL; )
+            {
+                // Find line of this hit, galloping from current line as hits are often close. Needle never contains '\n', so a hit never spans two lines.
+                const int p_offset = (int)(p - buf);
+                int gallop = 1;
+                while (line + gallop < run_end && index->LineOffsets[line + gallop] <= p_offset)
+                {
+                    line += gallop;
+                    gallop *= 2;
+                }
+                for (int count_lines = ImMin(gallop, run_end - line) - 1; count_lines > 0; )
+                {
+                    const int step = count_lines >> 1;
+                    if (index->LineOffsets[line + 1 + step] <= p_offset) { line += step + 1; count_lines -= step + 1; }
+                    else { count_lines = step; }
+                }
+                out_matches->SetBit(line - line_begin);
+                count++;
+                if (++line >= run_end)
+                    break;
+                p = index->get_line_begin(buf, line);
+            }
+            line = run_end;
+        }
+    }
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiTextMeasureCache
+//-----------------------------------------------------------------------------
+
+int ImGuiTextMeasureCache::Find(ImGuiID key, ImFont* font, float font_size, float wrap_width, const char* text, int text_len) const
+{
+    if (Buckets.Size == 0)
+        return -1;
+    const int mask = Buckets.Size - 1;
+    for (int bucket_n = (int)(key & (ImGuiID)mask); ; bucket_n = (bucket_n + 1) & mask)
+    {
+        const int entry_n = Buckets.Data[bucket_n];
+        if (entry_n == -1)
+            return -1;
+        const ImGuiTextMeasureEntry& entry = Entries.Data[entry_n];
+        if (entry.Key == key && entry.TextLen == text_len && entry.Font == font && entry.FontSize == font_size && entry.WrapWidth == wrap_width
+            && memcmp(&Text.Data[entry.TextOffset], text, (size_t)text_len) == 0)
+            return entry_n;
+    }
+}
+
+int ImGuiTextMeasureCache::Add(ImGuiID key, ImFont* font, float font_size, float wrap_width, const char* text, int text_len)
+{
+    // Keep load factor under 50%
+    if ((Entries.Size + 1) * 2 > Buckets.Size)
+        RebuildBuckets(ImMax(Buckets.Size * 2, 256));
+
+    const int entry_n = Entries.Size;
+    ImGuiTextMeasureEntry entry;
+    entry.Key = key;
+    entry.Font = font;
+    entry.FontSize = font_size;
+    entry.WrapWidth = wrap_width;
+    entry.TextOffset = Text.Size;
+    entry.TextLen = text_len;
+    entry.Size = ImVec2(0.0f, 0.0f);
+    entry.LinesOffset = entry.LinesCount = 0;
+    entry.LastFrameUsed = -1;
+    Entries.push_back(entry);
+    Text.resize(Text.Size + text_len);
+    memcpy(&Text.Data[entry.TextOffset], text, (size_t)text_len);
+
+    const int mask = Buckets.Size - 1;
+    int bucket_n = (int)(key & (ImGuiID)mask);
+    while (Buckets.Data[bucket_n] != -1)
+        bucket_n = (bucket_n + 1) & mask;
+    Buckets.Data[bucket_n] = entry_n;
+    return entry_n;
+}
+
+void ImGuiTextMeasureCache::RebuildBuckets(int buckets_count)
+{
+    IM_ASSERT(ImIsPowerOfTwo(buckets_count));
+    Buckets.resize(buckets_count);
+    memset(Buckets.Data, 0xFF, (size_t)Buckets.size_in_bytes());
+    const int mask = buckets_count - 1;
+    for (int entry_n = 0; entry_n < Entries.Size; entry_n++)
+    {
+        int bucket_n = (int)(Entries.Data[entry_n].Key & (ImGuiID)mask);
+        while (Buckets.Data[bucket_n] != -1)
+            bucket_n = (bucket_n + 1) & mask;
+        Buckets.Data[bucket_n] = entry_n;
+    }
+}
+
+// Discard entries which haven't been used since 'min_frame_used', compacting Lines[] and Text[] along the way.
+void ImGuiTextMeasureCache::GcCompact(int min_frame_used)
+{
+    int dst_n = 0;
+    int lines_dst_n = 0;
+    int text_dst_n = 0;
+    for (int src_n = 0; src_n < Entries.Size; src_n++)
+    {
+        ImGuiTextMeasureEntry entry = Entries.Data[src_n];
+        if (entry.LastFrameUsed < min_frame_used)
+            continue;
+        if (entry.LinesCount > 0)
+        {
+            memmove(&Lines.Data[lines_dst_n * 2], &Lines.Data[entry.LinesOffset * 2], (size_t)entry.LinesCount * 2 * sizeof(int));
+            entry.LinesOffset = lines_dst_n;
+            lines_dst_n += entry.LinesCount;
+        }
+        memmove(&Text.Data[text_dst_n], &Text.Data[entry.TextOffset], (size_t)entry.TextLen);
+        entry.TextOffset = text_dst_n;
+        text_dst_n += entry.TextLen;
+        Entries.Data[dst_n++] = entry;
+    }
+    if (dst_n == Entries.Size)
+        return;
+    Entries.resize(dst_n);
+    Lines.resize(lines_dst_n * 2);
+    Text.resize(text_dst_n);
+    if (dst_n == 0)
+    {
+        Clear();
+        return;
+    }
+    int buckets_count = 256;
+    while (buckets_count < dst_n * 2)
+        buckets_count *= 2;
+    RebuildBuckets(buckets_count);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 //-----------------------------------------------------------------------------
@@ -3049,6 +3549,29 @@ static void ImGuiListClipper_SeekCursorAndSetupPrevLine(float pos_y, float line_
     }
 }
 
+static void ImGuiListClipper_MeasureItem(ImGuiListClipper* clipper, ImGuiListClipperData* data)
+{
+    // Height of the item displayed by previous step
+    ImGuiContext& g = *clipper->Ctx;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiListClipperHeights* heights = clipper->Heights;
+    const float old_height = heights->GetItemHeight(data->MeasureItem);
+    const float new_height = window->DC.CursorPos.y - data->MeasurePosY;
+    heights->SetItemHeight(data->MeasureItem, new_height);
+
+    // Item starting above the visible area changed height: scroll by the same amount right away, and shift this frame's layout origin
+    // accordingly, so items after it (which are not submitted yet) and next frames stay where they were on screen.
+    const float delta = new_height - old_height;
+    if (data->MeasurePosY < window->ClipRect.Min.y && old_height > 0.0f && delta != 0.0f)
+    {
+        window->Scroll.y += delta;
+        window->DC.CursorStartPos.y -= delta;
+        window->DC.CursorPos.y -= delta;
+        clipper->StartPosY -= delta;
+    }
+    data->MeasureItem = -1;
+}
+
 ImGuiListClipper::ImGuiListClipper()
 {
     memset(this, 0, sizeof(*this));
@@ -3077,6 +3600,7 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     ItemsCount = items_count;
     DisplayStart = -1;
     DisplayEnd = 0;
+    Heights = NULL;
 
     // Acquire temporary buffer
     if (++g.ClipperTempDataStacked > g.ClipperTempData.Size)
@@ -3088,6 +3612,15 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     StartSeekOffsetY = data->LossynessOffset;
 }
 
+void ImGuiListClipper::BeginVariableHeight(int items_count, ImGuiListClipperHeights* heights)
+{
+    IM_ASSERT(heights != NULL);
+    IM_ASSERT(items_count >= 0 && items_count < INT_MAX && "Items count needs to be known with variable item heights.");
+    heights->Resize(items_count);
+    Begin(items_count, heights->DefaultHeight > 0.0f ? heights->DefaultHeight : -1.0f);
+    Heights = heights;
+}
+
 void ImGuiListClipper::End()
 {
     if (ImGuiListClipperData* data = (ImGuiListClipperData*)TempData)
@@ -3127,7 +3660,9 @@ void ImGuiListClipper::SeekCursorForItem(int item_n)
     // - Perform the add and multiply with double to allow seeking through larger ranges.
     // - StartPosY starts from ItemsFrozen, by adding SeekOffsetY we generally cancel that out (SeekOffsetY == LossynessOffset - ItemsFrozen * ItemsHeight).
     // - The reason we store SeekOffsetY instead of inferring it, is because we want to allow user to perform Seek after the last step, where ImGuiListClipperData is already done.
-    float pos_y = (float)((double)StartPosY + StartSeekOffsetY + (double)item_n * ItemsHeight);
+    // - With variable heights, the item offset comes from the height index instead.
+    const double item_offset_y = Heights ? Heights->GetItemPos(item_n) : (double)item_n * ItemsHeight;
+    float pos_y = (float)((double)StartPosY + StartSeekOffsetY + item_offset_y);
     ImGuiListClipper_SeekCursorAndSetupPrevLine(pos_y, ItemsHeight);
 }
 
@@ -3142,6 +3677,10 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     if (table && table->IsInsideRow)
         ImGui::TableEndRow(table);
 
+    // Variable heights: measure item displayed by previous step
+    if (clipper->Heights != NULL && data->MeasureItem >= 0)
+        ImGuiListClipper_MeasureItem(clipper, data);
+
     // No items
     if (clipper->ItemsCount == 0 || GetSkipItemForListClipping())
         return false;
@@ -3196,7 +3735,8 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     if (calc_clipping)
     {
         // Record seek offset, this is so ImGuiListClipper::Seek() can be called after ImGuiListClipperData is done
-        clipper->StartSeekOffsetY = (double)data->LossynessOffset - data->ItemsFrozen * (double)clipper->ItemsHeight;
+        const double frozen_height = clipper->Heights ? clipper->Heights->GetItemPos(data->ItemsFrozen) : data->ItemsFrozen * (double)clipper->ItemsHeight;
+        clipper->StartSeekOffsetY = (double)data->LossynessOffset - frozen_height;
 
         if (g.LogEnabled)
         {
@@ -3245,11 +3785,22 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
         // - Very important: when a starting position is after our maximum item, we set Min to (ItemsCount - 1). This allows us to handle most forms of wrapping.
         // - Due to how Selectable extra padding they tend to be "unaligned" with exact unit in the item list,
         //   which with the flooring/ceiling tend to lead to 2 items instead of one being submitted.
+        // - With variable heights, positions are converted by looking up the height index (O(log N)).
         for (ImGuiListClipperRange& range : data->Ranges)
             if (range.PosToIndexConvert)
             {
-                int m1 = (int)(((double)range.Min - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight);
-                int m2 = (int)((((double)range.Max - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight) + 0.999999f);
+                int m1, m2;
+                if (ImGuiListClipperHeights* heights = clipper->Heights)
+                {
+                    const double base_y = heights->GetItemPos(already_submitted) - window->DC.CursorPos.y - data->LossynessOffset;
+                    m1 = heights->FindItemAtPos(base_y + range.Min) - already_submitted;
+                    m2 = heights->FindItemAtPos(base_y + range.Max) + 1 - already_submitted;
+                }
+                else
+                {
+                    m1 = (int)(((double)range.Min - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight);
+                    m2 = (int)((((double)range.Max - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight) + 0.999999f);
+                }
                 range.Min = ImClamp(already_submitted + m1 + range.PosToIndexOffsetMin, already_submitted, clipper->ItemsCount - 1);
                 range.Max = ImClamp(already_submitted + m2 + range.PosToIndexOffsetMax, range.Min + 1, clipper->ItemsCount);
                 range.PosToIndexConvert = false;
@@ -3258,10 +3809,18 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     }
 
     // Step 0+ (if item height is given in advance) or 1+: Display the next range in line.
+    // - With variable heights, ranges are displayed one item per step, so every displayed item gets measured.
     while (data->StepNo < data->Ranges.Size)
     {
         clipper->DisplayStart = ImMax(data->Ranges[data->StepNo].Min, already_submitted);
         clipper->DisplayEnd = ImMin(data->Ranges[data->StepNo].Max, clipper->ItemsCount);
+        if (clipper->Heights != NULL && clipper->DisplayEnd - clipper->DisplayStart > 1)
+        {
+            // Rest of the range becomes the next step (StepNo must move on: step 0 would otherwise run again)
+            const ImGuiListClipperRange rest = ImGuiListClipperRange::FromIndices(clipper->DisplayStart + 1, clipper->DisplayEnd);
+            data->Ranges.insert(data->Ranges.Data + data->StepNo + 1, rest);
+            clipper->DisplayEnd = clipper->DisplayStart + 1;
+        }
         data->StepNo++;
         if (clipper->DisplayStart >= clipper->DisplayEnd)
             continue;
@@ -3292,6 +3851,14 @@ bool ImGuiListClipper::Step()
     if (ret)
     {
         IMGUI_DEBUG_LOG_CLIPPER("Clipper: Step(): display %d to %d.\n", DisplayStart, DisplayEnd);
+        if (Heights != NULL)
+        {
+            // Item gets measured on next step
+            ImGuiListClipperData* data = (ImGuiListClipperData*)TempData;
+            IM_ASSERT(DisplayEnd - DisplayStart == 1);
+            data->MeasureItem = DisplayStart;
+            data->MeasurePosY = g.CurrentWindow->DC.CursorPos.y;
+        }
     }
     else
     {
@@ -3301,6 +3868,109 @@ bool ImGuiListClipper::Step()
     return ret;
 }
 
+// Sum of (Heights[n] - DefaultHeight) over measured items n < item_n
+static double ImGuiListClipperHeights_SumDeltas(const ImGuiListClipperHeights* heights, int item_n)
+{
+    double sum = 0.0;
+    for (int i = item_n; i > 0; i -= i & -i)
+        sum += heights->Tree.Data[i - 1];
+    return sum;
+}
+
+static void ImGuiListClipperHeights_BuildTree(ImGuiListClipperHeights* heights)
+{
+    const int count = heights->Heights.Size;
+    for (int i = 1; i <= count; i++)
+    {
+        const float h = heights->Heights.Data[i - 1];
+        heights->Tree.Data[i - 1] = (h >= 0.0f) ? (double)h - heights->DefaultHeight : 0.0;
+    }
+    for (int i = 1; i <= count; i++)
+        if (i + (i & -i) <= count)
+            heights->Tree.Data[i + (i & -i) - 1] += heights->Tree.Data[i - 1];
+}
+
+void ImGuiListClipperHeights::Clear()
+{
+    const int count = Heights.Size;
+    Heights.resize(0);
+    Tree.resize(0);
+    Resize(count);
+}
+
+void ImGuiListClipperHeights::Resize(int items_count)
+{
+    IM_ASSERT(items_count >= 0);
+    const int old_count = Heights.Size;
+    if (items_count <= old_count)
+    {
+        // Fenwick tree nodes only cover items before them: truncating keeps it valid
+        Heights.resize(items_count);
+        Tree.resize(items_count);
+        return;
+    }
+    Heights.resize(items_count, -1.0f);
+    Tree.resize(items_count, 0.0);
+
+    // New nodes covering some old items need their sum. Added items are not measured so they don't contribute.
+    const double old_sum = ImGuiListClipperHeights_SumDeltas(this, old_count);
+    for (int i = old_count + 1; i <= items_count; i++)
+        if (i - (i & -i) < old_count)
+            Tree.Data[i - 1] = old_sum - ImGuiListClipperHeights_SumDeltas(this, i - (i & -i));
+}
+
+void ImGuiListClipperHeights::SetItemHeight(int item_n, float height)
+{
+    IM_ASSERT(item_n >= 0 && item_n < Heights.Size && height >= 0.0f);
+    const float old_height = GetItemHeight(item_n);
+    Heights.Data[item_n] = height;
+    if (DefaultHeight <= 0.0f && height > 0.0f)
+    {
+        // First measurement defines height of unmeasured items (only rebuilds if zero-height items were measured before)
+        DefaultHeight = height;
+        ImGuiListClipperHeights_BuildTree(this);
+        return;
+    }
+    const double delta = (double)height - old_height;
+    if (delta != 0.0)
+        for (int i = item_n + 1; i <= Heights.Size; i += i & -i)
+            Tree.Data[i - 1] += delta;
+}
+
+float ImGuiListClipperHeights::GetItemHeight(int item_n) const
+{
+    IM_ASSERT(item_n >= 0 && item_n < Heights.Size);
+    return Heights.Data[item_n] >= 0.0f ? Heights.Data[item_n] : DefaultHeight;
+}
+
+double ImGuiListClipperHeights::GetItemPos(int item_n) const
+{
+    IM_ASSERT(item_n >= 0 && item_n <= Heights.Size);
+    return item_n * (double)DefaultHeight + ImGuiListClipperHeights_SumDeltas(this, item_n);
+}
+
+int ImGuiListClipperHeights::FindItemAtPos(double pos) const
+{
+    // Descend the tree: node (item_n + step) covers the 'step' items after item_n
+    int item_n = 0;
+    int step = 1;
+    while (step <= Heights.Size / 2)
+        step <<= 1;
+    for (; step > 0; step >>= 1)
+    {
+        const int next = item_n + step;
+        if (next > Heights.Size)
+            continue;
+        const double node_height = Tree.Data[next - 1] + step * (double)DefaultHeight;
+        if (node_height <= pos)
+        {
+            item_n = next;
+            pos -= node_height;
+        }
+    }
+    return item_n;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] STYLING
 //-----------------------------------------------------------------------------
@@ -3628,7 +4298,27 @@ void ImGui::RenderTextWrapped(ImVec2 pos, const char* text, const char* text_end
 
     if (text != text_end)
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+        ImGuiTextMeasureEntry* entry = (wrap_width > 0.0f) ? TextMeasureCacheQuery(g.Font, g.FontSize, wrap_width, text, text_end) : NULL;
+        if (entry != NULL && entry->LinesCount > 0)
+        {
+            // Render from cached line breaks, jumping straight to the first visible line
+            const ImVec4& clip_rect = window->DrawList->_CmdHeader.ClipRect;
+            const ImU32 col = GetColorU32(ImGuiCol_Text);
+            const float line_height = g.FontSize;
+            const int* lines = &g.TextMeasureCache.Lines.Data[entry->LinesOffset * 2];
+            int line_n = (pos.y < clip_rect.y) ? ImMin((int)((clip_rect.y - pos.y) / line_height), entry->LinesCount) : 0;
+            for (; line_n < entry->LinesCount; line_n++)
+            {
+                const float line_y = pos.y + line_n * line_height;
+                if (line_y > clip_rect.w)
+                    break;
+                window->DrawList->AddText(g.Font, g.FontSize, ImVec2(pos.x, line_y), col, text + lines[line_n * 2], text + lines[line_n * 2 + 1]);
+            }
+        }
+        else
+        {
+            window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+        }
         if (g.LogEnabled)
             LogRenderedText(&pos, text, text_end);
     }
@@ -4076,6 +4766,7 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
 
     SettingsLoaded = false;
     SettingsDirtyTimer = 0.0f;
+    SettingsHandlerWindow = NULL;
     HookIdNext = 0;
 
     memset(LocalizationTable, 0, sizeof(LocalizationTable));
@@ -4231,6 +4922,8 @@ void ImGui::Shutdown()
     g.TablesTempData.clear_destruct();
     g.DrawChannelsTempMergeBuffer.clear();
 
+    g.TextMeasureCache.Clear();
+
     g.MultiSelectStorage.Clear();
     g.MultiSelectTempData.clear_destruct();
 
@@ -4241,6 +4934,7 @@ void ImGui::Shutdown()
 
     g.SettingsWindows.clear();
     g.SettingsHandlers.clear();
+    g.SettingsHandlerWindow = NULL;
 
     if (g.LogFile)
     {
@@ -4347,6 +5041,7 @@ void ImGui::GcCompactTransientMiscBuffers()
     g.GroupStack.clear();
     g.MultiSelectTempDataStacked = 0;
     g.MultiSelectTempData.clear_destruct();
+    g.TextMeasureCache.Clear();
     TableGcCompactSettings();
 }
 
@@ -4779,7 +5474,8 @@ void* ImGui::MemAlloc(size_t size)
     void* ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ImGuiContext* ctx = GImGui)
-        DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
+        if (!GImDebugAllocHookDisabled)
+            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
 #endif
     return ptr;
 }
@@ -4788,13 +5484,23 @@ void* ImGui::MemAlloc(size_t size)
 void ImGui::MemFree(void* ptr)
 {
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
-    if (ptr != NULL)
+    if (ptr != NULL && !GImDebugAllocHookDisabled)
         if (ImGuiContext* ctx = GImGui)
             DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
 #endif
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
 
+// Call with 'enabled = false' from threads that build draw lists for the current context without owning it (MemAlloc() is thread-safe if your allocator is).
+void ImGui::DebugAllocHookSetThreadEnabled(bool enabled)
+{
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+    GImDebugAllocHookDisabled = !enabled;
+#else
+    IM_UNUSED(enabled);
+#endif
+}
+
 // We record the number of allocation in recent frames, as a way to audit/sanitize our guiding principles of "no allocations on idle/repeating frames"
 void ImGui::DebugAllocHook(ImGuiDebugAllocInfo* info, int frame_count, void* ptr, size_t size)
 {
@@ -5206,6 +5912,8 @@ void ImGui::NewFrame()
 
     // Setup current font and draw list shared data
     g.IO.Fonts->Locked = true;
+    if (g.IO.Fonts->Dynamic)
+        ImFontAtlasDynamicNewFrame(g.IO.Fonts); // May evict glyphs, so must happen before any text is submitted
     SetupDrawListSharedData();
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
@@ -5370,6 +6078,8 @@ void ImGui::NewFrame()
     for (ImGuiTableTempData& table_temp_data : g.TablesTempData)
         if (table_temp_data.LastTimeActive >= 0.0f && table_temp_data.LastTimeActive < memory_compact_start_time)
             TableGcCompactTransientBuffers(&table_temp_data);
+    if ((g.FrameCount % IMGUI_TEXT_MEASURE_CACHE_GC_FRAMES) == 0)
+        g.TextMeasureCache.GcCompact(g.FrameCount - IMGUI_TEXT_MEASURE_CACHE_GC_FRAMES);
     if (g.GcCompactAll)
         GcCompactTransientMiscBuffers();
     g.GcCompactAll = false;
@@ -5800,7 +6510,13 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    if (text_display_end == NULL)
+        text_display_end = text + ImStrlen(text);
+    ImVec2 text_size;
+    if (ImGuiTextMeasureEntry* entry = TextMeasureCacheQuery(font, font_size, wrap_width, text, text_display_end))
+        text_size = entry->Size;
+    else
+        text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
     // FIXME: This has been here since Dec 2015 (7b0bf230) but down the line we want this out.
@@ -5812,6 +6528,47 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     return text_size;
 }
 
+// Lookup or create a text measurement cache entry. Measurement and line breaks are computed on creation.
+ImGuiTextMeasureEntry* ImGui::TextMeasureCacheQuery(ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    ImGuiContext& g = *GImGui;
+    const int text_len = (int)(text_end - text);
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    ImGuiTextMeasureCache& cache = g.TextMeasureCache;
+    if (!cache.Enabled || text_len == 0 || (!word_wrap_enabled && text_len < IMGUI_TEXT_MEASURE_CACHE_MIN_LEN))
+        return NULL;
+
+    if (cache.MetricsGeneration != font->ContainerAtlas->MetricsGeneration)
+    {
+        cache.Clear();
+        cache.MetricsGeneration = font->ContainerAtlas->MetricsGeneration;
+    }
+
+    if (!word_wrap_enabled)
+        wrap_width = 0.0f;
+    struct { ImFont* Font; float FontSize; float WrapWidth; } params = { font, font_size, wrap_width };
+    const ImGuiID key = ImHashData(text, (size_t)text_len, ImHashData(&params, sizeof(params)));
+    int entry_n = cache.Find(key, font, font_size, wrap_width, text, text_len);
+    if (entry_n == -1)
+    {
+        entry_n = cache.Add(key, font, font_size, wrap_width, text, text_len);
+        ImGuiTextMeasureEntry* entry = &cache.Entries.Data[entry_n];
+        if (word_wrap_enabled)
+        {
+            entry->LinesOffset = cache.Lines.Size / 2;
+            entry->Size = font->CalcWordWrapLinesA(font_size, wrap_width, text, text_end, &cache.Lines);
+            entry->LinesCount = cache.Lines.Size / 2 - entry->LinesOffset;
+        }
+        else
+        {
+            entry->Size = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, text, text_end, NULL);
+        }
+    }
+    ImGuiTextMeasureEntry* entry = &cache.Entries.Data[entry_n];
+    entry->LastFrameUsed = g.FrameCount;
+    return entry;
+}
+
 // Find window given position, search front-to-back
 // - Typically write output back to g.HoveredWindow and g.HoveredWindowUnderMovingWindow.
 // - FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
@@ -6291,9 +7048,15 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
 
     ImGuiWindowSettings* settings = NULL;
     if (!(flags & ImGuiWindowFlags_NoSavedSettings))
+    {
         if ((settings = ImGui::FindWindowSettingsByWindow(window)) != 0)
             window->SettingsOffset = g.SettingsWindows.offset_from_ptr(settings);
 
+        // Part of the next save like any other window, but doesn't trigger one by itself
+        if (ImGuiSettingsHandler* handler = ImGui::FindSettingsHandler("Window"))
+            handler->WriteDirty = true;
+    }
+
     InitOrLoadWindowSettings(window, settings);
 
     if (flags & ImGuiWindowFlags_NoBringToFrontOnFocus)
@@ -8228,6 +8991,8 @@ void ImGui::SetWindowCollapsed(ImGuiWindow* window, bool collapsed, ImGuiCond co
     window->SetWindowCollapsedAllowFlags &= ~(ImGuiCond_Once | ImGuiCond_FirstUseEver | ImGuiCond_Appearing);
 
     // Set
+    if (window->Collapsed != collapsed)
+        MarkIniSettingsDirty(window);
     window->Collapsed = collapsed;
 }
 
@@ -14622,19 +15387,34 @@ void ImGui::UpdateSettings()
     }
 }
 
+// Unknown data changed: every handler will be re-serialized
 void ImGui::MarkIniSettingsDirty()
 {
     ImGuiContext& g = *GImGui;
     if (g.SettingsDirtyTimer <= 0.0f)
         g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+        handler.WriteDirty = true;
 }
 
 void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
 {
+    // Called on every frame of a window move/resize: look the handler up once
     ImGuiContext& g = *GImGui;
-    if (!(window->Flags & ImGuiWindowFlags_NoSavedSettings))
-        if (g.SettingsDirtyTimer <= 0.0f)
-            g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    if (window->Flags & ImGuiWindowFlags_NoSavedSettings)
+        return;
+    if (g.SettingsHandlerWindow == NULL)
+        g.SettingsHandlerWindow = FindSettingsHandler("Window");
+    MarkIniSettingsDirty(g.SettingsHandlerWindow);
+}
+
+void ImGui::MarkIniSettingsDirty(ImGuiSettingsHandler* handler)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.SettingsDirtyTimer <= 0.0f)
+        g.SettingsDirtyTimer = g.IO.IniSavingRate;
+    if (handler != NULL)
+        handler->WriteDirty = true;
 }
 
 void ImGui::AddSettingsHandler(const ImGuiSettingsHandler* handler)
@@ -14642,13 +15422,18 @@ void ImGui::AddSettingsHandler(const ImGuiSettingsHandler* handler)
     ImGuiContext& g = *GImGui;
     IM_ASSERT(FindSettingsHandler(handler->TypeName) == NULL);
     g.SettingsHandlers.push_back(*handler);
+    g.SettingsHandlers.back().WriteDirty = true;
+    g.SettingsHandlerWindow = NULL;     // push_back() may have moved the handlers
 }
 
 void ImGui::RemoveSettingsHandler(const char* type_name)
 {
     ImGuiContext& g = *GImGui;
     if (ImGuiSettingsHandler* handler = FindSettingsHandler(type_name))
+    {
         g.SettingsHandlers.erase(handler);
+        g.SettingsHandlerWindow = NULL;
+    }
 }
 
 ImGuiSettingsHandler* ImGui::FindSettingsHandler(const char* type_name)
@@ -14667,8 +15452,11 @@ void ImGui::ClearIniSettings()
     ImGuiContext& g = *GImGui;
     g.SettingsIniData.clear();
     for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+    {
         if (handler.ClearAllFn != NULL)
             handler.ClearAllFn(&g, &handler);
+        handler.WriteDirty = true;
+    }
 }
 
 void ImGui::LoadIniSettingsFromDisk(const char* ini_filename)
@@ -14703,9 +15491,13 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
 
     // Call pre-read handlers
     // Some types will clear their data (e.g. dock information) some types will allow merge/override (window)
+    // SettingsIniData doesn't hold the output of the last save anymore, so every handler will be re-serialized.
     for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+    {
         if (handler.ReadInitFn != NULL)
             handler.ReadInitFn(&g, &handler);
+        handler.WriteDirty = true;
+    }
 
     void* entry_data = NULL;
     ImGuiSettingsHandler* entry_handler = NULL;
@@ -14771,14 +15563,27 @@ void ImGui::SaveIniSettingsToDisk(const char* ini_filename)
 }
 
 // Call registered handlers (e.g. SettingsHandlerWindow_WriteAll() + custom handlers) to write their stuff into a text buffer
+// With io.ConfigIniSaveIncremental, handlers not marked dirty since last save have their section copied from the previous output instead.
 const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
 {
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
+    const bool incremental = g.IO.ConfigIniSaveIncremental;
+    if (incremental)
+        g.SettingsIniData.Buf.swap(g.SettingsIniDataPrev.Buf);
     g.SettingsIniData.Buf.resize(0);
     g.SettingsIniData.Buf.push_back(0);
     for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
-        handler.WriteAllFn(&g, &handler, &g.SettingsIniData);
+    {
+        const int write_offset = g.SettingsIniData.size();
+        if (incremental && !handler.WriteDirty)
+            g.SettingsIniData.append(g.SettingsIniDataPrev.begin() + handler.WriteOffset, g.SettingsIniDataPrev.begin() + handler.WriteOffset + handler.WriteSize);
+        else
+            handler.WriteAllFn(&g, &handler, &g.SettingsIniData);
+        handler.WriteDirty = false;
+        handler.WriteOffset = write_offset;
+        handler.WriteSize = g.SettingsIniData.size() - write_offset;
+    }
     if (out_size)
         *out_size = (size_t)g.SettingsIniData.size();
     return g.SettingsIniData.c_str();
@@ -14839,6 +15644,8 @@ void ImGui::ClearWindowSettings(const char* name)
     }
     if (ImGuiWindowSettings* settings = window ? FindWindowSettingsByWindow(window) : FindWindowSettingsByID(ImHashStr(name)))
         settings->WantDelete = true;
+    if (ImGuiSettingsHandler* handler = FindSettingsHandler("Window"))
+        handler->WriteDirty = true;
 }
 
 static void WindowSettingsHandler_ClearAll(ImGuiContext* ctx, ImGuiSettingsHandler*)
@@ -15470,6 +16277,9 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
         DebugNodeFont(font);
         PopID();
     }
+    ImFontAtlasDynamicStats dyn_stats;
+    if (ImFontAtlasDynamicGetStats(atlas, NULL, &dyn_stats))
+        BulletText("Dynamic glyphs: %d loaded, %d pending, %d evictions (%d glyphs evicted)", dyn_stats.GlyphsCount, dyn_stats.GlyphsPendingCount, dyn_stats.EvictionsCount, dyn_stats.EvictedGlyphsCount);
     if (TreeNode("Font Atlas", "Font Atlas (%dx%d pixels)", atlas->TexWidth, atlas->TexHeight))
     {
         ImGuiContext& g = *GImGui;
@@ -16297,6 +17107,10 @@ void ImGui::DebugNodeFont(ImFont* font)
     Text("Ellipsis character: '%s' (U+%04X)", ImTextCharToUtf8(c_str, font->EllipsisChar), font->EllipsisChar);
     const int surface_sqrt = (int)ImSqrt((float)font->MetricsTotalSurface);
     Text("Texture Area: about %d px ~%dx%d px", font->MetricsTotalSurface, surface_sqrt, surface_sqrt);
+    ImFontAtlasDynamicStats dyn_stats;
+    if (font->ContainerAtlas && ImFontAtlasDynamicGetStats(font->ContainerAtlas, font, &dyn_stats))
+        Text("Dynamic glyphs: %d loaded (%d texels, %d bytes), %d pending, rasterized in %.3f ms (max %.3f ms)",
+            dyn_stats.GlyphsCount, dyn_stats.TexelsCount, dyn_stats.TexelsCount, dyn_stats.GlyphsPendingCount, dyn_stats.RasterizeMsTotal, dyn_stats.RasterizeMsMax);
     for (int config_i = 0; config_i < font->SourcesCount; config_i++)
         if (font->Sources)
         {
@@ -16364,7 +17178,7 @@ void ImGui::DebugNodeFont(ImFont* font)
     Unindent();
 }
 
-void ImGui::DebugNodeFontGlyph(ImFont*, const ImFontGlyph* glyph)
+void ImGui::DebugNodeFontGlyph(ImFont* font, const ImFontGlyph* glyph)
 {
     Text("Codepoint: U+%04X", glyph->Codepoint);
     Separator();
@@ -16372,6 +17186,8 @@ void ImGui::DebugNodeFontGlyph(ImFont*, const ImFontGlyph* glyph)
     Text("AdvanceX: %.1f", glyph->AdvanceX);
     Text("Pos: (%.2f,%.2f)->(%.2f,%.2f)", glyph->X0, glyph->Y0, glyph->X1, glyph->Y1);
     Text("UV: (%.3f,%.3f)->(%.3f,%.3f)", glyph->U0, glyph->V0, glyph->U1, glyph->V1);
+    if (const ImFontAtlasDynamicGlyph* dyn_glyph = font->ContainerAtlas ? ImFontAtlasDynamicFindGlyph(font->ContainerAtlas, font, (ImWchar)glyph->Codepoint) : NULL)
+        Text("Dynamic: %dx%d texels (%d bytes), rasterized in %.3f ms", dyn_glyph->W, dyn_glyph->H, dyn_glyph->W * dyn_glyph->H, dyn_glyph->RasterizeMs);
 }
 
 // [DEBUG] Display contents of ImGuiStorage
@@ -170,6 +170,7 @@ struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 byte
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
+struct ImFontAtlasDynamic;          // Opaque state of glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs)
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
@@ -181,6 +182,7 @@ struct ImGuiIO;                     // Main configuration and I/O between your a
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiKeyData;                // Storage for ImGuiIO and IsKeyDown(), IsKeyPressed() etc functions.
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListClipperHeights;     // Helper to store measured heights of items for ImGuiListClipper, when items don't all have the same height
 struct ImGuiMultiSelectIO;          // Structure to interact with a BeginMultiSelect()/EndMultiSelect() block
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame
 struct ImGuiPayload;                // User data payload for drag and drop operations
@@ -1178,6 +1180,9 @@ enum ImGuiInputTextFlags_
     // Elide display / Alignment
     ImGuiInputTextFlags_ElideLeft           = 1 << 17,  // When text doesn't fit, elide left side to ensure right side stays visible. Useful for path/filenames. Single-line only!
 
+    // Large text
+    ImGuiInputTextFlags_LineIndex           = 1 << 24,  // Multi-line only, ignored with ReadOnly: while active, keep line offsets and widths updated on each edit, so cursor moves, clicks and rendering only touch the lines involved instead of the whole text. For multi-megabyte buffers. The user buffer is only written back on frames where the text was edited.
+
     // Callback features
     ImGuiInputTextFlags_CallbackCompletion  = 1 << 18,  // Callback on pressing TAB (for completion handling)
     ImGuiInputTextFlags_CallbackHistory     = 1 << 19,  // Callback on pressing Up/Down arrows (for history handling)
@@ -2281,6 +2286,7 @@ struct ImGuiIO
     bool        ConfigWindowsCopyContentsWithCtrlC; // = false      // [EXPERIMENTAL] CTRL+C copy the contents of focused window into the clipboard. Experimental because: (1) has known issues with nested Begin/End pairs (2) text output quality varies (3) text output is in submission order rather than spatial order.
     bool        ConfigScrollbarScrollByPage;    // = true           // Enable scrolling page by page when clicking outside the scrollbar grab. When disabled, always scroll to clicked location. When enabled, Shift+Click scrolls to clicked location.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigIniSaveIncremental;       // = false          // Saving .ini data only re-serializes the settings types (handlers) modified since last save, other sections are copied from the previous output. Custom handlers are re-serialized on any MarkIniSettingsDirty() call.
 
     // Inputs Behaviors
     // (other variables, ones which are expected to be tweaked within UI code, are exposed in ImGuiStyle)
@@ -2585,6 +2591,7 @@ struct ImGuiTextFilter
         IMGUI_API void  split(char separator, ImVector<ImGuiTextRange>* out) const;
     };
     char                    InputBuf[256];
+    char                    InputBufLower[256]; // Lowercase copy of InputBuf, made by Build(). Filters[] point into InputBuf, search uses the same ranges in this copy.
     ImVector<ImGuiTextRange>Filters;
     int                     CountGrep;
 };
@@ -2625,6 +2632,7 @@ struct ImGuiStoragePair
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
 // This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// With IMGUI_USE_HASHED_STORAGE, pairs are kept in insertion order with a hash index on top: O(1) lookup and insertion, for storages holding many thousands of IDs.
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -2633,11 +2641,19 @@ struct ImGuiStorage
 {
     // [Internal]
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_USE_HASHED_STORAGE
+    mutable ImVector<int>           Index;              // Open addressing table (linear probing) of Data[] indices + 1, 0 = empty slot. Data[] is not sorted.
+    mutable int                     IndexedCount = 0;   // Number of Data[] pairs in Index[]. Pairs appended directly to Data[] are indexed on next access.
+#endif
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N) (O(1) with IMGUI_USE_HASHED_STORAGE)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+#ifdef IMGUI_USE_HASHED_STORAGE
+    void                Clear() { Data.clear(); Index.clear(); IndexedCount = 0; }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2658,6 +2674,10 @@ struct ImGuiStorage
 
     // Advanced: for quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
     IMGUI_API void      BuildSortByKey();
+#ifdef IMGUI_USE_HASHED_STORAGE
+    // Advanced: call after reordering Data[] yourself (appending to or shrinking Data[] is detected automatically).
+    IMGUI_API void      BuildIndex() const;
+#endif
     // Obsolete: use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
 
@@ -2696,12 +2716,14 @@ struct ImGuiListClipper
     float           StartPosY;          // [Internal] Cursor position at the time of Begin() or after table frozen rows are all processed
     double          StartSeekOffsetY;   // [Internal] Account for frozen rows in a table and initial loss of precision in very large windows.
     void*           TempData;           // [Internal] Internal data
+    ImGuiListClipperHeights* Heights;   // [Internal] Per-item heights when using BeginVariableHeight(), otherwise NULL
 
     // items_count: Use INT_MAX if you don't know how many items you have (in which case the cursor won't be advanced in the final step, and you can call SeekCursorForItem() manually if you need)
     // items_height: Use -1.0f to be calculated automatically on first step. Otherwise pass in the distance between your items, typically GetTextLineHeightWithSpacing() or GetFrameHeightWithSpacing().
     IMGUI_API ImGuiListClipper();
     IMGUI_API ~ImGuiListClipper();
     IMGUI_API void  Begin(int items_count, float items_height = -1.0f);
+    IMGUI_API void  BeginVariableHeight(int items_count, ImGuiListClipperHeights* heights); // Items of different heights: 'heights' must persist across frames. Step() then displays one item at a time, measuring each.
     IMGUI_API void  End();             // Automatically called on the last call of Step() that returns false.
     IMGUI_API bool  Step();            // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
 
@@ -2722,6 +2744,27 @@ struct ImGuiListClipper
 #endif
 };
 
+// Helper: Measured heights of items, for ImGuiListClipper::BeginVariableHeight()
+// - Items are measured as the clipper displays them. Items not measured yet are assumed to be DefaultHeight tall (the first measured item if left to 0.0f).
+// - DefaultHeight is never changed afterwards, so positions of unmeasured items don't move and the scrollbar stays stable while heights get refined.
+// - Stored as a Fenwick tree of (height - DefaultHeight), so converting between an item index and its position is O(log N), as is measuring an item.
+// - Items count follows the clipper. Call Clear() if items are reordered/removed or if their layout changes (e.g. wrap width), so they get measured again.
+struct ImGuiListClipperHeights
+{
+    float               DefaultHeight;  // Height of items not measured yet
+    ImVector<float>     Heights;        // [Internal] Measured height of each item, < 0.0f when not measured yet
+    ImVector<double>    Tree;           // [Internal] Fenwick tree (1-based: node i stored at Tree[i - 1]) over (Heights[n] - DefaultHeight) of measured items
+
+    ImGuiListClipperHeights(float default_height = 0.0f) { DefaultHeight = default_height; }
+    IMGUI_API void      Clear();                                    // Forget all measurements (keeps DefaultHeight)
+    IMGUI_API void      Resize(int items_count);                    // Added items are not measured yet. Called by BeginVariableHeight().
+    IMGUI_API void      SetItemHeight(int item_n, float height);    // Record measured height of an item. Called by ImGuiListClipper::Step().
+    IMGUI_API float     GetItemHeight(int item_n) const;            // Measured height, or DefaultHeight
+    IMGUI_API double    GetItemPos(int item_n) const;               // Offset of the top of item 'item_n' from the top of item 0. item_n == Heights.Size gives total height.
+    IMGUI_API int       FindItemAtPos(double pos) const;            // Item containing offset 'pos': 0 if pos < 0, Heights.Size if pos >= total height.
+    double              GetTotalHeight() const                      { return GetItemPos(Heights.Size); }
+};
+
 // Helpers: ImVec2/ImVec4 operators
 // - It is important that we are keeping those disabled by default so they don't leak in user space.
 // - This is in order to allow user enabling implicit cast operators between ImVec2/ImVec4 and their own types (using IM_VEC2_CLASS_EXTRA in imconfig.h)
@@ -3151,9 +3194,16 @@ struct ImDrawList
     IMGUI_API void  AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0); // Cubic Bezier (4 control points)
     IMGUI_API void  AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, ImU32 col, float thickness, int num_segments = 0);               // Quadratic Bezier (3 control points)
 
+    // Batched primitives
+    // - Same output as calling AddRectFilled()/AddQuadFilled()/AddCircleFilled() for each element, but shape setup and PrimReserve() are done once for many elements.
+    // - One color per element. Fully transparent elements are skipped, like the single calls do.
+    IMGUI_API void  AddRectFilledBatch(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count);                       // No rounding
+    IMGUI_API void  AddQuadFilledBatch(const ImVec2* points, const ImU32* cols, int count);                                           // 4 points per quad
+    IMGUI_API void  AddCircleFilledBatch(const ImVec2* centers, float radius, const ImU32* cols, int count, int num_segments = 0);    // Same radius for all circles
+
     // General polygon
     // - Only simple polygons are supported by filling functions (no self-intersections, no holes).
-    // - Concave polygon fill is more expensive than convex one: it has O(N^2) complexity. Provided as a convenience for the user but not used by the main library.
+    // - Concave polygon fill is more expensive than convex one: it has O(N^2) complexity below IM_DRAWLIST_CONCAVE_MONOTONE_MIN_POINTS points, O(N log N) above. Provided as a convenience for the user but not used by the main library.
     IMGUI_API void  AddPolyline(const ImVec2* points, int num_points, ImU32 col, ImDrawFlags flags, float thickness);
     IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col);
     IMGUI_API void  AddConcavePolyFilled(const ImVec2* points, int num_points, ImU32 col);
@@ -3348,6 +3398,7 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3,   // Only rasterize Latin-1 glyphs in Build(). Other glyphs of the requested ranges are rasterized on first use, and least recently used ones are evicted when the texture is full. Requires the stb_truetype builder, keeping font data alive, and a backend uploading GetTexDirtyRect(). Disables CacheFilename.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3392,6 +3443,8 @@ struct ImFontAtlas
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't build texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
+    IMGUI_API bool              GetTexDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h) const; // ImFontAtlasFlags_DynamicGlyphs: area of the texture modified since last ClearTexDirtyRect(). Backend should re-upload it before rendering.
+    IMGUI_API void              ClearTexDirtyRect();
 
     //-------------------------------------------
     // Glyph Ranges
@@ -3439,12 +3492,16 @@ struct ImFontAtlas
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // FIXME: Should be called "TexPackPadding". Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    const char*                 CacheFilename;      // = NULL   // Path to an on-disk cache of the built texture and glyphs, or NULL to disable. Build() memory-maps it when it matches all current inputs, otherwise builds then rewrites it.
+    int                         FontBuilderThreadCount; // Max number of threads rasterizing glyphs in Build(). 0 = one per hardware thread, 1 = single-threaded. Requires IMGUI_ENABLE_FONT_BUILD_THREADS (stb_truetype builder only).
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     bool                        TexReady;           // Set when texture was built matching current font input
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
+    bool                        TexLoadedFromCache; // Set by Build() when texture and glyphs were loaded from CacheFilename instead of being rasterized.
+    int                         MetricsGeneration;  // Incremented whenever glyph metrics may have changed (Build(), ClearFonts()). Used to invalidate cached text measurements.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
     int                         TexWidth;           // Texture width calculated during Build().
@@ -3464,6 +3521,9 @@ struct ImFontAtlas
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
 
+    // [Internal] Dynamic glyphs
+    ImFontAtlasDynamic*         Dynamic;            // Created by Build() when using ImFontAtlasFlags_DynamicGlyphs
+
     // [Obsolete]
     //typedef ImFontAtlasCustomRect    CustomRect;              // OBSOLETED in 1.72+
     //typedef ImFontGlyphRangesBuilder GlyphRangesBuilder;      // OBSOLETED in 1.67+
@@ -3482,6 +3542,7 @@ struct ImFont
     ImVector<ImU16>             IndexLookup;        // 12-16 // out // Sparse. Index glyphs by Unicode code-point.
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out // All glyphs.
     ImFontGlyph*                FallbackGlyph;      // 4-8   // out // = FindGlyph(FontFallbackChar)
+    ImVector<int>               GlyphsLastFrameUsed;// 12-16 // out // ImFontAtlasFlags_DynamicGlyphs only: parallel to Glyphs[], atlas frame of last FindGlyph() hit. Used to evict least recently used glyphs.
 
     // [Internal] Members: Cold ~32/40 bytes
     // Conceptually Sources[] is the list of font sources merged to create this font.
@@ -3513,6 +3574,7 @@ struct ImFont
     // 'wrap_width' enable automatic word-wrapping across multiple lines to fit into given width. 0.0f to disable.
     IMGUI_API ImVec2            CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL); // utf8
     IMGUI_API const char*       CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width);
+    IMGUI_API ImVec2            CalcWordWrapLinesA(float size, float wrap_width, const char* text_begin, const char* text_end, ImVector<int>* out_lines); // Output [begin,end) byte offsets of each wrapped line
     IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c);
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false);
 
@@ -39,6 +39,11 @@ Index of this file:
 #endif
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+#include <chrono>       // std::chrono::steady_clock
+#ifdef IMGUI_ENABLE_FONT_BUILD_THREADS
+#include <atomic>       // std::atomic<int>
+#include <thread>       // std::thread
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -92,6 +97,19 @@ Index of this file:
 //#define IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
 //#define IMGUI_DISABLE_STB_RECT_PACK_IMPLEMENTATION
 
+#if defined(IMGUI_ENABLE_STB_TRUETYPE) && defined(IMGUI_ENABLE_FONT_BUILD_THREADS)
+// Worker threads of ImFontAtlasBuildWithStbTruetype() point stbtt_fontinfo::userdata to one of those, so their
+// allocations go straight to the user allocator instead of IM_ALLOC(), whose debug hook writes to the context.
+struct ImFontBuildThreadAllocator
+{
+    ImGuiMemAllocFunc   AllocFunc;
+    ImGuiMemFreeFunc    FreeFunc;
+    void*               UserData;
+};
+static void*    ImFontBuildThreadMalloc(size_t size, void* u)   { ImFontBuildThreadAllocator* a = (ImFontBuildThreadAllocator*)u; return a->AllocFunc(size, a->UserData); }
+static void     ImFontBuildThreadFree(void* ptr, void* u)       { ImFontBuildThreadAllocator* a = (ImFontBuildThreadAllocator*)u; a->FreeFunc(ptr, a->UserData); }
+#endif
+
 #ifdef IMGUI_STB_NAMESPACE
 namespace IMGUI_STB_NAMESPACE
 {
@@ -135,8 +153,13 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
+#ifdef IMGUI_ENABLE_FONT_BUILD_THREADS
+#define STBTT_malloc(x,u)   ((u) ? ImFontBuildThreadMalloc(x,u) : IM_ALLOC(x))
+#define STBTT_free(x,u)     ((u) ? ImFontBuildThreadFree(x,u) : IM_FREE(x))
+#else
 #define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
 #define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+#endif
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -1642,6 +1665,226 @@ void ImDrawList::AddEllipseFilled(const ImVec2& center, const ImVec2& radius, Im
     PathFillConvex(col);
 }
 
+// Indices written by AddConvexPolyFilled() for a polygon starting at vertex 0: fill fan, then AA fringe when 'anti_aliased'.
+static int ImDrawListBuildConvexFillIndices(ImDrawIdx* out_idx, int points_count, bool anti_aliased)
+{
+    ImDrawIdx* p = out_idx;
+    const int shift = anti_aliased ? 1 : 0;
+    for (int i = 2; i < points_count; i++)
+    {
+        p[0] = 0; p[1] = (ImDrawIdx)((i - 1) << shift); p[2] = (ImDrawIdx)(i << shift);
+        p += 3;
+    }
+    if (anti_aliased)
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            p[0] = (ImDrawIdx)(i1 << 1); p[1] = (ImDrawIdx)(i0 << 1); p[2] = (ImDrawIdx)((i0 << 1) + 1);
+            p[3] = (ImDrawIdx)((i0 << 1) + 1); p[4] = (ImDrawIdx)((i1 << 1) + 1); p[5] = (ImDrawIdx)(i1 << 1);
+            p += 6;
+        }
+    return (int)(p - out_idx);
+}
+
+// Batched primitives: shape setup and PrimReserve() happen once per chunk of up to IM_DRAWLIST_BATCH_CHUNK_VTX_COUNT vertices
+// (so 16-bit indices can still switch to a new VtxOffset), then each element is a plain copy + translate.
+void ImDrawList::AddRectFilledBatch(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count)
+{
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const int chunk_size = IM_DRAWLIST_BATCH_CHUNK_VTX_COUNT / 4;
+    for (int chunk_start = 0; chunk_start < count; chunk_start += chunk_size)
+    {
+        const int chunk_end = ImMin(chunk_start + chunk_size, count);
+        PrimReserve((chunk_end - chunk_start) * 6, (chunk_end - chunk_start) * 4);
+        ImDrawVert* vtx = _VtxWritePtr;
+        ImDrawIdx* idx = _IdxWritePtr;
+        unsigned int vtx_idx = _VtxCurrentIdx;
+        for (int n = chunk_start; n < chunk_end; n++)
+        {
+            const ImU32 col = cols[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+                continue;
+            const ImVec2 a = p_min[n];
+            const ImVec2 c = p_max[n];
+            idx[0] = (ImDrawIdx)vtx_idx; idx[1] = (ImDrawIdx)(vtx_idx + 1); idx[2] = (ImDrawIdx)(vtx_idx + 2);
+            idx[3] = (ImDrawIdx)vtx_idx; idx[4] = (ImDrawIdx)(vtx_idx + 2); idx[5] = (ImDrawIdx)(vtx_idx + 3);
+            vtx[0].pos.x = a.x; vtx[0].pos.y = a.y; vtx[0].uv = uv; vtx[0].col = col;
+            vtx[1].pos.x = c.x; vtx[1].pos.y = a.y; vtx[1].uv = uv; vtx[1].col = col;
+            vtx[2].pos.x = c.x; vtx[2].pos.y = c.y; vtx[2].uv = uv; vtx[2].col = col;
+            vtx[3].pos.x = a.x; vtx[3].pos.y = c.y; vtx[3].uv = uv; vtx[3].col = col;
+            vtx += 4;
+            idx += 6;
+            vtx_idx += 4;
+        }
+        const int skipped = (chunk_end - chunk_start) - (int)(vtx - _VtxWritePtr) / 4;
+        PrimUnreserve(skipped * 6, skipped * 4);
+        _VtxWritePtr = vtx;
+        _IdxWritePtr = idx;
+        _VtxCurrentIdx = vtx_idx;
+    }
+}
+
+void ImDrawList::AddQuadFilledBatch(const ImVec2* points, const ImU32* cols, int count)
+{
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+    const float AA_SIZE = _FringeScale;
+    const int vtx_per_quad = anti_aliased ? 8 : 4;
+    ImDrawIdx idx_template[30];
+    const int idx_per_quad = ImDrawListBuildConvexFillIndices(idx_template, 4, anti_aliased);
+    const int chunk_size = IM_DRAWLIST_BATCH_CHUNK_VTX_COUNT / vtx_per_quad;
+    for (int chunk_start = 0; chunk_start < count; chunk_start += chunk_size)
+    {
+        const int chunk_end = ImMin(chunk_start + chunk_size, count);
+        PrimReserve((chunk_end - chunk_start) * idx_per_quad, (chunk_end - chunk_start) * vtx_per_quad);
+        ImDrawVert* vtx = _VtxWritePtr;
+        ImDrawIdx* idx = _IdxWritePtr;
+        unsigned int vtx_idx = _VtxCurrentIdx;
+        for (int n = chunk_start; n < chunk_end; n++)
+        {
+            const ImU32 col = cols[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+                continue;
+            const ImVec2* p = points + n * 4;
+            if (anti_aliased)
+            {
+                // Same math as AddConvexPolyFilled()
+                const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+                float normals[4][2];
+                for (int i0 = 3, i1 = 0; i1 < 4; i0 = i1++)
+                {
+                    float dx = p[i1].x - p[i0].x;
+                    float dy = p[i1].y - p[i0].y;
+                    IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+                    normals[i0][0] = dy;
+                    normals[i0][1] = -dx;
+                }
+                for (int i0 = 3, i1 = 0; i1 < 4; i0 = i1++)
+                {
+                    float dm_x = (normals[i0][0] + normals[i1][0]) * 0.5f;
+                    float dm_y = (normals[i0][1] + normals[i1][1]) * 0.5f;
+                    IM_FIXNORMAL2F(dm_x, dm_y);
+                    dm_x *= AA_SIZE * 0.5f;
+                    dm_y *= AA_SIZE * 0.5f;
+                    vtx[0].pos.x = (p[i1].x - dm_x); vtx[0].pos.y = (p[i1].y - dm_y); vtx[0].uv = uv; vtx[0].col = col;        // Inner
+                    vtx[1].pos.x = (p[i1].x + dm_x); vtx[1].pos.y = (p[i1].y + dm_y); vtx[1].uv = uv; vtx[1].col = col_trans;  // Outer
+                    vtx += 2;
+                }
+            }
+            else
+            {
+                for (int i = 0; i < 4; i++)
+                {
+                    vtx[i].pos = p[i]; vtx[i].uv = uv; vtx[i].col = col;
+                }
+                vtx += 4;
+            }
+            for (int i = 0; i < idx_per_quad; i++)
+                idx[i] = (ImDrawIdx)(vtx_idx + idx_template[i]);
+            idx += idx_per_quad;
+            vtx_idx += vtx_per_quad;
+        }
+        const int skipped = (chunk_end - chunk_start) - (int)(vtx - _VtxWritePtr) / vtx_per_quad;
+        PrimUnreserve(skipped * idx_per_quad, skipped * vtx_per_quad);
+        _VtxWritePtr = vtx;
+        _IdxWritePtr = idx;
+        _VtxCurrentIdx = vtx_idx;
+    }
+}
+
+void ImDrawList::AddCircleFilledBatch(const ImVec2* centers, float radius, const ImU32* cols, int count, int num_segments)
+{
+    if (count <= 0 || radius < 0.5f)
+        return;
+
+    // Build the circle once around (0,0) the same way AddCircleFilled() does, in a scratch area at the end of the current path
+    const int path_start = _Path.Size;
+    if (num_segments <= 0)
+    {
+        _PathArcToFastEx(ImVec2(0.0f, 0.0f), radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+        _Path.Size--;
+    }
+    else
+    {
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+        PathArcTo(ImVec2(0.0f, 0.0f), radius, 0.0f, a_max, num_segments - 1);
+    }
+    const int points_count = _Path.Size - path_start;
+    const ImVec2* points = _Path.Data + path_start;
+
+    // Vertex offsets from the center (inner/outer pairs with anti-aliasing) and indices relative to the first vertex
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+    const int vtx_per_circle = anti_aliased ? points_count * 2 : points_count;
+    const int idx_per_circle = (points_count - 2) * 3 + (anti_aliased ? points_count * 6 : 0);
+    _Data->TempBuffer.reserve_discard(vtx_per_circle + (int)((idx_per_circle * sizeof(ImDrawIdx) + sizeof(ImVec2) - 1) / sizeof(ImVec2)));
+    ImVec2* offsets = _Data->TempBuffer.Data;
+    ImDrawIdx* idx_template = (ImDrawIdx*)(offsets + vtx_per_circle);
+    ImDrawListBuildConvexFillIndices(idx_template, points_count, anti_aliased);
+    if (anti_aliased)
+    {
+        const float AA_SIZE = _FringeScale;
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            // Edge normals of i0 and i1, averaged (same math as AddConvexPolyFilled())
+            const int i2 = (i1 + 1 < points_count) ? i1 + 1 : 0;
+            float n0_x = points[i1].x - points[i0].x, n0_y = points[i1].y - points[i0].y;
+            float n1_x = points[i2].x - points[i1].x, n1_y = points[i2].y - points[i1].y;
+            IM_NORMALIZE2F_OVER_ZERO(n0_x, n0_y);
+            IM_NORMALIZE2F_OVER_ZERO(n1_x, n1_y);
+            float dm_x = (n0_y + n1_y) * 0.5f;
+            float dm_y = -(n0_x + n1_x) * 0.5f;
+            IM_FIXNORMAL2F(dm_x, dm_y);
+            dm_x *= AA_SIZE * 0.5f;
+            dm_y *= AA_SIZE * 0.5f;
+            offsets[i1 * 2 + 0] = ImVec2(points[i1].x - dm_x, points[i1].y - dm_y);
+            offsets[i1 * 2 + 1] = ImVec2(points[i1].x + dm_x, points[i1].y + dm_y);
+        }
+    }
+    else
+    {
+        memcpy(offsets, points, points_count * sizeof(ImVec2));
+    }
+    _Path.Size = path_start;
+
+    const int chunk_size = ImMax(IM_DRAWLIST_BATCH_CHUNK_VTX_COUNT / vtx_per_circle, 1);
+    for (int chunk_start = 0; chunk_start < count; chunk_start += chunk_size)
+    {
+        const int chunk_end = ImMin(chunk_start + chunk_size, count);
+        PrimReserve((chunk_end - chunk_start) * idx_per_circle, (chunk_end - chunk_start) * vtx_per_circle);
+        ImDrawVert* vtx = _VtxWritePtr;
+        ImDrawIdx* idx = _IdxWritePtr;
+        unsigned int vtx_idx = _VtxCurrentIdx;
+        for (int n = chunk_start; n < chunk_end; n++)
+        {
+            const ImU32 col = cols[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+                continue;
+            const ImVec2 center = centers[n];
+            for (int i = 0; i < vtx_per_circle; i++)
+            {
+                vtx[i].pos.x = center.x + offsets[i].x;
+                vtx[i].pos.y = center.y + offsets[i].y;
+                vtx[i].uv = uv;
+                vtx[i].col = col;
+            }
+            if (anti_aliased)
+                for (int i = 1; i < vtx_per_circle; i += 2)
+                    vtx[i].col = col & ~IM_COL32_A_MASK; // Outer
+            for (int i = 0; i < idx_per_circle; i++)
+                idx[i] = (ImDrawIdx)(vtx_idx + idx_template[i]);
+            vtx += vtx_per_circle;
+            idx += idx_per_circle;
+            vtx_idx += vtx_per_circle;
+        }
+        const int skipped = (chunk_end - chunk_start) - (int)(vtx - _VtxWritePtr) / vtx_per_circle;
+        PrimUnreserve(skipped * idx_per_circle, skipped * vtx_per_circle);
+        _VtxWritePtr = vtx;
+        _IdxWritePtr = idx;
+        _VtxCurrentIdx = vtx_idx;
+    }
+}
+
 // Cubic Bezier takes 4 controls points
 void ImDrawList::AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments)
 {
@@ -1762,8 +2005,10 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
 // Triangulate concave polygons. Based on "Triangulation by Ear Clipping" paper, O(N^2) complexity.
 // Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
 // Provided as a convenience for user but not used by main library.
+// Large polygons use ImTriangulatorMonotone, O(N log N), with ear clipping as fallback.
 //-----------------------------------------------------------------------------
 // - ImTriangulator [Internal]
+// - ImTriangulatorMonotone [Internal]
 // - AddConcavePolyFilled()
 //-----------------------------------------------------------------------------
 
@@ -1972,159 +2217,684 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
     n1->Type = type;
 }
 
-// Use ear-clipping algorithm to triangulate a simple polygon (no self-interaction, no holes).
-// (Reminder: we don't perform any coarse clipping/culling in ImDrawList layer!
-// It is up to caller to ensure not making costly calls that will be outside of visible area.
-// As concave fill is noticeably more expensive than other primitives, be mindful of this...
-// Caller can build AABB of points, and avoid filling if 'draw_list->_CmdHeader.ClipRect.Overlays(points_bb) == false')
-void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+//-----------------------------------------------------------------------------
+// ImTriangulatorMonotone: split the polygon in y-monotone pieces with a sweep line, then triangulate each piece in linear time.
+// O(N log N) complexity. Diagonals are added by duplicating their end vertices, so each piece remains a closed vertex ring.
+// Reference: "Computational Geometry: Algorithms and Applications", chapter 3 (de Berg, Cheong, van Kreveld, Overmars)
+// Sweep space has y pointing up (points are flipped on input), so the formulas match the reference.
+//-----------------------------------------------------------------------------
+
+enum ImTriangulatorMonotoneVertexType
 {
-    if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
-        return;
+    ImTriangulatorMonotoneVertexType_Start,
+    ImTriangulatorMonotoneVertexType_End,
+    ImTriangulatorMonotoneVertexType_Split,
+    ImTriangulatorMonotoneVertexType_Merge,
+    ImTriangulatorMonotoneVertexType_Regular
+};
 
-    const ImVec2 uv = _Data->TexUvWhitePixel;
-    ImTriangulator triangulator;
-    unsigned int triangle[3];
-    if (Flags & ImDrawListFlags_AntiAliasedFill)
-    {
-        // Anti-aliased Fill
-        const float AA_SIZE = _FringeScale;
-        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
-        const int idx_count = (points_count - 2) * 3 + points_count * 6;
-        const int vtx_count = (points_count * 2);
-        PrimReserve(idx_count, vtx_count);
+struct ImTriangulatorMonotoneVertex
+{
+    ImVec2  Pos;            // Sweep space
+    int     Index;          // Index in source points (copies made for diagonals share it)
+    int     Prev;
+    int     Next;
+    int     Edge;           // Sweep status node of edge (this, Next), -1 if none
+    ImS8    Type;           // ImTriangulatorMonotoneVertexType
+    ImS8    Chain;          // Piece triangulation: +1 left chain, -1 right chain, 0 top/bottom
+    bool    Visited;
+};
 
-        // Add indexes for fill
-        unsigned int vtx_inner_idx = _VtxCurrentIdx;
-        unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
+// Sweep status: treap of the edges crossing the sweep line with the polygon interior on their right, ordered left to right.
+struct ImTriangulatorMonotoneEdge
+{
+    ImVec2  P0, P1;
+    int     Vertex;         // Vertex owning the edge
+    int     Helper;         // Lowest vertex above the sweep line visible from the edge
+    int     Child[2];
+    ImU32   Priority;
+};
 
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
-        while (triangulator._TrianglesLeft > 0)
-        {
-            triangulator.GetNextTriangle(triangle);
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (triangle[0] << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (triangle[1] << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (triangle[2] << 1));
-            _IdxWritePtr += 3;
-        }
+struct ImTriangulatorMonotoneEvent
+{
+    ImVec2  Pos;
+    int     Vertex;
+};
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+struct ImTriangulatorMonotone
+{
+    static int EstimateScratchBufferSize(int points_count)  { return (int)(sizeof(ImTriangulatorMonotoneVertex) * points_count * 3 + sizeof(ImTriangulatorMonotoneEdge) * points_count + sizeof(ImTriangulatorMonotoneEvent) * points_count + sizeof(int) * points_count * 6 + sizeof(unsigned int) * points_count * 3); }
 
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
+    bool    Triangulate(const ImVec2* points, int points_count, void* scratch_buffer); // Return false on input it can't handle (e.g. self-intersecting), caller should fall back to ImTriangulator
 
-            // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
+    // Internal functions
+    bool    ProcessVertex(int v);
+    bool    AddDiagonal(int v0, int v1);
+    void    InsertEdge(int vertex, int helper);
+    bool    RemoveEdge(int edge);
+    int     FindEdgeLeftOf(const ImVec2& pos) const;
+    void    SplitStatus(int node, int edge, bool or_equal, int* out_left, int* out_right);
+    int     MergeStatus(int left, int right);
+    bool    TriangulatePiece(int first);
+    void    AddTriangle(int v0, int v1, int v2);
 
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
-            _IdxWritePtr += 6;
-        }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
-    }
-    else
+    // Internal members
+    ImTriangulatorMonotoneVertex*   _Vertices = NULL;
+    int                             _VerticesCount = 0;
+    int                             _VerticesCapacity = 0;
+    ImTriangulatorMonotoneEdge*     _Edges = NULL;
+    int                             _EdgesCount = 0;
+    int                             _StatusRoot = -1;
+    ImU32                           _Seed = 0;
+    ImTriangulatorMonotoneEvent*    _Events = NULL;
+    int*                            _Order = NULL;      // Piece vertices from top to bottom
+    int*                            _Stack = NULL;
+    unsigned int*                   _Triangles = NULL;
+    int                             _TrianglesCount = 0;
+    int                             _TrianglesCapacity = 0;
+};
+
+// 'a' is strictly below 'b' in sweep order (ties on y are broken by x, so no two distinct points are at the same height)
+static inline bool ImTriangulatorMonotoneIsBelow(const ImVec2& a, const ImVec2& b)  { return a.y < b.y || (a.y == b.y && a.x < b.x); }
+static inline bool ImTriangulatorMonotoneIsLeftTurn(const ImVec2& a, const ImVec2& b, const ImVec2& c) { return (c.y - a.y) * (b.x - a.x) - (c.x - a.x) * (b.y - a.y) > 0.0f; }
+
+// Edge (a0, a1) is left of edge (b0, b1), both crossing the sweep line. A point is passed as a zero-length edge.
+static bool ImTriangulatorMonotoneEdgeIsLeftOf(const ImVec2& a0, const ImVec2& a1, const ImVec2& b0, const ImVec2& b1)
+{
+    if (b0.y == b1.y)
     {
-        // Non Anti-aliased Fill
-        const int idx_count = (points_count - 2) * 3;
-        const int vtx_count = points_count;
-        PrimReserve(idx_count, vtx_count);
-        for (int i = 0; i < vtx_count; i++)
-        {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr++;
-        }
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
-        while (triangulator._TrianglesLeft > 0)
-        {
-            triangulator.GetNextTriangle(triangle);
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx + triangle[0]); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + triangle[1]); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + triangle[2]);
-            _IdxWritePtr += 3;
-        }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        if (a0.y == a1.y)
+            return a0.y < b0.y;
+        return ImTriangulatorMonotoneIsLeftTurn(a0, a1, b0);
     }
+    if (a0.y == a1.y || a0.y < b0.y)
+        return !ImTriangulatorMonotoneIsLeftTurn(b0, b1, a0);
+    return ImTriangulatorMonotoneIsLeftTurn(a0, a1, b0);
 }
 
-//-----------------------------------------------------------------------------
-// [SECTION] ImDrawListSplitter
-//-----------------------------------------------------------------------------
-// FIXME: This may be a little confusing, trying to be a little too low-level/optimal instead of just doing vector swap..
-//-----------------------------------------------------------------------------
+static int IMGUI_CDECL ImTriangulatorMonotoneComparerEvent(const void* lhs, const void* rhs)
+{
+    const ImVec2& a = ((const ImTriangulatorMonotoneEvent*)lhs)->Pos;
+    const ImVec2& b = ((const ImTriangulatorMonotoneEvent*)rhs)->Pos;
+    if (ImTriangulatorMonotoneIsBelow(b, a))
+        return -1;
+    return ImTriangulatorMonotoneIsBelow(a, b) ? +1 : 0;
+}
 
-void ImDrawListSplitter::ClearFreeMemory()
+bool ImTriangulatorMonotone::Triangulate(const ImVec2* points, int points_count, void* scratch_buffer)
 {
-    for (int i = 0; i < _Channels.Size; i++)
+    IM_ASSERT(scratch_buffer != NULL && points_count >= 3);
+    _Vertices       = (ImTriangulatorMonotoneVertex*)scratch_buffer;                // points_count x 3 x Vertex (at most 2 copies per diagonal, N-3 diagonals)
+    _Edges          = (ImTriangulatorMonotoneEdge*)(_Vertices + points_count * 3);  // points_count x Edge
+    _Events         = (ImTriangulatorMonotoneEvent*)(_Edges + points_count);        // points_count x Event
+    _Order          = (int*)(_Events + points_count);                               // points_count x 3 x int
+    _Stack          = _Order + points_count * 3;                                    // points_count x 3 x int
+    _Triangles      = (unsigned int*)(_Stack + points_count * 3);                   // points_count x 3 x unsigned int
+    _VerticesCapacity = points_count * 3;
+    _EdgesCount = 0;
+    _StatusRoot = -1;
+    _Seed = 0x9E3779B9;
+    _TrianglesCount = 0;
+    _TrianglesCapacity = points_count - 2;
+
+    // Skip repeated points (e.g. where path segments join), each one gets a zero-area triangle
+    int count = 0;
+    for (int i = 0; i < points_count; i++)
     {
-        if (i == _Current)
-            memset(&_Channels[i], 0, sizeof(_Channels[i]));  // Current channel is a copy of CmdBuffer/IdxBuffer, don't destruct again
-        _Channels[i]._CmdBuffer.clear();
-        _Channels[i]._IdxBuffer.clear();
+        const ImVec2 pos(points[i].x, -points[i].y);
+        if (count > 0 && pos.x == _Vertices[count - 1].Pos.x && pos.y == _Vertices[count - 1].Pos.y)
+            continue;
+        _Vertices[count].Pos = pos;
+        _Vertices[count].Index = i;
+        count++;
     }
-    _Current = 0;
-    _Count = 1;
-    _Channels.clear();
+    while (count > 1 && _Vertices[count - 1].Pos.x == _Vertices[0].Pos.x && _Vertices[count - 1].Pos.y == _Vertices[0].Pos.y)
+        count--;
+    if (count < 3)
+        return false;
+    for (int i = 0, next = 0; i < points_count; i++)
+    {
+        if (next < count && _Vertices[next].Index == i)
+        {
+            next++;
+            continue;
+        }
+        unsigned int* out = _Triangles + _TrianglesCount++ * 3;
+        out[0] = out[1] = out[2] = (unsigned int)i;
+    }
+    _VerticesCount = count;
+
+    // Link vertices counter-clockwise in sweep space, i.e. with a positive area once y is flipped
+    float area = 0.0f;
+    for (int i0 = count - 1, i1 = 0; i1 < count; i0 = i1++)
+        area += _Vertices[i0].Pos.x * _Vertices[i1].Pos.y - _Vertices[i1].Pos.x * _Vertices[i0].Pos.y;
+    if (!(area > 0.0f) && !(area < 0.0f)) // Also rejects NaN
+        return false;
+    const int step = (area > 0.0f) ? 1 : count - 1;
+    for (int i = 0; i < count; i++)
+    {
+        ImTriangulatorMonotoneVertex& vtx = _Vertices[i];
+        vtx.Next = (i + step) % count;
+        vtx.Prev = (i + count - step) % count;
+        vtx.Edge = -1;
+        vtx.Visited = false;
+        _Events[i].Pos = vtx.Pos;
+        _Events[i].Vertex = i;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        ImTriangulatorMonotoneVertex& vtx = _Vertices[i];
+        const ImVec2& prev = _Vertices[vtx.Prev].Pos;
+        const ImVec2& next = _Vertices[vtx.Next].Pos;
+        if (ImTriangulatorMonotoneIsBelow(prev, vtx.Pos) && ImTriangulatorMonotoneIsBelow(next, vtx.Pos))
+            vtx.Type = ImTriangulatorMonotoneIsLeftTurn(next, prev, vtx.Pos) ? ImTriangulatorMonotoneVertexType_Start : ImTriangulatorMonotoneVertexType_Split;
+        else if (ImTriangulatorMonotoneIsBelow(vtx.Pos, prev) && ImTriangulatorMonotoneIsBelow(vtx.Pos, next))
+            vtx.Type = ImTriangulatorMonotoneIsLeftTurn(next, prev, vtx.Pos) ? ImTriangulatorMonotoneVertexType_End : ImTriangulatorMonotoneVertexType_Merge;
+        else
+            vtx.Type = ImTriangulatorMonotoneVertexType_Regular;
+    }
+
+    // Sweep from top to bottom, adding diagonals to remove split and merge vertices
+    ImQsort(_Events, (size_t)count, sizeof(ImTriangulatorMonotoneEvent), ImTriangulatorMonotoneComparerEvent);
+    for (int n = 0; n < count; n++)
+        if (!ProcessVertex(_Events[n].Vertex))
+            return false;
+    if (_StatusRoot != -1)
+        return false;
+
+    for (int v = 0; v < _VerticesCount; v++)
+        if (!_Vertices[v].Visited && !TriangulatePiece(v))
+            return false;
+    return _TrianglesCount == _TrianglesCapacity;
 }
 
-void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
+bool ImTriangulatorMonotone::ProcessVertex(int v)
 {
-    IM_UNUSED(draw_list);
-    IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
-    int old_channels_count = _Channels.Size;
-    if (old_channels_count < channels_count)
+    ImTriangulatorMonotoneVertex* vertices = _Vertices;
+    switch (vertices[v].Type)
     {
-        _Channels.reserve(channels_count); // Avoid over reserving since this is likely to stay stable
-        _Channels.resize(channels_count);
+    case ImTriangulatorMonotoneVertexType_Start:
+    {
+        InsertEdge(v, v);
+        return true;
     }
-    _Count = channels_count;
-
-    // Channels[] (24/32 bytes each) hold storage that we'll swap with draw_list->_CmdBuffer/_IdxBuffer
-    // The content of Channels[0] at this point doesn't matter. We clear it to make state tidy in a debugger but we don't strictly need to.
-    // When we switch to the next channel, we'll copy draw_list->_CmdBuffer/_IdxBuffer into Channels[0] and then Channels[1] into draw_list->CmdBuffer/_IdxBuffer
-    memset(&_Channels[0], 0, sizeof(ImDrawChannel));
-    for (int i = 1; i < channels_count; i++)
+    case ImTriangulatorMonotoneVertexType_End:
     {
-        if (i >= old_channels_count)
+        const int edge = vertices[vertices[v].Prev].Edge;
+        if (edge == -1)
+            return false;
+        if (vertices[_Edges[edge].Helper].Type == ImTriangulatorMonotoneVertexType_Merge && !AddDiagonal(v, _Edges[edge].Helper))
+            return false;
+        return RemoveEdge(edge);
+    }
+    case ImTriangulatorMonotoneVertexType_Split:
+    {
+        const int left = FindEdgeLeftOf(vertices[v].Pos);
+        if (left == -1 || !AddDiagonal(v, _Edges[left].Helper))
+            return false;
+        _Edges[left].Helper = v;
+        InsertEdge(_VerticesCount - 2, _VerticesCount - 2);
+        return true;
+    }
+    case ImTriangulatorMonotoneVertexType_Merge:
+    {
+        const int edge = vertices[vertices[v].Prev].Edge;
+        if (edge == -1)
+            return false;
+        int v2 = v;
+        if (vertices[_Edges[edge].Helper].Type == ImTriangulatorMonotoneVertexType_Merge)
         {
-            IM_PLACEMENT_NEW(&_Channels[i]) ImDrawChannel();
+            if (!AddDiagonal(v, _Edges[edge].Helper))
+                return false;
+            v2 = _VerticesCount - 2;
         }
-        else
+        if (!RemoveEdge(edge))
+            return false;
+        const int left = FindEdgeLeftOf(vertices[v].Pos);
+        if (left == -1)
+            return false;
+        if (vertices[_Edges[left].Helper].Type == ImTriangulatorMonotoneVertexType_Merge && !AddDiagonal(v2, _Edges[left].Helper))
+            return false;
+        _Edges[left].Helper = v2;
+        return true;
+    }
+    default:
+    {
+        if (ImTriangulatorMonotoneIsBelow(vertices[v].Pos, vertices[vertices[v].Prev].Pos))
         {
-            _Channels[i]._CmdBuffer.resize(0);
-            _Channels[i]._IdxBuffer.resize(0);
+            // Interior is on the right: the edge above ends here and the edge below starts here
+            const int edge = vertices[vertices[v].Prev].Edge;
+            if (edge == -1)
+                return false;
+            int v2 = v;
+            if (vertices[_Edges[edge].Helper].Type == ImTriangulatorMonotoneVertexType_Merge)
+            {
+                if (!AddDiagonal(v, _Edges[edge].Helper))
+                    return false;
+                v2 = _VerticesCount - 2;
+            }
+            if (!RemoveEdge(edge))
+                return false;
+            InsertEdge(v2, v2);
+            return true;
         }
+        const int left = FindEdgeLeftOf(vertices[v].Pos);
+        if (left == -1)
+            return false;
+        if (vertices[_Edges[left].Helper].Type == ImTriangulatorMonotoneVertexType_Merge && !AddDiagonal(v, _Edges[left].Helper))
+            return false;
+        _Edges[left].Helper = v;
+        return true;
+    }
     }
 }
 
-void ImDrawListSplitter::Merge(ImDrawList* draw_list)
+// Split the ring in two along (v0, v1). Copies of v0 and v1 take over their outgoing edges: v0 -> copy of v1 -> old v1.Next ... and v1 -> copy of v0 -> old v0.Next ...
+bool ImTriangulatorMonotone::AddDiagonal(int v0, int v1)
 {
-    // Note that we never use or rely on _Channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
-    if (_Count <= 1)
-        return;
+    if (_VerticesCount + 2 > _VerticesCapacity)
+        return false;
+    ImTriangulatorMonotoneVertex* vertices = _Vertices;
+    const int c0 = _VerticesCount++;
+    const int c1 = _VerticesCount++;
+    vertices[c0] = vertices[v0];
+    vertices[c1] = vertices[v1];
+    vertices[vertices[v0].Next].Prev = c0;
+    vertices[vertices[v1].Next].Prev = c1;
+    vertices[v0].Next = c1;
+    vertices[c1].Prev = v0;
+    vertices[v1].Next = c0;
+    vertices[c0].Prev = v1;
+    vertices[v0].Edge = vertices[v1].Edge = -1;
+    if (vertices[c0].Edge != -1)
+        _Edges[vertices[c0].Edge].Vertex = c0;
+    if (vertices[c1].Edge != -1)
+        _Edges[vertices[c1].Edge].Vertex = c1;
+    return true;
+}
 
-    SetCurrentChannel(draw_list, 0);
-    draw_list->_PopUnusedDrawCmd();
+void ImTriangulatorMonotone::InsertEdge(int vertex, int helper)
+{
+    IM_ASSERT(_EdgesCount < _VerticesCapacity / 3); // At most one insertion per source point
+    const int node = _EdgesCount++;
+    ImTriangulatorMonotoneEdge& edge = _Edges[node];
+    edge.P0 = _Vertices[vertex].Pos;
+    edge.P1 = _Vertices[_Vertices[vertex].Next].Pos;
+    edge.Vertex = vertex;
+    edge.Helper = helper;
+    edge.Child[0] = edge.Child[1] = -1;
+    _Seed ^= _Seed << 13; _Seed ^= _Seed >> 17; _Seed ^= _Seed << 5;
+    edge.Priority = _Seed;
+    _Vertices[vertex].Edge = node;
+
+    int left, right;
+    SplitStatus(_StatusRoot, node, false, &left, &right);
+    _StatusRoot = MergeStatus(MergeStatus(left, node), right);
+}
+
+bool ImTriangulatorMonotone::RemoveEdge(int node)
+{
+    int left, middle, right;
+    SplitStatus(_StatusRoot, node, false, &left, &middle);
+    SplitStatus(middle, node, true, &middle, &right);
+    _StatusRoot = MergeStatus(left, right);
+    _Vertices[_Edges[node].Vertex].Edge = -1;
+    return middle == node && _Edges[node].Child[0] == -1 && _Edges[node].Child[1] == -1; // Otherwise edges are not ordered consistently (e.g. self-intersecting polygon)
+}
+
+int ImTriangulatorMonotone::FindEdgeLeftOf(const ImVec2& pos) const
+{
+    int found = -1;
+    for (int node = _StatusRoot; node != -1; )
+    {
+        const ImTriangulatorMonotoneEdge& edge = _Edges[node];
+        if (ImTriangulatorMonotoneEdgeIsLeftOf(edge.P0, edge.P1, pos, pos))
+        {
+            found = node;
+            node = edge.Child[1];
+        }
+        else
+        {
+            node = edge.Child[0];
+        }
+    }
+    return found;
+}
+
+// Split subtree 'node' in edges left of 'edge' (or equal to it when 'or_equal') and the others
+void ImTriangulatorMonotone::SplitStatus(int node, int edge, bool or_equal, int* out_left, int* out_right)
+{
+    if (node == -1)
+    {
+        *out_left = *out_right = -1;
+        return;
+    }
+    ImTriangulatorMonotoneEdge& n = _Edges[node];
+    const ImTriangulatorMonotoneEdge& e = _Edges[edge];
+    const bool is_left = or_equal ? !ImTriangulatorMonotoneEdgeIsLeftOf(e.P0, e.P1, n.P0, n.P1) : ImTriangulatorMonotoneEdgeIsLeftOf(n.P0, n.P1, e.P0, e.P1);
+    if (is_left)
+    {
+        SplitStatus(n.Child[1], edge, or_equal, &n.Child[1], out_right);
+        *out_left = node;
+    }
+    else
+    {
+        SplitStatus(n.Child[0], edge, or_equal, out_left, &n.Child[0]);
+        *out_right = node;
+    }
+}
+
+// Join two subtrees, all edges of 'left' being left of all edges of 'right'
+int ImTriangulatorMonotone::MergeStatus(int left, int right)
+{
+    if (left == -1)
+        return right;
+    if (right == -1)
+        return left;
+    if (_Edges[left].Priority > _Edges[right].Priority)
+    {
+        _Edges[left].Child[1] = MergeStatus(_Edges[left].Child[1], right);
+        return left;
+    }
+    _Edges[right].Child[0] = MergeStatus(left, _Edges[right].Child[0]);
+    return right;
+}
+
+// Vertices are passed clockwise (the reference emits them counter-clockwise), so winding matches ImTriangulator output.
+void ImTriangulatorMonotone::AddTriangle(int v0, int v1, int v2)
+{
+    if (_TrianglesCount == _TrianglesCapacity)
+    {
+        _TrianglesCount++; // Fail in Triangulate()
+        return;
+    }
+    unsigned int* out = _Triangles + _TrianglesCount++ * 3;
+    out[0] = _Vertices[v0].Index;
+    out[1] = _Vertices[v1].Index;
+    out[2] = _Vertices[v2].Index;
+}
+
+// Triangulate the y-monotone piece containing vertex 'first': walk both chains from top to bottom, keeping the vertices
+// that can't be connected yet on a stack.
+bool ImTriangulatorMonotone::TriangulatePiece(int first)
+{
+    ImTriangulatorMonotoneVertex* vertices = _Vertices;
+    int top = first, bottom = first, count = 0;
+    for (int v = first; count == 0 || v != first; v = vertices[v].Next)
+    {
+        if (++count > _VerticesCount)
+            return false;
+        vertices[v].Visited = true;
+        if (ImTriangulatorMonotoneIsBelow(vertices[v].Pos, vertices[bottom].Pos))
+            bottom = v;
+        if (ImTriangulatorMonotoneIsBelow(vertices[top].Pos, vertices[v].Pos))
+            top = v;
+    }
+    if (count < 3)
+        return false;
+    if (count == 3)
+    {
+        AddTriangle(first, vertices[vertices[first].Next].Next, vertices[first].Next);
+        return true;
+    }
+
+    // Both chains must go down from top to bottom, otherwise the sweep failed (e.g. self-intersecting polygon)
+    for (int v = top; v != bottom; v = vertices[v].Next)
+        if (!ImTriangulatorMonotoneIsBelow(vertices[vertices[v].Next].Pos, vertices[v].Pos))
+            return false;
+    for (int v = bottom; v != top; v = vertices[v].Next)
+        if (!ImTriangulatorMonotoneIsBelow(vertices[v].Pos, vertices[vertices[v].Next].Pos))
+            return false;
+
+    // Merge chains in sweep order
+    int* order = _Order;
+    int left = vertices[top].Next;
+    int right = vertices[top].Prev;
+    order[0] = top;
+    vertices[top].Chain = 0;
+    int i;
+    for (i = 1; i < count - 1; i++)
+    {
+        if (left == bottom || (right != bottom && ImTriangulatorMonotoneIsBelow(vertices[left].Pos, vertices[right].Pos)))
+        {
+            order[i] = right;
+            vertices[right].Chain = -1;
+            right = vertices[right].Prev;
+        }
+        else
+        {
+            order[i] = left;
+            vertices[left].Chain = +1;
+            left = vertices[left].Next;
+        }
+    }
+    order[i] = bottom;
+    vertices[bottom].Chain = 0;
+
+    int* stack = _Stack;
+    int stack_size = 2;
+    stack[0] = order[0];
+    stack[1] = order[1];
+    for (i = 2; i < count - 1; i++)
+    {
+        const int v = order[i];
+        if (vertices[v].Chain != vertices[stack[stack_size - 1]].Chain)
+        {
+            // Opposite chain: connect to every stacked vertex
+            for (int j = 0; j < stack_size - 1; j++)
+            {
+                if (vertices[v].Chain == +1)
+                    AddTriangle(stack[j + 1], v, stack[j]);
+                else
+                    AddTriangle(stack[j], v, stack[j + 1]);
+            }
+            stack[0] = order[i - 1];
+            stack[1] = v;
+            stack_size = 2;
+        }
+        else
+        {
+            // Same chain: connect to stacked vertices while the diagonal stays inside
+            stack_size--;
+            while (stack_size > 0)
+            {
+                const int s0 = stack[stack_size - 1];
+                const int s1 = stack[stack_size];
+                if (vertices[v].Chain == +1)
+                {
+                    if (!ImTriangulatorMonotoneIsLeftTurn(vertices[v].Pos, vertices[s0].Pos, vertices[s1].Pos))
+                        break;
+                    AddTriangle(v, s1, s0);
+                }
+                else
+                {
+                    if (!ImTriangulatorMonotoneIsLeftTurn(vertices[v].Pos, vertices[s1].Pos, vertices[s0].Pos))
+                        break;
+                    AddTriangle(v, s0, s1);
+                }
+                stack_size--;
+            }
+            stack_size++;
+            stack[stack_size++] = v;
+        }
+    }
+    const int v = order[i];
+    for (int j = 0; j < stack_size - 1; j++)
+    {
+        if (vertices[stack[j + 1]].Chain == +1)
+            AddTriangle(stack[j], v, stack[j + 1]);
+        else
+            AddTriangle(stack[j + 1], v, stack[j]);
+    }
+    return true;
+}
+
+// Write indices of the (points_count - 2) triangles of a simple polygon, point N being vertex 'vtx_idx + (N << vtx_shift)'.
+static void ImDrawListTriangulateConcave(ImDrawListSharedData* data, const ImVec2* points, int points_count, ImDrawIdx* out_idx, unsigned int vtx_idx, int vtx_shift)
+{
+    if (points_count >= IM_DRAWLIST_CONCAVE_MONOTONE_MIN_POINTS)
+    {
+        ImTriangulatorMonotone monotone;
+        data->TempBuffer.reserve_discard((ImTriangulatorMonotone::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+        if (monotone.Triangulate(points, points_count, data->TempBuffer.Data))
+        {
+            for (int i = 0; i < monotone._TrianglesCount * 3; i++)
+                out_idx[i] = (ImDrawIdx)(vtx_idx + (monotone._Triangles[i] << vtx_shift));
+            return;
+        }
+    }
+
+    ImTriangulator triangulator;
+    unsigned int triangle[3];
+    data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+    triangulator.Init(points, points_count, data->TempBuffer.Data);
+    while (triangulator._TrianglesLeft > 0)
+    {
+        triangulator.GetNextTriangle(triangle);
+        out_idx[0] = (ImDrawIdx)(vtx_idx + (triangle[0] << vtx_shift)); out_idx[1] = (ImDrawIdx)(vtx_idx + (triangle[1] << vtx_shift)); out_idx[2] = (ImDrawIdx)(vtx_idx + (triangle[2] << vtx_shift));
+        out_idx += 3;
+    }
+}
+
+// Triangulate a simple polygon (no self-interaction, no holes): ear clipping, or monotone decomposition for large polygons.
+// (Reminder: we don't perform any coarse clipping/culling in ImDrawList layer!
+// It is up to caller to ensure not making costly calls that will be outside of visible area.
+// As concave fill is noticeably more expensive than other primitives, be mindful of this...
+// Caller can build AABB of points, and avoid filling if 'draw_list->_CmdHeader.ClipRect.Overlays(points_bb) == false')
+void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+{
+    if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
+        return;
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    if (Flags & ImDrawListFlags_AntiAliasedFill)
+    {
+        // Anti-aliased Fill
+        const float AA_SIZE = _FringeScale;
+        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+        const int idx_count = (points_count - 2) * 3 + points_count * 6;
+        const int vtx_count = (points_count * 2);
+        PrimReserve(idx_count, vtx_count);
+
+        // Add indexes for fill
+        unsigned int vtx_inner_idx = _VtxCurrentIdx;
+        unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
+
+        ImDrawListTriangulateConcave(_Data, points, points_count, _IdxWritePtr, vtx_inner_idx, 1);
+        _IdxWritePtr += (points_count - 2) * 3;
+
+        // Compute normals
+        _Data->TempBuffer.reserve_discard(points_count);
+        ImVec2* temp_normals = _Data->TempBuffer.Data;
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            const ImVec2& p0 = points[i0];
+            const ImVec2& p1 = points[i1];
+            float dx = p1.x - p0.x;
+            float dy = p1.y - p0.y;
+            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+            temp_normals[i0].x = dy;
+            temp_normals[i0].y = -dx;
+        }
+
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            // Average normals
+            const ImVec2& n0 = temp_normals[i0];
+            const ImVec2& n1 = temp_normals[i1];
+            float dm_x = (n0.x + n1.x) * 0.5f;
+            float dm_y = (n0.y + n1.y) * 0.5f;
+            IM_FIXNORMAL2F(dm_x, dm_y);
+            dm_x *= AA_SIZE * 0.5f;
+            dm_y *= AA_SIZE * 0.5f;
+
+            // Add vertices
+            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr += 2;
+
+            // Add indexes for fringes
+            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+            _IdxWritePtr += 6;
+        }
+        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+    else
+    {
+        // Non Anti-aliased Fill
+        const int idx_count = (points_count - 2) * 3;
+        const int vtx_count = points_count;
+        PrimReserve(idx_count, vtx_count);
+        for (int i = 0; i < vtx_count; i++)
+        {
+            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr++;
+        }
+        ImDrawListTriangulateConcave(_Data, points, points_count, _IdxWritePtr, _VtxCurrentIdx, 0);
+        _IdxWritePtr += idx_count;
+        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawListSplitter
+//-----------------------------------------------------------------------------
+// FIXME: This may be a little confusing, trying to be a little too low-level/optimal instead of just doing vector swap..
+//-----------------------------------------------------------------------------
+
+void ImDrawListSplitter::ClearFreeMemory()
+{
+    for (int i = 0; i < _Channels.Size; i++)
+    {
+        if (i == _Current)
+            memset(&_Channels[i], 0, sizeof(_Channels[i]));  // Current channel is a copy of CmdBuffer/IdxBuffer, don't destruct again
+        _Channels[i]._CmdBuffer.clear();
+        _Channels[i]._IdxBuffer.clear();
+    }
+    _Current = 0;
+    _Count = 1;
+    _Channels.clear();
+}
+
+void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
+{
+    IM_UNUSED(draw_list);
+    IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
+    int old_channels_count = _Channels.Size;
+    if (old_channels_count < channels_count)
+    {
+        _Channels.reserve(channels_count); // Avoid over reserving since this is likely to stay stable
+        _Channels.resize(channels_count);
+    }
+    _Count = channels_count;
+
+    // Channels[] (24/32 bytes each) hold storage that we'll swap with draw_list->_CmdBuffer/_IdxBuffer
+    // The content of Channels[0] at this point doesn't matter. We clear it to make state tidy in a debugger but we don't strictly need to.
+    // When we switch to the next channel, we'll copy draw_list->_CmdBuffer/_IdxBuffer into Channels[0] and then Channels[1] into draw_list->CmdBuffer/_IdxBuffer
+    memset(&_Channels[0], 0, sizeof(ImDrawChannel));
+    for (int i = 1; i < channels_count; i++)
+    {
+        if (i >= old_channels_count)
+        {
+            IM_PLACEMENT_NEW(&_Channels[i]) ImDrawChannel();
+        }
+        else
+        {
+            _Channels[i]._CmdBuffer.resize(0);
+            _Channels[i]._IdxBuffer.resize(0);
+        }
+    }
+}
+
+void ImDrawListSplitter::Merge(ImDrawList* draw_list)
+{
+    // Note that we never use or rely on _Channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
+    if (_Count <= 1)
+        return;
+
+    SetCurrentChannel(draw_list, 0);
+    draw_list->_PopUnusedDrawCmd();
 
     // Calculate our final buffer sizes. Also fix the incorrect IdxOffset values in each command.
     int new_cmd_buffer_count = 0;
@@ -2408,6 +3178,9 @@ ImFontConfig::ImFontConfig()
 // - ImFontAtlas::Build()
 // - ImFontAtlasBuildMultiplyCalcLookupTable()
 // - ImFontAtlasBuildMultiplyRectAlpha8()
+// - ImFontAtlasDynamicLoadGlyph()
+// - ImFontAtlasDynamicNewFrame()
+// - ImFontAtlas::GetTexDirtyRect()
 // - ImFontAtlasBuildWithStbTruetype()
 // - ImFontAtlasGetBuilderForStbTruetype()
 // - ImFontAtlasUpdateSourcesPointers()
@@ -2419,6 +3192,9 @@ ImFontConfig::ImFontConfig()
 // - ImFontAtlasBuildRenderLinesTexData()
 // - ImFontAtlasBuildInit()
 // - ImFontAtlasBuildFinish()
+// - ImFontAtlasBuildCalcCacheKey()
+// - ImFontAtlasBuildLoadCache()
+// - ImFontAtlasBuildSaveCache()
 //-----------------------------------------------------------------------------
 
 // A work of art lies ahead! (. = white layer, X = black layer, others are blank)
@@ -2489,6 +3265,7 @@ ImFontAtlas::~ImFontAtlas()
 void    ImFontAtlas::ClearInputData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasDynamicDestroy(this); // Needs font data to rasterize
     for (ImFontConfig& font_cfg : Sources)
         if (font_cfg.FontData && font_cfg.FontDataOwnedByAtlas)
         {
@@ -2512,6 +3289,7 @@ void    ImFontAtlas::ClearInputData()
 void    ImFontAtlas::ClearTexData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasDynamicDestroy(this);
     if (TexPixelsAlpha8)
         IM_FREE(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
@@ -2528,6 +3306,7 @@ void    ImFontAtlas::ClearFonts()
     ClearInputData();
     Fonts.clear_delete();
     TexReady = false;
+    MetricsGeneration++;
 }
 
 void    ImFontAtlas::Clear()
@@ -2803,7 +3582,23 @@ bool    ImFontAtlas::Build()
     }
 
     // Build
-    return builder_io->FontBuilder_Build(this);
+    TexLoadedFromCache = false;
+    if (CacheFilename == NULL || (Flags & ImFontAtlasFlags_DynamicGlyphs)) // Glyphs rasterized on demand are not part of the cache
+        return builder_io->FontBuilder_Build(this);
+
+    // Build with on-disk cache: reuse texture and glyphs from a previous build with identical inputs, otherwise build and save them.
+    // Custom rectangles are registered first so they are part of the key and get their packed position restored.
+    ImFontAtlasBuildInit(this);
+    const ImGuiID cache_key = ImFontAtlasBuildCalcCacheKey(this);
+    if (ImFontAtlasBuildLoadCache(this, cache_key))
+    {
+        TexLoadedFromCache = true;
+        return true;
+    }
+    if (!builder_io->FontBuilder_Build(this))
+        return false;
+    ImFontAtlasBuildSaveCache(this, cache_key);
+    return true;
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -2846,6 +3641,7 @@ struct ImFontBuildSrcData
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<int>       GlyphsList;         // Glyph codepoints list (flattened version of GlyphsSet)
+    ImVector<int>       GlyphsListDynamic;  // ImFontAtlasFlags_DynamicGlyphs: glyph codepoints not rasterized by Build()
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -2869,11 +3665,462 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+#ifdef IMGUI_ENABLE_FONT_BUILD_THREADS
+#ifndef IM_FONT_BUILD_THREADS_MAX
+#define IM_FONT_BUILD_THREADS_MAX   16
+#endif
+#endif
+
+// Rasterization job: a contiguous run of glyphs from one source font.
+// Every glyph writes to its own packed rectangle, so jobs can run in any order or in parallel and still produce the exact same texture.
+struct ImFontBuildRenderJob
+{
+    int                 SrcIndex;
+    int                 GlyphStart;
+    int                 GlyphCount;
+};
+
+static void ImFontAtlasBuildRenderGlyphs(ImFontAtlas* atlas, ImVector<ImFontBuildSrcData>& src_tmp_array, const stbtt_pack_context& spc_template, const ImFontBuildRenderJob& job, void* alloc_userdata)
+{
+    ImFontConfig& src = atlas->Sources[job.SrcIndex];
+    ImFontBuildSrcData& src_tmp = src_tmp_array[job.SrcIndex];
+
+    // stbtt_PackFontRangesRenderIntoRects() temporarily writes oversampling factors into the context and reads allocator from the font info, so work on copies.
+    stbtt_pack_context spc = spc_template;
+    stbtt_fontinfo font_info = src_tmp.FontInfo;
+    font_info.userdata = alloc_userdata;
+    stbtt_pack_range range = src_tmp.PackRange;
+    range.array_of_unicode_codepoints += job.GlyphStart;
+    range.chardata_for_range += job.GlyphStart;
+    range.num_chars = job.GlyphCount;
+    stbrp_rect* rects = src_tmp.Rects + job.GlyphStart;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &range, 1, rects);
+
+    // Apply multiply operator
+    if (src.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, src.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < job.GlyphCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
+//-------------------------------------------------------------------------
+// Dynamic glyphs (ImFontAtlasFlags_DynamicGlyphs)
+//-------------------------------------------------------------------------
+// - Build() only rasterizes Latin-1 and a few special glyphs. Other requested glyphs get their final AdvanceX (so text layout never changes)
+//   and IM_FONTGLYPH_INDEX_DYNAMIC in ImFont::IndexLookup[], and are rasterized on their first FindGlyph() hit.
+// - They are packed below the glyphs baked by Build(), by a skyline packer which lives as long as the atlas.
+// - When that area is full, missing glyphs use the fallback glyph until the next NewFrame() evicts least recently used glyphs and repacks
+//   the others. Doing it between frames guarantees that no vertex in flight refers to a moved glyph.
+// - Modified texels are accumulated in a dirty rectangle which the renderer backend uploads (see ImFontAtlas::GetTexDirtyRect()).
+//-------------------------------------------------------------------------
+
+struct ImFontAtlasDynamicSrc
+{
+    stbtt_fontinfo      FontInfo;
+    float               Scale;
+    int                 OversampleH, OversampleV;
+};
+
+struct ImFontAtlasDynamic
+{
+    ImVector<ImFontAtlasDynamicSrc>     Sources;                // Parallel to atlas->Sources[]
+    ImVector<ImU64>                     PendingGlyphs;          // All glyphs which may be rasterized on demand, sorted: (font_index << 40) | (codepoint << 16) | source_index
+    ImVector<int>                       FontsStaticGlyphsCount; // Parallel to atlas->Fonts[]: number of glyphs baked by Build(), never evicted
+    ImVector<ImFontAtlasDynamicGlyph>   Glyphs;                 // Glyphs currently rasterized on demand
+    stbrp_context                       PackContext;            // Skyline of the dynamic area, in coordinates relative to RegionY
+    ImVector<stbrp_node>                PackNodes;
+    int                                 RegionY;                // Dynamic area is [RegionY, TexHeight)
+    bool                                RegionFull;             // Set when a glyph didn't fit. Evict at next NewFrame()
+    int                                 FrameCount;
+    int                                 DirtyX0, DirtyY0, DirtyX1, DirtyY1;
+    int                                 EvictionsCount;
+    int                                 EvictedGlyphsCount;
+
+    ImFontAtlasDynamic() { memset(&PackContext, 0, sizeof(PackContext)); RegionY = 0; RegionFull = false; FrameCount = 0; DirtyX0 = DirtyY0 = INT_MAX; DirtyX1 = DirtyY1 = 0; EvictionsCount = EvictedGlyphsCount = 0; }
+    void    AddDirtyRect(int x0, int y0, int x1, int y1) { DirtyX0 = ImMin(DirtyX0, x0); DirtyY0 = ImMin(DirtyY0, y0); DirtyX1 = ImMax(DirtyX1, x1); DirtyY1 = ImMax(DirtyY1, y1); }
+};
+
+// Glyphs always baked by Build(): Latin-1, and glyphs looked up by ImFont::BuildLookupTable() (fallback, ellipsis)
+static bool ImFontAtlasDynamicIsStaticCodepoint(const ImFontConfig* src, int codepoint)
+{
+    return codepoint <= 0xFF || codepoint == IM_UNICODE_CODEPOINT_INVALID || codepoint == 0x2026 || codepoint == 0xFF0E || codepoint == src->EllipsisChar;
+}
+
+// Same computation as stbtt_PackFontRangesRenderIntoRects() + ImFont::AddGlyph(), so AddGlyph() later produces the exact same value.
+static float ImFontAtlasDynamicCalcAdvanceX(const ImFontConfig* src, const ImFontAtlasDynamicSrc* dyn_src, int glyph_index_in_font)
+{
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(&dyn_src->FontInfo, glyph_index_in_font, &advance, &lsb);
+    const float xadvance = dyn_src->Scale * advance;
+    float advance_x = xadvance * (1.0f / src->RasterizerDensity);
+    advance_x = ImClamp(advance_x, src->GlyphMinAdvanceX, src->GlyphMaxAdvanceX);
+    if (src->PixelSnapH)
+        advance_x = IM_ROUND(advance_x);
+    return advance_x + src->GlyphExtraAdvanceX;
+}
+
+static double ImFontAtlasDynamicGetTimeMs()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Keep RGBA32 copy in sync if GetTexDataAsRGBA32() was used
+static void ImFontAtlasDynamicUpdateRGBA32(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    if (atlas->TexPixelsRGBA32 == NULL)
+        return;
+    for (int yy = y; yy < y + h; yy++)
+    {
+        const unsigned char* src = atlas->TexPixelsAlpha8 + yy * atlas->TexWidth + x;
+        unsigned int* dst = atlas->TexPixelsRGBA32 + yy * atlas->TexWidth + x;
+        for (int n = w; n > 0; n--)
+            *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+    }
+}
+
+static int IMGUI_CDECL ImFontAtlasDynamicComparerPendingGlyph(const void* lhs, const void* rhs)
+{
+    const ImU64 a = *(const ImU64*)lhs;
+    const ImU64 b = *(const ImU64*)rhs;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
+}
+
+struct ImFontAtlasDynamicGlyphUsage
+{
+    int     LastFrameUsed;
+    int     Index;          // Index in ImFontAtlasDynamic::Glyphs[]
+};
+
+// Most recently used first
+static int IMGUI_CDECL ImFontAtlasDynamicComparerGlyphUsage(const void* lhs, const void* rhs)
+{
+    const ImFontAtlasDynamicGlyphUsage* a = (const ImFontAtlasDynamicGlyphUsage*)lhs;
+    const ImFontAtlasDynamicGlyphUsage* b = (const ImFontAtlasDynamicGlyphUsage*)rhs;
+    if (a->LastFrameUsed != b->LastFrameUsed)
+        return b->LastFrameUsed - a->LastFrameUsed;
+    return a->Index - b->Index;
+}
+
+static void ImFontAtlasDynamicInit(ImFontAtlas* atlas, ImVector<ImFontBuildSrcData>& src_tmp_array, int region_y)
+{
+    IM_ASSERT(atlas->Dynamic == NULL);
+    ImFontAtlasDynamic* dyn = atlas->Dynamic = IM_NEW(ImFontAtlasDynamic)();
+    dyn->RegionY = region_y;
+    dyn->Sources.resize(src_tmp_array.Size);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    {
+        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+        ImFontConfig& src = atlas->Sources[src_i];
+        ImFontAtlasDynamicSrc& dyn_src = dyn->Sources[src_i];
+        dyn_src.FontInfo = src_tmp.FontInfo; // Points to src.FontData, valid until ClearInputData()
+        dyn_src.Scale = (src.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, src.SizePixels * src.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -src.SizePixels * src.RasterizerDensity);
+        ImFontAtlasBuildGetOversampleFactors(&src, &dyn_src.OversampleH, &dyn_src.OversampleV);
+        for (int codepoint : src_tmp.GlyphsListDynamic)
+            dyn->PendingGlyphs.push_back(((ImU64)src_tmp.DstIndex << 40) | ((ImU64)codepoint << 16) | (ImU64)src_i);
+    }
+    ImQsort(dyn->PendingGlyphs.Data, (size_t)dyn->PendingGlyphs.Size, sizeof(ImU64), ImFontAtlasDynamicComparerPendingGlyph);
+
+    // Register pending glyphs into lookup tables, with their final advance
+    for (ImFont* font : atlas->Fonts)
+        dyn->FontsStaticGlyphsCount.push_back(font->Glyphs.Size);
+    for (ImU64 pending : dyn->PendingGlyphs)
+    {
+        const int src_i = (int)(pending & 0xFFFF);
+        const int codepoint = (int)((pending >> 16) & 0xFFFFFF);
+        ImFont* font = atlas->Fonts[(int)(pending >> 40)];
+        if (codepoint >= font->IndexLookup.Size)
+        {
+            const int old_size = font->IndexLookup.Size;
+            font->GrowIndex(codepoint + 1);
+            for (int n = old_size; n < font->IndexAdvanceX.Size; n++)
+                font->IndexAdvanceX[n] = font->FallbackAdvanceX;
+        }
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&dyn->Sources[src_i].FontInfo, codepoint);
+        font->IndexAdvanceX[codepoint] = ImFontAtlasDynamicCalcAdvanceX(&atlas->Sources[src_i], &dyn->Sources[src_i], glyph_index_in_font);
+        font->IndexLookup[codepoint] = (ImU16)IM_FONTGLYPH_INDEX_DYNAMIC;
+        const int page_n = codepoint / 8192;
+        font->Used8kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+    }
+    for (ImFont* font : atlas->Fonts)
+        font->GlyphsLastFrameUsed.resize(font->Glyphs.Size, 0);
+
+    dyn->PackNodes.resize(atlas->TexWidth);
+    stbrp_init_target(&dyn->PackContext, atlas->TexWidth, atlas->TexHeight - dyn->RegionY, dyn->PackNodes.Data, dyn->PackNodes.Size);
+}
+
+ImFontGlyph* ImFontAtlasDynamicLoadGlyph(ImFont* font, ImWchar c)
+{
+    ImFontAtlas* atlas = font->ContainerAtlas;
+    ImFontAtlasDynamic* dyn = atlas->Dynamic;
+    if (dyn == NULL || dyn->RegionFull || atlas->TexPixelsAlpha8 == NULL)
+        return font->FallbackGlyph;
+    const double time_start = ImFontAtlasDynamicGetTimeMs();
+
+    // Find source font
+    const ImU64 key = ((ImU64)atlas->Fonts.index_from_ptr(atlas->Fonts.find(font)) << 40) | ((ImU64)c << 16);
+    const ImU64* it = dyn->PendingGlyphs.Data;
+    for (int count = dyn->PendingGlyphs.Size; count > 0; )
+    {
+        const int step = count >> 1;
+        if (it[step] < key) { it += step + 1; count -= step + 1; }
+        else { count = step; }
+    }
+    if (it == dyn->PendingGlyphs.end() || (*it & ~(ImU64)0xFFFF) != key)
+        return font->FallbackGlyph; // e.g. remapped with AddRemapChar()
+    const int src_i = (int)(*it & 0xFFFF);
+    ImFontConfig& src = atlas->Sources[src_i];
+    ImFontAtlasDynamicSrc& dyn_src = dyn->Sources[src_i];
+
+    // Pack (this is based on step 4 of ImFontAtlasBuildWithStbTruetype)
+    const int pack_padding = atlas->TexGlyphPadding;
+    const int glyph_index_in_font = stbtt_FindGlyphIndex(&dyn_src.FontInfo, c);
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(&dyn_src.FontInfo, glyph_index_in_font, dyn_src.Scale * dyn_src.OversampleH, dyn_src.Scale * dyn_src.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    stbrp_rect rect = {};
+    rect.w = (stbrp_coord)(x1 - x0 + pack_padding + dyn_src.OversampleH - 1);
+    rect.h = (stbrp_coord)(y1 - y0 + pack_padding + dyn_src.OversampleV - 1);
+    stbrp_pack_rects(&dyn->PackContext, &rect, 1);
+    if (!rect.was_packed)
+    {
+        dyn->RegionFull = true;
+        return font->FallbackGlyph;
+    }
+    rect.y += dyn->RegionY;
+
+    ImFontAtlasDynamicGlyph dyn_glyph;
+    dyn_glyph.Font = font;
+    dyn_glyph.Codepoint = c;
+    dyn_glyph.X = (unsigned short)rect.x;
+    dyn_glyph.Y = (unsigned short)rect.y;
+    dyn_glyph.W = (unsigned short)rect.w;
+    dyn_glyph.H = (unsigned short)rect.h;
+
+    // Rasterize with the same code path as the initial build
+    stbtt_pack_context spc = {};
+    spc.width = atlas->TexWidth;
+    spc.height = atlas->TexHeight;
+    spc.stride_in_bytes = atlas->TexWidth;
+    spc.padding = pack_padding;
+    spc.pixels = atlas->TexPixelsAlpha8;
+    int codepoint = c;
+    stbtt_packedchar pc = {};
+    stbtt_pack_range range = {};
+    range.font_size = src.SizePixels * src.RasterizerDensity;
+    range.array_of_unicode_codepoints = &codepoint;
+    range.num_chars = 1;
+    range.chardata_for_range = &pc;
+    range.h_oversample = (unsigned char)dyn_src.OversampleH;
+    range.v_oversample = (unsigned char)dyn_src.OversampleV;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &dyn_src.FontInfo, &range, 1, &rect);
+    if (src.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, src.RasterizerMultiply);
+        ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, rect.x, rect.y, rect.w, rect.h, atlas->TexWidth * 1);
+    }
+    ImFontAtlasDynamicUpdateRGBA32(atlas, dyn_glyph.X, dyn_glyph.Y, dyn_glyph.W, dyn_glyph.H);
+    dyn->AddDirtyRect(dyn_glyph.X, dyn_glyph.Y, dyn_glyph.X + dyn_glyph.W, dyn_glyph.Y + dyn_glyph.H);
+
+    // Register glyph (this is based on step 9 of ImFontAtlasBuildWithStbTruetype)
+    stbtt_aligned_quad q;
+    float unused_x = 0.0f, unused_y = 0.0f;
+    stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+    const float inv_rasterization_scale = 1.0f / src.RasterizerDensity;
+    const float font_off_x = src.GlyphOffset.x;
+    const float font_off_y = src.GlyphOffset.y + IM_ROUND(font->Ascent);
+    const int fallback_glyph_idx = font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1;
+    font->AddGlyph(&src, c, q.x0 * inv_rasterization_scale + font_off_x, q.y0 * inv_rasterization_scale + font_off_y, q.x1 * inv_rasterization_scale + font_off_x, q.y1 * inv_rasterization_scale + font_off_y, q.s0, q.t0, q.s1, q.t1, pc.xadvance * inv_rasterization_scale);
+    if (fallback_glyph_idx != -1)
+        font->FallbackGlyph = &font->Glyphs.Data[fallback_glyph_idx]; // Glyphs[] may have been reallocated
+    font->DirtyLookupTables = false;
+    font->IndexLookup[c] = (ImU16)(font->Glyphs.Size - 1);
+    font->GlyphsLastFrameUsed.push_back(dyn->FrameCount);
+    IM_ASSERT(font->IndexAdvanceX[c] == font->Glyphs.back().AdvanceX);
+
+    dyn_glyph.RasterizeMs = (float)(ImFontAtlasDynamicGetTimeMs() - time_start);
+    dyn->Glyphs.push_back(dyn_glyph);
+    return &font->Glyphs.back();
+}
+
+// Evict least recently used glyphs, keeping at most half of the dynamic area, and repack the others.
+static void ImFontAtlasDynamicEvict(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamic* dyn = atlas->Dynamic;
+    ImVector<ImFontAtlasDynamicGlyphUsage> usage;
+    usage.resize(dyn->Glyphs.Size);
+    for (int n = 0; n < dyn->Glyphs.Size; n++)
+    {
+        const ImFontAtlasDynamicGlyph& dyn_glyph = dyn->Glyphs[n];
+        usage[n].LastFrameUsed = dyn_glyph.Font->GlyphsLastFrameUsed[dyn_glyph.Font->IndexLookup[dyn_glyph.Codepoint]];
+        usage[n].Index = n;
+    }
+    ImQsort(usage.Data, (size_t)usage.Size, sizeof(ImFontAtlasDynamicGlyphUsage), ImFontAtlasDynamicComparerGlyphUsage);
+
+    // Select survivors and repack them from scratch. Those not fitting anymore are evicted too.
+    const int region_h = atlas->TexHeight - dyn->RegionY;
+    const int surface_budget = atlas->TexWidth * region_h / 2;
+    int surface = 0;
+    ImVector<stbrp_rect> rects;
+    for (const ImFontAtlasDynamicGlyphUsage& glyph_usage : usage)
+    {
+        const ImFontAtlasDynamicGlyph& dyn_glyph = dyn->Glyphs[glyph_usage.Index];
+        if (surface + dyn_glyph.W * dyn_glyph.H > surface_budget)
+            break;
+        surface += dyn_glyph.W * dyn_glyph.H;
+        stbrp_rect rect = {};
+        rect.id = glyph_usage.Index;
+        rect.w = dyn_glyph.W;
+        rect.h = dyn_glyph.H;
+        rects.push_back(rect);
+    }
+    stbrp_init_target(&dyn->PackContext, atlas->TexWidth, region_h, dyn->PackNodes.Data, dyn->PackNodes.Size);
+    stbrp_pack_rects(&dyn->PackContext, rects.Data, rects.Size);
+
+    // Move texels of survivors to their new location (through a copy of the dynamic area, as source and destination may overlap)
+    unsigned char* region_pixels = atlas->TexPixelsAlpha8 + dyn->RegionY * atlas->TexWidth;
+    ImVector<unsigned char> old_region_pixels;
+    old_region_pixels.resize(atlas->TexWidth * region_h);
+    memcpy(old_region_pixels.Data, region_pixels, (size_t)old_region_pixels.Size);
+    memset(region_pixels, 0, (size_t)old_region_pixels.Size);
+    for (const stbrp_rect& rect : rects)
+        if (rect.was_packed)
+        {
+            const ImFontAtlasDynamicGlyph& dyn_glyph = dyn->Glyphs[rect.id];
+            for (int y = 0; y < dyn_glyph.H; y++)
+                memcpy(region_pixels + (rect.y + y) * atlas->TexWidth + rect.x, old_region_pixels.Data + (dyn_glyph.Y - dyn->RegionY + y) * atlas->TexWidth + dyn_glyph.X, dyn_glyph.W);
+        }
+
+    // Rebuild dynamic part of each font: remove all dynamic glyphs, then add back survivors with their new texture coordinates.
+    ImVector<ImFontGlyph> old_glyphs;
+    ImVector<int> old_last_frame;
+    old_glyphs.resize(dyn->Glyphs.Size);
+    old_last_frame.resize(dyn->Glyphs.Size);
+    for (int n = 0; n < dyn->Glyphs.Size; n++)
+    {
+        ImFontAtlasDynamicGlyph& dyn_glyph = dyn->Glyphs[n];
+        const int glyph_idx = dyn_glyph.Font->IndexLookup[dyn_glyph.Codepoint];
+        old_glyphs[n] = dyn_glyph.Font->Glyphs[glyph_idx];
+        old_last_frame[n] = dyn_glyph.Font->GlyphsLastFrameUsed[glyph_idx];
+        dyn_glyph.Font->IndexLookup[dyn_glyph.Codepoint] = (ImU16)IM_FONTGLYPH_INDEX_DYNAMIC;
+    }
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        atlas->Fonts[font_n]->Glyphs.resize(dyn->FontsStaticGlyphsCount[font_n]); // Shrinking never reallocates, FallbackGlyph stays valid
+        atlas->Fonts[font_n]->GlyphsLastFrameUsed.resize(dyn->FontsStaticGlyphsCount[font_n]);
+    }
+    const int pack_padding = atlas->TexGlyphPadding;
+    const ImVec2 uv_scale = atlas->TexUvScale;
+    ImVector<ImFontAtlasDynamicGlyph> kept_glyphs;
+    for (const stbrp_rect& rect : rects)
+        if (rect.was_packed)
+        {
+            ImFontAtlasDynamicGlyph dyn_glyph = dyn->Glyphs[rect.id];
+            dyn_glyph.X = (unsigned short)rect.x;
+            dyn_glyph.Y = (unsigned short)(rect.y + dyn->RegionY);
+            ImFontGlyph glyph = old_glyphs[rect.id];
+            glyph.U0 = (dyn_glyph.X + pack_padding) * uv_scale.x;
+            glyph.V0 = (dyn_glyph.Y + pack_padding) * uv_scale.y;
+            glyph.U1 = (dyn_glyph.X + dyn_glyph.W) * uv_scale.x;
+            glyph.V1 = (dyn_glyph.Y + dyn_glyph.H) * uv_scale.y;
+            ImFont* font = dyn_glyph.Font;
+            font->IndexLookup[dyn_glyph.Codepoint] = (ImU16)font->Glyphs.Size;
+            font->Glyphs.push_back(glyph);
+            font->GlyphsLastFrameUsed.push_back(old_last_frame[rect.id]);
+            kept_glyphs.push_back(dyn_glyph);
+        }
+
+    dyn->EvictionsCount++;
+    dyn->EvictedGlyphsCount += dyn->Glyphs.Size - kept_glyphs.Size;
+    dyn->Glyphs.swap(kept_glyphs);
+    ImFontAtlasDynamicUpdateRGBA32(atlas, 0, dyn->RegionY, atlas->TexWidth, region_h);
+    dyn->AddDirtyRect(0, dyn->RegionY, atlas->TexWidth, atlas->TexHeight);
+}
+
+void ImFontAtlasDynamicNewFrame(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamic* dyn = atlas->Dynamic;
+    if (dyn == NULL)
+        return;
+    dyn->FrameCount++;
+    if (dyn->RegionFull && atlas->TexPixelsAlpha8 != NULL)
+        ImFontAtlasDynamicEvict(atlas);
+    dyn->RegionFull = false;
+}
+
+void ImFontAtlasDynamicDestroy(ImFontAtlas* atlas)
+{
+    if (atlas->Dynamic == NULL)
+        return;
+    IM_DELETE(atlas->Dynamic);
+    atlas->Dynamic = NULL;
+    for (ImFont* font : atlas->Fonts)
+        font->GlyphsLastFrameUsed.clear();
+}
+
+const ImFontAtlasDynamicGlyph* ImFontAtlasDynamicFindGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c)
+{
+    if (atlas->Dynamic == NULL)
+        return NULL;
+    for (const ImFontAtlasDynamicGlyph& dyn_glyph : atlas->Dynamic->Glyphs)
+        if (dyn_glyph.Font == font && dyn_glyph.Codepoint == c)
+            return &dyn_glyph;
+    return NULL;
+}
+
+bool ImFontAtlasDynamicGetStats(ImFontAtlas* atlas, const ImFont* font, ImFontAtlasDynamicStats* out_stats)
+{
+    ImFontAtlasDynamic* dyn = atlas->Dynamic;
+    memset(out_stats, 0, sizeof(*out_stats));
+    if (dyn == NULL)
+        return false;
+    const int font_n = font ? atlas->Fonts.index_from_ptr(atlas->Fonts.find((ImFont*)font)) : -1;
+    for (ImU64 pending : dyn->PendingGlyphs)
+        if (font_n == -1 || (int)(pending >> 40) == font_n)
+            out_stats->GlyphsPendingCount++;
+    for (const ImFontAtlasDynamicGlyph& dyn_glyph : dyn->Glyphs)
+        if (font == NULL || dyn_glyph.Font == font)
+        {
+            out_stats->GlyphsCount++;
+            out_stats->TexelsCount += dyn_glyph.W * dyn_glyph.H;
+            out_stats->RasterizeMsTotal += dyn_glyph.RasterizeMs;
+            out_stats->RasterizeMsMax = ImMax(out_stats->RasterizeMsMax, dyn_glyph.RasterizeMs);
+        }
+    out_stats->GlyphsPendingCount -= out_stats->GlyphsCount;
+    out_stats->EvictionsCount = dyn->EvictionsCount;
+    out_stats->EvictedGlyphsCount = dyn->EvictedGlyphsCount;
+    return true;
+}
+
+bool ImFontAtlas::GetTexDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h) const
+{
+    if (Dynamic == NULL || Dynamic->DirtyX1 <= Dynamic->DirtyX0 || Dynamic->DirtyY1 <= Dynamic->DirtyY0)
+        return false;
+    *out_x = Dynamic->DirtyX0;
+    *out_y = Dynamic->DirtyY0;
+    *out_w = ImMin(Dynamic->DirtyX1, TexWidth) - Dynamic->DirtyX0;
+    *out_h = ImMin(Dynamic->DirtyY1, TexHeight) - Dynamic->DirtyY0;
+    return true;
+}
+
+void ImFontAtlas::ClearTexDirtyRect()
+{
+    if (Dynamic == NULL)
+        return;
+    Dynamic->DirtyX0 = Dynamic->DirtyY0 = INT_MAX;
+    Dynamic->DirtyX1 = Dynamic->DirtyY1 = 0;
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->Sources.Size > 0);
 
     ImFontAtlasBuildInit(atlas);
+    ImFontAtlasDynamicDestroy(atlas);
 
     // Clear atlas
     atlas->TexID = (ImTextureID)NULL;
@@ -2966,6 +4213,24 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         UnpackBitVectorToFlatIndexList(&src_tmp.GlyphsSet, &src_tmp.GlyphsList);
         src_tmp.GlyphsSet.Clear();
         IM_ASSERT(src_tmp.GlyphsList.Size == src_tmp.GlyphsCount);
+
+        // With ImFontAtlasFlags_DynamicGlyphs, only bake a small subset now and leave others to ImFontAtlasDynamicLoadGlyph()
+        if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+        {
+            ImFontConfig& src = atlas->Sources[src_i];
+            int static_count = 0;
+            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+            {
+                const int codepoint = src_tmp.GlyphsList[glyph_i];
+                if (ImFontAtlasDynamicIsStaticCodepoint(&src, codepoint) || (static_count == 0 && glyph_i == src_tmp.GlyphsList.Size - 1)) // Keep at least one glyph per source
+                    src_tmp.GlyphsList[static_count++] = codepoint;
+                else
+                    src_tmp.GlyphsListDynamic.push_back(codepoint);
+            }
+            src_tmp.GlyphsList.resize(static_count);
+            total_glyphs_count -= src_tmp.GlyphsCount - static_count;
+            src_tmp.GlyphsCount = static_count;
+        }
     }
     for (int dst_i = 0; dst_i < dst_tmp_array.Size; dst_i++)
         dst_tmp_array[dst_i].GlyphsSet.Clear();
@@ -3035,6 +4300,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         atlas->TexWidth = atlas->TexDesiredWidth;
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    if ((atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) && atlas->TexDesiredWidth <= 0)
+        atlas->TexWidth = ImMax(atlas->TexWidth, 1024); // Room for glyphs rasterized on demand
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
@@ -3061,6 +4328,10 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 7. Allocate texture
+    // With ImFontAtlasFlags_DynamicGlyphs, the area below packed glyphs is reserved for glyphs rasterized on demand.
+    const int dynamic_region_y = atlas->TexHeight;
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+        atlas->TexHeight = ImMax(atlas->TexHeight + atlas->TexWidth / 4, atlas->TexWidth);
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
@@ -3069,27 +4340,47 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Packing above is sequential and deterministic. Rasterization is split into fixed-size jobs which may be processed by multiple threads.
+    const int GLYPHS_PER_JOB = 128;
+    ImVector<ImFontBuildRenderJob> render_jobs;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& src = atlas->Sources[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (src.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += GLYPHS_PER_JOB)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, src.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRenderJob job;
+            job.SrcIndex = src_i;
+            job.GlyphStart = glyph_i;
+            job.GlyphCount = ImMin(GLYPHS_PER_JOB, src_tmp_array[src_i].GlyphsCount - glyph_i);
+            render_jobs.push_back(job);
         }
-        src_tmp.Rects = NULL;
+
+#ifdef IMGUI_ENABLE_FONT_BUILD_THREADS
+    int threads_count = (atlas->FontBuilderThreadCount > 0) ? atlas->FontBuilderThreadCount : (int)std::thread::hardware_concurrency();
+    threads_count = ImClamp(ImMin(threads_count, render_jobs.Size), 1, IM_FONT_BUILD_THREADS_MAX);
+    if (threads_count > 1)
+    {
+        ImFontBuildThreadAllocator thread_allocator;
+        ImGui::GetAllocatorFunctions(&thread_allocator.AllocFunc, &thread_allocator.FreeFunc, &thread_allocator.UserData);
+        std::atomic<int> next_job(0);
+        auto worker_func = [&]()
+        {
+            for (int job_n = next_job++; job_n < render_jobs.Size; job_n = next_job++)
+                ImFontAtlasBuildRenderGlyphs(atlas, src_tmp_array, spc, render_jobs[job_n], &thread_allocator);
+        };
+        std::thread threads[IM_FONT_BUILD_THREADS_MAX];
+        for (int thread_n = 1; thread_n < threads_count; thread_n++)
+            threads[thread_n] = std::thread(worker_func);
+        worker_func();
+        for (int thread_n = 1; thread_n < threads_count; thread_n++)
+            threads[thread_n].join();
+    }
+    else
+#endif
+    {
+        for (const ImFontBuildRenderJob& job : render_jobs)
+            ImFontAtlasBuildRenderGlyphs(atlas, src_tmp_array, spc, job, NULL);
     }
+    for (ImFontBuildSrcData& src_tmp : src_tmp_array)
+        src_tmp.Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -3133,10 +4424,12 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
     }
 
+    ImFontAtlasBuildFinish(atlas);
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+        ImFontAtlasDynamicInit(atlas, src_tmp_array, dynamic_region_y);
+
     // Cleanup
     src_tmp_array.clear_destruct();
-
-    ImFontAtlasBuildFinish(atlas);
     return true;
 }
 
@@ -3147,6 +4440,17 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
     return &io;
 }
 
+#else
+
+// ImFontAtlasFlags_DynamicGlyphs is only supported by the stb_truetype builder
+ImFontGlyph* ImFontAtlasDynamicLoadGlyph(ImFont* font, ImWchar) { return font->FallbackGlyph; }
+void ImFontAtlasDynamicNewFrame(ImFontAtlas*) {}
+void ImFontAtlasDynamicDestroy(ImFontAtlas*) {}
+const ImFontAtlasDynamicGlyph* ImFontAtlasDynamicFindGlyph(ImFontAtlas*, const ImFont*, ImWchar) { return NULL; }
+bool ImFontAtlasDynamicGetStats(ImFontAtlas*, const ImFont*, ImFontAtlasDynamicStats* out_stats) { memset(out_stats, 0, sizeof(*out_stats)); return false; }
+bool ImFontAtlas::GetTexDirtyRect(int*, int*, int*, int*) const { return false; }
+void ImFontAtlas::ClearTexDirtyRect() {}
+
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
 void ImFontAtlasUpdateSourcesPointers(ImFontAtlas* atlas)
@@ -3369,6 +4673,228 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
             font->BuildLookupTable();
 
     atlas->TexReady = true;
+    atlas->MetricsGeneration++;
+}
+
+// On-disk atlas cache layout (native endianness, every block is a multiple of 4 bytes):
+//   ImFontAtlasCacheHeader
+//   ImFontAtlasCacheFont[FontsCount]
+//   ImFontGlyph[sum of GlyphsCount] (in font order)
+//   ImU16[CustomRectsCount * 2] (packed X,Y of each custom rectangle, padded to 4 bytes)
+//   unsigned char[TexWidth * TexHeight] (Alpha8 texels)
+// Note: there are no kerning tables to store, ImFont only uses AdvanceX.
+#define IM_FONT_ATLAS_CACHE_MAGIC       0x43464D49  // "IMFC"
+#define IM_FONT_ATLAS_CACHE_VERSION     1           // Increment when changing the layout
+
+struct ImFontAtlasCacheHeader
+{
+    ImU32       Magic;
+    ImU32       Version;
+    ImGuiID     Key;                // = ImFontAtlasBuildCalcCacheKey()
+    ImGuiID     DataChecksum;       // ImHashData() of everything following the header
+    int         TexWidth, TexHeight;
+    int         TexPixelsUseColors;
+    int         FontsCount;
+    int         CustomRectsCount;
+    ImVec2      TexUvWhitePixel;
+    ImVec4      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct ImFontAtlasCacheFont
+{
+    float       FontSize;
+    float       Ascent, Descent;
+    int         MetricsTotalSurface;
+    int         GlyphsCount;
+};
+
+// Hash every input which may affect the output of Build(), including the font files contents.
+ImGuiID ImFontAtlasBuildCalcCacheKey(ImFontAtlas* atlas)
+{
+#ifdef IMGUI_ENABLE_FREETYPE
+    const int builder_id = 2;
+#else
+    const int builder_id = 1;
+#endif
+    const int atlas_i[] = { IM_FONT_ATLAS_CACHE_VERSION, IMGUI_VERSION_NUM, (int)sizeof(ImFontGlyph), (int)sizeof(ImWchar), builder_id, atlas->FontBuilderIO != NULL, atlas->Flags, atlas->TexDesiredWidth, atlas->TexGlyphPadding, (int)atlas->FontBuilderFlags, atlas->Fonts.Size };
+    ImGuiID key = ImHashData(atlas_i, sizeof(atlas_i));
+    for (const ImFontConfig& src : atlas->Sources)
+    {
+        const int src_i[] = { src.FontDataSize, src.FontNo, src.MergeMode, src.PixelSnapH, src.OversampleH, src.OversampleV, (int)src.FontBuilderFlags, (int)src.EllipsisChar, atlas->Fonts.index_from_ptr(atlas->Fonts.find(src.DstFont)) };
+        const float src_f[] = { src.SizePixels, src.GlyphOffset.x, src.GlyphOffset.y, src.GlyphMinAdvanceX, src.GlyphMaxAdvanceX, src.GlyphExtraAdvanceX, src.RasterizerMultiply, src.RasterizerDensity };
+        const ImWchar* ranges = src.GlyphRanges ? src.GlyphRanges : atlas->GetGlyphRangesDefault();
+        int ranges_count = 0;
+        while (ranges[ranges_count] != 0)
+            ranges_count++;
+        key = ImHashData(src_i, sizeof(src_i), key);
+        key = ImHashData(src_f, sizeof(src_f), key);
+        key = ImHashData(ranges, ranges_count * sizeof(ImWchar), key);
+        key = ImHashData(src.FontData, (size_t)src.FontDataSize, key);
+    }
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        const int rect_i[] = { r.Width, r.Height, (int)r.GlyphID, (int)r.GlyphColored, r.Font ? atlas->Fonts.index_from_ptr(atlas->Fonts.find(r.Font)) : -1 };
+        const float rect_f[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        key = ImHashData(rect_i, sizeof(rect_i), key);
+        key = ImHashData(rect_f, sizeof(rect_f), key);
+    }
+    return key;
+}
+
+// Load texture and glyphs from atlas->CacheFilename. Return false (leaving the atlas untouched) if the file is missing, stale or corrupted.
+bool ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, ImGuiID key)
+{
+    IM_ASSERT(atlas->CacheFilename != NULL);
+    size_t file_size = 0;
+    const unsigned char* file_data = (const unsigned char*)ImFileMap(atlas->CacheFilename, &file_size);
+    if (file_data == NULL)
+        return false;
+
+    // Validate header, sizes and checksum before touching the atlas
+    bool valid = false;
+    ImFontAtlasCacheHeader header;
+    const size_t fonts_offset = sizeof(ImFontAtlasCacheHeader);
+    size_t glyphs_offset = 0, rects_offset = 0, pixels_offset = 0;
+    if (file_size >= sizeof(header))
+    {
+        memcpy(&header, file_data, sizeof(header));
+        valid = header.Magic == IM_FONT_ATLAS_CACHE_MAGIC && header.Version == IM_FONT_ATLAS_CACHE_VERSION && header.Key == key;
+        valid = valid && header.FontsCount == atlas->Fonts.Size && header.CustomRectsCount == atlas->CustomRects.Size;
+        valid = valid && header.TexWidth > 0 && header.TexWidth <= 0x8000 && header.TexHeight > 0 && header.TexHeight <= 0x8000;
+        glyphs_offset = fonts_offset + (size_t)header.FontsCount * sizeof(ImFontAtlasCacheFont);
+        valid = valid && file_size >= glyphs_offset;
+    }
+    if (valid)
+    {
+        size_t glyphs_count = 0;
+        for (int font_n = 0; font_n < header.FontsCount && valid; font_n++)
+        {
+            ImFontAtlasCacheFont font_header;
+            memcpy(&font_header, file_data + fonts_offset + font_n * sizeof(ImFontAtlasCacheFont), sizeof(font_header));
+            valid = font_header.GlyphsCount > 0 && font_header.GlyphsCount < 0xFFFF;
+            glyphs_count += (size_t)font_header.GlyphsCount;
+        }
+        rects_offset = glyphs_offset + glyphs_count * sizeof(ImFontGlyph);
+        pixels_offset = rects_offset + (((size_t)header.CustomRectsCount * 2 * sizeof(ImU16) + 3) & ~(size_t)3);
+        valid = valid && file_size == pixels_offset + (size_t)header.TexWidth * header.TexHeight;
+        valid = valid && ImHashData(file_data + sizeof(header), file_size - sizeof(header)) == header.DataChecksum;
+    }
+    if (!valid)
+    {
+        ImFileUnmap(file_data, file_size);
+        return false;
+    }
+
+    // Texture
+    atlas->TexID = (ImTextureID)NULL;
+    atlas->ClearTexData();
+    atlas->TexWidth = header.TexWidth;
+    atlas->TexHeight = header.TexHeight;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    atlas->TexUvWhitePixel = header.TexUvWhitePixel;
+    atlas->TexPixelsUseColors = header.TexPixelsUseColors != 0;
+    memcpy(atlas->TexUvLines, header.TexUvLines, sizeof(atlas->TexUvLines));
+    atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
+    memcpy(atlas->TexPixelsAlpha8, file_data + pixels_offset, (size_t)atlas->TexWidth * atlas->TexHeight);
+
+    // Custom rectangles
+    for (int rect_n = 0; rect_n < atlas->CustomRects.Size; rect_n++)
+    {
+        ImU16 xy[2];
+        memcpy(xy, file_data + rects_offset + rect_n * sizeof(xy), sizeof(xy));
+        atlas->CustomRects[rect_n].X = xy[0];
+        atlas->CustomRects[rect_n].Y = xy[1];
+    }
+
+    // Fonts (lookup tables are rebuilt from glyphs, as in ImFontAtlasBuildFinish())
+    size_t glyphs_cursor = glyphs_offset;
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        ImFontAtlasCacheFont font_header;
+        memcpy(&font_header, file_data + fonts_offset + font_n * sizeof(ImFontAtlasCacheFont), sizeof(font_header));
+        ImFont* font = atlas->Fonts[font_n];
+        font->ClearOutputData();
+        font->ContainerAtlas = atlas;
+        font->FontSize = font_header.FontSize;
+        font->Ascent = font_header.Ascent;
+        font->Descent = font_header.Descent;
+        font->MetricsTotalSurface = font_header.MetricsTotalSurface;
+        font->Glyphs.resize(font_header.GlyphsCount);
+        memcpy(font->Glyphs.Data, file_data + glyphs_cursor, font->Glyphs.size_in_bytes());
+        glyphs_cursor += font->Glyphs.size_in_bytes();
+        font->BuildLookupTable();
+    }
+    ImFileUnmap(file_data, file_size);
+
+    atlas->TexReady = true;
+    atlas->MetricsGeneration++;
+    return true;
+}
+
+// Write output of a successful build to atlas->CacheFilename. Only Alpha8 textures are supported.
+bool ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, ImGuiID key)
+{
+    IM_ASSERT(atlas->CacheFilename != NULL && atlas->TexReady);
+    if (atlas->TexPixelsAlpha8 == NULL || atlas->TexPixelsRGBA32 != NULL)
+        return false;
+    for (ImFont* font : atlas->Fonts)
+        if (font->Glyphs.Size == 0)
+            return false;
+
+    // Compute layout then serialize
+    size_t glyphs_size = 0;
+    for (ImFont* font : atlas->Fonts)
+        glyphs_size += (size_t)font->Glyphs.size_in_bytes();
+    const size_t fonts_offset = sizeof(ImFontAtlasCacheHeader);
+    const size_t glyphs_offset = fonts_offset + (size_t)atlas->Fonts.Size * sizeof(ImFontAtlasCacheFont);
+    const size_t rects_offset = glyphs_offset + glyphs_size;
+    const size_t pixels_offset = rects_offset + (((size_t)atlas->CustomRects.Size * 2 * sizeof(ImU16) + 3) & ~(size_t)3);
+    ImVector<unsigned char> data;
+    data.resize((int)(pixels_offset + (size_t)atlas->TexWidth * atlas->TexHeight));
+    memset(data.Data, 0, pixels_offset);
+
+    size_t glyphs_cursor = glyphs_offset;
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        ImFont* font = atlas->Fonts[font_n];
+        ImFontAtlasCacheFont font_header;
+        font_header.FontSize = font->FontSize;
+        font_header.Ascent = font->Ascent;
+        font_header.Descent = font->Descent;
+        font_header.MetricsTotalSurface = font->MetricsTotalSurface;
+        font_header.GlyphsCount = font->Glyphs.Size;
+        memcpy(data.Data + fonts_offset + font_n * sizeof(ImFontAtlasCacheFont), &font_header, sizeof(font_header));
+        memcpy(data.Data + glyphs_cursor, font->Glyphs.Data, font->Glyphs.size_in_bytes());
+        glyphs_cursor += font->Glyphs.size_in_bytes();
+    }
+    for (int rect_n = 0; rect_n < atlas->CustomRects.Size; rect_n++)
+    {
+        const ImU16 xy[2] = { atlas->CustomRects[rect_n].X, atlas->CustomRects[rect_n].Y };
+        memcpy(data.Data + rects_offset + rect_n * sizeof(xy), xy, sizeof(xy));
+    }
+    memcpy(data.Data + pixels_offset, atlas->TexPixelsAlpha8, (size_t)atlas->TexWidth * atlas->TexHeight);
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = IM_FONT_ATLAS_CACHE_MAGIC;
+    header.Version = IM_FONT_ATLAS_CACHE_VERSION;
+    header.Key = key;
+    header.DataChecksum = ImHashData(data.Data + sizeof(header), data.Size - sizeof(header));
+    header.TexWidth = atlas->TexWidth;
+    header.TexHeight = atlas->TexHeight;
+    header.TexPixelsUseColors = atlas->TexPixelsUseColors;
+    header.FontsCount = atlas->Fonts.Size;
+    header.CustomRectsCount = atlas->CustomRects.Size;
+    header.TexUvWhitePixel = atlas->TexUvWhitePixel;
+    memcpy(header.TexUvLines, atlas->TexUvLines, sizeof(header.TexUvLines));
+    memcpy(data.Data, &header, sizeof(header));
+
+    ImFileHandle f = ImFileOpen(atlas->CacheFilename, "wb");
+    if (f == NULL)
+        return false;
+    const bool ret = ImFileWrite(data.Data, 1, (ImU64)data.Size, f) == (ImU64)data.Size;
+    ImFileClose(f);
+    return ret;
 }
 
 //-------------------------------------------------------------------------
@@ -3704,6 +5230,7 @@ void    ImFont::ClearOutputData()
     FontSize = 0.0f;
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
+    GlyphsLastFrameUsed.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     FallbackGlyph = NULL;
@@ -3870,7 +5397,7 @@ void ImFont::AddGlyph(const ImFontConfig* src, ImWchar codepoint, float x0, floa
     glyph.U1 = u1;
     glyph.V1 = v1;
     glyph.AdvanceX = advance_x;
-    IM_ASSERT(Glyphs.Size < 0xFFFF); // IndexLookup[] hold 16-bit values and -1 is reserved.
+    IM_ASSERT(Glyphs.Size < IM_FONTGLYPH_INDEX_DYNAMIC); // IndexLookup[] hold 16-bit values and -1, IM_FONTGLYPH_INDEX_DYNAMIC are reserved.
 
     // Compute rough surface usage metrics (+1 to account for average padding, +0.99 to round)
     // We use (U1-U0)*TexWidth instead of X1-X0 to account for oversampling.
@@ -3902,6 +5429,12 @@ ImFontGlyph* ImFont::FindGlyph(ImWchar c)
     const ImU16 i = IndexLookup.Data[c];
     if (i == (ImU16)-1)
         return FallbackGlyph;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    if (i == IM_FONTGLYPH_INDEX_DYNAMIC)
+        return ImFontAtlasDynamicLoadGlyph(this, c);
+    if (GlyphsLastFrameUsed.Size > 0)
+        GlyphsLastFrameUsed.Data[i] = ContainerAtlas->Dynamic->FrameCount;
+#endif
     return &Glyphs.Data[i];
 }
 
@@ -3910,7 +5443,7 @@ ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c)
     if (c >= (size_t)IndexLookup.Size)
         return NULL;
     const ImU16 i = IndexLookup.Data[c];
-    if (i == (ImU16)-1)
+    if (i == (ImU16)-1 || i == IM_FONTGLYPH_INDEX_DYNAMIC) // Doesn't rasterize glyphs on demand
         return NULL;
     return &Glyphs.Data[i];
 }
@@ -4106,6 +5639,83 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     return text_size;
 }
 
+// Same traversal as the word-wrapping path of CalcTextSizeA() and RenderText(), but also output the [begin,end) byte offsets
+// (relative to text_begin) of every visual line. This is what allows ImGui::RenderTextWrapped() to reuse cached line breaks.
+ImVec2 ImFont::CalcWordWrapLinesA(float size, float wrap_width, const char* text_begin, const char* text_end, ImVector<int>* out_lines)
+{
+    IM_ASSERT(wrap_width > 0.0f && text_end != NULL);
+    const float line_height = size;
+    const float scale = size / FontSize;
+
+    ImVec2 text_size = ImVec2(0, 0);
+    float line_width = 0.0f;
+
+    const char* word_wrap_eol = NULL;
+    const char* line_begin = text_begin;
+
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        // Calculate how far we can render.
+        if (!word_wrap_eol)
+            word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - line_width);
+
+        if (s >= word_wrap_eol)
+        {
+            if (text_size.x < line_width)
+                text_size.x = line_width;
+            text_size.y += line_height;
+            line_width = 0.0f;
+            word_wrap_eol = NULL;
+            out_lines->push_back((int)(line_begin - text_begin));
+            out_lines->push_back((int)(s - text_begin));
+            s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
+            line_begin = s;
+            continue;
+        }
+
+        // Decode and advance source
+        const char* prev_s = s;
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                text_size.x = ImMax(text_size.x, line_width);
+                text_size.y += line_height;
+                line_width = 0.0f;
+                out_lines->push_back((int)(line_begin - text_begin));
+                out_lines->push_back((int)(prev_s - text_begin));
+                line_begin = s;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        line_width += ImFontGetCharAdvanceX(this, c) * scale;
+    }
+
+    if (text_size.x < line_width)
+        text_size.x = line_width;
+
+    if (line_width > 0 || text_size.y == 0.0f)
+        text_size.y += line_height;
+
+    if (line_begin < text_end)
+    {
+        out_lines->push_back((int)(line_begin - text_begin));
+        out_lines->push_back((int)(text_end - text_begin));
+    }
+
+    return text_size;
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c)
 {
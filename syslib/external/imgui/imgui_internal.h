@@ -62,11 +62,17 @@ Index of this file:
 #if (defined __SSE__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))) && !defined(IMGUI_DISABLE_SSE)
 #define IMGUI_ENABLE_SSE
 #include <immintrin.h>
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_ENABLE_SSE2
+#endif
 #if (defined __AVX__ || defined __SSE4_2__)
 #define IMGUI_ENABLE_SSE4_2
 #include <nmmintrin.h>
 #endif
 #endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // _BitScanForward
+#endif
 // Emscripten has partial SSE 4.2 support where _mm_crc32_u32 is not available. See https://emscripten.org/docs/porting/simd.html#id11 and #8213
 #if defined(IMGUI_ENABLE_SSE4_2) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(__EMSCRIPTEN__)
 #define IMGUI_ENABLE_SSE4_2_CRC
@@ -176,6 +182,7 @@ struct ImGuiTableInstanceData;      // Storage for one instance of a same table
 struct ImGuiTableTempData;          // Temporary storage for one table (one per table in the stack), shared between tables.
 struct ImGuiTableSettings;          // Storage for a table .ini settings
 struct ImGuiTableColumnsSettings;   // Storage for a column .ini settings
+struct ImGuiTextMeasureCache;       // Storage for cached CalcTextSize() results and word-wrap line breaks
 struct ImGuiTreeNodeStackData;      // Temporary storage for TreeNode().
 struct ImGuiTypingSelectState;      // Storage for GetTypingSelectRequest()
 struct ImGuiTypingSelectRequest;    // Storage for GetTypingSelectRequest() (aimed to be public)
@@ -371,6 +378,13 @@ static inline bool      ImIsPowerOfTwo(int v)               { return v != 0 && (
 static inline bool      ImIsPowerOfTwo(ImU64 v)             { return v != 0 && (v & (v - 1)) == 0; }
 static inline int       ImUpperPowerOfTwo(int v)            { v--; v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16; v++; return v; }
 static inline unsigned int ImCountSetBits(unsigned int v)   { unsigned int count = 0; while (v > 0) { v = v & (v - 1); count++; } return count; }
+#if defined(_MSC_VER) && !defined(__clang__)
+static inline int       ImCountTrailingZeroes(unsigned int v) { unsigned long index; _BitScanForward(&index, v); return (int)index; } // v must be != 0
+#elif defined(__GNUC__) || defined(__clang__)
+static inline int       ImCountTrailingZeroes(unsigned int v) { return __builtin_ctz(v); }
+#else
+static inline int       ImCountTrailingZeroes(unsigned int v) { int n = 0; while (!(v & 1)) { v >>= 1; n++; } return n; }
+#endif
 
 // Helpers: String
 #define ImStrlen strlen
@@ -383,12 +397,14 @@ IMGUI_API char*         ImStrdupcpy(char* dst, size_t* p_dst_size, const char* s
 IMGUI_API const char*   ImStrchrRange(const char* str_begin, const char* str_end, char c);  // Find first occurrence of 'c' in string range.
 IMGUI_API const char*   ImStreolRange(const char* str, const char* str_end);                // End end-of-line
 IMGUI_API const char*   ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end);  // Find a substring in a string range.
+IMGUI_API const char*   ImStristrLower(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end); // Find a substring in a string range, faster version of ImStristr() for a lowercase needle.
 IMGUI_API void          ImStrTrimBlanks(char* str);                                         // Remove leading and trailing blanks from a buffer.
 IMGUI_API const char*   ImStrSkipBlank(const char* str);                                    // Find first non-blank character.
 IMGUI_API int           ImStrlenW(const ImWchar* str);                                      // Computer string length (ImWchar string)
 IMGUI_API const char*   ImStrbol(const char* buf_mid_line, const char* buf_begin);          // Find beginning-of-line
 IM_MSVC_RUNTIME_CHECKS_OFF
 static inline char      ImToUpper(char c)               { return (c >= 'a' && c <= 'z') ? c &= ~32 : c; }
+static inline char      ImToLower(char c)               { return (c >= 'A' && c <= 'Z') ? c |= 32 : c; }
 static inline bool      ImCharIsBlankA(char c)          { return c == ' ' || c == '\t'; }
 static inline bool      ImCharIsBlankW(unsigned int c)  { return c == ' ' || c == '\t' || c == 0x3000; }
 static inline bool      ImCharIsXdigitA(char c)         { return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'); }
@@ -438,6 +454,8 @@ IMGUI_API ImU64             ImFileWrite(const void* data, ImU64 size, ImU64 coun
 #define IMGUI_DISABLE_TTY_FUNCTIONS // Can't use stdout, fflush if we are not using default file functions
 #endif
 IMGUI_API void*             ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_file_size = NULL, int padding_bytes = 0);
+IMGUI_API const void*       ImFileMap(const char* filename, size_t* out_file_size);      // Read-only mapping of a whole file. Release with ImFileUnmap().
+IMGUI_API void              ImFileUnmap(const void* data, size_t file_size);
 
 // Helpers: Maths
 IM_MSVC_RUNTIME_CHECKS_OFF
@@ -745,6 +763,11 @@ struct ImGuiTextIndex
     void            append(const char* base, int old_size, int new_size);
 };
 
+// Helper: ImGuiTextFilter over many lines of a text buffer
+// Set bit (n - line_begin) of 'out_matches' for each line n passing the filter, return number of matching lines. 'out_matches' must be sized and cleared by caller.
+// Faster than calling PassFilter() on each line when filter has no "-excl" terms, as the whole range is searched at once.
+IMGUI_API int           ImTextFilterPassLines(const ImGuiTextFilter* filter, const char* buf, ImGuiTextIndex* index, int line_begin, int line_end, ImBitVector* out_matches);
+
 // Helper: ImGuiStorage
 IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStoragePair* in_end, ImGuiID key);
 
@@ -777,6 +800,16 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: AddConcavePolyFilled() uses ear clipping (O(N^2)) below this number of points, monotone decomposition (O(N log N)) above.
+#ifndef IM_DRAWLIST_CONCAVE_MONOTONE_MIN_POINTS
+#define IM_DRAWLIST_CONCAVE_MONOTONE_MIN_POINTS                 32
+#endif
+
+// ImDrawList: batched primitives (AddRectFilledBatch() etc.) reserve at most this many vertices at once, so 16-bit indices can move to a new VtxOffset in between.
+#ifndef IM_DRAWLIST_BATCH_CHUNK_VTX_COUNT
+#define IM_DRAWLIST_BATCH_CHUNK_VTX_COUNT                       16384
+#endif
+
 // Data shared between all ImDrawList instances
 // Conceptually this could have been called e.g. ImDrawListSharedContext
 // Typically one ImGui context would create and maintain one of this.
@@ -812,6 +845,46 @@ struct ImDrawDataBuilder
     ImDrawDataBuilder()                     { memset(this, 0, sizeof(*this)); }
 };
 
+// Text measurement cache
+// - Stores the output of CalcTextSize() and the word-wrapping line breaks used by RenderTextWrapped(), keyed by font, font size, wrap width and text contents.
+// - The hash only selects a bucket: a hit compares font, font size, wrap width and a copy of the text, so a collision can't return another text's size.
+// - Entries not used for IMGUI_TEXT_MEASURE_CACHE_GC_FRAMES frames are discarded. Everything is discarded when ImFontAtlas::MetricsGeneration changes.
+// - Unwrapped text shorter than IMGUI_TEXT_MEASURE_CACHE_MIN_LEN is cheaper to measure than to hash, so it bypasses the cache.
+#ifndef IMGUI_TEXT_MEASURE_CACHE_MIN_LEN
+#define IMGUI_TEXT_MEASURE_CACHE_MIN_LEN        32
+#endif
+#define IMGUI_TEXT_MEASURE_CACHE_GC_FRAMES      60
+
+struct ImGuiTextMeasureEntry
+{
+    ImGuiID     Key;                // Hash of font, font size, wrap width and text
+    ImFont*     Font;
+    float       FontSize;
+    float       WrapWidth;          // 0.0f when not wrapped
+    int         TextOffset;         // Index of a copy of the text in ImGuiTextMeasureCache::Text[]
+    int         TextLen;
+    ImVec2      Size;               // Unrounded output of ImFont::CalcTextSizeA()
+    int         LinesOffset;        // Index of first line in ImGuiTextMeasureCache::Lines[] (pairs of begin/end offsets). Wrapped text only.
+    int         LinesCount;
+    int         LastFrameUsed;
+};
+
+struct IMGUI_API ImGuiTextMeasureCache
+{
+    ImVector<ImGuiTextMeasureEntry> Entries;
+    ImVector<int>   Buckets;                // Open addressing hash table of indices into Entries[], -1 for empty. Size is zero or a power of two.
+    ImVector<int>   Lines;                  // [begin, end) byte offsets of wrapped lines, 2 ints per line
+    ImVector<char>  Text;                   // Copies of the measured texts, compared on lookup
+    int             MetricsGeneration = -1; // Value of ImFontAtlas::MetricsGeneration matching our entries
+    bool            Enabled = true;         // Can be cleared to measure without the cache (tools/text_measure_bench)
+
+    void            Clear()                 { Entries.clear(); Buckets.clear(); Lines.clear(); Text.clear(); }
+    int             Find(ImGuiID key, ImFont* font, float font_size, float wrap_width, const char* text, int text_len) const;
+    int             Add(ImGuiID key, ImFont* font, float font_size, float wrap_width, const char* text, int text_len);
+    void            GcCompact(int min_frame_used);
+    void            RebuildBuckets(int buckets_count);
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Style support
 //-----------------------------------------------------------------------------
@@ -1156,13 +1229,27 @@ struct IMGUI_API ImGuiInputTextState
     int                     ReloadSelectionStart;
     int                     ReloadSelectionEnd;
 
+    // Line index (ImGuiInputTextFlags_LineIndex). Empty when unused or invalidated by a bulk change of TextA, rebuilt on next frame.
+    ImVector<int>           LineStarts;             // offset of each line in TextA, kept up to date by STB_TEXTEDIT_INSERTCHARS/DELETECHARS
+    ImVector<float>         LineWidths;             // width of each line, < 0.0f when not measured since last edit of the line
+    ImFont*                 LineWidthsFont;         // font and size LineWidths were measured with
+    float                   LineWidthsFontSize;
+
     ImGuiInputTextState();
     ~ImGuiInputTextState();
-    void        ClearText()                 { TextLen = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextA.clear(); TextToRevertTo.clear(); }
+    void        ClearText()                 { TextLen = 0; TextA[0] = 0; CursorClamp(); LineIndexClear(); }
+    void        ClearFreeMemory()           { TextA.clear(); TextToRevertTo.clear(); LineStarts.clear(); LineWidths.clear(); }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
     void        OnCharPressed(unsigned int c);
 
+    // Line index
+    void        LineIndexBuild();
+    void        LineIndexClear()            { LineStarts.resize(0); LineWidths.resize(0); }
+    int         LineIndexFind(int offset) const;    // line containing byte 'offset'
+    float       LineIndexGetWidth(int line);
+    void        LineIndexOnInsert(int pos, const char* new_text, int new_text_len);
+    void        LineIndexOnDelete(int pos, int n);
+
     // Cursor & Selection
     void        CursorAnimReset();
     void        CursorClamp();
@@ -1561,10 +1648,12 @@ struct ImGuiListClipperData
     float                           LossynessOffset;
     int                             StepNo;
     int                             ItemsFrozen;
+    int                             MeasureItem;        // With ImGuiListClipper::Heights: item displayed by last step, measured on next step (-1 if none)
+    float                           MeasurePosY;        // With ImGuiListClipper::Heights: cursor position at the top of MeasureItem
     ImVector<ImGuiListClipperRange> Ranges;
 
     ImGuiListClipperData()          { memset(this, 0, sizeof(*this)); }
-    void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; Ranges.resize(0); }
+    void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; MeasureItem = -1; MeasurePosY = 0.0f; Ranges.resize(0); }
 };
 
 //-----------------------------------------------------------------------------
@@ -1907,6 +1996,9 @@ struct ImGuiSettingsHandler
     void        (*ApplyAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler);                                // Read: Called after reading (in registration order)
     void        (*WriteAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* out_buf);      // Write: Output every entries into 'out_buf'
     void*       UserData;
+    bool        WriteDirty;     // [Internal] Data changed since last save: WriteAllFn must be called again with io.ConfigIniSaveIncremental
+    int         WriteOffset;    // [Internal] Section of g.SettingsIniData written by this handler at last save
+    int         WriteSize;
 
     ImGuiSettingsHandler() { memset(this, 0, sizeof(*this)); }
 };
@@ -2288,6 +2380,9 @@ struct ImGuiContext
     ImVector<float>                 TablesLastTimeActive;       // Last used timestamp of each tables (SOA, for efficient GC)
     ImVector<ImDrawChannel>         DrawChannelsTempMergeBuffer;
 
+    // Text measurement
+    ImGuiTextMeasureCache           TextMeasureCache;           // Cached CalcTextSize() results and word-wrap line breaks
+
     // Tab bars
     ImGuiTabBar*                    CurrentTabBar;
     ImPool<ImGuiTabBar>             TabBars;
@@ -2356,7 +2451,9 @@ struct ImGuiContext
     bool                    SettingsLoaded;
     float                   SettingsDirtyTimer;                 // Save .ini Settings to memory when time reaches zero
     ImGuiTextBuffer         SettingsIniData;                    // In memory .ini settings
+    ImGuiTextBuffer         SettingsIniDataPrev;                // Previous SettingsIniData, clean sections are copied from it with io.ConfigIniSaveIncremental
     ImVector<ImGuiSettingsHandler>      SettingsHandlers;       // List of .ini settings handlers
+    ImGuiSettingsHandler*               SettingsHandlerWindow;  // Cached FindSettingsHandler("Window") for MarkIniSettingsDirty(window), reset when SettingsHandlers changes
     ImChunkStream<ImGuiWindowSettings>  SettingsWindows;        // ImGuiWindow .ini settings entries
     ImChunkStream<ImGuiTableSettings>   SettingsTables;         // ImGuiTable .ini settings entries
     ImVector<ImGuiContextHook>          Hooks;                  // Hooks for extensions (e.g. test engine)
@@ -3067,6 +3164,7 @@ namespace ImGui
     // Settings
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API void                  MarkIniSettingsDirty(ImGuiWindow* window);
+    IMGUI_API void                  MarkIniSettingsDirty(ImGuiSettingsHandler* handler);
     IMGUI_API void                  ClearIniSettings();
     IMGUI_API void                  AddSettingsHandler(const ImGuiSettingsHandler* handler);
     IMGUI_API void                  RemoveSettingsHandler(const char* type_name);
@@ -3423,6 +3521,7 @@ namespace ImGui
     inline    void          RenderNavHighlight(const ImRect& bb, ImGuiID id, ImGuiNavRenderCursorFlags flags = ImGuiNavRenderCursorFlags_None) { RenderNavCursor(bb, id, flags); } // Renamed in 1.91.4
 #endif
     IMGUI_API const char*   FindRenderedTextEnd(const char* text, const char* text_end = NULL); // Find the optional ## from which we stop displaying text.
+    IMGUI_API ImGuiTextMeasureEntry* TextMeasureCacheQuery(ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end); // Return NULL when text doesn't qualify for caching. Pointer is valid until next query.
     IMGUI_API void          RenderMouseCursor(ImVec2 pos, float scale, ImGuiMouseCursor mouse_cursor, ImU32 col_fill, ImU32 col_border, ImU32 col_shadow);
 
     // Render helpers (those functions don't access any ImGui state!)
@@ -3525,6 +3624,7 @@ namespace ImGui
 
     // Debug Tools
     IMGUI_API void          DebugAllocHook(ImGuiDebugAllocInfo* info, int frame_count, void* ptr, size_t size); // size >= 0 : alloc, size = -1 : free
+    IMGUI_API void          DebugAllocHookSetThreadEnabled(bool enabled);                                       // Per thread. Disable on worker threads allocating through MemAlloc()
     IMGUI_API void          DebugDrawCursorPos(ImU32 col = IM_COL32(255, 0, 0, 255));
     IMGUI_API void          DebugDrawLineExtents(ImU32 col = IM_COL32(255, 0, 0, 255));
     IMGUI_API void          DebugDrawItemRect(ImU32 col = IM_COL32(255, 0, 0, 255));
@@ -3594,12 +3694,43 @@ IMGUI_API void      ImFontAtlasBuildInit(ImFontAtlas* atlas);
 IMGUI_API void      ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src, float ascent, float descent);
 IMGUI_API void      ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* stbrp_context_opaque);
 IMGUI_API void      ImFontAtlasBuildFinish(ImFontAtlas* atlas);
+IMGUI_API ImGuiID   ImFontAtlasBuildCalcCacheKey(ImFontAtlas* atlas);
+IMGUI_API bool      ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, ImGuiID key);
+IMGUI_API bool      ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, ImGuiID key);
 IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned char in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 IMGUI_API void      ImFontAtlasBuildGetOversampleFactors(const ImFontConfig* src, int* out_oversample_h, int* out_oversample_v);
 
+// Dynamic glyphs (ImFontAtlasFlags_DynamicGlyphs)
+#define IM_FONTGLYPH_INDEX_DYNAMIC  0xFFFE          // Value in ImFont::IndexLookup[] of a glyph which will be rasterized on first use
+
+struct ImFontAtlasDynamicGlyph
+{
+    ImFont*             Font;
+    unsigned int        Codepoint;
+    unsigned short      X, Y, W, H;                 // Packed rectangle in texture, padding included
+    float               RasterizeMs;                // First-use latency: time to pack and rasterize this glyph
+};
+
+struct ImFontAtlasDynamicStats
+{
+    int                 GlyphsCount;                // Glyphs currently rasterized on demand
+    int                 GlyphsPendingCount;         // Glyphs not rasterized yet (never used or evicted)
+    int                 TexelsCount;                // Texture area used by rasterized glyphs, padding included
+    float               RasterizeMsTotal;
+    float               RasterizeMsMax;
+    int                 EvictionsCount;             // Number of times the dynamic area was full and repacked
+    int                 EvictedGlyphsCount;
+};
+
+IMGUI_API ImFontGlyph*  ImFontAtlasDynamicLoadGlyph(ImFont* font, ImWchar c);
+IMGUI_API void          ImFontAtlasDynamicNewFrame(ImFontAtlas* atlas);
+IMGUI_API void          ImFontAtlasDynamicDestroy(ImFontAtlas* atlas);
+IMGUI_API const ImFontAtlasDynamicGlyph* ImFontAtlasDynamicFindGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c);
+IMGUI_API bool          ImFontAtlasDynamicGetStats(ImFontAtlas* atlas, const ImFont* font, ImFontAtlasDynamicStats* out_stats);    // font == NULL for whole atlas
+
 IMGUI_API bool      ImFontAtlasGetMouseCursorTexData(ImFontAtlas* atlas, ImGuiMouseCursor cursor_type, ImVec2* out_offset, ImVec2* out_size, ImVec2 out_uv_border[2], ImVec2 out_uv_fill[2]);
 
 //-----------------------------------------------------------------------------
@@ -3704,7 +3704,7 @@ void ImGui::TableSaveSettings(ImGuiTable* table)
     settings->SaveFlags &= table->Flags;
     settings->RefScale = save_ref_scale ? table->RefScale : 0.0f;
 
-    MarkIniSettingsDirty();
+    MarkIniSettingsDirty(FindSettingsHandler("Table"));
 }
 
 void ImGui::TableLoadSettings(ImGuiTable* table)
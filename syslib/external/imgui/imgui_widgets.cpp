@@ -3974,6 +3974,22 @@ static float   STB_TEXTEDIT_GETWIDTH(ImGuiInputTextState* obj, int line_start_id
 static char    STB_TEXTEDIT_NEWLINE = '\n';
 static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, ImGuiInputTextState* obj, int line_start_idx)
 {
+    // With a line index, rows starting a line are known without measuring them (every row is one line high)
+    if (obj->LineStarts.Size > 0)
+    {
+        const int line = obj->LineIndexFind(line_start_idx);
+        if (obj->LineStarts[line] == line_start_idx)
+        {
+            const int line_end = (line + 1 < obj->LineStarts.Size) ? obj->LineStarts[line + 1] : obj->TextLen;
+            r->x0 = 0.0f;
+            r->x1 = obj->LineIndexGetWidth(line);
+            r->baseline_y_delta = r->ymax = obj->Ctx->FontSize;
+            r->ymin = 0.0f;
+            r->num_chars = line_end - line_start_idx;
+            return;
+        }
+    }
+
     const char* text = obj->TextSrc;
     const char* text_remaining = NULL;
     const ImVec2 size = InputTextCalcTextSize(obj->Ctx, text + line_start_idx, text + obj->TextLen, &text_remaining, NULL, true);
@@ -3985,6 +4001,33 @@ static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, ImGuiInputTextState* ob
     r->num_chars = (int)(text_remaining - (text + line_start_idx));
 }
 
+// With a line index, stb_textedit starts its row searches from the row of interest instead of the first row.
+// The row state we provide is the one the search would have reached by itself: row 'line' starts at line 'line' and is 'line' rows down.
+#define IMSTB_TEXTEDIT_FINDROWATY       IMSTB_TEXTEDIT_FINDROWATY_IMPL
+#define IMSTB_TEXTEDIT_FINDROWOFCHAR    IMSTB_TEXTEDIT_FINDROWOFCHAR_IMPL
+
+static void IMSTB_TEXTEDIT_FINDROWATY_IMPL(ImGuiInputTextState* obj, float y, int* row_start, float* row_y)
+{
+    if (obj->LineStarts.Size == 0 || y <= 0.0f)
+        return;
+    const float line_height = obj->Ctx->FontSize;
+    const int line = (int)ImMin(y / line_height, (float)(obj->LineStarts.Size - 1));
+    *row_start = obj->LineStarts[line];
+    *row_y = line * line_height;
+}
+
+static void IMSTB_TEXTEDIT_FINDROWOFCHAR_IMPL(ImGuiInputTextState* obj, int idx, int* row_start, int* prev_row_start, float* row_y)
+{
+    if (obj->LineStarts.Size == 0)
+        return;
+    int line = obj->LineIndexFind(idx);
+    if (line > 0 && obj->LineStarts[line] == obj->TextLen)
+        line--; // Empty last line after a trailing '\n': stb_textedit reaches it by stepping from the previous row
+    *row_start = obj->LineStarts[line];
+    *prev_row_start = obj->LineStarts[ImMax(line - 1, 0)];
+    *row_y = line * obj->Ctx->FontSize;
+}
+
 #define IMSTB_TEXTEDIT_GETNEXTCHARINDEX  IMSTB_TEXTEDIT_GETNEXTCHARINDEX_IMPL
 #define IMSTB_TEXTEDIT_GETPREVCHARINDEX  IMSTB_TEXTEDIT_GETPREVCHARINDEX_IMPL
 
@@ -4087,6 +4130,8 @@ static void STB_TEXTEDIT_DELETECHARS(ImGuiInputTextState* obj, int pos, int n)
     memmove(dst, src, obj->TextLen - n - pos + 1);
     obj->Edited = true;
     obj->TextLen -= n;
+    if (obj->LineStarts.Size > 0)
+        obj->LineIndexOnDelete(pos, n);
 }
 
 static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const char* new_text, int new_text_len)
@@ -4116,6 +4161,8 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const ch
     obj->Edited = true;
     obj->TextLen += new_text_len;
     obj->TextA[obj->TextLen] = '\0';
+    if (obj->LineStarts.Size > 0)
+        obj->LineIndexOnInsert(pos, new_text, new_text_len);
 
     return true;
 }
@@ -4207,6 +4254,94 @@ void ImGuiInputTextState::ReloadUserBufAndSelectAll()       { WantReloadUserBuf
 void ImGuiInputTextState::ReloadUserBufAndKeepSelection()   { WantReloadUserBuf = true; ReloadSelectionStart = Stb->select_start; ReloadSelectionEnd = Stb->select_end; }
 void ImGuiInputTextState::ReloadUserBufAndMoveToEnd()       { WantReloadUserBuf = true; ReloadSelectionStart = ReloadSelectionEnd = INT_MAX; }
 
+void ImGuiInputTextState::LineIndexBuild()
+{
+    const char* text = TextA.Data;
+    const char* text_end = text + TextLen;
+    LineStarts.resize(0);
+    LineStarts.push_back(0);
+    for (const char* s = text; (s = (const char*)ImMemchr(s, '\n', (size_t)(text_end - s))) != NULL; s++)
+        LineStarts.push_back((int)(s + 1 - text));
+    LineWidths.resize(0);
+    LineWidths.resize(LineStarts.Size, -1.0f);
+}
+
+int ImGuiInputTextState::LineIndexFind(int offset) const
+{
+    // Last line starting at or before 'offset'
+    int lo = 1, hi = LineStarts.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (LineStarts[mid] <= offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo - 1;
+}
+
+float ImGuiInputTextState::LineIndexGetWidth(int line)
+{
+    ImGuiContext& g = *Ctx;
+    if (LineWidthsFont != g.Font || LineWidthsFontSize != g.FontSize)
+    {
+        LineWidthsFont = g.Font;
+        LineWidthsFontSize = g.FontSize;
+        for (float& width : LineWidths)
+            width = -1.0f;
+    }
+    if (LineWidths[line] < 0.0f)
+    {
+        const int line_end = (line + 1 < LineStarts.Size) ? LineStarts[line + 1] : TextLen;
+        LineWidths[line] = InputTextCalcTextSize(&g, TextSrc + LineStarts[line], TextSrc + line_end, NULL, NULL, true).x;
+    }
+    return LineWidths[line];
+}
+
+// Inserted '\n' split the line at 'pos' and add new lines after it, every following line moves by 'new_text_len'.
+void ImGuiInputTextState::LineIndexOnInsert(int pos, const char* new_text, int new_text_len)
+{
+    const int line = LineIndexFind(pos);
+    LineWidths[line] = -1.0f;
+
+    const char* new_text_end = new_text + new_text_len;
+    int new_lines = 0;
+    for (const char* s = new_text; (s = (const char*)ImMemchr(s, '\n', (size_t)(new_text_end - s))) != NULL; s++)
+        new_lines++;
+    if (new_lines > 0)
+    {
+        const int moved_lines = LineStarts.Size - (line + 1);
+        LineStarts.resize(LineStarts.Size + new_lines);
+        LineWidths.resize(LineWidths.Size + new_lines);
+        memmove(LineStarts.Data + line + 1 + new_lines, LineStarts.Data + line + 1, (size_t)moved_lines * sizeof(int));
+        memmove(LineWidths.Data + line + 1 + new_lines, LineWidths.Data + line + 1, (size_t)moved_lines * sizeof(float));
+        int dst = line + 1;
+        for (const char* s = new_text; (s = (const char*)ImMemchr(s, '\n', (size_t)(new_text_end - s))) != NULL; s++, dst++)
+        {
+            LineStarts[dst] = pos + (int)(s + 1 - new_text);
+            LineWidths[dst] = -1.0f;
+        }
+    }
+    for (int n = line + 1 + new_lines; n < LineStarts.Size; n++)
+        LineStarts[n] += new_text_len;
+}
+
+// Lines starting within (pos, pos + n] lost their '\n' and merge into the line at 'pos', every following line moves by -n.
+void ImGuiInputTextState::LineIndexOnDelete(int pos, int n)
+{
+    const int line = LineIndexFind(pos);
+    const int removed_lines = LineIndexFind(pos + n) - line;
+    LineWidths[line] = -1.0f;
+    if (removed_lines > 0)
+    {
+        LineStarts.erase(LineStarts.Data + line + 1, LineStarts.Data + line + 1 + removed_lines);
+        LineWidths.erase(LineWidths.Data + line + 1, LineWidths.Data + line + 1 + removed_lines);
+    }
+    for (int k = line + 1; k < LineStarts.Size; k++)
+        LineStarts[k] -= n;
+}
+
 ImGuiInputTextCallbackData::ImGuiInputTextCallbackData()
 {
     memset(this, 0, sizeof(*this));
@@ -4549,6 +4684,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     const bool is_password = (flags & ImGuiInputTextFlags_Password) != 0;
     const bool is_undoable = (flags & ImGuiInputTextFlags_NoUndoRedo) == 0;
     const bool is_resizable = (flags & ImGuiInputTextFlags_CallbackResize) != 0;
+    const bool is_line_indexed = is_multiline && !is_readonly && (flags & ImGuiInputTextFlags_LineIndex) != 0;
     if (is_resizable)
         IM_ASSERT(callback != NULL); // Must provide a callback if you set the ImGuiInputTextFlags_CallbackResize flag!
 
@@ -4575,6 +4711,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextA.resize(buf_size + 1); // we use +1 to make sure that .Data is always pointing to at least an empty string.
         state->TextLen = new_len;
         memcpy(state->TextA.Data, buf, state->TextLen + 1);
+        state->LineIndexClear();
         state->Stb->select_start = state->ReloadSelectionStart;
         state->Stb->cursor = state->Stb->select_end = state->ReloadSelectionEnd;
         state->CursorClamp();
@@ -4609,6 +4746,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             state->TextA.resize(buf_size + 1); // we use +1 to make sure that .Data is always pointing to at least an empty string.
             memcpy(state->TextA.Data, buf, state->TextLen + 1);
         }
+        state->LineIndexClear();
 
         // Find initial scroll position for right alignment
         state->Scroll = ImVec2(0.0f, 0.0f);
@@ -4712,6 +4850,12 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->BufCapacity = buf_size;
         state->Flags = flags;
 
+        // (Re)build the line index after activation or a bulk change of the text, it is then updated by each insertion/deletion
+        if (is_line_indexed && state->LineStarts.Size == 0)
+            state->LineIndexBuild();
+        else if (!is_line_indexed && state->LineStarts.Size > 0)
+            state->LineIndexClear();
+
         // Although we are active we don't prevent mouse from hovering other elements unless we are interacting right now with the widget.
         // Down the line we should have a cleaner library-wide concept of Selected vs Active.
         g.ActiveIdAllowOverlap = !io.MouseDown[0];
@@ -5099,13 +5243,16 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                         IM_ASSERT(callback_data.BufTextLen == (int)ImStrlen(callback_data.Buf)); // You need to maintain BufTextLen if you change the text!
                         InputTextReconcileUndoState(state, state->CallbackTextBackup.Data, state->CallbackTextBackup.Size - 1, callback_data.Buf, callback_data.BufTextLen);
                         state->TextLen = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        state->Edited = true;
+                        state->LineIndexClear();
                         state->CursorAnimReset();
                     }
                 }
             }
 
             // Will copy result string if modified
-            if (!is_readonly && strcmp(state->TextSrc, buf) != 0)
+            // (with a line index, comparing a multi-megabyte buffer every frame would defeat the purpose: only compare after edits)
+            if (!is_readonly && (state->Edited || !is_line_indexed) && strcmp(state->TextSrc, buf) != 0)
             {
                 apply_new_text = state->TextSrc;
                 apply_new_text_length = state->TextLen;
@@ -5216,7 +5363,25 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         const char* text_begin = buf_display;
         const char* text_end = text_begin + state->TextLen;
         ImVec2 cursor_offset, select_start_offset;
+        const bool use_line_index = is_line_indexed && state->LineStarts.Size > 0 && !is_displaying_hint;
 
+        if (use_line_index)
+        {
+            // Same as below with O(log N) lookups in the line index instead of a scan of the whole text
+            const int line_count = state->LineStarts.Size;
+            const int cursor_line = state->LineIndexFind(state->Stb->cursor);
+            cursor_offset.x = InputTextCalcTextSize(&g, text_begin + state->LineStarts[cursor_line], text_begin + state->Stb->cursor).x;
+            cursor_offset.y = (cursor_line + 1) * g.FontSize;
+            if (render_selection)
+            {
+                const int selmin = ImMin(state->Stb->select_start, state->Stb->select_end);
+                const int selmin_line = state->LineIndexFind(selmin);
+                select_start_offset.x = InputTextCalcTextSize(&g, text_begin + state->LineStarts[selmin_line], text_begin + selmin).x;
+                select_start_offset.y = (selmin_line + 1) * g.FontSize;
+            }
+            text_size = ImVec2(inner_size.x, line_count * g.FontSize);
+        }
+        else
         {
             // Find lines numbers straddling cursor and selection min position
             int cursor_line_no = render_cursor ? -1 : -1000;
@@ -5300,7 +5465,19 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImVec2 rect_pos = draw_pos + select_start_offset - draw_scroll;
-            for (const char* p = text_selected_begin; p < text_selected_end; )
+            const char* p = text_selected_begin;
+            if (use_line_index && rect_pos.y < clip_rect.y)
+            {
+                // Jump to the first visible line of the selection
+                const int selmin_line = (int)(select_start_offset.y / g.FontSize) - 1;
+                const int first_visible_line = ImMin((int)((clip_rect.y - draw_pos.y) / g.FontSize), state->LineStarts.Size - 1);
+                if (first_visible_line > selmin_line)
+                {
+                    p = ImMin(text_begin + state->LineStarts[first_visible_line], text_selected_end);
+                    rect_pos = ImVec2(draw_pos.x - draw_scroll.x, draw_pos.y + (first_visible_line + 1) * g.FontSize);
+                }
+            }
+            for (; p < text_selected_end; )
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
@@ -5325,7 +5502,17 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
 
         // We test for 'buf_display_max_length' as a way to avoid some pathological cases (e.g. single-line 1 MB string) which would make ImDrawList crash.
         // FIXME-OPT: Multiline could submit a smaller amount of contents to AddText() since we already iterated through it.
-        if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
+        if (use_line_index)
+        {
+            // Only submit visible lines
+            const int line_count = state->LineStarts.Size;
+            const int line_first = ImClamp((int)((clip_rect.y - draw_pos.y) / g.FontSize), 0, line_count - 1);
+            const int line_last = ImClamp((int)((clip_rect.w - draw_pos.y) / g.FontSize) + 1, line_first + 1, line_count);
+            const char* text_visible_end = (line_last < line_count) ? text_begin + state->LineStarts[line_last] : text_end;
+            ImU32 col = GetColorU32(ImGuiCol_Text);
+            draw_window->DrawList->AddText(g.Font, g.FontSize, ImVec2(draw_pos.x - draw_scroll.x, draw_pos.y + line_first * g.FontSize), col, text_begin + state->LineStarts[line_first], text_visible_end, 0.0f, NULL);
+        }
+        else if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
             draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
@@ -8116,6 +8303,10 @@ void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
     ImSwap(Size, r.Size);
     ImSwap(_SelectionOrder, r._SelectionOrder);
     _Storage.Data.swap(r._Storage.Data);
+#ifdef IMGUI_USE_HASHED_STORAGE
+    _Storage.Index.swap(r._Storage.Index);
+    ImSwap(_Storage.IndexedCount, r._Storage.IndexedCount);
+#endif
 }
 
 bool ImGuiSelectionBasicStorage::Contains(ImGuiID id) const
@@ -8137,7 +8328,12 @@ bool ImGuiSelectionBasicStorage::GetNextSelectedItem(void** opaque_it, ImGuiID*
     ImGuiStoragePair* it = (ImGuiStoragePair*)*opaque_it;
     ImGuiStoragePair* it_end = _Storage.Data.Data + _Storage.Data.Size;
     if (PreserveOrder && it == NULL && it_end != NULL)
+    {
         ImQsort(_Storage.Data.Data, (size_t)_Storage.Data.Size, sizeof(ImGuiStoragePair), PairComparerByValueInt); // ~ImGuiStorage::BuildSortByValueInt()
+#ifdef IMGUI_USE_HASHED_STORAGE
+        _Storage.BuildIndex(); // Keep Contains() valid while iterating
+#endif
+    }
     if (it == NULL)
         it = _Storage.Data.Data;
     IM_ASSERT(it >= _Storage.Data.Data && it <= it_end);
@@ -8163,6 +8359,13 @@ void ImGuiSelectionBasicStorage::SetItemSelected(ImGuiID id, bool selected)
 static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicStorage* selection, ImGuiID id, bool selected, int size_before_amends, int selection_order)
 {
     ImGuiStorage* storage = &selection->_Storage;
+#ifdef IMGUI_USE_HASHED_STORAGE
+    // Data[] is not sorted: lookup through the hash index instead of a dichotomy over the first 'size_before_amends' pairs
+    IM_UNUSED(size_before_amends);
+    if (selected == (storage->GetInt(id, 0) != 0))
+        return;
+    *storage->GetIntRef(id, 0) = selected ? selection_order : 0;
+#else
     ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + size_before_amends, id);
     const bool is_contained = (it != storage->Data.Data + size_before_amends) && (it->key == id);
     if (selected == (is_contained && it->val_i != 0))
@@ -8171,6 +8374,7 @@ static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicS
         storage->Data.push_back(ImGuiStoragePair(id, selection_order)); // Push unsorted at end of vector, will be sorted in SelectionMultiAmendsFinish()
     else if (is_contained)
         it->val_i = selected ? selection_order : 0; // Modify in-place.
+#endif
     selection->Size += selected ? +1 : -1;
 }
 
@@ -419,6 +419,9 @@ static int stb_text_locate_coord(IMSTB_TEXTEDIT_STRING *str, float x, float y)
    r.num_chars = 0;
 
    // search rows to find one that straddles 'y'
+   #ifdef IMSTB_TEXTEDIT_FINDROWATY
+   IMSTB_TEXTEDIT_FINDROWATY(str, y, &i, &base_y); // [DEAR IMGUI] optionally start from the row at 'y' instead of laying out every row above it
+   #endif
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
       if (r.num_chars <= 0)
@@ -547,6 +550,9 @@ static void stb_textedit_find_charpos(StbFindState *find, IMSTB_TEXTEDIT_STRING
 
    // search rows to find the one that straddles character n
    find->y = 0;
+   #ifdef IMSTB_TEXTEDIT_FINDROWOFCHAR
+   IMSTB_TEXTEDIT_FINDROWOFCHAR(str, n, &i, &prev_start, &find->y); // [DEAR IMGUI] optionally start from the row of character n instead of laying out every row above it
+   #endif
 
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
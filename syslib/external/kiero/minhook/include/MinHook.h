@@ -84,7 +84,7 @@ typedef enum MH_STATUS
 MH_STATUS;
 
 // Can be passed as a parameter to MH_EnableHook, MH_DisableHook,
-// MH_QueueEnableHook or MH_QueueDisableHook.
+// MH_QueueEnableHook, MH_QueueDisableHook or MH_QueueRemoveHook.
 #define MH_ALL_HOOKS NULL
 
 #ifdef __cplusplus
@@ -174,7 +174,16 @@ extern "C" {
     //                queued to be disabled.
     MH_STATUS WINAPI MH_QueueDisableHook(LPVOID pTarget);
 
-    // Applies all queued changes in one go.
+    // Queues to disable and remove an already created hook. Queuing to enable
+    // or disable the hook again before MH_ApplyQueued cancels the removal.
+    // Parameters:
+    //   pTarget [in] A pointer to the target function.
+    //                If this parameter is MH_ALL_HOOKS, all created hooks are
+    //                queued to be removed.
+    MH_STATUS WINAPI MH_QueueRemoveHook(LPVOID pTarget);
+
+    // Applies all queued changes in one go, suspending the other threads
+    // only once however many hooks change.
     MH_STATUS WINAPI MH_ApplyQueued(VOID);
 
     // Translates the MH_STATUS to its name as a string.
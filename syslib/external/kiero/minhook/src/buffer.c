@@ -39,21 +39,34 @@
 #define PAGE_EXECUTE_FLAGS \
     (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)
 
+// Blocks with a free slot are listed per address window (= 256MB), hashed into
+// WINDOW_BUCKETS lists. Finding a block with room only checks the lists of the
+// windows within WINDOW_REACH of the origin's window. Those lists may hold
+// blocks out of reach (distant windows in the same bucket, address limits), so
+// IsReachable() still checks each one. Blocks in the windows only partly within
+// MAX_MEMORY_RANGE are not looked up.
+#define WINDOW_SHIFT   28
+#define WINDOW_BUCKETS 64
+#define WINDOW_REACH   ((MAX_MEMORY_RANGE >> WINDOW_SHIFT) - 1)
+
+// Empty blocks kept for reuse before being released.
+#define MAX_EMPTY_BLOCKS 4
+
 // Memory slot.
 typedef struct _MEMORY_SLOT
 {
-    union
-    {
-        struct _MEMORY_SLOT *pNext;
-        UINT8 buffer[MEMORY_SLOT_SIZE];
-    };
+    struct _MEMORY_SLOT *pNext;
 } MEMORY_SLOT, *PMEMORY_SLOT;
 
 // Memory block info. Placed at the head of each block.
 typedef struct _MEMORY_BLOCK
 {
-    struct _MEMORY_BLOCK *pNext;
-    PMEMORY_SLOT pFree;         // First element of the free slot list.
+    struct _MEMORY_BLOCK *pNext;        // All the blocks.
+    struct _MEMORY_BLOCK *pPrev;
+    struct _MEMORY_BLOCK *pNextList;    // Blocks of the same free or empty list.
+    struct _MEMORY_BLOCK *pPrevList;
+    struct _MEMORY_BLOCK **ppList;      // Head of that list, NULL if the block is full.
+    PMEMORY_SLOT pFree;                 // First element of the free slot list.
     UINT usedCount;
 } MEMORY_BLOCK, *PMEMORY_BLOCK;
 
@@ -64,6 +77,42 @@ typedef struct _MEMORY_BLOCK
 // First element of the memory block list.
 PMEMORY_BLOCK g_pMemoryBlocks;
 
+// Blocks with at least one free slot and one used slot, by window bucket.
+PMEMORY_BLOCK g_pFreeBlocks[WINDOW_BUCKETS];
+
+// Blocks without used slots, waiting for reuse or release.
+PMEMORY_BLOCK g_pEmptyBlocks;
+UINT g_emptyCount;
+
+//-------------------------------------------------------------------------
+static LPVOID DefaultAlloc(LPVOID pAddress, SIZE_T size)
+{
+    return VirtualAlloc(pAddress, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+}
+
+static VOID DefaultFree(LPVOID pAddress)
+{
+    VirtualFree(pAddress, 0, MEM_RELEASE);
+}
+
+static SIZE_T DefaultQuery(LPCVOID pAddress, PMEMORY_BASIC_INFORMATION pInfo)
+{
+    return VirtualQuery(pAddress, pInfo, sizeof(*pInfo));
+}
+
+static const BUFFER_VM_PROVIDER g_defaultProvider =
+{
+    DefaultAlloc, DefaultFree, DefaultQuery, GetSystemInfo
+};
+
+const BUFFER_VM_PROVIDER *g_pProvider = &g_defaultProvider;
+
+//-------------------------------------------------------------------------
+VOID SetBufferProvider(const BUFFER_VM_PROVIDER *pProvider)
+{
+    g_pProvider = (pProvider != NULL) ? pProvider : &g_defaultProvider;
+}
+
 //-------------------------------------------------------------------------
 VOID InitializeBuffer(VOID)
 {
@@ -79,9 +128,87 @@ VOID UninitializeBuffer(VOID)
     while (pBlock)
     {
         PMEMORY_BLOCK pNext = pBlock->pNext;
-        VirtualFree(pBlock, 0, MEM_RELEASE);
+        g_pProvider->pfnFree(pBlock);
         pBlock = pNext;
     }
+
+    memset(g_pFreeBlocks, 0, sizeof(g_pFreeBlocks));
+    g_pEmptyBlocks = NULL;
+    g_emptyCount   = 0;
+}
+
+//-------------------------------------------------------------------------
+static UINT GetWindowBucket(ULONG_PTR address)
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    return (UINT)((address >> WINDOW_SHIFT) & (WINDOW_BUCKETS - 1));
+#else
+    // In x86 mode, every block is reachable.
+    UNREFERENCED_PARAMETER(address);
+    return 0;
+#endif
+}
+
+//-------------------------------------------------------------------------
+static VOID PushBlock(PMEMORY_BLOCK *ppList, PMEMORY_BLOCK pBlock)
+{
+    pBlock->ppList    = ppList;
+    pBlock->pPrevList = NULL;
+    pBlock->pNextList = *ppList;
+    if (*ppList != NULL)
+        (*ppList)->pPrevList = pBlock;
+    *ppList = pBlock;
+}
+
+//-------------------------------------------------------------------------
+static VOID UnlinkBlock(PMEMORY_BLOCK pBlock)
+{
+    if (pBlock->ppList == NULL)
+        return;
+
+    if (pBlock->pPrevList != NULL)
+        pBlock->pPrevList->pNextList = pBlock->pNextList;
+    else
+        *pBlock->ppList = pBlock->pNextList;
+
+    if (pBlock->pNextList != NULL)
+        pBlock->pNextList->pPrevList = pBlock->pPrevList;
+
+    pBlock->ppList = NULL;
+}
+
+//-------------------------------------------------------------------------
+static BOOL IsReachable(PMEMORY_BLOCK pBlock, ULONG_PTR minAddr, ULONG_PTR maxAddr)
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    return (ULONG_PTR)pBlock >= minAddr && (ULONG_PTR)pBlock < maxAddr;
+#else
+    UNREFERENCED_PARAMETER(pBlock);
+    UNREFERENCED_PARAMETER(minAddr);
+    UNREFERENCED_PARAMETER(maxAddr);
+    return TRUE;
+#endif
+}
+
+//-------------------------------------------------------------------------
+// Builds the free slot list of an unused block and lists it as free.
+static VOID CarveMemoryBlock(PMEMORY_BLOCK pBlock)
+{
+    ULONG_PTR pos = (sizeof(MEMORY_BLOCK) + MEMORY_SLOT_SIZE - 1) & ~(ULONG_PTR)(MEMORY_SLOT_SIZE - 1);
+    ULONG_PTR end = MEMORY_BLOCK_SIZE - MEMORY_SLOT_SIZE;
+
+    pBlock->pFree     = NULL;
+    pBlock->usedCount = 0;
+
+    // Backwards, so the slots are handed out in address order.
+    for (; end >= pos; end -= MEMORY_SLOT_SIZE)
+    {
+        PMEMORY_SLOT pSlot = (PMEMORY_SLOT)((LPBYTE)pBlock + end);
+        pSlot->pNext  = pBlock->pFree;
+        pBlock->pFree = pSlot;
+    }
+
+    PushBlock(&g_pFreeBlocks[GetWindowBucket((ULONG_PTR)pBlock)], pBlock);
 }
 
 //-------------------------------------------------------------------------
@@ -99,7 +226,7 @@ static LPVOID FindPrevFreeRegion(LPVOID pAddress, LPVOID pMinAddr, DWORD dwAlloc
     while (tryAddr >= (ULONG_PTR)pMinAddr)
     {
         MEMORY_BASIC_INFORMATION mbi;
-        if (VirtualQuery((LPVOID)tryAddr, &mbi, sizeof(mbi)) == 0)
+        if (g_pProvider->pfnQuery((LPVOID)tryAddr, &mbi) == 0)
             break;
 
         if (mbi.State == MEM_FREE)
@@ -130,7 +257,7 @@ static LPVOID FindNextFreeRegion(LPVOID pAddress, LPVOID pMaxAddr, DWORD dwAlloc
     while (tryAddr <= (ULONG_PTR)pMaxAddr)
     {
         MEMORY_BASIC_INFORMATION mbi;
-        if (VirtualQuery((LPVOID)tryAddr, &mbi, sizeof(mbi)) == 0)
+        if (g_pProvider->pfnQuery((LPVOID)tryAddr, &mbi) == 0)
             break;
 
         if (mbi.State == MEM_FREE)
@@ -150,17 +277,19 @@ static LPVOID FindNextFreeRegion(LPVOID pAddress, LPVOID pMaxAddr, DWORD dwAlloc
 //-------------------------------------------------------------------------
 static PMEMORY_BLOCK GetMemoryBlock(LPVOID pOrigin)
 {
-    PMEMORY_BLOCK pBlock;
+    PMEMORY_BLOCK pBlock = NULL;
+    ULONG_PTR minAddr = 0;
+    ULONG_PTR maxAddr = 0;
 #if defined(_M_X64) || defined(__x86_64__)
-    ULONG_PTR minAddr;
-    ULONG_PTR maxAddr;
+    ULONG_PTR window = (ULONG_PTR)pOrigin >> WINDOW_SHIFT;
+    UINT i;
 
     SYSTEM_INFO si;
-    GetSystemInfo(&si);
+    g_pProvider->pfnGetSystemInfo(&si);
     minAddr = (ULONG_PTR)si.lpMinimumApplicationAddress;
     maxAddr = (ULONG_PTR)si.lpMaximumApplicationAddress;
 
-    // pOrigin ± 512MB
+    // pOrigin ± 1024MB
     if ((ULONG_PTR)pOrigin > MAX_MEMORY_RANGE && minAddr < (ULONG_PTR)pOrigin - MAX_MEMORY_RANGE)
         minAddr = (ULONG_PTR)pOrigin - MAX_MEMORY_RANGE;
 
@@ -169,19 +298,38 @@ static PMEMORY_BLOCK GetMemoryBlock(LPVOID pOrigin)
 
     // Make room for MEMORY_BLOCK_SIZE bytes.
     maxAddr -= MEMORY_BLOCK_SIZE - 1;
-#endif
 
-    // Look the registered blocks for a reachable one.
-    for (pBlock = g_pMemoryBlocks; pBlock != NULL; pBlock = pBlock->pNext)
+    // Look the free lists of the nearby windows for a reachable block.
+    for (i = 0; i <= 2 * WINDOW_REACH && pBlock == NULL; ++i)
     {
-#if defined(_M_X64) || defined(__x86_64__)
-        // Ignore the blocks too far.
-        if ((ULONG_PTR)pBlock < minAddr || (ULONG_PTR)pBlock >= maxAddr)
-            continue;
+        PMEMORY_BLOCK pFree = g_pFreeBlocks[GetWindowBucket((window + i - WINDOW_REACH) << WINDOW_SHIFT)];
+        for (; pFree != NULL; pFree = pFree->pNextList)
+        {
+            // Other windows hashed into the same bucket may be too far.
+            if (IsReachable(pFree, minAddr, maxAddr))
+            {
+                pBlock = pFree;
+                break;
+            }
+        }
+    }
+#else
+    pBlock = g_pFreeBlocks[0];
 #endif
-        // The block has at least one unused slot.
-        if (pBlock->pFree != NULL)
+
+    if (pBlock != NULL)
+        return pBlock;
+
+    // Reuse an empty block.
+    for (pBlock = g_pEmptyBlocks; pBlock != NULL; pBlock = pBlock->pNextList)
+    {
+        if (IsReachable(pBlock, minAddr, maxAddr))
+        {
+            UnlinkBlock(pBlock);
+            g_emptyCount--;
+            CarveMemoryBlock(pBlock);
             return pBlock;
+        }
     }
 
 #if defined(_M_X64) || defined(__x86_64__)
@@ -194,8 +342,7 @@ static PMEMORY_BLOCK GetMemoryBlock(LPVOID pOrigin)
             if (pAlloc == NULL)
                 break;
 
-            pBlock = (PMEMORY_BLOCK)VirtualAlloc(
-                pAlloc, MEMORY_BLOCK_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+            pBlock = (PMEMORY_BLOCK)g_pProvider->pfnAlloc(pAlloc, MEMORY_BLOCK_SIZE);
             if (pBlock != NULL)
                 break;
         }
@@ -211,33 +358,25 @@ static PMEMORY_BLOCK GetMemoryBlock(LPVOID pOrigin)
             if (pAlloc == NULL)
                 break;
 
-            pBlock = (PMEMORY_BLOCK)VirtualAlloc(
-                pAlloc, MEMORY_BLOCK_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+            pBlock = (PMEMORY_BLOCK)g_pProvider->pfnAlloc(pAlloc, MEMORY_BLOCK_SIZE);
             if (pBlock != NULL)
                 break;
         }
     }
 #else
     // In x86 mode, a memory block can be placed anywhere.
-    pBlock = (PMEMORY_BLOCK)VirtualAlloc(
-        NULL, MEMORY_BLOCK_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+    pBlock = (PMEMORY_BLOCK)g_pProvider->pfnAlloc(NULL, MEMORY_BLOCK_SIZE);
 #endif
 
     if (pBlock != NULL)
     {
-        // Build a linked list of all the slots.
-        PMEMORY_SLOT pSlot = (PMEMORY_SLOT)pBlock + 1;
-        pBlock->pFree = NULL;
-        pBlock->usedCount = 0;
-        do
-        {
-            pSlot->pNext = pBlock->pFree;
-            pBlock->pFree = pSlot;
-            pSlot++;
-        } while ((ULONG_PTR)pSlot - (ULONG_PTR)pBlock <= MEMORY_BLOCK_SIZE - MEMORY_SLOT_SIZE);
-
+        pBlock->pPrev = NULL;
         pBlock->pNext = g_pMemoryBlocks;
+        if (g_pMemoryBlocks != NULL)
+            g_pMemoryBlocks->pPrev = pBlock;
         g_pMemoryBlocks = pBlock;
+
+        CarveMemoryBlock(pBlock);
     }
 
     return pBlock;
@@ -255,9 +394,13 @@ LPVOID AllocateBuffer(LPVOID pOrigin)
     pSlot = pBlock->pFree;
     pBlock->pFree = pSlot->pNext;
     pBlock->usedCount++;
+
+    // Full blocks are not listed.
+    if (pBlock->pFree == NULL)
+        UnlinkBlock(pBlock);
 #ifdef _DEBUG
     // Fill the slot with INT3 for debugging.
-    memset(pSlot, 0xCC, sizeof(MEMORY_SLOT));
+    memset(pSlot, 0xCC, MEMORY_SLOT_SIZE);
 #endif
     return pSlot;
 }
@@ -265,40 +408,45 @@ LPVOID AllocateBuffer(LPVOID pOrigin)
 //-------------------------------------------------------------------------
 VOID FreeBuffer(LPVOID pBuffer)
 {
-    PMEMORY_BLOCK pBlock = g_pMemoryBlocks;
-    PMEMORY_BLOCK pPrev = NULL;
-    ULONG_PTR pTargetBlock = ((ULONG_PTR)pBuffer / MEMORY_BLOCK_SIZE) * MEMORY_BLOCK_SIZE;
+    // Blocks are aligned to their size, so the slot leads straight to its block.
+    PMEMORY_BLOCK pBlock = (PMEMORY_BLOCK)(((ULONG_PTR)pBuffer / MEMORY_BLOCK_SIZE) * MEMORY_BLOCK_SIZE);
+    PMEMORY_SLOT  pSlot  = (PMEMORY_SLOT)pBuffer;
+    BOOL          wasFull = (pBlock->pFree == NULL);
 
-    while (pBlock != NULL)
-    {
-        if ((ULONG_PTR)pBlock == pTargetBlock)
-        {
-            PMEMORY_SLOT pSlot = (PMEMORY_SLOT)pBuffer;
 #ifdef _DEBUG
-            // Clear the released slot for debugging.
-            memset(pSlot, 0x00, sizeof(*pSlot));
+    // Clear the released slot for debugging.
+    memset(pSlot, 0x00, MEMORY_SLOT_SIZE);
 #endif
-            // Restore the released slot to the list.
-            pSlot->pNext = pBlock->pFree;
-            pBlock->pFree = pSlot;
-            pBlock->usedCount--;
+    // Restore the released slot to the list.
+    pSlot->pNext = pBlock->pFree;
+    pBlock->pFree = pSlot;
+    pBlock->usedCount--;
 
-            // Free if unused.
-            if (pBlock->usedCount == 0)
-            {
-                if (pPrev)
-                    pPrev->pNext = pBlock->pNext;
-                else
-                    g_pMemoryBlocks = pBlock->pNext;
-
-                VirtualFree(pBlock, 0, MEM_RELEASE);
-            }
+    if (pBlock->usedCount == 0)
+    {
+        UnlinkBlock(pBlock);
 
-            break;
+        if (g_emptyCount < MAX_EMPTY_BLOCKS)
+        {
+            // Keep it for the next allocations nearby.
+            PushBlock(&g_pEmptyBlocks, pBlock);
+            g_emptyCount++;
         }
-
-        pPrev = pBlock;
-        pBlock = pBlock->pNext;
+        else
+        {
+            if (pBlock->pPrev != NULL)
+                pBlock->pPrev->pNext = pBlock->pNext;
+            else
+                g_pMemoryBlocks = pBlock->pNext;
+            if (pBlock->pNext != NULL)
+                pBlock->pNext->pPrev = pBlock->pPrev;
+
+            g_pProvider->pfnFree(pBlock);
+        }
+    }
+    else if (wasFull)
+    {
+        PushBlock(&g_pFreeBlocks[GetWindowBucket((ULONG_PTR)pBlock)], pBlock);
     }
 }
 
@@ -306,7 +454,7 @@ VOID FreeBuffer(LPVOID pBuffer)
 BOOL IsExecutableAddress(LPVOID pAddress)
 {
     MEMORY_BASIC_INFORMATION mi;
-    VirtualQuery(pAddress, &mi, sizeof(mi));
+    g_pProvider->pfnQuery(pAddress, &mi);
 
     return (mi.State == MEM_COMMIT && (mi.Protect & PAGE_EXECUTE_FLAGS));
 }
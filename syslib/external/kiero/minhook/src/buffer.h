@@ -35,8 +35,21 @@
     #define MEMORY_SLOT_SIZE 32
 #endif
 
+// Virtual memory functions used by the buffer. Replaceable, so the allocation
+// policy can run against a simulated address space.
+typedef struct _BUFFER_VM_PROVIDER
+{
+    LPVOID (*pfnAlloc)(LPVOID pAddress, SIZE_T size);   // Commits executable memory at pAddress (anywhere if NULL). NULL on failure.
+    VOID   (*pfnFree)(LPVOID pAddress);
+    SIZE_T (*pfnQuery)(LPCVOID pAddress, PMEMORY_BASIC_INFORMATION pInfo);
+    VOID   (WINAPI *pfnGetSystemInfo)(LPSYSTEM_INFO pInfo);
+} BUFFER_VM_PROVIDER;
+
 VOID   InitializeBuffer(VOID);
 VOID   UninitializeBuffer(VOID);
-LPVOID AllocateBuffer(LPVOID pOrigin);
+LPVOID AllocateBuffer(LPVOID pOrigin);      // MEMORY_SLOT_SIZE bytes, reachable from pOrigin.
 VOID   FreeBuffer(LPVOID pBuffer);
 BOOL   IsExecutableAddress(LPVOID pAddress);
+
+// NULL restores the Win32 functions. Only while no buffer is allocated.
+VOID   SetBufferProvider(const BUFFER_VM_PROVIDER *pProvider);
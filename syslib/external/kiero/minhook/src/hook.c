@@ -32,6 +32,7 @@
 
 #include "../include/MinHook.h"
 #include "buffer.h"
+#include "hook_index.h"
 #include "trampoline.h"
 
 #ifndef ARRAYSIZE
@@ -68,6 +69,7 @@ typedef struct _HOOK_ENTRY
     UINT8  patchAbove  : 1;     // Uses the hot patch area.
     UINT8  isEnabled   : 1;     // Enabled.
     UINT8  queueEnable : 1;     // Queued for enabling/disabling when != isEnabled.
+    UINT8  queueRemove : 1;     // Queued for removal.
 
     UINT   nIP : 4;             // Count of the instruction boundaries.
     UINT8  oldIPs[8];           // Instruction boundaries of the target function.
@@ -100,23 +102,24 @@ struct
     UINT        size;       // Actual number of data items
 } g_hooks;
 
+// Positions in g_hooks.pItems, by target address.
+HOOK_INDEX g_hookIndex;
+
 //-------------------------------------------------------------------------
 // Returns INVALID_HOOK_POS if not found.
 static UINT FindHookEntry(LPVOID pTarget)
 {
-    UINT i;
-    for (i = 0; i < g_hooks.size; ++i)
-    {
-        if ((ULONG_PTR)pTarget == (ULONG_PTR)g_hooks.pItems[i].pTarget)
-            return i;
-    }
-
-    return INVALID_HOOK_POS;
+    return HookIndexFind(&g_hookIndex, pTarget);
 }
 
 //-------------------------------------------------------------------------
-static PHOOK_ENTRY AddHookEntry()
+static PHOOK_ENTRY AddHookEntry(LPVOID pTarget)
 {
+    PHOOK_ENTRY pHook;
+
+    if (!HookIndexReserve(&g_hookIndex, g_hHeap, g_hooks.size + 1))
+        return NULL;
+
     if (g_hooks.pItems == NULL)
     {
         g_hooks.capacity = INITIAL_HOOK_CAPACITY;
@@ -136,14 +139,23 @@ static PHOOK_ENTRY AddHookEntry()
         g_hooks.pItems = p;
     }
 
-    return &g_hooks.pItems[g_hooks.size++];
+    HookIndexInsert(&g_hookIndex, pTarget, g_hooks.size);
+
+    pHook = &g_hooks.pItems[g_hooks.size++];
+    pHook->pTarget = pTarget;
+    return pHook;
 }
 
 //-------------------------------------------------------------------------
 static void DeleteHookEntry(UINT pos)
 {
+    HookIndexRemove(&g_hookIndex, g_hooks.pItems[pos].pTarget);
+
     if (pos < g_hooks.size - 1)
+    {
         g_hooks.pItems[pos] = g_hooks.pItems[g_hooks.size - 1];
+        HookIndexMove(&g_hookIndex, g_hooks.pItems[pos].pTarget, pos);
+    }
 
     g_hooks.size--;
 
@@ -159,6 +171,13 @@ static void DeleteHookEntry(UINT pos)
     }
 }
 
+//-------------------------------------------------------------------------
+// State MH_ApplyQueued() will leave the hook in. Hooks queued for removal are disabled first.
+static BOOL GetQueuedState(PHOOK_ENTRY pHook)
+{
+    return pHook->queueEnable && !pHook->queueRemove;
+}
+
 //-------------------------------------------------------------------------
 static DWORD_PTR FindOldIP(PHOOK_ENTRY pHook, DWORD_PTR ip)
 {
@@ -240,7 +259,7 @@ static void ProcessThreadIPs(HANDLE hThread, UINT pos, UINT action)
             break;
 
         default: // ACTION_APPLY_QUEUED
-            enable = pHook->queueEnable;
+            enable = GetQueuedState(pHook);
             break;
         }
         if (pHook->isEnabled == enable)
@@ -512,6 +531,7 @@ MH_STATUS WINAPI MH_Uninitialize(VOID)
             UninitializeBuffer();
 
             HeapFree(g_hHeap, 0, g_hooks.pItems);
+            HookIndexFree(&g_hookIndex, g_hHeap);
             HeapDestroy(g_hHeap);
 
             g_hHeap = NULL;
@@ -555,10 +575,9 @@ MH_STATUS WINAPI MH_CreateHook(LPVOID pTarget, LPVOID pDetour, LPVOID *ppOrigina
                     ct.pTrampoline = pBuffer;
                     if (CreateTrampolineFunction(&ct))
                     {
-                        PHOOK_ENTRY pHook = AddHookEntry();
+                        PHOOK_ENTRY pHook = AddHookEntry(ct.pTarget);
                         if (pHook != NULL)
                         {
-                            pHook->pTarget     = ct.pTarget;
 #if defined(_M_X64) || defined(__x86_64__)
                             pHook->pDetour     = ct.pRelay;
 #else
@@ -568,6 +587,7 @@ MH_STATUS WINAPI MH_CreateHook(LPVOID pTarget, LPVOID pDetour, LPVOID *ppOrigina
                             pHook->patchAbove  = ct.patchAbove;
                             pHook->isEnabled   = FALSE;
                             pHook->queueEnable = FALSE;
+                            pHook->queueRemove = FALSE;
                             pHook->nIP         = ct.nIP;
                             memcpy(pHook->oldIPs, ct.oldIPs, ARRAYSIZE(ct.oldIPs));
                             memcpy(pHook->newIPs, ct.newIPs, ARRAYSIZE(ct.newIPs));
@@ -745,7 +765,10 @@ static MH_STATUS QueueHook(LPVOID pTarget, BOOL queueEnable)
         {
             UINT i;
             for (i = 0; i < g_hooks.size; ++i)
+            {
                 g_hooks.pItems[i].queueEnable = queueEnable;
+                g_hooks.pItems[i].queueRemove = FALSE;
+            }
         }
         else
         {
@@ -753,6 +776,7 @@ static MH_STATUS QueueHook(LPVOID pTarget, BOOL queueEnable)
             if (pos != INVALID_HOOK_POS)
             {
                 g_hooks.pItems[pos].queueEnable = queueEnable;
+                g_hooks.pItems[pos].queueRemove = FALSE;
             }
             else
             {
@@ -782,11 +806,50 @@ MH_STATUS WINAPI MH_QueueDisableHook(LPVOID pTarget)
     return QueueHook(pTarget, FALSE);
 }
 
+//-------------------------------------------------------------------------
+MH_STATUS WINAPI MH_QueueRemoveHook(LPVOID pTarget)
+{
+    MH_STATUS status = MH_OK;
+
+    EnterSpinLock();
+
+    if (g_hHeap != NULL)
+    {
+        if (pTarget == MH_ALL_HOOKS)
+        {
+            UINT i;
+            for (i = 0; i < g_hooks.size; ++i)
+                g_hooks.pItems[i].queueRemove = TRUE;
+        }
+        else
+        {
+            UINT pos = FindHookEntry(pTarget);
+            if (pos != INVALID_HOOK_POS)
+            {
+                g_hooks.pItems[pos].queueRemove = TRUE;
+            }
+            else
+            {
+                status = MH_ERROR_NOT_CREATED;
+            }
+        }
+    }
+    else
+    {
+        status = MH_ERROR_NOT_INITIALIZED;
+    }
+
+    LeaveSpinLock();
+
+    return status;
+}
+
 //-------------------------------------------------------------------------
 MH_STATUS WINAPI MH_ApplyQueued(VOID)
 {
     MH_STATUS status = MH_OK;
     UINT i, first = INVALID_HOOK_POS;
+    BOOL removeQueued = FALSE;
 
     EnterSpinLock();
 
@@ -794,24 +857,26 @@ MH_STATUS WINAPI MH_ApplyQueued(VOID)
     {
         for (i = 0; i < g_hooks.size; ++i)
         {
-            if (g_hooks.pItems[i].isEnabled != g_hooks.pItems[i].queueEnable)
-            {
+            PHOOK_ENTRY pHook = &g_hooks.pItems[i];
+            if (pHook->queueRemove)
+                removeQueued = TRUE;
+            if (first == INVALID_HOOK_POS && pHook->isEnabled != GetQueuedState(pHook))
                 first = i;
-                break;
-            }
         }
 
         if (first != INVALID_HOOK_POS)
         {
+            // A single freeze and IP fix-up pass for every queued change.
             FROZEN_THREADS threads;
             Freeze(&threads, ALL_HOOKS_POS, ACTION_APPLY_QUEUED);
 
             for (i = first; i < g_hooks.size; ++i)
             {
                 PHOOK_ENTRY pHook = &g_hooks.pItems[i];
-                if (pHook->isEnabled != pHook->queueEnable)
+                BOOL enable = GetQueuedState(pHook);
+                if (pHook->isEnabled != enable)
                 {
-                    status = EnableHookLL(i, pHook->queueEnable);
+                    status = EnableHookLL(i, enable);
                     if (status != MH_OK)
                         break;
                 }
@@ -819,6 +884,21 @@ MH_STATUS WINAPI MH_ApplyQueued(VOID)
 
             Unfreeze(&threads);
         }
+
+        if (removeQueued)
+        {
+            // Backwards, so DeleteHookEntry() only moves entries already visited.
+            // Hooks that failed to disable stay queued.
+            for (i = g_hooks.size; i-- > 0; )
+            {
+                PHOOK_ENTRY pHook = &g_hooks.pItems[i];
+                if (pHook->queueRemove && !pHook->isEnabled)
+                {
+                    FreeBuffer(pHook->pTrampoline);
+                    DeleteHookEntry(i);
+                }
+            }
+        }
     }
     else
     {
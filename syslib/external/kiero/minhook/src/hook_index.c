@@ -0,0 +1,142 @@
+﻿/*
+ *  Hash index of the hook entries, keyed by target address.
+ */
+
+#include <windows.h>
+
+#include "hook_index.h"
+
+// Smallest table, enough for the initial HOOK_ENTRY buffer.
+#define INITIAL_INDEX_BITS 6
+
+//-------------------------------------------------------------------------
+// Fibonacci hashing: the top bits of the product mix all the address bits,
+// including the low ones that function alignment leaves at zero.
+static UINT HashTarget(const HOOK_INDEX *pIndex, LPVOID pTarget)
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    return (UINT)(((ULONG_PTR)pTarget * 0x9E3779B97F4A7C15ULL) >> (64 - pIndex->bits));
+#else
+    return (UINT)(((ULONG_PTR)pTarget * 0x9E3779B9UL) >> (32 - pIndex->bits));
+#endif
+}
+
+//-------------------------------------------------------------------------
+static PHOOK_INDEX_SLOT FindSlot(const HOOK_INDEX *pIndex, LPVOID pTarget)
+{
+    UINT mask = (1u << pIndex->bits) - 1;
+    UINT i    = HashTarget(pIndex, pTarget);
+
+    // Stops at the target or at the empty slot where it would go.
+    while (pIndex->pSlots[i].pTarget != NULL && pIndex->pSlots[i].pTarget != pTarget)
+        i = (i + 1) & mask;
+
+    return &pIndex->pSlots[i];
+}
+
+//-------------------------------------------------------------------------
+// Makes room for 'count' targets. Returns FALSE if out of memory, the index is then unchanged.
+BOOL HookIndexReserve(PHOOK_INDEX pIndex, HANDLE hHeap, UINT count)
+{
+    HOOK_INDEX grown;
+    UINT i;
+
+    if (pIndex->pSlots != NULL && count <= (1u << pIndex->bits) / 2)
+        return TRUE;
+
+    grown.bits = (pIndex->pSlots != NULL) ? pIndex->bits : INITIAL_INDEX_BITS;
+    while (count > (1u << grown.bits) / 2)
+        grown.bits++;
+
+    grown.pSlots = (PHOOK_INDEX_SLOT)HeapAlloc(
+        hHeap, HEAP_ZERO_MEMORY, ((SIZE_T)1 << grown.bits) * sizeof(HOOK_INDEX_SLOT));
+    if (grown.pSlots == NULL)
+        return FALSE;
+
+    grown.size = 0;
+    if (pIndex->pSlots != NULL)
+    {
+        for (i = 0; i < (1u << pIndex->bits); ++i)
+        {
+            if (pIndex->pSlots[i].pTarget != NULL)
+                HookIndexInsert(&grown, pIndex->pSlots[i].pTarget, pIndex->pSlots[i].pos);
+        }
+        HeapFree(hHeap, 0, pIndex->pSlots);
+    }
+
+    *pIndex = grown;
+    return TRUE;
+}
+
+//-------------------------------------------------------------------------
+VOID HookIndexFree(PHOOK_INDEX pIndex, HANDLE hHeap)
+{
+    if (pIndex->pSlots != NULL)
+        HeapFree(hHeap, 0, pIndex->pSlots);
+
+    pIndex->pSlots = NULL;
+    pIndex->bits   = 0;
+    pIndex->size   = 0;
+}
+
+//-------------------------------------------------------------------------
+// Returns HOOK_INDEX_NOT_FOUND if not found.
+UINT HookIndexFind(const HOOK_INDEX *pIndex, LPVOID pTarget)
+{
+    PHOOK_INDEX_SLOT pSlot;
+
+    if (pIndex->pSlots == NULL || pTarget == NULL)
+        return HOOK_INDEX_NOT_FOUND;
+
+    pSlot = FindSlot(pIndex, pTarget);
+    return (pSlot->pTarget != NULL) ? pSlot->pos : HOOK_INDEX_NOT_FOUND;
+}
+
+//-------------------------------------------------------------------------
+// The target must not be indexed yet, and HookIndexReserve() must have made room for it.
+VOID HookIndexInsert(PHOOK_INDEX pIndex, LPVOID pTarget, UINT pos)
+{
+    PHOOK_INDEX_SLOT pSlot = FindSlot(pIndex, pTarget);
+    pSlot->pTarget = pTarget;
+    pSlot->pos     = pos;
+    pIndex->size++;
+}
+
+//-------------------------------------------------------------------------
+// Updates the position of an indexed target, after its entry moved.
+VOID HookIndexMove(PHOOK_INDEX pIndex, LPVOID pTarget, UINT pos)
+{
+    PHOOK_INDEX_SLOT pSlot = FindSlot(pIndex, pTarget);
+    if (pSlot->pTarget != NULL)
+        pSlot->pos = pos;
+}
+
+//-------------------------------------------------------------------------
+VOID HookIndexRemove(PHOOK_INDEX pIndex, LPVOID pTarget)
+{
+    UINT mask, hole, i;
+
+    if (pIndex->pSlots == NULL || pTarget == NULL)
+        return;
+
+    mask = (1u << pIndex->bits) - 1;
+    hole = (UINT)(FindSlot(pIndex, pTarget) - pIndex->pSlots);
+    if (pIndex->pSlots[hole].pTarget == NULL)
+        return;
+
+    // Backward shift deletion: pull back the following slots of the run that
+    // would no longer be reachable from their home slot, so no tombstones are needed.
+    for (i = (hole + 1) & mask; pIndex->pSlots[i].pTarget != NULL; i = (i + 1) & mask)
+    {
+        UINT home = HashTarget(pIndex, pIndex->pSlots[i].pTarget);
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            pIndex->pSlots[hole] = pIndex->pSlots[i];
+            hole = i;
+        }
+    }
+
+    pIndex->pSlots[hole].pTarget = NULL;
+    pIndex->pSlots[hole].pos     = 0;
+    pIndex->size--;
+}
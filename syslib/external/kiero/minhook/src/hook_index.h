@@ -0,0 +1,33 @@
+﻿/*
+ *  Hash index of the hook entries, keyed by target address.
+ *  Uses only the Win32 heap functions, so it builds anywhere they are stubbed.
+ */
+
+#pragma once
+
+#include <windows.h>
+#include <limits.h>
+
+// Returned by HookIndexFind() for a target without an entry.
+#define HOOK_INDEX_NOT_FOUND UINT_MAX
+
+typedef struct _HOOK_INDEX_SLOT
+{
+    LPVOID pTarget;         // NULL if the slot is empty.
+    UINT   pos;             // Position of the entry in g_hooks.pItems.
+} HOOK_INDEX_SLOT, *PHOOK_INDEX_SLOT;
+
+// Open addressing with linear probing, kept at most half full.
+typedef struct _HOOK_INDEX
+{
+    PHOOK_INDEX_SLOT pSlots;    // Data heap
+    UINT             bits;      // log2 of the number of slots
+    UINT             size;      // Number of targets stored
+} HOOK_INDEX, *PHOOK_INDEX;
+
+BOOL HookIndexReserve(PHOOK_INDEX pIndex, HANDLE hHeap, UINT count);
+VOID HookIndexFree(PHOOK_INDEX pIndex, HANDLE hHeap);
+UINT HookIndexFind(const HOOK_INDEX *pIndex, LPVOID pTarget);
+VOID HookIndexInsert(PHOOK_INDEX pIndex, LPVOID pTarget, UINT pos);
+VOID HookIndexMove(PHOOK_INDEX pIndex, LPVOID pTarget, UINT pos);
+VOID HookIndexRemove(PHOOK_INDEX pIndex, LPVOID pTarget);
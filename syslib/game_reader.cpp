@@ -5,6 +5,8 @@
 
 void GameReader::Initialize()
 {
+    PublishSnapshot();
+    
     // Find the game process
     HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     if (hSnapshot != INVALID_HANDLE_VALUE)
@@ -63,6 +65,7 @@ void GameReader::Update()
     UpdatePlayerInfo();
     UpdateMonsters();
     UpdateItems();
+    PublishSnapshot();
 }
 
 PlayerInfo GameReader::GetPlayerInfo() const
@@ -77,7 +80,32 @@ std::vector<MonsterInfo> GameReader::GetNearbyMonsters() const
 
 std::vector<std::string> GameReader::GetItemsOnGround() const
 {
-    return m_items;
+    std::vector<std::string> names;
+    names.reserve(m_items.size());
+    for (const GroundItemInfo& item : m_items)
+        names.push_back(item.name);
+    return names;
+}
+
+std::shared_ptr<const WorldSnapshot> GameReader::GetSnapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
+void GameReader::PublishSnapshot()
+{
+    std::shared_ptr<WorldSnapshot> snapshot = std::make_shared<WorldSnapshot>();
+    snapshot->playerX = m_playerInfo.x;
+    snapshot->playerY = m_playerInfo.y;
+    snapshot->generation = ++m_snapshotGeneration;
+    snapshot->entities.reserve(m_monsters.size() + m_items.size());
+    for (const MonsterInfo& monster : m_monsters)
+        snapshot->entities.push_back({ monster.x, monster.y, WorldSnapshot::Monster });
+    for (const GroundItemInfo& item : m_items)
+        snapshot->entities.push_back({ item.x, item.y, WorldSnapshot::Item });
+    
+    // Readers holding the previous snapshot keep it alive until they drop it
+    std::atomic_store(&m_snapshot, std::shared_ptr<const WorldSnapshot>(std::move(snapshot)));
 }
 
 bool GameReader::IsInGame() const
@@ -215,6 +243,8 @@ void GameReader::UpdateMonsters()
             if (monster.health <= 0)
             {
                 monster.isAlive = false;
+                m_killCount++;
+                m_playerInfo.experience += monster.level * 10;     // Estimate, see PlayerInfo::experienceEstimated
                 MuBot::LogMessage("Monstro eliminado: " + monster.name);
             }
         }
@@ -262,7 +292,10 @@ void GameReader::UpdateItems()
         int itemCount = rand() % 4; // 0-3 items
         for (int i = 0; i < itemCount; ++i)
         {
-            std::string item = itemTypes[rand() % itemTypes.size()];
+            GroundItemInfo item;
+            item.name = itemTypes[rand() % itemTypes.size()];
+            item.x = m_playerInfo.x + (rand() % 40) - 20;
+            item.y = m_playerInfo.y + (rand() % 40) - 20;
             m_items.push_back(item);
         }
         
@@ -1,17 +1,23 @@
 #pragma once
 
 #include <Windows.h>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "world_snapshot.h"
+
 struct PlayerInfo
 {
     std::string name;
     int level = 0;
+    long long experience = 0;
+    bool experienceEstimated = true;    // experience isn't read from the game (no address known): it is counted from kills
     int health = 100;
     int maxHealth = 100;
     int mana = 100;
     int maxMana = 100;
+    int map = 0;
     int x = 0, y = 0;
     bool isValid = false;
 };
@@ -27,6 +33,12 @@ struct MonsterInfo
     float distance = 0.0f;
 };
 
+struct GroundItemInfo
+{
+    std::string name;
+    int x = 0, y = 0;
+};
+
 class GameReader
 {
 public:
@@ -38,9 +50,15 @@ public:
     std::vector<MonsterInfo> GetNearbyMonsters() const;
     std::vector<std::string> GetItemsOnGround() const;
     
+    // Latest snapshot, never null after Initialize(). Lock-free for the reader, safe to call from any thread.
+    std::shared_ptr<const WorldSnapshot> GetSnapshot() const;
+    
     bool IsInGame() const;
     bool IsPlayerAlive() const;
     
+    // Monsters seen dying since Initialize(), for incremental statistics
+    unsigned int GetKillCount() const { return m_killCount; }
+    
     // Memory reading functions
     int ReadInt(DWORD address);
     float ReadFloat(DWORD address);
@@ -50,13 +68,18 @@ private:
     void UpdatePlayerInfo();
     void UpdateMonsters();
     void UpdateItems();
+    void PublishSnapshot();
     
     HANDLE m_processHandle = nullptr;
     DWORD m_processId = 0;
     
     PlayerInfo m_playerInfo;
     std::vector<MonsterInfo> m_monsters;
-    std::vector<std::string> m_items;
+    std::vector<GroundItemInfo> m_items;
+    unsigned int m_killCount = 0;
+    
+    std::shared_ptr<const WorldSnapshot> m_snapshot;    // Only accessed with std::atomic_load/atomic_store
+    unsigned int m_snapshotGeneration = 0;
     
     // Memory addresses (these would be found through reverse engineering)
     static const DWORD PLAYER_BASE_ADDR = 0x00400000;
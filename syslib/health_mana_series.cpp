@@ -0,0 +1,388 @@
+#include "health_mana_series.h"
+
+#include <algorithm>
+
+static void PutVarint(std::vector<unsigned char>& data, int64_t value)
+{
+    // Zigzag, so small negative deltas stay small
+    uint64_t bits = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+    while (bits >= 0x80)
+    {
+        data.push_back((unsigned char)(bits | 0x80));
+        bits >>= 7;
+    }
+    data.push_back((unsigned char)bits);
+}
+
+static int64_t GetVarint(const unsigned char*& p)
+{
+    uint64_t bits = 0;
+    int shift = 0;
+    while (*p & 0x80)
+    {
+        bits |= (uint64_t)(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    bits |= (uint64_t)*p++ << shift;
+    return (int64_t)(bits >> 1) ^ -(int64_t)(bits & 1);
+}
+
+static HealthManaPoint ToPoint(const HealthManaSeries::Sample& sample)
+{
+    HealthManaPoint point;
+    point.time = sample.time;
+    point.healthMin = point.healthMax = point.healthAvg = sample.health;
+    point.manaMin = point.manaMax = point.manaAvg = sample.mana;
+    point.maxHealth = sample.maxHealth;
+    point.maxMana = sample.maxMana;
+    point.sampleCount = 1;
+    return point;
+}
+
+// Block rows: the fields in the order of SAMPLE_FIELDS and POINT_FIELDS
+static void ToRow(const HealthManaSeries::Sample& sample, int64_t* row)
+{
+    row[0] = sample.time;
+    row[1] = sample.health;
+    row[2] = sample.maxHealth;
+    row[3] = sample.mana;
+    row[4] = sample.maxMana;
+}
+
+static HealthManaSeries::Sample ToSample(const int64_t* row)
+{
+    return { row[0], (int)row[1], (int)row[2], (int)row[3], (int)row[4] };
+}
+
+static void ToRow(const HealthManaPoint& point, int64_t* row)
+{
+    row[0] = point.time;
+    row[1] = point.healthMin;
+    row[2] = point.healthMax;
+    row[3] = point.healthAvg;
+    row[4] = point.manaMin;
+    row[5] = point.manaMax;
+    row[6] = point.manaAvg;
+    row[7] = point.maxHealth;
+    row[8] = point.maxMana;
+    row[9] = point.sampleCount;
+}
+
+static HealthManaPoint ToPoint(const int64_t* row)
+{
+    HealthManaPoint point;
+    point.time = row[0];
+    point.healthMin = (int)row[1];
+    point.healthMax = (int)row[2];
+    point.healthAvg = (int)row[3];
+    point.manaMin = (int)row[4];
+    point.manaMax = (int)row[5];
+    point.manaAvg = (int)row[6];
+    point.maxHealth = (int)row[7];
+    point.maxMana = (int)row[8];
+    point.sampleCount = (int)row[9];
+    return point;
+}
+
+template <int FIELDS, int ROWS>
+void HealthManaSeries::DeltaBlock<FIELDS, ROWS>::Append(const int64_t* row)
+{
+    if (count == 0)
+    {
+        firstTime = row[0];
+        for (std::vector<unsigned char>& column : columns)
+            column.reserve(ROWS * 2);
+    }
+
+    for (int f = 0; f < FIELDS; f++)
+    {
+        int64_t delta = row[f] - last[f];
+        if (f == 0 && count > 0)
+        {
+            const int64_t step = delta;
+            delta = step - lastStep;
+            lastStep = step;
+        }
+        PutVarint(columns[f], delta);
+        last[f] = row[f];
+    }
+    count++;
+}
+
+template <int FIELDS, int ROWS>
+template <typename Visitor>
+void HealthManaSeries::DeltaBlock<FIELDS, ROWS>::Decode(Visitor visit) const
+{
+    // One read position per column
+    const unsigned char* p[FIELDS];
+    for (int f = 0; f < FIELDS; f++)
+        p[f] = columns[f].data();
+    int64_t row[FIELDS] = {};
+    int64_t step = 0;
+    for (int n = 0; n < count; n++)
+    {
+        const int64_t timeDelta = GetVarint(p[0]);
+        step = (n > 0) ? step + timeDelta : 0;
+        row[0] += (n > 0) ? step : timeDelta;
+        for (int f = 1; f < FIELDS; f++)
+            row[f] += GetVarint(p[f]);
+        visit((const int64_t*)row);
+    }
+}
+
+template <int FIELDS, int ROWS>
+void HealthManaSeries::DeltaBlock<FIELDS, ROWS>::Seal()
+{
+    for (std::vector<unsigned char>& column : columns)
+        column.shrink_to_fit();
+}
+
+template <int FIELDS, int ROWS>
+size_t HealthManaSeries::DeltaBlock<FIELDS, ROWS>::GetMemoryUsage() const
+{
+    size_t bytes = sizeof(*this);
+    for (const std::vector<unsigned char>& column : columns)
+        bytes += column.capacity();
+    return bytes;
+}
+
+void HealthManaSeries::Add(const Sample& sample)
+{
+    Sample s = sample;
+    if (!m_raw.empty() && s.time < m_raw.back().last[0])
+        s.time = m_raw.back().last[0];      // system_clock went back: keep the series ordered
+
+    if (m_raw.empty() || m_raw.back().IsFull())
+    {
+        if (!m_raw.empty())
+            m_raw.back().Seal();
+        if (m_raw.size() == MAX_RAW_BLOCKS)
+        {
+            m_raw.pop_front();
+            m_rawDropped = true;
+        }
+        m_raw.emplace_back();
+    }
+
+    int64_t row[SAMPLE_FIELDS];
+    ToRow(s, row);
+    m_raw.back().Append(row);
+
+    for (Tier& tier : m_tiers)
+        AddToTier(tier, s);
+    m_sampleCount++;
+}
+
+void HealthManaSeries::Clear()
+{
+    m_raw.clear();
+    m_rawDropped = false;
+    for (Tier& tier : m_tiers)
+    {
+        tier.blocks.clear();
+        tier.bucketCount = 0;
+        tier.open.sampleCount = 0;
+        tier.dropped = false;
+    }
+    m_sampleCount = 0;
+}
+
+bool HealthManaSeries::GetLast(Sample& sample) const
+{
+    if (m_raw.empty())
+        return false;
+    sample = ToSample(m_raw.back().last);
+    return true;
+}
+
+void HealthManaSeries::GetRecentSamples(size_t maxCount, std::vector<Sample>& out) const
+{
+    out.clear();
+
+    // Decode only the newest blocks holding the last 'maxCount' samples
+    size_t first = m_raw.size(), count = 0;
+    while (first > 0 && count < maxCount)
+        count += m_raw[--first].count;
+    for (size_t n = first; n < m_raw.size(); n++)
+        m_raw[n].Decode([&out](const int64_t* row) { out.push_back(ToSample(row)); });
+
+    if (out.size() > maxCount)
+        out.erase(out.begin(), out.end() - maxCount);
+}
+
+void HealthManaSeries::Query(int64_t from, int64_t to, size_t maxPoints, std::vector<HealthManaPoint>& out) const
+{
+    out.clear();
+    if (maxPoints == 0 || from >= to)
+        return;
+
+    const size_t maxSourcePoints = maxPoints * MAX_MERGED_POINTS;
+
+    // Raw samples, if still retained for the whole range and few enough. Block counts bound the samples in range
+    size_t rawCount = 0;
+    for (const RawBlock& block : m_raw)
+    {
+        if (block.last[0] >= from && block.firstTime < to)
+            rawCount += block.count;
+    }
+    if (RawCovers(from) && rawCount <= maxSourcePoints)
+    {
+        for (const RawBlock& block : m_raw)
+        {
+            if (block.last[0] >= from && block.firstTime < to)
+            {
+                block.Decode([&](const int64_t* row) {
+                    if (row[0] >= from && row[0] < to)
+                        out.push_back(ToPoint(ToSample(row)));
+                });
+            }
+        }
+    }
+    else
+    {
+        // Finest tier holding the range start with few enough buckets, else the coarsest one. The buckets in range are
+        // bounded without decoding: at most one per bucket width, and at most those of the blocks overlapping the range
+        const Tier* source = nullptr;
+        int64_t start = 0;
+        size_t begin = 0, end = 0;
+        for (int t = 0; t < TIER_COUNT; t++)
+        {
+            const Tier& tier = m_tiers[t];
+            start = from - tier.width + 1;      // Buckets starting from here overlap the range
+            auto first = std::lower_bound(tier.blocks.begin(), tier.blocks.end(), start,
+                [](const BucketBlock& block, int64_t time) { return block.last[0] < time; });
+            auto last = std::lower_bound(first, tier.blocks.end(), to,
+                [](const BucketBlock& block, int64_t time) { return block.firstTime < time; });
+            size_t bucketCount = 0;
+            for (auto block = first; block != last && bucketCount <= maxSourcePoints; ++block)
+                bucketCount += block->count;
+            bucketCount = std::min(bucketCount, (size_t)((to - start + tier.width - 1) / tier.width));
+            if (t == TIER_COUNT - 1 || (TierCovers(tier, from) && bucketCount + 1 <= maxSourcePoints))
+            {
+                source = &tier;
+                begin = first - tier.blocks.begin();
+                end = last - tier.blocks.begin();
+                break;
+            }
+        }
+
+        for (size_t n = begin; n < end; n++)
+        {
+            source->blocks[n].Decode([&](const int64_t* row) {
+                if (row[0] >= start && row[0] < to)
+                    out.push_back(ToPoint(row));
+            });
+        }
+        if (source->open.sampleCount > 0 && source->open.time < to && source->open.time + source->width > from)
+            out.push_back(CloseBucket(*source));
+    }
+
+    if (out.size() <= maxPoints)
+        return;
+
+    // Merge runs of adjacent points, keeping the extremes and the sample-weighted average
+    const size_t groupSize = (out.size() + maxPoints - 1) / maxPoints;
+    size_t merged = 0;
+    for (size_t start = 0; start < out.size(); start += groupSize)
+    {
+        HealthManaPoint point = out[start];
+        int64_t healthSum = (int64_t)point.healthAvg * point.sampleCount;
+        int64_t manaSum = (int64_t)point.manaAvg * point.sampleCount;
+        const size_t stop = std::min(start + groupSize, out.size());
+        for (size_t n = start + 1; n < stop; n++)
+        {
+            const HealthManaPoint& other = out[n];
+            point.healthMin = std::min(point.healthMin, other.healthMin);
+            point.healthMax = std::max(point.healthMax, other.healthMax);
+            point.manaMin = std::min(point.manaMin, other.manaMin);
+            point.manaMax = std::max(point.manaMax, other.manaMax);
+            point.maxHealth = other.maxHealth;
+            point.maxMana = other.maxMana;
+            point.sampleCount += other.sampleCount;
+            healthSum += (int64_t)other.healthAvg * other.sampleCount;
+            manaSum += (int64_t)other.manaAvg * other.sampleCount;
+        }
+        point.healthAvg = (int)(healthSum / point.sampleCount);
+        point.manaAvg = (int)(manaSum / point.sampleCount);
+        out[merged++] = point;
+    }
+    out.resize(merged);
+}
+
+size_t HealthManaSeries::GetMemoryUsage() const
+{
+    size_t bytes = sizeof(*this);
+    for (const RawBlock& block : m_raw)
+        bytes += block.GetMemoryUsage();
+    for (const Tier& tier : m_tiers)
+    {
+        for (const BucketBlock& block : tier.blocks)
+            bytes += block.GetMemoryUsage();
+    }
+    return bytes;
+}
+
+void HealthManaSeries::AddToTier(Tier& tier, const Sample& sample)
+{
+    const int64_t start = sample.time - ((sample.time % tier.width) + tier.width) % tier.width;
+    HealthManaPoint& open = tier.open;
+
+    if (open.sampleCount > 0 && open.time != start)
+    {
+        if (tier.blocks.empty() || tier.blocks.back().IsFull())
+        {
+            if (!tier.blocks.empty())
+                tier.blocks.back().Seal();
+            tier.blocks.emplace_back();
+        }
+        int64_t row[POINT_FIELDS];
+        ToRow(CloseBucket(tier), row);
+        tier.blocks.back().Append(row);
+        tier.bucketCount++;
+
+        while (tier.bucketCount - tier.blocks.front().count >= tier.maxBuckets)
+        {
+            tier.bucketCount -= tier.blocks.front().count;
+            tier.blocks.pop_front();
+            tier.dropped = true;
+        }
+        open.sampleCount = 0;
+    }
+
+    if (open.sampleCount == 0)
+    {
+        open = ToPoint(sample);
+        open.time = start;
+        tier.healthSum = sample.health;
+        tier.manaSum = sample.mana;
+        return;
+    }
+
+    open.healthMin = std::min(open.healthMin, sample.health);
+    open.healthMax = std::max(open.healthMax, sample.health);
+    open.manaMin = std::min(open.manaMin, sample.mana);
+    open.manaMax = std::max(open.manaMax, sample.mana);
+    open.maxHealth = sample.maxHealth;
+    open.maxMana = sample.maxMana;
+    open.sampleCount++;
+    tier.healthSum += sample.health;
+    tier.manaSum += sample.mana;
+}
+
+HealthManaPoint HealthManaSeries::CloseBucket(const Tier& tier)
+{
+    HealthManaPoint point = tier.open;
+    point.healthAvg = (int)(tier.healthSum / point.sampleCount);
+    point.manaAvg = (int)(tier.manaSum / point.sampleCount);
+    return point;
+}
+
+bool HealthManaSeries::RawCovers(int64_t from) const
+{
+    return !m_rawDropped || (!m_raw.empty() && m_raw.front().firstTime <= from);
+}
+
+bool HealthManaSeries::TierCovers(const Tier& tier, int64_t from) const
+{
+    return !tier.dropped || (!tier.blocks.empty() && tier.blocks.front().firstTime <= from);
+}
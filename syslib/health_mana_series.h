@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// A point of a health/mana series: one raw sample, or the min/max/average of the samples of a time bucket
+struct HealthManaPoint
+{
+    int64_t time;               // ms since the system_clock epoch, start of the bucket
+    int healthMin, healthMax, healthAvg;
+    int manaMin, manaMax, manaAvg;
+    int maxHealth, maxMana;     // Last seen in the bucket
+    int sampleCount;
+};
+
+// Health/mana time series, stored column by column. Raw samples are kept in blocks of BLOCK_SAMPLES where each field is
+// its own stream of zigzag varint deltas (the time as delta-of-deltas), so a sample takes a few bytes instead of a full
+// struct. Every sample also feeds 1 s, 1 min and 1 h min/max/avg tiers, whose closed buckets are stored the same way in
+// blocks of TIER_BLOCK_BUCKETS, so a multi-day session keeps its whole history in under a MB. Add() and the tier updates
+// are O(1).
+class HealthManaSeries
+{
+public:
+    struct Sample
+    {
+        int64_t time;           // ms since the system_clock epoch
+        int health, maxHealth;
+        int mana, maxMana;
+    };
+
+    // Samples must come in time order
+    void Add(const Sample& sample);
+    void Clear();
+
+    bool GetLast(Sample& sample) const;
+    // Up to 'maxCount' of the most recent raw samples still retained, oldest first
+    void GetRecentSamples(size_t maxCount, std::vector<Sample>& out) const;
+
+    // At most 'maxPoints' points covering [from, to), oldest first: raw samples when there are few enough, otherwise the finest
+    // tier still holding 'from', with adjacent buckets merged down to 'maxPoints'
+    void Query(int64_t from, int64_t to, size_t maxPoints, std::vector<HealthManaPoint>& out) const;
+
+    int64_t GetSampleCount() const { return m_sampleCount; }
+    size_t GetMemoryUsage() const;
+
+private:
+    // Up to ROWS rows of FIELDS values stored column by column: columns[f] holds field f of every row as zigzag varint
+    // deltas from the previous row. Field 0 is the time, stored as the change of its delta, as rows come at a near-constant rate.
+    template <int FIELDS, int ROWS>
+    struct DeltaBlock
+    {
+        int64_t firstTime = 0;
+        int64_t last[FIELDS] = {};      // Last row, base of the next deltas. last[0] is the last time
+        int64_t lastStep = 0;           // Last time delta
+        int count = 0;
+        std::vector<unsigned char> columns[FIELDS];
+
+        bool IsFull() const { return count == ROWS; }
+        void Append(const int64_t* row);
+        template <typename Visitor>
+        void Decode(Visitor visit) const;          // visit(const int64_t* row) for each row, oldest first
+        void Seal();                    // Block full: drops the spare capacity
+        size_t GetMemoryUsage() const;
+    };
+
+    static const int SAMPLE_FIELDS = 5;     // time, health, maxHealth, mana, maxMana
+    static const int POINT_FIELDS = 10;     // time, health min/max/avg, mana min/max/avg, maxHealth, maxMana, sampleCount
+    static const int BLOCK_SAMPLES = 256;
+    static const int TIER_BLOCK_BUCKETS = 64;
+    typedef DeltaBlock<SAMPLE_FIELDS, BLOCK_SAMPLES> RawBlock;
+    typedef DeltaBlock<POINT_FIELDS, TIER_BLOCK_BUCKETS> BucketBlock;
+
+    struct Tier
+    {
+        Tier(int64_t width, size_t maxBuckets) : width(width), maxBuckets(maxBuckets) {}
+
+        int64_t width;                  // Bucket length, ms
+        size_t maxBuckets;              // Oldest blocks are dropped while the others still hold this many buckets
+        std::deque<BucketBlock> blocks;
+        size_t bucketCount = 0;
+        HealthManaPoint open = {};      // Bucket being filled, valid when open.sampleCount > 0
+        int64_t healthSum = 0;
+        int64_t manaSum = 0;
+        bool dropped = false;           // Buckets were dropped: the tier no longer starts with the session
+    };
+
+    static const size_t MAX_RAW_BLOCKS = 256;          // 65536 samples
+    static const int TIER_COUNT = 3;
+    static const size_t MAX_MERGED_POINTS = 16;         // A tier is used if at most maxPoints * this buckets must be merged
+
+    static void AddToTier(Tier& tier, const Sample& sample);
+    static HealthManaPoint CloseBucket(const Tier& tier);
+
+    bool RawCovers(int64_t from) const;
+    bool TierCovers(const Tier& tier, int64_t from) const;
+
+    std::deque<RawBlock> m_raw;
+    bool m_rawDropped = false;
+    Tier m_tiers[TIER_COUNT] = {
+        { 1000, 6 * 3600 },                 // 1 s for 6 hours
+        { 60 * 1000, 7 * 24 * 60 },         // 1 min for a week
+        { 3600 * 1000, 365 * 24 },          // 1 h for a year
+    };
+    int64_t m_sampleCount = 0;
+};
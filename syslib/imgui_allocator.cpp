@@ -0,0 +1,233 @@
+#include "imgui_allocator.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+#include <cstdarg>
+#include <cstdio>
+
+#include "external/imgui/imgui.h"
+
+// Written before every block, so MemFree() knows where the block came from. 16 bytes keeps the heap alignment.
+union BlockHeader
+{
+    struct
+    {
+        size_t size;        // Requested size
+        int pool;           // Size class, or -1 for a heap block
+    } info;
+    char padding[16];
+};
+static_assert(sizeof(BlockHeader) == 16, "BlockHeader must keep 16 bytes alignment");
+
+ImGuiAllocator::ImGuiAllocator()
+{
+#ifdef _WIN32
+    m_heap = HeapCreate(0, 0, 0);
+#endif
+
+    // Smallest size class (16 << pool bytes) holding the size
+    int pool = 0;
+    for (size_t n = 0; n <= MAX_POOLED_SIZE / 16; n++)
+    {
+        while (((size_t)16 << pool) < n * 16)
+            pool++;
+        m_poolFromSize[n] = (unsigned char)pool;
+    }
+}
+
+ImGuiAllocator::~ImGuiAllocator()
+{
+    // Releases slabs, arena chunks and heap blocks at once
+#ifdef _WIN32
+    if (m_heap)
+    {
+        HeapDestroy(m_heap);
+        return;
+    }
+#endif
+    // From the process heap: slabs aren't listed and stay until exit, as pooled blocks may still be in use
+    for (char* chunk : m_arenaChunks)
+        free(chunk);
+}
+
+void ImGuiAllocator::Install()
+{
+    ImGui::SetAllocatorFunctions(MemAlloc, MemFree, this);
+}
+
+void* ImGuiAllocator::MemAlloc(size_t size, void* userData)
+{
+    return static_cast<ImGuiAllocator*>(userData)->Alloc(size);
+}
+
+void ImGuiAllocator::MemFree(void* ptr, void* userData)
+{
+    static_cast<ImGuiAllocator*>(userData)->Free(ptr);
+}
+
+void* ImGuiAllocator::HeapAllocate(size_t size)
+{
+    // Fall back to the process heap if the private heap couldn't be created, or off Windows (tools)
+#ifdef _WIN32
+    if (m_heap)
+        return HeapAlloc(m_heap, 0, size);
+#endif
+    return malloc(size);
+}
+
+void* ImGuiAllocator::Alloc(size_t size)
+{
+    BlockHeader* header = nullptr;
+    int pool = -1;
+    if (size <= MAX_POOLED_SIZE)
+    {
+        pool = m_poolFromSize[(size + 15) / 16];
+        const size_t blockSize = sizeof(BlockHeader) + ((size_t)16 << pool);
+        Pool& p = m_pools[pool];
+        std::lock_guard<std::mutex> lock(p.mutex);
+        if (p.freeList != nullptr)
+        {
+            header = static_cast<BlockHeader*>(p.freeList);
+            p.freeList = *reinterpret_cast<void**>(header + 1);
+        }
+        else
+        {
+            // Slabs are never returned: pools keep the peak usage of each size class
+            if (p.slabCursor + blockSize > p.slabEnd)
+            {
+                char* slab = static_cast<char*>(HeapAllocate(SLAB_SIZE));
+                if (slab == nullptr)
+                    return nullptr;
+                p.slabCursor = slab;
+                p.slabEnd = slab + SLAB_SIZE;
+            }
+            header = reinterpret_cast<BlockHeader*>(p.slabCursor);
+            p.slabCursor += blockSize;
+        }
+        p.counters.allocCount++;
+        p.counters.allocBytes += size;
+        p.counters.liveBytes += size;
+    }
+    else
+    {
+        header = static_cast<BlockHeader*>(HeapAllocate(sizeof(BlockHeader) + size));
+        if (header == nullptr)
+            return nullptr;
+        std::lock_guard<std::mutex> heapLock(m_heapMutex);
+        m_heapCounters.allocCount++;
+        m_heapCounters.allocBytes += size;
+        m_heapCounters.liveBytes += size;
+    }
+    header->info.size = size;
+    header->info.pool = pool;
+    return header + 1;
+}
+
+void ImGuiAllocator::Free(void* ptr)
+{
+    if (ptr == nullptr)
+        return;
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    const int pool = header->info.pool;
+    if (pool < 0)
+    {
+        {
+            std::lock_guard<std::mutex> heapLock(m_heapMutex);
+            m_heapCounters.freeCount++;
+            m_heapCounters.liveBytes -= header->info.size;
+        }
+#ifdef _WIN32
+        if (m_heap)
+        {
+            HeapFree(m_heap, 0, header);
+            return;
+        }
+#endif
+        free(header);
+        return;
+    }
+    Pool& p = m_pools[pool];
+    std::lock_guard<std::mutex> lock(p.mutex);
+    p.counters.freeCount++;
+    p.counters.liveBytes -= header->info.size;
+    *reinterpret_cast<void**>(header + 1) = p.freeList;
+    p.freeList = header;
+}
+
+void ImGuiAllocator::NewFrame()
+{
+    FrameStats& stats = m_lastFrame;
+    stats.allocCount = stats.freeCount = stats.pooledAllocCount = 0;
+    stats.allocBytes = stats.liveBytes = 0;
+    for (Pool& p : m_pools)
+    {
+        std::lock_guard<std::mutex> lock(p.mutex);
+        stats.allocCount += p.counters.allocCount;
+        stats.freeCount += p.counters.freeCount;
+        stats.allocBytes += p.counters.allocBytes;
+        stats.liveBytes += p.counters.liveBytes;
+        p.counters.allocCount = p.counters.freeCount = 0;
+        p.counters.allocBytes = 0;
+    }
+    stats.pooledAllocCount = stats.allocCount;
+    {
+        std::lock_guard<std::mutex> heapLock(m_heapMutex);
+        stats.allocCount += m_heapCounters.allocCount;
+        stats.freeCount += m_heapCounters.freeCount;
+        stats.allocBytes += m_heapCounters.allocBytes;
+        stats.liveBytes += m_heapCounters.liveBytes;
+        m_heapCounters.allocCount = m_heapCounters.freeCount = 0;
+        m_heapCounters.allocBytes = 0;
+    }
+    if (stats.liveBytes > stats.peakLiveBytes)
+        stats.peakLiveBytes = stats.liveBytes;
+    stats.arenaBytes = m_arenaBytes;
+    if (m_arenaBytes > stats.arenaPeakBytes)
+        stats.arenaPeakBytes = m_arenaBytes;
+
+    // Chunks are kept, so after the first frames the arena doesn't allocate anymore
+    m_arenaChunk = 0;
+    m_arenaOffset = 0;
+    m_arenaBytes = 0;
+}
+
+void* ImGuiAllocator::FrameAlloc(size_t size)
+{
+    size = (size + 15) & ~(size_t)15;
+    while (m_arenaChunk < (int)m_arenaChunks.size() && m_arenaOffset + size > m_arenaChunkSizes[m_arenaChunk])
+    {
+        m_arenaChunk++;
+        m_arenaOffset = 0;
+    }
+    if (m_arenaChunk == (int)m_arenaChunks.size())
+    {
+        const size_t chunkSize = size > ARENA_CHUNK_SIZE ? size : ARENA_CHUNK_SIZE;
+        char* chunk = static_cast<char*>(HeapAllocate(chunkSize));
+        if (chunk == nullptr)
+            return nullptr;
+        m_arenaChunks.push_back(chunk);
+        m_arenaChunkSizes.push_back(chunkSize);
+    }
+    char* ptr = m_arenaChunks[m_arenaChunk] + m_arenaOffset;
+    m_arenaOffset += size;
+    m_arenaBytes += size;
+    return ptr;
+}
+
+const char* ImGuiAllocator::FrameFormat(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    const int length = vsnprintf(nullptr, 0, fmt, argsCopy);
+    va_end(argsCopy);
+    char* buffer = length >= 0 ? static_cast<char*>(FrameAlloc((size_t)length + 1)) : nullptr;
+    if (buffer != nullptr)
+        vsnprintf(buffer, (size_t)length + 1, fmt, args);
+    va_end(args);
+    return buffer != nullptr ? buffer : "";
+}
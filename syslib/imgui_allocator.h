@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Memory for ImGui, registered with ImGui::SetAllocatorFunctions() before the context is created.
+// Blocks up to MAX_POOLED_SIZE come from size-class pools, larger ones from a private heap, so ImGui never
+// contends with the game client on the process heap. Also owns a per-frame bump arena for transient data.
+// Pools may be used from any thread. The frame arena and NewFrame() are render thread only.
+class ImGuiAllocator
+{
+public:
+    struct FrameStats
+    {
+        int allocCount = 0;             // MemAlloc() calls during the frame
+        int freeCount = 0;
+        int pooledAllocCount = 0;       // Of allocCount, served by a size-class pool
+        size_t allocBytes = 0;
+        size_t liveBytes = 0;           // Allocated and not freed, at the end of the frame
+        size_t peakLiveBytes = 0;       // High-water mark of liveBytes at frame boundaries since Install()
+        size_t arenaBytes = 0;          // Frame arena usage during the frame
+        size_t arenaPeakBytes = 0;      // High-water mark of arenaBytes since Install()
+    };
+
+    ImGuiAllocator();
+    ~ImGuiAllocator();
+
+    void Install();             // Call before ImGui::CreateContext(), the allocator must outlive the context
+    void NewFrame();            // Call before ImGui::NewFrame(): closes the stats of the previous frame and resets the arena
+
+    const FrameStats& GetLastFrameStats() const { return m_lastFrame; }
+
+    // Transient memory, valid until the next NewFrame()
+    void* FrameAlloc(size_t size);
+    const char* FrameFormat(const char* fmt, ...);
+
+private:
+    // Counters are updated under the lock of the pool (or of the heap) that served the block, and summed by NewFrame()
+    struct Counters
+    {
+        int allocCount = 0;
+        int freeCount = 0;
+        size_t allocBytes = 0;
+        size_t liveBytes = 0;
+    };
+
+    struct Pool
+    {
+        std::mutex mutex;
+        void* freeList = nullptr;
+        char* slabCursor = nullptr;     // Blocks not handed out yet in the current slab
+        char* slabEnd = nullptr;
+        Counters counters;
+    };
+
+    static void* MemAlloc(size_t size, void* userData);
+    static void MemFree(void* ptr, void* userData);
+    void* Alloc(size_t size);
+    void Free(void* ptr);
+    void* HeapAllocate(size_t size);
+
+    static const int POOL_COUNT = 9;                    // Size classes 16, 32, ..., 4096 bytes
+    static const size_t MAX_POOLED_SIZE = 4096;
+    static const size_t SLAB_SIZE = 64 * 1024;
+    static const size_t ARENA_CHUNK_SIZE = 64 * 1024;
+
+    void* m_heap = nullptr;
+    Pool m_pools[POOL_COUNT];
+    unsigned char m_poolFromSize[MAX_POOLED_SIZE / 16 + 1];    // Indexed by (size + 15) / 16
+    std::mutex m_heapMutex;
+    Counters m_heapCounters;                // Blocks larger than MAX_POOLED_SIZE
+
+    std::vector<char*> m_arenaChunks;       // Each ARENA_CHUNK_SIZE, or more for a single large FrameAlloc()
+    std::vector<size_t> m_arenaChunkSizes;
+    int m_arenaChunk = 0;
+    size_t m_arenaOffset = 0;
+    size_t m_arenaBytes = 0;
+
+    FrameStats m_lastFrame;
+};
@@ -1,4 +1,12 @@
 #include "imgui_hook.h"
+#include "settings_writer.h"
+#include "imgui_allocator.h"
+#include "worker_draw_lists.h"
+#include "draw_data_recorder.h"
+#include "input_queue.h"
+#include "key_bindings.h"
+
+#include <mutex>
 
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
@@ -6,6 +14,7 @@
 
 #include "external/kiero/kiero.h"
 #include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
 #include "external/imgui/imgui_impl_win32.h"
 #include "external/imgui/imgui_impl_opengl2.h"
 
@@ -15,6 +24,10 @@ extern LRESULT ImGui_ImplWin32_WndProcHandler(
     WPARAM wParam, 
     LPARAM lParam);
 
+extern ImGuiKey ImGui_ImplWin32_KeyEventToImGuiKey(
+    WPARAM wParam,
+    LPARAM lParam);
+
 namespace ImGuiHook 
 {
     typedef BOOL(__stdcall* wglSwapBuffers_t) (HDC hDc);
@@ -34,6 +47,10 @@ namespace ImGuiHook
     static bool	 g_initImGui  = false;
     static HWND  g_hWnd       = nullptr;
 
+    // Held for a whole frame, so Unload() can wait for the frame in progress. No frame is rendered once g_isUnloading is set.
+    static std::mutex g_renderMutex;
+    static bool       g_isUnloading = false;
+
     // Render function variables
     static std::function<void()> g_renderMain = []() {};
     static std::function<void()> g_extraInit  = []() {};
@@ -41,6 +58,114 @@ namespace ImGuiHook
     // Last error status
     static std::string g_lastError;
 
+    // .ini settings are serialized on the render thread and written to disk by g_settingsWriter
+    static SettingsWriter g_settingsWriter;
+
+    // ImGui memory: pools on a private heap, plus a per-frame arena
+    static ImGuiAllocator g_allocator;
+
+    // Custom layers built on worker threads, merged into the draw data after ImGui::Render()
+    static WorkerDrawLists g_workerDrawLists;
+
+    // Optional capture of every frame's draw data, replayed offline by tools/draw_replay
+    static DrawDataRecorder g_drawDataRecorder;
+
+    // Keyboard, character and focus messages, queued by the WndProc hook and dispatched once per frame to bot hotkeys and ImGui
+    static InputQueue g_inputQueue;
+    static KeyBindings g_keyBindings;
+
+    static void QueueKeyEvent(WPARAM vk, LPARAM lParam, bool down)
+    {
+        // Resolve left/right modifiers, which the message only reports through the scancode and extended flag
+        const UINT scancode = (lParam >> 16) & 0xFF;
+        const bool extended = (HIWORD(lParam) & KF_EXTENDED) != 0;
+        if (vk == VK_SHIFT)
+            vk = MapVirtualKeyW(scancode, MAPVK_VSC_TO_VK_EX);
+        else if (vk == VK_CONTROL)
+            vk = extended ? VK_RCONTROL : VK_LCONTROL;
+        else if (vk == VK_MENU)
+            vk = extended ? VK_RMENU : VK_LMENU;
+
+        InputEvent event;
+        event.type = InputEvent::Key;
+        event.down = down;
+        event.repeat = down && (lParam & (1 << 30)) != 0;
+        event.virtualKey = (unsigned char)vk;
+        event.key = ImGui_ImplWin32_KeyEventToImGuiKey(vk, lParam);
+
+        // Windows sends no key down for Print Screen
+        if (event.key == ImGuiKey_PrintScreen && !down)
+        {
+            InputEvent press = event;
+            press.down = true;
+            g_inputQueue.Push(press);
+        }
+        g_inputQueue.Push(event);
+    }
+
+    static void QueueCharEvent(unsigned int character, bool utf16)
+    {
+        InputEvent event;
+        event.type = InputEvent::Char;
+        event.utf16 = utf16;
+        event.character = character;
+        g_inputQueue.Push(event);
+    }
+
+    // ANSI code page of the keyboard layout, for WM_CHAR in non-Unicode windows (as the ImGui Win32 backend)
+    static UINT GetKeyboardCodePage()
+    {
+        const LCID keyboardLcid = MAKELCID(HIWORD(GetKeyboardLayout(0)), SORT_DEFAULT);
+        UINT codePage = CP_ACP;
+        if (GetLocaleInfoA(keyboardLcid, LOCALE_RETURN_NUMBER | LOCALE_IDEFAULTANSICODEPAGE, (LPSTR)&codePage, sizeof(codePage)) == 0)
+            codePage = CP_ACP;
+        return codePage;
+    }
+
+    // Returns true if the message was queued, instead of being handled by the ImGui Win32 backend
+    static bool QueueInputMessage(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+    {
+        switch (uMsg)
+        {
+        case WM_KEYDOWN:
+        case WM_SYSKEYDOWN:
+        case WM_KEYUP:
+        case WM_SYSKEYUP:
+            if (wParam < 256)
+                QueueKeyEvent(wParam, lParam, uMsg == WM_KEYDOWN || uMsg == WM_SYSKEYDOWN);
+            return true;
+        case WM_CHAR:
+            // Queued with the keys, so text typed between two frames keeps its order relative to them
+            if (IsWindowUnicode(hWnd))
+            {
+                if (wParam > 0 && wParam < 0x10000)
+                    QueueCharEvent((unsigned int)wParam, true);     // Surrogate pairs come as two messages
+            }
+            else
+            {
+                wchar_t wch = 0;
+                if (MultiByteToWideChar(GetKeyboardCodePage(), MB_PRECOMPOSED, (char*)&wParam, 1, &wch, 1) == 1)
+                    QueueCharEvent(wch, true);
+            }
+            return true;
+        case WM_UNICHAR:
+            // UNICODE_NOCHAR only asks whether the window takes WM_UNICHAR, answered by ImGui_WndProc
+            if (wParam != UNICODE_NOCHAR)
+                QueueCharEvent((unsigned int)wParam, false);
+            return true;
+        case WM_SETFOCUS:
+        case WM_KILLFOCUS:
+        {
+            InputEvent event;
+            event.type = InputEvent::Focus;
+            event.down = uMsg == WM_SETFOCUS;
+            g_inputQueue.Push(event);
+            return true;
+        }
+        }
+        return false;
+    }
+
     // WndProc callback ImGui handler
     static LRESULT CALLBACK ImGui_WndProc(
         const HWND	hWnd, 
@@ -48,6 +173,11 @@ namespace ImGuiHook
         WPARAM		wParam, 
         LPARAM		lParam)
     {
+        if (g_initImGui && uMsg == WM_UNICHAR && wParam == UNICODE_NOCHAR)
+            return TRUE;
+        if (g_initImGui && QueueInputMessage(hWnd, uMsg, wParam, lParam))
+            return CallWindowProc(g_WndProc_o, hWnd, uMsg, wParam, lParam);
+
         if (ImGui_ImplWin32_WndProcHandler(hWnd, uMsg, wParam, lParam)) 
             return true;
 
@@ -102,6 +232,7 @@ namespace ImGuiHook
         }
 
         IMGUI_CHECKVERSION();
+        g_allocator.Install();
         if (!ImGui::CreateContext())
         {
             g_lastError = "Failed to create ImGui context";
@@ -111,8 +242,18 @@ namespace ImGuiHook
         if (!InitPlatform())
             return false;
 
+        // Take over .ini saving from NewFrame(), which would write the file on this thread
+        ImGuiIO& io = ImGui::GetIO();
+        ImGui::LoadIniSettingsFromDisk(io.IniFilename);
+        g_settingsWriter.Start(io.IniFilename);
+        io.IniFilename = nullptr;
+        io.ConfigIniSaveIncremental = true;
+
         g_extraInit();
 
+        // After the fonts are set up: workers only draw text from a static atlas
+        g_workerDrawLists.Start(0);
+
         g_initImGui = true;
 
         return true;
@@ -133,14 +274,27 @@ namespace ImGuiHook
             return false;
         }
 
+        g_allocator.NewFrame();
         ImGui_ImplOpenGL2_NewFrame();
         ImGui_ImplWin32_NewFrame();
+        g_keyBindings.Dispatch(g_inputQueue, ImGui::GetIO());
         ImGui::NewFrame();
         g_renderMain();
         ImGui::EndFrame();
         ImGui::Render();
+        g_workerDrawLists.EndFrame(ImGui::GetDrawData());
+        g_drawDataRecorder.Record(ImGui::GetDrawData());
         ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
 
+        ImGuiIO& io = ImGui::GetIO();
+        if (io.WantSaveIniSettings)
+        {
+            size_t iniSize = 0;
+            const char* iniData = ImGui::SaveIniSettingsToMemory(&iniSize);
+            g_settingsWriter.Submit(iniData, iniSize);
+            io.WantSaveIniSettings = false;
+        }
+
         if (!wglMakeCurrent(hDc, o_WglContext))
         {
             g_lastError = "Failed to make original OpenGL context current";
@@ -153,8 +307,14 @@ namespace ImGuiHook
     // Hooked wglSwapBuffers function
     static BOOL WINAPI wglSwapBuffers_h(const HDC hDc)
     {
-        Init_ImGui_OpenGL2(hDc);
-        Render_ImGui(hDc);
+        {
+            std::lock_guard<std::mutex> lock(g_renderMutex);
+            if (!g_isUnloading)
+            {
+                Init_ImGui_OpenGL2(hDc);
+                Render_ImGui(hDc);
+            }
+        }
         return g_wglSwapBuffers_o(hDc);
     }
 
@@ -179,6 +339,26 @@ namespace ImGuiHook
         return g_lastError;
     }
 
+    ImGuiAllocator& GetAllocator()
+    {
+        return g_allocator;
+    }
+
+    WorkerDrawLists& GetWorkerDrawLists()
+    {
+        return g_workerDrawLists;
+    }
+
+    DrawDataRecorder& GetDrawDataRecorder()
+    {
+        return g_drawDataRecorder;
+    }
+
+    KeyBindings& GetKeyBindings()
+    {
+        return g_keyBindings;
+    }
+
     // Main load function
     bool Load(const std::function<void()>& render, const std::function<void()>& init)
     {
@@ -187,11 +367,44 @@ namespace ImGuiHook
         return InitHook();
     }
 
+    // Settings changed less than io.IniSavingRate ago are only marked dirty: hands them to the writer. Under g_renderMutex
+    static void SubmitDirtySettings()
+    {
+        if (!g_initImGui)
+            return;
+        ImGuiContext& g = *ImGui::GetCurrentContext();
+        if (g.SettingsDirtyTimer > 0.0f || g.IO.WantSaveIniSettings)
+        {
+            size_t iniSize = 0;
+            const char* iniData = ImGui::SaveIniSettingsToMemory(&iniSize);
+            g_settingsWriter.Submit(iniData, iniSize);
+            g.IO.WantSaveIniSettings = false;
+        }
+    }
+
     // Main unload function
     void Unload()
     {
         kiero::shutdown();
+        {
+            std::lock_guard<std::mutex> lock(g_renderMutex);
+            g_isUnloading = true;
+            if (g_WndProc_o)
+                SetWindowLongPtr(g_hWnd, GWLP_WNDPROC, (LONG_PTR)g_WndProc_o);
+            SubmitDirtySettings();
+        }
+        g_settingsWriter.Stop();
+        g_workerDrawLists.Stop();
+        g_drawDataRecorder.Stop();
     }
-}
-
 
+    void FlushSettings()
+    {
+        // A thread killed by the exiting process may hold the lock, mid-frame: then ImGui's state can't be trusted
+        std::unique_lock<std::mutex> lock(g_renderMutex, std::try_to_lock);
+        if (!lock.owns_lock() || g_isUnloading)
+            return;
+        SubmitDirtySettings();
+        g_settingsWriter.Flush();
+    }
+}
@@ -27,6 +27,10 @@
 #include <functional> 
 #include <string>
 
+class ImGuiAllocator;
+class WorkerDrawLists;
+class DrawDataRecorder;
+class KeyBindings;
 
 namespace ImGuiHook
 {
@@ -46,10 +50,19 @@ namespace ImGuiHook
     /**
      * @brief Unload the ImGui hook.
      *
-     * This function should be called when the DLL is detached or the hook is no longer needed.
+     * Restores the window procedure, saves pending .ini settings and joins the hook's threads. Call it from
+     * the unload thread (MuBot::RequestUnload()), never from DllMain: joining under the loader lock deadlocks.
      */
     void Unload();
 
+    /**
+     * @brief Save pending .ini settings on the calling thread.
+     *
+     * For DLL_PROCESS_DETACH when the process exits without an unload: joins nothing and never waits for a lock,
+     * since the other threads are gone and may have died holding one. Does nothing after Unload().
+     */
+    void FlushSettings();
+
     /**
      * @brief Get the last error message.
      *
@@ -58,4 +71,44 @@ namespace ImGuiHook
      * @return A string containing the last error message.
      */
     std::string GetLastError();
+
+    /**
+     * @brief Get the allocator used by ImGui.
+     *
+     * Gives access to per-frame allocation statistics and to the frame arena (FrameAlloc(), FrameFormat()),
+     * whose memory stays valid until the next frame starts.
+     *
+     * @return The allocator installed before the ImGui context was created.
+     */
+    ImGuiAllocator& GetAllocator();
+
+    /**
+     * @brief Get the worker threads building custom draw layers.
+     *
+     * Layers submitted while rendering a window are built in parallel with the rest of the frame,
+     * and drawn right after that window's draw list.
+     *
+     * @return The worker draw lists, started when the ImGui context is created.
+     */
+    WorkerDrawLists& GetWorkerDrawLists();
+
+    /**
+     * @brief Get the recorder of rendered frames.
+     *
+     * While recording, the draw data of every frame is written to a .mbdd file after the worker layers are merged,
+     * so it can be replayed, timed and compared offline with tools/draw_replay.
+     *
+     * @return The draw data recorder, idle until Start() is called.
+     */
+    DrawDataRecorder& GetDrawDataRecorder();
+
+    /**
+     * @brief Get the hotkeys dispatcher.
+     *
+     * Keyboard messages seen by the WndProc hook are queued and dispatched once per frame, before the ImGui frame:
+     * bound keys run their action, the others go to ImGui. Actions run on the render thread.
+     *
+     * @return The key bindings, empty until keys are bound.
+     */
+    KeyBindings& GetKeyBindings();
 }
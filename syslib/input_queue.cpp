@@ -0,0 +1,24 @@
+#include "input_queue.h"
+
+bool InputQueue::Push(const InputEvent& event)
+{
+    const unsigned int head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) == CAPACITY)
+    {
+        m_dropped++;
+        return false;
+    }
+    m_events[head & (CAPACITY - 1)] = event;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputQueue::Pop(InputEvent& event)
+{
+    const unsigned int tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire))
+        return false;
+    event = m_events[tail & (CAPACITY - 1)];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+
+#include "external/imgui/imgui.h"
+
+// Keyboard, text and focus input, as received by the WndProc hook
+struct InputEvent
+{
+    enum Type : unsigned char
+    {
+        Key,
+        Char,
+        Focus
+    };
+
+    Type type = Key;
+    bool down = false;              // Key pressed, or window focused
+    bool repeat = false;            // Key: auto-repeat of a key already held
+    bool utf16 = false;             // Char: 'character' is a UTF-16 code unit (WM_CHAR), else a code point (WM_UNICHAR)
+    unsigned char virtualKey = 0;   // Key: VK_ code, with left/right resolved for Shift, Ctrl and Alt
+    ImGuiKey key = ImGuiKey_None;   // Key: same key for ImGui, ImGuiKey_None if ImGui has none
+    unsigned int character = 0;     // Char
+};
+
+// Lock-free single producer, single consumer ring: the WndProc hook pushes, the render thread pops once per frame.
+// Every press and release is kept in order, so a key pressed and released between two frames is still seen.
+class InputQueue
+{
+public:
+    bool Push(const InputEvent& event);     // Producer only. false when full: the event is dropped and counted
+    bool Pop(InputEvent& event);            // Consumer only. false when empty
+
+    int GetDroppedCount() const { return m_dropped; }
+
+private:
+    static const unsigned int CAPACITY = 256;       // Power of two, several frames worth of typing
+
+    InputEvent m_events[CAPACITY];
+    alignas(64) std::atomic<unsigned int> m_head{ 0 };     // Next slot to write, only the producer stores it
+    alignas(64) std::atomic<unsigned int> m_tail{ 0 };     // Next slot to read, only the consumer stores it
+    std::atomic<int> m_dropped{ 0 };
+};
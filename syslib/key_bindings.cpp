@@ -0,0 +1,121 @@
+#include "key_bindings.h"
+
+#include <cstring>
+
+// VK_ codes of the modifiers. The WndProc hook sends the left/right codes, never the generic VK_SHIFT/VK_CONTROL/VK_MENU.
+static const int KEY_LSHIFT = 0xA0, KEY_RSHIFT = 0xA1;
+static const int KEY_LCONTROL = 0xA2, KEY_RCONTROL = 0xA3;
+static const int KEY_LMENU = 0xA4, KEY_RMENU = 0xA5;
+static const int KEY_LWIN = 0x5B, KEY_RWIN = 0x5C;
+
+void KeyBindings::Bind(int virtualKey, int modifiers, Action action)
+{
+    Unbind(virtualKey, modifiers);
+    m_bindings.push_back({ virtualKey, modifiers, std::move(action) });
+}
+
+void KeyBindings::Unbind(int virtualKey, int modifiers)
+{
+    for (size_t n = 0; n < m_bindings.size(); n++)
+    {
+        if (m_bindings[n].virtualKey == virtualKey && m_bindings[n].modifiers == modifiers)
+        {
+            m_bindings.erase(m_bindings.begin() + n);
+            return;
+        }
+    }
+}
+
+void KeyBindings::Dispatch(InputQueue& queue, ImGuiIO& io)
+{
+    InputEvent event;
+    while (queue.Pop(event))
+    {
+        if (event.type == InputEvent::Focus)
+        {
+            // Releases sent while unfocused are lost: forget held keys, as ImGui does on focus loss
+            if (!event.down)
+                ReleaseAll(io);
+            io.AddFocusEvent(event.down);
+        }
+        else if (event.type == InputEvent::Char)
+        {
+            if (m_swallowChars)
+                continue;
+            if (event.utf16)
+                io.AddInputCharacterUTF16((ImWchar16)event.character);
+            else
+                io.AddInputCharacter(event.character);
+        }
+        else
+        {
+            DispatchKey(event, io);
+        }
+    }
+}
+
+void KeyBindings::DispatchKey(const InputEvent& event, ImGuiIO& io)
+{
+    const int vk = event.virtualKey;
+    m_down[vk] = event.down;
+
+    // WantCaptureKeyboard is from the previous frame, as for the rest of the application
+    if (event.down && !event.repeat && !io.WantCaptureKeyboard)
+    {
+        const int modifiers = GetModifiers();
+        for (const Binding& binding : m_bindings)
+        {
+            if (binding.virtualKey != vk || binding.modifiers != modifiers)
+                continue;
+            m_swallowed[vk] = true;
+            m_swallowChars = true;
+            Action action = binding.action;     // The action may rebind keys
+            action();
+            return;
+        }
+    }
+
+    if (m_swallowed[vk])
+    {
+        // TranslateMessage() posts the characters of a press before its release
+        if (!event.down)
+            m_swallowed[vk] = m_swallowChars = false;
+        return;
+    }
+    if (event.down)
+        m_swallowChars = false;
+
+    // Modifiers first, so ImGui sees e.g. Ctrl held when the key arrives (same order as imgui_impl_win32)
+    SubmitModifiers(io);
+    if (event.key != ImGuiKey_None)
+        io.AddKeyEvent(event.key, event.down);
+}
+
+void KeyBindings::ReleaseAll(ImGuiIO& io)
+{
+    memset(m_down, 0, sizeof(m_down));
+    memset(m_swallowed, 0, sizeof(m_swallowed));
+    m_swallowChars = false;
+    SubmitModifiers(io);
+}
+
+int KeyBindings::GetModifiers() const
+{
+    int modifiers = Mod_None;
+    if (m_down[KEY_LCONTROL] || m_down[KEY_RCONTROL])
+        modifiers |= Mod_Ctrl;
+    if (m_down[KEY_LSHIFT] || m_down[KEY_RSHIFT])
+        modifiers |= Mod_Shift;
+    if (m_down[KEY_LMENU] || m_down[KEY_RMENU])
+        modifiers |= Mod_Alt;
+    return modifiers;
+}
+
+void KeyBindings::SubmitModifiers(ImGuiIO& io) const
+{
+    // ImGui drops events that don't change the key state, so submitting every time is cheap
+    io.AddKeyEvent(ImGuiMod_Ctrl, m_down[KEY_LCONTROL] || m_down[KEY_RCONTROL]);
+    io.AddKeyEvent(ImGuiMod_Shift, m_down[KEY_LSHIFT] || m_down[KEY_RSHIFT]);
+    io.AddKeyEvent(ImGuiMod_Alt, m_down[KEY_LMENU] || m_down[KEY_RMENU]);
+    io.AddKeyEvent(ImGuiMod_Super, m_down[KEY_LWIN] || m_down[KEY_RWIN]);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "input_queue.h"
+#include "external/imgui/imgui.h"
+
+// Single consumer of the input queue: key presses bound to a bot action run it, everything else goes to ImGui
+// (AddKeyEvent, AddInputCharacter, AddFocusEvent), in the order it was received.
+class KeyBindings
+{
+public:
+    enum Modifiers
+    {
+        Mod_None = 0,
+        Mod_Ctrl = 1 << 0,
+        Mod_Shift = 1 << 1,
+        Mod_Alt = 1 << 2
+    };
+
+    using Action = std::function<void()>;
+
+    // 'action' runs when 'virtualKey' is pressed while exactly 'modifiers' are held. Replaces a previous binding of the same keys.
+    void Bind(int virtualKey, int modifiers, Action action);
+    void Unbind(int virtualKey, int modifiers);
+
+    // Render thread, before ImGui::NewFrame(). Bound presses (their repeats, release and characters too) don't reach
+    // ImGui, except while ImGui wants the keyboard (io.WantCaptureKeyboard: text input, keyboard navigation in a
+    // focused window, modal popup), when every key goes to ImGui and no action runs.
+    void Dispatch(InputQueue& queue, ImGuiIO& io);
+
+    bool IsKeyDown(int virtualKey) const { return virtualKey >= 0 && virtualKey < 256 && m_down[virtualKey]; }
+
+private:
+    struct Binding
+    {
+        int virtualKey;
+        int modifiers;
+        Action action;
+    };
+
+    void DispatchKey(const InputEvent& event, ImGuiIO& io);
+    void ReleaseAll(ImGuiIO& io);
+    int GetModifiers() const;
+    void SubmitModifiers(ImGuiIO& io) const;
+
+    std::vector<Binding> m_bindings;
+    bool m_down[256] = {};          // Keys held, from the events seen so far
+    bool m_swallowed[256] = {};     // Held keys whose press ran an action, so ImGui never saw them
+    bool m_swallowChars = false;    // A bound key is held: drop the characters its press produces
+};
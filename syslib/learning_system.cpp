@@ -82,6 +82,7 @@ void LearningSystem::LogEvent(const std::string& type, const std::string& data)
     {
         m_events.erase(m_events.begin());
     }
+    m_eventsGeneration++;
 }
 
 void LearningSystem::LogHealthMana(int health, int maxHealth, int mana, int maxMana)
@@ -89,26 +90,15 @@ void LearningSystem::LogHealthMana(int health, int maxHealth, int mana, int maxM
     if (!m_enabled)
         return;
         
-    HealthManaInfo info;
-    info.health = health;
-    info.maxHealth = maxHealth;
-    info.mana = mana;
-    info.maxMana = maxMana;
-    info.timestamp = std::chrono::system_clock::now();
+    HealthManaSeries::Sample prev;
+    const bool hasPrev = m_healthMana.GetLast(prev);
     
-    m_healthManaHistory.push_back(info);
-    
-    // Keep only recent history
-    if (m_healthManaHistory.size() > MAX_HEALTH_MANA_HISTORY)
-    {
-        m_healthManaHistory.erase(m_healthManaHistory.begin());
-    }
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    m_healthMana.Add({ std::chrono::duration_cast<std::chrono::milliseconds>(now).count(), health, maxHealth, mana, maxMana });
     
     // Log significant changes
-    if (m_healthManaHistory.size() > 1)
+    if (hasPrev)
     {
-        auto& prev = m_healthManaHistory[m_healthManaHistory.size() - 2];
-        
         if (abs(health - prev.health) > 10)
         {
             std::stringstream ss;
@@ -210,7 +200,8 @@ void LearningSystem::ExportLogs(const std::string& format)
 void LearningSystem::ClearLogs()
 {
     m_events.clear();
-    m_healthManaHistory.clear();
+    m_eventsGeneration++;
+    m_healthMana.Clear();
     m_characters.clear();
     m_items.clear();
     
@@ -230,9 +221,39 @@ std::vector<GameEvent> LearningSystem::GetRecentEvents(int count) const
     return recent;
 }
 
+const std::vector<GameEvent>& LearningSystem::GetEvents() const
+{
+    return m_events;
+}
+
+unsigned int LearningSystem::GetEventsGeneration() const
+{
+    return m_eventsGeneration;
+}
+
 std::vector<HealthManaInfo> LearningSystem::GetHealthManaHistory() const
 {
-    return m_healthManaHistory;
+    std::vector<HealthManaSeries::Sample> samples;
+    m_healthMana.GetRecentSamples(MAX_HEALTH_MANA_HISTORY, samples);
+    
+    std::vector<HealthManaInfo> history;
+    history.reserve(samples.size());
+    for (const auto& sample : samples)
+    {
+        HealthManaInfo info;
+        info.health = sample.health;
+        info.maxHealth = sample.maxHealth;
+        info.mana = sample.mana;
+        info.maxMana = sample.maxMana;
+        info.timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(sample.time));
+        history.push_back(info);
+    }
+    return history;
+}
+
+const HealthManaSeries& LearningSystem::GetHealthManaSeries() const
+{
+    return m_healthMana;
 }
 
 void LearningSystem::ProcessColorAnalysis()
@@ -355,9 +376,10 @@ void LearningSystem::WriteTextLog(const std::string& filename)
     }
     
     // Write health/mana history
-    file << "\nHEALTH/MANA HISTORY (" << m_healthManaHistory.size() << " entries):\n";
+    const std::vector<HealthManaInfo> healthManaHistory = GetHealthManaHistory();
+    file << "\nHEALTH/MANA HISTORY (" << healthManaHistory.size() << " entries):\n";
     file << "----------------------------------------\n";
-    for (const auto& hm : m_healthManaHistory)
+    for (const auto& hm : healthManaHistory)
     {
         auto time_t = std::chrono::system_clock::to_time_t(hm.timestamp);
         auto tm = *std::localtime(&time_t);
@@ -429,9 +451,10 @@ void LearningSystem::WriteJsonLog(const std::string& filename)
     file << "  \"healthManaHistory\": [\n";
     
     // Write health/mana history
-    for (size_t i = 0; i < m_healthManaHistory.size(); ++i)
+    const std::vector<HealthManaInfo> healthManaHistory = GetHealthManaHistory();
+    for (size_t i = 0; i < healthManaHistory.size(); ++i)
     {
-        const auto& hm = m_healthManaHistory[i];
+        const auto& hm = healthManaHistory[i];
         auto time_t = std::chrono::system_clock::to_time_t(hm.timestamp);
         auto tm = *std::localtime(&time_t);
         
@@ -443,7 +466,7 @@ void LearningSystem::WriteJsonLog(const std::string& filename)
         file << "      \"maxMana\": " << hm.maxMana << "\n";
         file << "    }";
         
-        if (i < m_healthManaHistory.size() - 1)
+        if (i < healthManaHistory.size() - 1)
             file << ",";
         file << "\n";
     }
@@ -1,11 +1,12 @@
 #pragma once
 
-#include <Windows.h>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <chrono>
 
+#include "health_mana_series.h"
+
 struct GameEvent
 {
     std::chrono::system_clock::time_point timestamp;
@@ -58,7 +59,10 @@ public:
     void ClearLogs();
     
     std::vector<GameEvent> GetRecentEvents(int count = 50) const;
-    std::vector<HealthManaInfo> GetHealthManaHistory() const;
+    const std::vector<GameEvent>& GetEvents() const;
+    unsigned int GetEventsGeneration() const; // Changes whenever events are added or removed
+    std::vector<HealthManaInfo> GetHealthManaHistory() const; // Most recent MAX_HEALTH_MANA_HISTORY samples
+    const HealthManaSeries& GetHealthManaSeries() const; // Whole session, for plotting
 
 private:
     void ProcessColorAnalysis();
@@ -73,7 +77,8 @@ private:
     bool m_enabled = false;
     
     std::vector<GameEvent> m_events;
-    std::vector<HealthManaInfo> m_healthManaHistory;
+    unsigned int m_eventsGeneration = 0;
+    HealthManaSeries m_healthMana;
     std::vector<CharacterInfo> m_characters;
     std::vector<ItemInfo> m_items;
     
@@ -81,7 +86,7 @@ private:
     std::chrono::steady_clock::time_point m_lastSave;
     
     static const size_t MAX_EVENTS = 1000;
-    static const size_t MAX_HEALTH_MANA_HISTORY = 500;
+    static const size_t MAX_HEALTH_MANA_HISTORY = 500;     // Samples written to the logs
     static const size_t MAX_CHARACTERS = 100;
     static const size_t MAX_ITEMS = 200;
 };
\ No newline at end of file
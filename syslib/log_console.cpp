@@ -0,0 +1,126 @@
+#include "log_console.h"
+
+void LogConsole::AddLine(const char* line, const char* lineEnd)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    int oldSize = m_buffer.size();
+    m_buffer.append(line, lineEnd);
+    m_buffer.append("\n");
+    m_lineOffsets.append(m_buffer.begin(), oldSize, m_buffer.size());
+
+    if (m_buffer.size() > MAX_BUFFER_SIZE)
+        TrimOldestLines();
+}
+
+void LogConsole::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffer.clear();
+    m_lineOffsets.clear();
+    m_filteredLines.clear();
+    m_filterScannedLines = 0;
+}
+
+int LogConsole::GetLineCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lineOffsets.size();
+}
+
+void LogConsole::TrimOldestLines()
+{
+    // Drop the oldest half of the lines in one go, so the cost of moving the buffer is amortized over many AddLine()
+    int droppedLines = m_lineOffsets.size() / 2;
+    if (droppedLines == 0)
+        return;
+    int droppedBytes = m_lineOffsets.LineOffsets[droppedLines];
+
+    m_buffer.Buf.erase(m_buffer.Buf.begin(), m_buffer.Buf.begin() + droppedBytes);
+    m_lineOffsets.LineOffsets.erase(m_lineOffsets.LineOffsets.begin(), m_lineOffsets.LineOffsets.begin() + droppedLines);
+    for (int& offset : m_lineOffsets.LineOffsets)
+        offset -= droppedBytes;
+    m_lineOffsets.EndOffset -= droppedBytes;
+
+    int keptFilteredLines = 0;
+    for (int line : m_filteredLines)
+        if (line >= droppedLines)
+            m_filteredLines[keptFilteredLines++] = line - droppedLines;
+    m_filteredLines.resize(keptFilteredLines);
+    m_filterScannedLines = ImMax(m_filterScannedLines - droppedLines, 0);
+}
+
+void LogConsole::UpdateFilter()
+{
+    if (!m_filter.IsActive())
+        return;
+
+    // Only test lines appended since last frame, bounded per frame so a full re-filter is spread over a few frames
+    int lineEnd = ImMin(m_lineOffsets.size(), m_filterScannedLines + FILTER_LINES_PER_FRAME);
+    if (lineEnd == m_filterScannedLines)
+        return;
+    ImBitVector matches;
+    matches.Create(lineEnd - m_filterScannedLines);
+    if (ImTextFilterPassLines(&m_filter, m_buffer.begin(), &m_lineOffsets, m_filterScannedLines, lineEnd, &matches) > 0)
+        for (int line = m_filterScannedLines; line < lineEnd; line++)
+            if (matches.TestBit(line - m_filterScannedLines))
+                m_filteredLines.push_back(line);
+    m_filterScannedLines = lineEnd;
+}
+
+void LogConsole::Draw(const char* id, const ImVec2& size)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ImGui::PushID(id);
+
+    if (m_filter.Draw("Filtro", 180.0f))
+    {
+        m_filteredLines.clear();
+        m_filterScannedLines = 0;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Limpar"))
+    {
+        m_buffer.clear();
+        m_lineOffsets.clear();
+        m_filteredLines.clear();
+        m_filterScannedLines = 0;
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Auto-rolagem", &m_autoScroll);
+
+    UpdateFilter();
+    const bool filtering = m_filter.IsActive();
+    const int lineCount = m_lineOffsets.size();
+    ImGui::SameLine();
+    if (filtering && m_filterScannedLines < lineCount)
+        ImGui::TextDisabled("Filtrando... %d%%", (int)(100.0f * m_filterScannedLines / lineCount));
+    else if (filtering)
+        ImGui::TextDisabled("%d de %d linhas", m_filteredLines.Size, lineCount);
+    else
+        ImGui::TextDisabled("%d linhas", lineCount);
+
+    if (ImGui::BeginChild("Lines", size, ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar))
+    {
+        const char* buf = m_buffer.begin();
+        ImGuiListClipper clipper;
+        clipper.Begin(filtering ? m_filteredLines.Size : lineCount);
+        while (clipper.Step())
+        {
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            {
+                int line = filtering ? m_filteredLines[n] : n;
+                const char* lineBegin = m_lineOffsets.get_line_begin(buf, line);
+                const char* lineEnd = m_lineOffsets.get_line_end(buf, line);
+                if (lineEnd > lineBegin && lineEnd[-1] == '\n')
+                    lineEnd--;
+                ImGui::TextUnformatted(lineBegin, lineEnd);
+            }
+        }
+        clipper.End();
+
+        if (m_autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+            ImGui::SetScrollHereY(1.0f);
+    }
+    ImGui::EndChild();
+    ImGui::PopID();
+}
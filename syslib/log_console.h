@@ -0,0 +1,33 @@
+#pragma once
+
+#include <mutex>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+// Log console: all lines live in a single text buffer with a line index, and only visible lines are submitted
+// (ImGuiListClipper), so the frame cost doesn't depend on the number of lines.
+class LogConsole
+{
+public:
+    void AddLine(const char* line, const char* lineEnd = nullptr);
+    void Clear();
+    void Draw(const char* id, const ImVec2& size);
+
+    int GetLineCount();
+
+private:
+    void TrimOldestLines();
+    void UpdateFilter();
+
+    static const int MAX_BUFFER_SIZE = 64 * 1024 * 1024;       // Oldest half of the lines is dropped above this
+    static const int FILTER_LINES_PER_FRAME = 100000;          // Bound the cost of re-filtering a large log after editing the filter
+
+    std::mutex m_mutex;                 // AddLine() may be called from any thread
+    ImGuiTextBuffer m_buffer;
+    ImGuiTextIndex m_lineOffsets;
+    ImGuiTextFilter m_filter;
+    ImVector<int> m_filteredLines;      // Indices of lines passing m_filter
+    int m_filterScannedLines = 0;       // Lines already tested against m_filter, only newer ones are scanned
+    bool m_autoScroll = true;
+};
@@ -1,33 +1,48 @@
 #include "mubot.h"
+#include "mubot_menu.h"
 #include "imgui_hook.h"
 #include "license_validator.h"
 #include "pve_system.h"
 #include "pvp_system.h"
 #include "learning_system.h"
 #include "game_reader.h"
+#include "key_bindings.h"
+#include "session_stats.h"
 
 #include "external/imgui/imgui.h"
 #include <fstream>
-#include <sstream>
 #include <chrono>
 
 namespace MuBot
 {
-    static MenuState g_currentState = MenuState::Main;
-    static MenuSize g_menuSize = MenuSize::Full;
     static BotConfig g_config;
     static LicenseValidator g_licenseValidator;
     static PvESystem g_pveSystem;
     static PvPSystem g_pvpSystem;
     static LearningSystem g_learningSystem;
     static GameReader g_gameReader;
+    static MenuSources g_menuSources;
     
-    static bool g_showConfirmDialog = false;
-    static std::string g_confirmMessage;
-    static std::function<void()> g_confirmCallback;
+    // Session statistics, fed from the cumulative counters of the game reader and the PvE system
+    static SessionStats g_sessionStats;
+    static unsigned int g_seenKills = 0;
+    static unsigned int g_seenHealthPotions = 0;
+    static unsigned int g_seenManaPotions = 0;
+    static int64_t g_lastStatsLog = 0;
+    static const int64_t STATS_LOG_INTERVAL_MS = 60 * 1000;
+    static const char* STATS_LOG_PATH = "mubot_session_stats.mbss";
     
-    static std::vector<std::string> g_logMessages;
-    static const size_t MAX_LOG_MESSAGES = 100;
+    static int64_t GetSteadyMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    static int64_t GetWallMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
+    static void RenderFrame();
 
     void Initialize()
     {
@@ -46,11 +61,33 @@ namespace MuBot
         g_learningSystem.Initialize();
         g_gameReader.Initialize();
         
+        g_sessionStats.Reset(GetSteadyMs());
+        g_lastStatsLog = GetSteadyMs();
+        
+        // What the menu draws from, the per-frame part refreshed by RenderFrame()
+        g_menuSources.config = &g_config;
+        g_menuSources.license = g_licenseValidator.GetLicenseInfo();
+        g_menuSources.events = &g_learningSystem.GetEvents();
+        g_menuSources.healthMana = &g_learningSystem.GetHealthManaSeries();
+        g_menuSources.sessionStats = &g_sessionStats;
+        g_menuSources.resetSessionStats = []() {
+            const int64_t now = GetSteadyMs();
+            g_sessionStats.AppendLog(STATS_LOG_PATH, now, GetWallMs(), true);
+            g_sessionStats.Reset(now);
+        };
+        g_menuSources.allocator = &ImGuiHook::GetAllocator();
+        g_menuSources.workers = &ImGuiHook::GetWorkerDrawLists();
+        g_menuSources.recorder = &ImGuiHook::GetDrawDataRecorder();
+        SetMenuSources(&g_menuSources);
+        
         // Load configuration
         LoadConfig();
         
+        // Hotkeys are dispatched by the hook, from the window's keyboard messages
+        RegisterHotkeys();
+        
         // Initialize ImGui hook
-        if (!ImGuiHook::Load(RenderMenu, []() {
+        if (!ImGuiHook::Load(RenderFrame, []() {
             ImGui::StyleColorsDark();
             
             // Customize colors for MU theme
@@ -62,6 +99,14 @@ namespace MuBot
             style.Colors[ImGuiCol_Button] = ImVec4(0.5f, 0.2f, 0.2f, 0.8f);
             style.Colors[ImGuiCol_ButtonHovered] = ImVec4(0.6f, 0.3f, 0.3f, 0.9f);
             style.Colors[ImGuiCol_ButtonActive] = ImVec4(0.7f, 0.4f, 0.4f, 1.0f);
+            
+            // Build font atlas now, reusing the on-disk cache from the previous session when fonts didn't change
+            ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+            fonts->CacheFilename = "mubot_fonts.cache";
+            auto buildStart = std::chrono::steady_clock::now();
+            fonts->Build();
+            auto buildMs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - buildStart).count() / 1000.0;
+            LogMessage("Fontes carregadas em " + std::to_string(buildMs) + " ms (" + (fonts->TexLoadedFromCache ? "cache" : "rasterizadas") + ")");
         }))
         {
             LogMessage("ERRO: Falha ao inicializar ImGui hook!");
@@ -81,6 +126,9 @@ namespace MuBot
         
         SaveConfig();
         
+        if (!g_sessionStats.GetSpots().empty())
+            g_sessionStats.AppendLog(STATS_LOG_PATH, GetSteadyMs(), GetWallMs(), true);
+        
         g_pveSystem.Shutdown();
         g_pvpSystem.Shutdown();
         g_learningSystem.Shutdown();
@@ -89,6 +137,41 @@ namespace MuBot
         LogMessage("MuBot finalizado.");
     }
 
+    static void UpdateSessionStats()
+    {
+        const int64_t now = GetSteadyMs();
+        
+        if (g_gameReader.IsInGame())
+        {
+            const PlayerInfo player = g_gameReader.GetPlayerInfo();
+            g_sessionStats.Update(now, player.map, player.x, player.y, player.health, player.experience);
+        }
+        else
+        {
+            g_sessionStats.OnLeftGame();
+        }
+        
+        // Only the counts since the previous frame are added, however long the session
+        const unsigned int kills = g_gameReader.GetKillCount();
+        const unsigned int healthPotions = g_pveSystem.GetHealthPotionsUsed();
+        const unsigned int manaPotions = g_pveSystem.GetManaPotionsUsed();
+        if (kills != g_seenKills)
+            g_sessionStats.Add(now, SessionStats::Kills, kills - g_seenKills);
+        if (healthPotions != g_seenHealthPotions)
+            g_sessionStats.Add(now, SessionStats::HealthPotions, healthPotions - g_seenHealthPotions);
+        if (manaPotions != g_seenManaPotions)
+            g_sessionStats.Add(now, SessionStats::ManaPotions, manaPotions - g_seenManaPotions);
+        g_seenKills = kills;
+        g_seenHealthPotions = healthPotions;
+        g_seenManaPotions = manaPotions;
+        
+        if (now - g_lastStatsLog >= STATS_LOG_INTERVAL_MS)
+        {
+            g_sessionStats.AppendLog(STATS_LOG_PATH, now, GetWallMs(), false);
+            g_lastStatsLog = now;
+        }
+    }
+
     void Update()
     {
         if (!g_licenseValidator.IsValid())
@@ -105,259 +188,43 @@ namespace MuBot
             g_learningSystem.Update();
             
         g_gameReader.Update();
+        UpdateSessionStats();
     }
 
-    void RenderMenu()
+    // Called by the hook on the render thread, once per frame
+    static void RenderFrame()
     {
         Update();
         
-        // Handle F5 key for menu toggle
-        static bool f5Pressed = false;
-        if (GetAsyncKeyState(VK_F5) & 0x8000)
-        {
-            if (!f5Pressed)
-            {
-                f5Pressed = true;
-                if (g_menuSize == MenuSize::Full)
-                    g_menuSize = MenuSize::Compact;
-                else
-                    g_menuSize = MenuSize::Full;
-            }
-        }
-        else
-        {
-            f5Pressed = false;
-        }
-        
-        // Handle keyboard navigation
-        HandleInput();
-        
-        // Set window size based on menu size
-        ImVec2 windowSize = (g_menuSize == MenuSize::Full) ? ImVec2(500, 400) : ImVec2(300, 200);
-        
-        ImGui::SetNextWindowSize(windowSize, ImGuiCond_Always);
-        ImGui::SetNextWindowPos(ImVec2(50, 50), ImGuiCond_FirstUseEver);
-        
-        if (ImGui::Begin("MuBot v1.0", nullptr, ImGuiWindowFlags_NoResize))
-        {
-            // License status at top
-            if (!g_licenseValidator.IsValid())
-            {
-                ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "LICENÇA INVÁLIDA!");
-                ImGui::End();
-                return;
-            }
-            
-            int daysRemaining = GetDaysRemaining();
-            ImVec4 licenseColor = (daysRemaining < 5) ? ImVec4(1.0f, 0.0f, 0.0f, 1.0f) : ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
-            ImGui::TextColored(licenseColor, "Validade: %d dias restantes", daysRemaining);
-            
-            ImGui::Separator();
-            
-            // Render current menu state
-            switch (g_currentState)
-            {
-                case MenuState::Main:
-                    RenderMainMenu();
-                    break;
-                case MenuState::PvE:
-                    RenderPvEMenu();
-                    break;
-                case MenuState::PvP:
-                    RenderPvPMenu();
-                    break;
-                case MenuState::License:
-                    RenderLicenseMenu();
-                    break;
-            }
-            
-            // Show confirm dialog if needed
-            if (g_showConfirmDialog)
-            {
-                ImGui::OpenPopup("Confirmação");
-                if (ImGui::BeginPopupModal("Confirmação", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
-                {
-                    ImGui::Text("%s", g_confirmMessage.c_str());
-                    ImGui::Separator();
-                    
-                    if (ImGui::Button("Sim"))
-                    {
-                        if (g_confirmCallback)
-                            g_confirmCallback();
-                        g_showConfirmDialog = false;
-                        ImGui::CloseCurrentPopup();
-                    }
-                    ImGui::SameLine();
-                    if (ImGui::Button("Cancelar"))
-                    {
-                        g_showConfirmDialog = false;
-                        ImGui::CloseCurrentPopup();
-                    }
-                    
-                    ImGui::EndPopup();
-                }
-            }
-        }
-        ImGui::End();
+        g_menuSources.time = GetSteadyMs();
+        g_menuSources.wallTime = GetWallMs();
+        g_menuSources.experienceEstimated = g_gameReader.GetPlayerInfo().experienceEstimated;
+        g_menuSources.licenseValid = g_licenseValidator.IsValid();
+        g_menuSources.daysRemaining = g_licenseValidator.GetDaysRemaining();
+        g_menuSources.eventsGeneration = g_learningSystem.GetEventsGeneration();
+        g_menuSources.pvpStatistics = g_pvpSystem.GetStatistics();
+        g_menuSources.snapshot = g_gameReader.GetSnapshot();
+        RenderMenu();
     }
 
-    void RenderMainMenu()
+    void RegisterHotkeys()
     {
-        if (g_menuSize == MenuSize::Compact)
-        {
-            ImGui::Text("MuBot - Menu Compacto");
-            if (ImGui::Button("PvE")) SetMenuState(MenuState::PvE);
-            ImGui::SameLine();
-            if (ImGui::Button("PvP")) SetMenuState(MenuState::PvP);
-            return;
-        }
-        
-        ImGui::Text("Menu Principal");
-        ImGui::Separator();
-        
-        // PvE Section
-        if (ImGui::Button("PvE", ImVec2(150, 40)))
-        {
-            SetMenuState(MenuState::PvE);
-        }
-        ImGui::SameLine();
-        ImGui::Text("Status: %s", g_config.pveEnabled ? "ATIVO" : "Inativo");
-        
-        // PvP Section
-        if (ImGui::Button("PvP", ImVec2(150, 40)))
-        {
-            SetMenuState(MenuState::PvP);
-        }
-        ImGui::SameLine();
-        ImGui::Text("Status: %s", g_config.pvpEnabled ? "ATIVO" : "Inativo");
+        KeyBindings& keys = ImGuiHook::GetKeyBindings();
         
-        // License info
-        if (ImGui::Button("Informações da Licença", ImVec2(200, 30)))
-        {
-            SetMenuState(MenuState::License);
-        }
-        
-        ImGui::Separator();
+        // F5 toggles the menu size
+        keys.Bind(VK_F5, KeyBindings::Mod_None, ToggleMenuSize);
         
-        // Learning mode toggle
-        if (ImGui::Checkbox("Modo Aprendizado", &g_config.learningMode))
-        {
-            if (g_config.learningMode)
-                LogMessage("Modo aprendizado ativado - coletando dados do jogo");
-            else
-                LogMessage("Modo aprendizado desativado");
-        }
+        // Ctrl+End unloads the bot, saving config and settings
+        keys.Bind(VK_END, KeyBindings::Mod_Ctrl, RequestUnload);
         
-        // Log messages
-        if (ImGui::CollapsingHeader("Log"))
-        {
-            ImGui::BeginChild("LogScroll", ImVec2(0, 100), true);
-            for (const auto& msg : g_logMessages)
-            {
-                ImGui::Text("%s", msg.c_str());
-            }
-            ImGui::SetScrollHereY(1.0f);
-            ImGui::EndChild();
-        }
-    }
-
-    void RenderPvEMenu()
-    {
-        if (ImGui::Button("← Voltar"))
-        {
-            if (g_config.pveEnabled)
+        // Left arrow goes back to the main menu
+        keys.Bind(VK_LEFT, KeyBindings::Mod_None, []() {
+            if (GetCurrentState() == MenuState::Main)
+                return;
+            if (g_config.pveEnabled || g_config.pvpEnabled)
             {
-                ShowConfirmDialog("Deseja retornar ao menu principal? Isso desativará o PvE.", []() {
+                ShowConfirmDialog("Deseja retornar ao menu principal? Isso desativará a função atual.", []() {
                     g_config.pveEnabled = false;
-                    SetMenuState(MenuState::Main);
-                });
-            }
-            else
-            {
-                SetMenuState(MenuState::Main);
-            }
-        }
-        
-        ImGui::Separator();
-        ImGui::Text("Sistema PvE");
-        
-        if (ImGui::Checkbox("Ativar PvE", &g_config.pveEnabled))
-        {
-            if (g_config.pveEnabled)
-                LogMessage("PvE ativado");
-            else
-                LogMessage("PvE desativado");
-        }
-        
-        if (g_config.pveEnabled)
-        {
-            ImGui::Separator();
-            
-            ImGui::Checkbox("Auto Farm", &g_config.autoFarm);
-            ImGui::Checkbox("Auto Reset", &g_config.autoReset);
-            if (g_config.autoReset)
-            {
-                ImGui::SliderInt("Nível para Reset", &g_config.resetLevel, 300, 500);
-            }
-            
-            ImGui::Checkbox("Coleta de Itens (ALT)", &g_config.autoCollectItems);
-            ImGui::Checkbox("Auto Pot", &g_config.autoPot);
-            
-            if (g_config.autoPot)
-            {
-                ImGui::SliderInt("Vida %", &g_config.healthPotPercent, 10, 90);
-                ImGui::SliderInt("Mana %", &g_config.manaPotPercent, 10, 90);
-            }
-            
-            // Skills configuration
-            if (ImGui::CollapsingHeader("Configuração de Skills"))
-            {
-                static char skillName[64] = "";
-                static int skillDelay = 1000;
-                static int skillKey = VK_F1;
-                
-                ImGui::InputText("Nome da Skill", skillName, sizeof(skillName));
-                ImGui::SliderInt("Delay (ms)", &skillDelay, 100, 5000);
-                ImGui::SliderInt("Tecla", &skillKey, VK_F1, VK_F12);
-                
-                if (ImGui::Button("Adicionar Skill"))
-                {
-                    if (strlen(skillName) > 0)
-                    {
-                        g_config.skillList.push_back(std::string(skillName));
-                        g_config.skillDelays.push_back(skillDelay);
-                        g_config.skillKeys.push_back(skillKey);
-                        memset(skillName, 0, sizeof(skillName));
-                    }
-                }
-                
-                // Display current skills
-                for (size_t i = 0; i < g_config.skillList.size(); ++i)
-                {
-                    ImGui::Text("%s - Delay: %dms - Tecla: F%d", 
-                               g_config.skillList[i].c_str(), 
-                               g_config.skillDelays[i],
-                               g_config.skillKeys[i] - VK_F1 + 1);
-                    ImGui::SameLine();
-                    if (ImGui::Button(("Remover##" + std::to_string(i)).c_str()))
-                    {
-                        g_config.skillList.erase(g_config.skillList.begin() + i);
-                        g_config.skillDelays.erase(g_config.skillDelays.begin() + i);
-                        g_config.skillKeys.erase(g_config.skillKeys.begin() + i);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    void RenderPvPMenu()
-    {
-        if (ImGui::Button("← Voltar"))
-        {
-            if (g_config.pvpEnabled)
-            {
-                ShowConfirmDialog("Deseja retornar ao menu principal? Isso desativará o PvP.", []() {
                     g_config.pvpEnabled = false;
                     SetMenuState(MenuState::Main);
                 });
@@ -366,161 +233,7 @@ namespace MuBot
             {
                 SetMenuState(MenuState::Main);
             }
-        }
-        
-        ImGui::Separator();
-        ImGui::Text("Sistema PvP");
-        
-        if (ImGui::Checkbox("Ativar PvP", &g_config.pvpEnabled))
-        {
-            if (g_config.pvpEnabled)
-                LogMessage("PvP ativado");
-            else
-                LogMessage("PvP desativado");
-        }
-        
-        if (g_config.pvpEnabled)
-        {
-            ImGui::Separator();
-            
-            ImGui::Checkbox("Alvo Automático", &g_config.pvpAutoTarget);
-            ImGui::Checkbox("Auto Shield", &g_config.autoShield);
-            
-            if (g_config.autoShield)
-            {
-                ImGui::SliderInt("Shield quando vida < %", &g_config.shieldHealthPercent, 10, 90);
-            }
-            
-            // Combos configuration
-            if (ImGui::CollapsingHeader("Combos"))
-            {
-                static char comboName[128] = "";
-                ImGui::InputText("Combo", comboName, sizeof(comboName));
-                
-                if (ImGui::Button("Adicionar Combo"))
-                {
-                    if (strlen(comboName) > 0)
-                    {
-                        g_config.combos.push_back(std::string(comboName));
-                        memset(comboName, 0, sizeof(comboName));
-                    }
-                }
-                
-                // Display current combos
-                for (size_t i = 0; i < g_config.combos.size(); ++i)
-                {
-                    ImGui::Text("%zu. %s", i + 1, g_config.combos[i].c_str());
-                    ImGui::SameLine();
-                    if (ImGui::Button(("Remover##combo" + std::to_string(i)).c_str()))
-                    {
-                        g_config.combos.erase(g_config.combos.begin() + i);
-                        break;
-                    }
-                }
-            }
-            
-            // PvP Statistics
-            if (ImGui::CollapsingHeader("Estatísticas"))
-            {
-                auto stats = g_pvpSystem.GetStatistics();
-                ImGui::Text("Dano Total: %.0f", stats.totalDamage);
-                ImGui::Text("Vitórias: %d", stats.wins);
-                ImGui::Text("Mortes: %d", stats.deaths);
-                ImGui::Text("K/D Ratio: %.2f", stats.deaths > 0 ? (float)stats.wins / stats.deaths : (float)stats.wins);
-            }
-        }
-    }
-
-    void RenderLicenseMenu()
-    {
-        if (ImGui::Button("← Voltar"))
-        {
-            SetMenuState(MenuState::Main);
-        }
-        
-        ImGui::Separator();
-        ImGui::Text("Informações da Licença");
-        ImGui::Separator();
-        
-        auto licenseInfo = g_licenseValidator.GetLicenseInfo();
-        
-        ImGui::Text("Usuário: %s", licenseInfo.usuario.c_str());
-        ImGui::Text("Validade: %s", licenseInfo.validadeStr.c_str());
-        
-        int daysRemaining = GetDaysRemaining();
-        ImVec4 color = (daysRemaining < 5) ? ImVec4(1.0f, 0.0f, 0.0f, 1.0f) : ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
-        ImGui::TextColored(color, "Dias restantes: %d", daysRemaining);
-        
-        ImGui::Text("PCs permitidos: %d", licenseInfo.quantidadePCs);
-        ImGui::Text("Status: %s", g_licenseValidator.IsValid() ? "VÁLIDA" : "INVÁLIDA");
-    }
-
-    void HandleInput()
-    {
-        // Handle arrow key navigation
-        static bool rightPressed = false;
-        static bool leftPressed = false;
-        
-        if (GetAsyncKeyState(VK_RIGHT) & 0x8000)
-        {
-            if (!rightPressed)
-            {
-                rightPressed = true;
-                // Enter submenu logic here if needed
-            }
-        }
-        else
-        {
-            rightPressed = false;
-        }
-        
-        if (GetAsyncKeyState(VK_LEFT) & 0x8000)
-        {
-            if (!leftPressed)
-            {
-                leftPressed = true;
-                // Go back logic
-                if (g_currentState != MenuState::Main)
-                {
-                    if (g_config.pveEnabled || g_config.pvpEnabled)
-                    {
-                        ShowConfirmDialog("Deseja retornar ao menu principal? Isso desativará a função atual.", []() {
-                            g_config.pveEnabled = false;
-                            g_config.pvpEnabled = false;
-                            SetMenuState(MenuState::Main);
-                        });
-                    }
-                    else
-                    {
-                        SetMenuState(MenuState::Main);
-                    }
-                }
-            }
-        }
-        else
-        {
-            leftPressed = false;
-        }
-    }
-
-    MenuState GetCurrentState()
-    {
-        return g_currentState;
-    }
-
-    void SetMenuState(MenuState state)
-    {
-        g_currentState = state;
-    }
-
-    MenuSize GetMenuSize()
-    {
-        return g_menuSize;
-    }
-
-    void ToggleMenuSize()
-    {
-        g_menuSize = (g_menuSize == MenuSize::Full) ? MenuSize::Compact : MenuSize::Full;
+        });
     }
 
     BotConfig& GetConfig()
@@ -589,28 +302,4 @@ namespace MuBot
     {
         return g_licenseValidator.GetDaysRemaining();
     }
-
-    void LogMessage(const std::string& message)
-    {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto tm = *std::localtime(&time_t);
-        
-        std::stringstream ss;
-        ss << "[" << std::put_time(&tm, "%H:%M:%S") << "] " << message;
-        
-        g_logMessages.push_back(ss.str());
-        
-        if (g_logMessages.size() > MAX_LOG_MESSAGES)
-        {
-            g_logMessages.erase(g_logMessages.begin());
-        }
-    }
-
-    void ShowConfirmDialog(const std::string& message, std::function<void()> onConfirm)
-    {
-        g_confirmMessage = message;
-        g_confirmCallback = onConfirm;
-        g_showConfirmDialog = true;
-    }
 }
\ No newline at end of file
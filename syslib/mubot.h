@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Windows.h>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
@@ -50,11 +50,12 @@ namespace MuBot
     // Core functions
     void Initialize();
     void Shutdown();
+    void RequestUnload();     // Shutdown(), ImGuiHook::Unload() and FreeLibrary on a new thread (dllmain.cpp)
     void Update();
     
     // Menu functions
     void RenderMenu();
-    void HandleInput();
+    void RegisterHotkeys();
     
     // State management
     MenuState GetCurrentState();
@@ -74,5 +75,6 @@ namespace MuBot
     
     // Utility functions
     void LogMessage(const std::string& message);
+    void ClearLog();
     void ShowConfirmDialog(const std::string& message, std::function<void()> onConfirm);
 }
\ No newline at end of file
@@ -0,0 +1,612 @@
+#include "mubot_menu.h"
+#include "log_console.h"
+#include "table_sorter.h"
+#include "radar_widget.h"
+#include "imgui_allocator.h"
+#include "draw_data_recorder.h"
+#include "session_stats.h"
+
+#include "external/imgui/imgui.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+// The menu only draws from MenuSources and its own widget state: no Win32, no game memory (see tools/ui_bench)
+namespace MuBot
+{
+    static MenuSources* g_sources = nullptr;
+    static MenuState g_currentState = MenuState::Main;
+    static MenuSize g_menuSize = MenuSize::Full;
+    
+    static bool g_showConfirmDialog = false;
+    static std::string g_confirmMessage;
+    static std::function<void()> g_confirmCallback;
+    
+    static LogConsole g_logConsole;
+    static TableSorter g_learningEventsSorter;
+    static RadarWidget g_radar;
+    static int g_healthManaRange = 0;
+    
+    // Skill keys are Windows virtual-key codes (VK_F1, VK_F12)
+    static const int KEY_F1 = 0x70;
+    static const int KEY_F12 = 0x7B;
+
+    void SetMenuSources(MenuSources* sources)
+    {
+        g_sources = sources;
+        
+        // Sort keys of the learning events table (Hora, Tipo, Dados)
+        g_learningEventsSorter.SetNumberColumn(0, [](int row) {
+            auto timestamp = (*g_sources->events)[row].timestamp.time_since_epoch();
+            return (double)std::chrono::duration_cast<std::chrono::milliseconds>(timestamp).count();
+        });
+        g_learningEventsSorter.SetTextColumn(1, [](int row) { return (*g_sources->events)[row].type.c_str(); });
+        g_learningEventsSorter.SetTextColumn(2, [](int row) { return (*g_sources->events)[row].data.c_str(); });
+    }
+
+    void RenderMenu()
+    {
+        IM_ASSERT(g_sources != nullptr && "SetMenuSources() first");
+        
+        // Set window size based on menu size
+        ImVec2 windowSize = (g_menuSize == MenuSize::Full) ? ImVec2(500, 400) : ImVec2(300, 200);
+        
+        ImGui::SetNextWindowSize(windowSize, ImGuiCond_Always);
+        ImGui::SetNextWindowPos(ImVec2(50, 50), ImGuiCond_FirstUseEver);
+        
+        if (ImGui::Begin("MuBot v1.0", nullptr, ImGuiWindowFlags_NoResize))
+        {
+            // License status at top
+            if (!g_sources->licenseValid)
+            {
+                ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "LICENÇA INVÁLIDA!");
+                ImGui::End();
+                return;
+            }
+            
+            int daysRemaining = g_sources->daysRemaining;
+            ImVec4 licenseColor = (daysRemaining < 5) ? ImVec4(1.0f, 0.0f, 0.0f, 1.0f) : ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
+            ImGui::TextColored(licenseColor, "Validade: %d dias restantes", daysRemaining);
+            
+            ImGui::Separator();
+            
+            // Render current menu state
+            switch (g_currentState)
+            {
+                case MenuState::Main:
+                    RenderMainMenu();
+                    break;
+                case MenuState::PvE:
+                    RenderPvEMenu();
+                    break;
+                case MenuState::PvP:
+                    RenderPvPMenu();
+                    break;
+                case MenuState::License:
+                    RenderLicenseMenu();
+                    break;
+            }
+            
+            // Show confirm dialog if needed
+            if (g_showConfirmDialog)
+            {
+                ImGui::OpenPopup("Confirmação");
+                if (ImGui::BeginPopupModal("Confirmação", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+                {
+                    ImGui::Text("%s", g_confirmMessage.c_str());
+                    ImGui::Separator();
+                    
+                    if (ImGui::Button("Sim"))
+                    {
+                        if (g_confirmCallback)
+                            g_confirmCallback();
+                        g_showConfirmDialog = false;
+                        ImGui::CloseCurrentPopup();
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Cancelar"))
+                    {
+                        g_showConfirmDialog = false;
+                        ImGui::CloseCurrentPopup();
+                    }
+                    
+                    ImGui::EndPopup();
+                }
+            }
+        }
+        ImGui::End();
+    }
+
+    static void RenderLearningEvents()
+    {
+        const ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_ScrollY |
+                                      ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_Resizable;
+        if (!ImGui::BeginTable("LearningEvents", 3, flags, ImVec2(0, 150)))
+            return;
+        
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Hora", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending | ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Tipo", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Dados", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+        
+        // Row order is only rebuilt when events change or another column is clicked
+        const std::vector<GameEvent>& events = *g_sources->events;
+        g_learningEventsSorter.Update((int)events.size(), g_sources->eventsGeneration);
+        
+        ImGuiListClipper clipper;
+        clipper.Begin(g_learningEventsSorter.GetRowCount());
+        while (clipper.Step())
+        {
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            {
+                const GameEvent& event = events[g_learningEventsSorter.GetRow(n)];
+                std::time_t time = std::chrono::system_clock::to_time_t(event.timestamp);
+                char timeText[16];
+                std::strftime(timeText, sizeof(timeText), "%H:%M:%S", std::localtime(&time));
+                
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(timeText);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(event.type.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(event.data.c_str());
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    static void RenderHealthManaHistory()
+    {
+        static const char* RANGE_NAMES[] = { "10 minutos", "1 hora", "24 horas", "7 dias" };
+        static const int64_t RANGE_MS[] = { 10 * 60 * 1000LL, 3600 * 1000LL, 24 * 3600 * 1000LL, 7 * 24 * 3600 * 1000LL };
+        static const size_t PLOT_POINTS = 240;
+        
+        ImGui::SetNextItemWidth(120);
+        ImGui::Combo("Período", &g_healthManaRange, RANGE_NAMES, IM_ARRAYSIZE(RANGE_NAMES));
+        
+        // Decimated by the series (raw samples or 1 s / 1 min / 1 h buckets), so the cost doesn't grow with the session
+        const HealthManaSeries& series = *g_sources->healthMana;
+        const int64_t now = g_sources->wallTime;
+        static std::vector<HealthManaPoint> points;
+        static std::vector<float> health, mana;
+        series.Query(now - RANGE_MS[g_healthManaRange], now + 1, PLOT_POINTS, points);
+        
+        health.resize(points.size());
+        mana.resize(points.size());
+        for (size_t n = 0; n < points.size(); n++)
+        {
+            health[n] = points[n].maxHealth > 0 ? 100.0f * points[n].healthMin / points[n].maxHealth : 0.0f;
+            mana[n] = points[n].maxMana > 0 ? 100.0f * points[n].manaAvg / points[n].maxMana : 0.0f;
+        }
+        
+        ImGui::PlotLines("HP mín. %", health.data(), (int)health.size(), 0, nullptr, 0.0f, 100.0f, ImVec2(0, 50));
+        ImGui::PlotLines("MP méd. %", mana.data(), (int)mana.size(), 0, nullptr, 0.0f, 100.0f, ImVec2(0, 50));
+        ImGui::Text("%lld amostras, %.1f KB", (long long)series.GetSampleCount(), series.GetMemoryUsage() / 1024.0);
+    }
+    
+    static void RenderSessionStats()
+    {
+        static const char* METRIC_NAMES[SessionStats::METRIC_COUNT] = { "Abates", "Experiência", "Dano recebido", "Poções de vida", "Poções de mana" };
+        static const size_t TOP_SPOTS = 5;
+        
+        SessionStats& sessionStats = *g_sources->sessionStats;
+        const int64_t now = g_sources->time;
+        const bool estimated = g_sources->experienceEstimated;     // Labeled as such wherever experience is shown
+        const int64_t elapsed = sessionStats.GetElapsed(now) / 1000;
+        ImGui::Text("Sessão: %lldh %02lldm", (long long)(elapsed / 3600), (long long)(elapsed / 60 % 60));
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Zerar") && g_sources->resetSessionStats)
+            g_sources->resetSessionStats();
+        
+        if (ImGui::BeginTable("SessionRates", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("");
+            ImGui::TableSetupColumn("Total");
+            ImGui::TableSetupColumn("/h (última hora)");
+            ImGui::TableSetupColumn("/h (média móvel)");
+            ImGui::TableHeadersRow();
+            for (int metric = 0; metric < SessionStats::METRIC_COUNT; metric++)
+            {
+                const RateMeter& meter = sessionStats.GetMeter((SessionStats::Metric)metric);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%s%s", METRIC_NAMES[metric], (estimated && metric == SessionStats::Experience) ? " (estimada)" : "");
+                ImGui::TableNextColumn(); ImGui::Text("%.0f", meter.GetTotal());
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", meter.GetWindowRate(now));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", meter.GetSmoothedRate(now));
+            }
+            ImGui::EndTable();
+        }
+        if (estimated)
+            ImGui::TextDisabled("Experiência estimada pelos abates (nível do monstro x 10), não lida do jogo");
+        
+        // Best spots by kills per hour. Only sorted while the header is open; spots are few (one per 16x16 tiles visited)
+        static std::vector<std::pair<SessionStats::Spot, SessionStats::Breakdown>> spots;
+        spots.assign(sessionStats.GetSpots().begin(), sessionStats.GetSpots().end());
+        const size_t shown = std::min(TOP_SPOTS, spots.size());
+        std::partial_sort(spots.begin(), spots.begin() + shown, spots.end(), [](const auto& a, const auto& b) {
+            return a.second.GetRate(SessionStats::Kills) > b.second.GetRate(SessionStats::Kills);
+        });
+        
+        ImGui::Text("Melhores locais (%d mapas, %d locais):", (int)sessionStats.GetMaps().size(), (int)spots.size());
+        if (ImGui::BeginTable("SessionSpots", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Mapa (x, y)");
+            ImGui::TableSetupColumn("Tempo");
+            ImGui::TableSetupColumn("Abates/h");
+            ImGui::TableSetupColumn(estimated ? "XP/h (est.)" : "XP/h");
+            ImGui::TableSetupColumn("Dano/h");
+            ImGui::TableHeadersRow();
+            for (size_t n = 0; n < shown; n++)
+            {
+                const SessionStats::Spot& spot = spots[n].first;
+                const SessionStats::Breakdown& breakdown = spots[n].second;
+                const bool current = sessionStats.HasSpot() && spot == sessionStats.GetCurrentSpot();
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%d (%d, %d)%s", spot.map, spot.cellX * SessionStats::SPOT_SIZE, spot.cellY * SessionStats::SPOT_SIZE, current ? " *" : "");
+                ImGui::TableNextColumn(); ImGui::Text("%lldm", (long long)(breakdown.timeMs / 60000));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", breakdown.GetRate(SessionStats::Kills));
+                ImGui::TableNextColumn(); ImGui::Text("%.0f", breakdown.GetRate(SessionStats::Experience));
+                ImGui::TableNextColumn(); ImGui::Text("%.0f", breakdown.GetRate(SessionStats::DamageTaken));
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    void RenderMainMenu()
+    {
+        BotConfig& config = *g_sources->config;
+        
+        if (g_menuSize == MenuSize::Compact)
+        {
+            ImGui::Text("MuBot - Menu Compacto");
+            if (ImGui::Button("PvE")) SetMenuState(MenuState::PvE);
+            ImGui::SameLine();
+            if (ImGui::Button("PvP")) SetMenuState(MenuState::PvP);
+            return;
+        }
+        
+        ImGui::Text("Menu Principal");
+        ImGui::Separator();
+        
+        // PvE Section
+        if (ImGui::Button("PvE", ImVec2(150, 40)))
+        {
+            SetMenuState(MenuState::PvE);
+        }
+        ImGui::SameLine();
+        ImGui::Text("Status: %s", config.pveEnabled ? "ATIVO" : "Inativo");
+        
+        // PvP Section
+        if (ImGui::Button("PvP", ImVec2(150, 40)))
+        {
+            SetMenuState(MenuState::PvP);
+        }
+        ImGui::SameLine();
+        ImGui::Text("Status: %s", config.pvpEnabled ? "ATIVO" : "Inativo");
+        
+        // License info
+        if (ImGui::Button("Informações da Licença", ImVec2(200, 30)))
+        {
+            SetMenuState(MenuState::License);
+        }
+        
+        ImGui::Separator();
+        
+        // Learning mode toggle
+        if (ImGui::Checkbox("Modo Aprendizado", &config.learningMode))
+        {
+            if (config.learningMode)
+                LogMessage("Modo aprendizado ativado - coletando dados do jogo");
+            else
+                LogMessage("Modo aprendizado desativado");
+        }
+        
+        if (config.learningMode && ImGui::CollapsingHeader("Eventos de Aprendizado"))
+        {
+            RenderLearningEvents();
+        }
+        
+        if (config.learningMode && ImGui::CollapsingHeader("Histórico HP/MP"))
+        {
+            RenderHealthManaHistory();
+        }
+        
+        if (ImGui::CollapsingHeader("Estatísticas da Sessão"))
+        {
+            RenderSessionStats();
+        }
+        
+        // Radar, drawn from the latest snapshot published by the game reader. Markers are built on a worker thread
+        if (ImGui::CollapsingHeader("Radar"))
+        {
+            g_radar.Draw("Radar", g_sources->snapshot, 180.0f, g_sources->workers);
+        }
+        
+        // ImGui memory usage of the previous frame
+        if (ImGui::CollapsingHeader("Memória"))
+        {
+            const ImGuiAllocator::FrameStats& stats = g_sources->allocator->GetLastFrameStats();
+            ImGui::Text("Alocações por frame: %d (%d em pools), liberações: %d", stats.allocCount, stats.pooledAllocCount, stats.freeCount);
+            ImGui::Text("Em uso: %.1f KB (pico %.1f KB)", stats.liveBytes / 1024.0, stats.peakLiveBytes / 1024.0);
+            ImGui::Text("Arena do frame: %.1f KB (pico %.1f KB)", stats.arenaBytes / 1024.0, stats.arenaPeakBytes / 1024.0);
+        }
+        
+        // Frame capture for offline replay and comparison (tools/draw_replay)
+        if (ImGui::CollapsingHeader("Gravação de Frames"))
+        {
+            DrawDataRecorder& recorder = *g_sources->recorder;
+            if (!recorder.IsRecording())
+            {
+                if (ImGui::Button("Gravar"))
+                {
+                    if (recorder.Start("mubot_frames.mbdd"))
+                        LogMessage("Gravação de frames iniciada: mubot_frames.mbdd");
+                    else
+                        LogMessage("Falha ao criar mubot_frames.mbdd");
+                }
+            }
+            else if (ImGui::Button("Parar"))
+            {
+                recorder.Stop();
+                LogMessage("Gravação de frames finalizada");
+            }
+            ImGui::Text("Frames: %d, %.1f MB", recorder.GetFrameCount(), recorder.GetWrittenBytes() / (1024.0 * 1024.0));
+            if (recorder.HasFailed())
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Erro de escrita, gravação interrompida");
+        }
+        
+        // Log messages
+        if (ImGui::CollapsingHeader("Log"))
+        {
+            g_logConsole.Draw("LogScroll", ImVec2(0, 100));
+        }
+    }
+
+    void RenderPvEMenu()
+    {
+        BotConfig& config = *g_sources->config;
+        
+        if (ImGui::Button("← Voltar"))
+        {
+            if (config.pveEnabled)
+            {
+                ShowConfirmDialog("Deseja retornar ao menu principal? Isso desativará o PvE.", []() {
+                    g_sources->config->pveEnabled = false;
+                    SetMenuState(MenuState::Main);
+                });
+            }
+            else
+            {
+                SetMenuState(MenuState::Main);
+            }
+        }
+        
+        ImGui::Separator();
+        ImGui::Text("Sistema PvE");
+        
+        if (ImGui::Checkbox("Ativar PvE", &config.pveEnabled))
+        {
+            if (config.pveEnabled)
+                LogMessage("PvE ativado");
+            else
+                LogMessage("PvE desativado");
+        }
+        
+        if (config.pveEnabled)
+        {
+            ImGui::Separator();
+            
+            ImGui::Checkbox("Auto Farm", &config.autoFarm);
+            ImGui::Checkbox("Auto Reset", &config.autoReset);
+            if (config.autoReset)
+            {
+                ImGui::SliderInt("Nível para Reset", &config.resetLevel, 300, 500);
+            }
+            
+            ImGui::Checkbox("Coleta de Itens (ALT)", &config.autoCollectItems);
+            ImGui::Checkbox("Auto Pot", &config.autoPot);
+            
+            if (config.autoPot)
+            {
+                ImGui::SliderInt("Vida %", &config.healthPotPercent, 10, 90);
+                ImGui::SliderInt("Mana %", &config.manaPotPercent, 10, 90);
+            }
+            
+            // Skills configuration
+            if (ImGui::CollapsingHeader("Configuração de Skills"))
+            {
+                static char skillName[64] = "";
+                static int skillDelay = 1000;
+                static int skillKey = KEY_F1;
+                
+                ImGui::InputText("Nome da Skill", skillName, sizeof(skillName));
+                ImGui::SliderInt("Delay (ms)", &skillDelay, 100, 5000);
+                ImGui::SliderInt("Tecla", &skillKey, KEY_F1, KEY_F12);
+                
+                if (ImGui::Button("Adicionar Skill"))
+                {
+                    if (strlen(skillName) > 0)
+                    {
+                        config.skillList.push_back(std::string(skillName));
+                        config.skillDelays.push_back(skillDelay);
+                        config.skillKeys.push_back(skillKey);
+                        memset(skillName, 0, sizeof(skillName));
+                    }
+                }
+                
+                // Display current skills
+                for (size_t i = 0; i < config.skillList.size(); ++i)
+                {
+                    ImGui::Text("%s - Delay: %dms - Tecla: F%d", 
+                               config.skillList[i].c_str(), 
+                               config.skillDelays[i],
+                               config.skillKeys[i] - KEY_F1 + 1);
+                    ImGui::SameLine();
+                    if (ImGui::Button(g_sources->allocator->FrameFormat("Remover##%zu", i)))
+                    {
+                        config.skillList.erase(config.skillList.begin() + i);
+                        config.skillDelays.erase(config.skillDelays.begin() + i);
+                        config.skillKeys.erase(config.skillKeys.begin() + i);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    void RenderPvPMenu()
+    {
+        BotConfig& config = *g_sources->config;
+        
+        if (ImGui::Button("← Voltar"))
+        {
+            if (config.pvpEnabled)
+            {
+                ShowConfirmDialog("Deseja retornar ao menu principal? Isso desativará o PvP.", []() {
+                    g_sources->config->pvpEnabled = false;
+                    SetMenuState(MenuState::Main);
+                });
+            }
+            else
+            {
+                SetMenuState(MenuState::Main);
+            }
+        }
+        
+        ImGui::Separator();
+        ImGui::Text("Sistema PvP");
+        
+        if (ImGui::Checkbox("Ativar PvP", &config.pvpEnabled))
+        {
+            if (config.pvpEnabled)
+                LogMessage("PvP ativado");
+            else
+                LogMessage("PvP desativado");
+        }
+        
+        if (config.pvpEnabled)
+        {
+            ImGui::Separator();
+            
+            ImGui::Checkbox("Alvo Automático", &config.pvpAutoTarget);
+            ImGui::Checkbox("Auto Shield", &config.autoShield);
+            
+            if (config.autoShield)
+            {
+                ImGui::SliderInt("Shield quando vida < %", &config.shieldHealthPercent, 10, 90);
+            }
+            
+            // Combos configuration
+            if (ImGui::CollapsingHeader("Combos"))
+            {
+                static char comboName[128] = "";
+                ImGui::InputText("Combo", comboName, sizeof(comboName));
+                
+                if (ImGui::Button("Adicionar Combo"))
+                {
+                    if (strlen(comboName) > 0)
+                    {
+                        config.combos.push_back(std::string(comboName));
+                        memset(comboName, 0, sizeof(comboName));
+                    }
+                }
+                
+                // Display current combos
+                for (size_t i = 0; i < config.combos.size(); ++i)
+                {
+                    ImGui::Text("%zu. %s", i + 1, config.combos[i].c_str());
+                    ImGui::SameLine();
+                    if (ImGui::Button(g_sources->allocator->FrameFormat("Remover##combo%zu", i)))
+                    {
+                        config.combos.erase(config.combos.begin() + i);
+                        break;
+                    }
+                }
+            }
+            
+            // PvP Statistics
+            if (ImGui::CollapsingHeader("Estatísticas"))
+            {
+                const PvPStatistics& stats = g_sources->pvpStatistics;
+                ImGui::Text("Dano Total: %.0f", stats.totalDamage);
+                ImGui::Text("Vitórias: %d", stats.wins);
+                ImGui::Text("Mortes: %d", stats.deaths);
+                ImGui::Text("K/D Ratio: %.2f", stats.deaths > 0 ? (float)stats.wins / stats.deaths : (float)stats.wins);
+            }
+        }
+    }
+
+    void RenderLicenseMenu()
+    {
+        if (ImGui::Button("← Voltar"))
+        {
+            SetMenuState(MenuState::Main);
+        }
+        
+        ImGui::Separator();
+        ImGui::Text("Informações da Licença");
+        ImGui::Separator();
+        
+        const LicenseInfo& licenseInfo = g_sources->license;
+        
+        ImGui::Text("Usuário: %s", licenseInfo.usuario.c_str());
+        ImGui::Text("Validade: %s", licenseInfo.validadeStr.c_str());
+        
+        int daysRemaining = g_sources->daysRemaining;
+        ImVec4 color = (daysRemaining < 5) ? ImVec4(1.0f, 0.0f, 0.0f, 1.0f) : ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
+        ImGui::TextColored(color, "Dias restantes: %d", daysRemaining);
+        
+        ImGui::Text("PCs permitidos: %d", licenseInfo.quantidadePCs);
+        ImGui::Text("Status: %s", g_sources->licenseValid ? "VÁLIDA" : "INVÁLIDA");
+    }
+
+    MenuState GetCurrentState()
+    {
+        return g_currentState;
+    }
+
+    void SetMenuState(MenuState state)
+    {
+        g_currentState = state;
+    }
+
+    MenuSize GetMenuSize()
+    {
+        return g_menuSize;
+    }
+
+    void ToggleMenuSize()
+    {
+        g_menuSize = (g_menuSize == MenuSize::Full) ? MenuSize::Compact : MenuSize::Full;
+    }
+
+    void LogMessage(const std::string& message)
+    {
+        auto now = std::chrono::system_clock::now();
+        auto time_t = std::chrono::system_clock::to_time_t(now);
+        auto tm = *std::localtime(&time_t);
+        
+        std::stringstream ss;
+        ss << "[" << std::put_time(&tm, "%H:%M:%S") << "] " << message;
+        
+        std::string line = ss.str();
+        g_logConsole.AddLine(line.c_str(), line.c_str() + line.size());
+    }
+
+    void ClearLog()
+    {
+        g_logConsole.Clear();
+    }
+
+    void ShowConfirmDialog(const std::string& message, std::function<void()> onConfirm)
+    {
+        g_confirmMessage = message;
+        g_confirmCallback = onConfirm;
+        g_showConfirmDialog = true;
+    }
+}
\ No newline at end of file
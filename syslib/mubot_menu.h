@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "mubot.h"
+#include "license_validator.h"
+#include "learning_system.h"
+#include "pvp_system.h"
+#include "world_snapshot.h"
+
+class SessionStats;
+class ImGuiAllocator;
+class WorkerDrawLists;
+class DrawDataRecorder;
+
+namespace MuBot
+{
+    // Everything the menu shows or edits besides its own widget state. mubot.cpp fills it from the bot's systems,
+    // tools/ui_bench from simulated ones: the menu only talks to ImGui, so it also runs outside the game client.
+    // All pointers but workers must be set.
+    struct MenuSources
+    {
+        BotConfig* config = nullptr;
+        LicenseInfo license;
+        const std::vector<GameEvent>* events = nullptr;
+        const HealthManaSeries* healthMana = nullptr;
+        SessionStats* sessionStats = nullptr;
+        std::function<void()> resetSessionStats;       // "Zerar" button
+        ImGuiAllocator* allocator = nullptr;
+        WorkerDrawLists* workers = nullptr;             // Radar markers, built inline if null
+        DrawDataRecorder* recorder = nullptr;
+
+        // Refreshed every frame, before RenderMenu()
+        int64_t time = 0;                               // Steady clock, in ms: the time base of sessionStats
+        int64_t wallTime = 0;                           // System clock, in ms: the time base of healthMana
+        bool experienceEstimated = false;               // sessionStats' experience is an estimate, not the game's value
+        bool licenseValid = false;
+        int daysRemaining = 0;
+        unsigned int eventsGeneration = 0;              // Changes whenever events are added or removed
+        PvPStatistics pvpStatistics;
+        std::shared_ptr<const WorldSnapshot> snapshot;
+    };
+
+    void SetMenuSources(MenuSources* sources);      // Before the first RenderMenu(). Must outlive the menu
+
+    void RenderMainMenu();
+    void RenderPvEMenu();
+    void RenderPvPMenu();
+    void RenderLicenseMenu();
+}
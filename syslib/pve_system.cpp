@@ -189,6 +189,7 @@ void PvESystem::ProcessAutoPot()
     {
         SendKey(VK_F1); // Health pot key (example)
         simulatedHealth = 100;
+        m_healthPotionsUsed++;
         MuBot::LogMessage("Auto Pot: Usando poção de vida");
     }
     
@@ -197,6 +198,7 @@ void PvESystem::ProcessAutoPot()
     {
         SendKey(VK_F2); // Mana pot key (example)
         simulatedMana = 100;
+        m_manaPotionsUsed++;
         MuBot::LogMessage("Auto Pot: Usando poção de mana");
     }
 }
@@ -19,6 +19,10 @@ public:
     void AddSkill(const std::string& name, int delay, int key);
     void RemoveSkill(size_t index);
     void ClearSkills();
+    
+    // Potions used since Initialize(), for incremental statistics
+    unsigned int GetHealthPotionsUsed() const { return m_healthPotionsUsed; }
+    unsigned int GetManaPotionsUsed() const { return m_manaPotionsUsed; }
 
 private:
     void ProcessAutoFarm();
@@ -38,6 +42,8 @@ private:
     int m_resetLevel = 400;
     int m_healthPotPercent = 30;
     int m_manaPotPercent = 20;
+    unsigned int m_healthPotionsUsed = 0;
+    unsigned int m_manaPotionsUsed = 0;
     
     struct Skill
     {
@@ -1,5 +1,6 @@
 #include "pvp_system.h"
 #include "mubot.h"
+#include <Windows.h>
 #include <thread>
 #include <sstream>
 
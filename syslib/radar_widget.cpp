@@ -0,0 +1,161 @@
+#include "radar_widget.h"
+
+#include <algorithm>
+
+static const ImU32 RADAR_COLORS[] =
+{
+    IM_COL32(230, 60, 50, 255),     // WorldSnapshot::Monster
+    IM_COL32(240, 200, 60, 255),    // WorldSnapshot::Item
+};
+static const int RADAR_TYPE_COUNT = (int)(sizeof(RADAR_COLORS) / sizeof(RADAR_COLORS[0]));
+
+void RadarWidget::Draw(const char* id, std::shared_ptr<const WorldSnapshot> snapshot, float size, WorkerDrawLists* workers)
+{
+    ImGui::PushID(id);
+    const ImVec2 p0 = ImGui::GetCursorScreenPos();
+    const ImVec2 p1(p0.x + size, p0.y + size);
+    ImGui::InvisibleButton("canvas", ImVec2(size, size));
+
+    // Mouse wheel zooms
+    if (ImGui::IsItemHovered() && ImGui::GetIO().MouseWheel != 0.0f)
+        m_range = std::min(std::max(m_range * (ImGui::GetIO().MouseWheel > 0.0f ? 0.8f : 1.25f), 10.0f), 2000.0f);
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    const ImVec2 center((p0.x + p1.x) * 0.5f, (p0.y + p1.y) * 0.5f);
+    const float halfSize = size * 0.5f;
+    drawList->AddRectFilled(p0, p1, IM_COL32(15, 20, 15, 220));
+    drawList->AddCircle(center, halfSize * 0.5f, IM_COL32(60, 90, 60, 255));
+    drawList->AddCircle(center, halfSize, IM_COL32(60, 90, 60, 255));
+    drawList->AddLine(ImVec2(center.x, p0.y), ImVec2(center.x, p1.y), IM_COL32(40, 60, 40, 255));
+    drawList->AddLine(ImVec2(p0.x, center.y), ImVec2(p1.x, center.y), IM_COL32(40, 60, 40, 255));
+    drawList->AddRect(p0, p1, IM_COL32(60, 90, 60, 255));
+
+    // Markers cost grows with the entity count: build them on a worker when possible
+    const float range = m_range;
+    if (workers != nullptr)
+    {
+        workers->Submit(p0, p1, [this, snapshot, center, halfSize, range](ImDrawList* layer) { BuildLayer(layer, snapshot.get(), center, halfSize, range); });
+    }
+    else
+    {
+        drawList->PushClipRect(p0, p1, true);
+        BuildLayer(drawList, snapshot.get(), center, halfSize, range);
+        drawList->PopClipRect();
+    }
+
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Alcance: %.0f\nEntidades visíveis: %d\nMarcadores: %d", m_range, m_visibleCount.load(), m_markerCount.load());
+    ImGui::PopID();
+}
+
+void RadarWidget::BuildLayer(ImDrawList* drawList, const WorldSnapshot* snapshot, const ImVec2& center, float halfSize, float range)
+{
+    if (snapshot != nullptr)
+    {
+        BinEntities(*snapshot, center, halfSize, range);
+        BuildMarkers();
+        DrawMarkers(drawList);
+    }
+    else
+    {
+        m_visibleCount = 0;
+        m_markerCount = 0;
+    }
+
+    // Player, above the markers
+    drawList->AddTriangleFilled(ImVec2(center.x, center.y - 5.0f), ImVec2(center.x - 4.0f, center.y + 4.0f), ImVec2(center.x + 4.0f, center.y + 4.0f), IM_COL32(80, 200, 255, 255));
+}
+
+void RadarWidget::BinEntities(const WorldSnapshot& snapshot, const ImVec2& center, float halfSize, float range)
+{
+    const int gridSize = std::max((int)(halfSize * 2.0f) / CELL_SIZE, 1);
+    if (gridSize != m_gridSize)
+    {
+        m_gridSize = gridSize;
+        m_cells.assign((size_t)gridSize * gridSize * RADAR_TYPE_COUNT, Cell());
+        m_usedCells.clear();
+    }
+
+    // Clear only the cells used last frame
+    for (int cell : m_usedCells)
+        m_cells[cell].count = 0;
+    m_usedCells.clear();
+
+    // Cull against the view square in world units first, then bin the screen position
+    const float scale = halfSize / range;
+    const float originX = center.x - halfSize;
+    const float originY = center.y - halfSize;
+    const float cellScale = (float)gridSize / (halfSize * 2.0f);
+    const int playerX = snapshot.playerX;
+    const int playerY = snapshot.playerY;
+    int visibleCount = 0;
+    for (const WorldSnapshot::Entity& entity : snapshot.entities)
+    {
+        const float dx = (float)(entity.x - playerX);
+        const float dy = (float)(entity.y - playerY);
+        // Non-short-circuit tests: one predictable branch per entity instead of four random ones
+        const bool inside = (dx >= -range) & (dx < range) & (dy >= -range) & (dy < range) & (entity.type < RADAR_TYPE_COUNT);
+        if (!inside)
+            continue;
+        visibleCount++;
+
+        const float screenX = center.x + dx * scale;
+        const float screenY = center.y + dy * scale;
+        const int cellX = std::min((int)((screenX - originX) * cellScale), gridSize - 1);
+        const int cellY = std::min((int)((screenY - originY) * cellScale), gridSize - 1);
+        const int index = (entity.type * gridSize + cellY) * gridSize + cellX;
+        Cell& cell = m_cells[index];
+        if (cell.count == 0)
+        {
+            cell.sumX = cell.sumY = 0.0f;
+            m_usedCells.push_back(index);
+        }
+        cell.sumX += screenX;
+        cell.sumY += screenY;
+        cell.count++;
+    }
+    m_visibleCount = visibleCount;
+}
+
+void RadarWidget::BuildMarkers()
+{
+    m_singleMin.clear();
+    m_singleMax.clear();
+    m_singleColors.clear();
+    for (int bucket = 0; bucket < CLUSTER_BUCKETS; bucket++)
+    {
+        m_clusterCenters[bucket].clear();
+        m_clusterColors[bucket].clear();
+    }
+
+    // Cells are scanned in first-use order, so markers keep a stable order while entities don't move
+    const float halfMarker = 2.0f;
+    const int cellsPerType = m_gridSize * m_gridSize;
+    for (int index : m_usedCells)
+    {
+        const Cell& cell = m_cells[index];
+        const ImU32 color = RADAR_COLORS[index / cellsPerType];
+        const ImVec2 pos(cell.sumX / cell.count, cell.sumY / cell.count);
+        if (cell.count == 1)
+        {
+            m_singleMin.push_back(ImVec2(pos.x - halfMarker, pos.y - halfMarker));
+            m_singleMax.push_back(ImVec2(pos.x + halfMarker, pos.y + halfMarker));
+            m_singleColors.push_back(color);
+        }
+        else
+        {
+            const int bucket = cell.count < 10 ? 0 : cell.count < 100 ? 1 : 2;
+            m_clusterCenters[bucket].push_back(pos);
+            m_clusterColors[bucket].push_back(color);
+        }
+    }
+    m_markerCount = (int)m_usedCells.size();
+}
+
+void RadarWidget::DrawMarkers(ImDrawList* drawList) const
+{
+    static const float CLUSTER_RADIUS[CLUSTER_BUCKETS] = { 3.5f, 5.0f, 7.0f };
+    for (int bucket = 0; bucket < CLUSTER_BUCKETS; bucket++)
+        drawList->AddCircleFilledBatch(m_clusterCenters[bucket].data(), CLUSTER_RADIUS[bucket], m_clusterColors[bucket].data(), (int)m_clusterCenters[bucket].size(), 8);
+    drawList->AddRectFilledBatch(m_singleMin.data(), m_singleMax.data(), m_singleColors.data(), (int)m_singleMin.size());
+}
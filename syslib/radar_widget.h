@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "world_snapshot.h"
+#include "worker_draw_lists.h"
+#include "external/imgui/imgui.h"
+
+// Radar centered on the player, drawn from a WorldSnapshot (never touches GameReader state, so it never waits for it).
+// Entities outside the view are culled, entities closer than a marker are merged into one cluster marker,
+// and markers are submitted with the batched ImDrawList calls, so the cost stays flat with thousands of entities.
+class RadarWidget
+{
+public:
+    // Call once per frame. With 'workers', markers are built on a worker thread (the widget must outlive the frame).
+    void Draw(const char* id, std::shared_ptr<const WorldSnapshot> snapshot, float size, WorkerDrawLists* workers = nullptr);
+
+    float GetRange() const { return m_range; }
+    void SetRange(float range) { m_range = range; }
+
+    int GetVisibleCount() const { return m_visibleCount; }     // Entities inside the view, last built frame
+    int GetMarkerCount() const { return m_markerCount; }       // Markers after clustering, last built frame
+
+private:
+    struct Cell
+    {
+        float sumX, sumY;
+        int count;
+    };
+
+    void BuildLayer(ImDrawList* drawList, const WorldSnapshot* snapshot, const ImVec2& center, float halfSize, float range);
+    void BinEntities(const WorldSnapshot& snapshot, const ImVec2& center, float halfSize, float range);
+    void BuildMarkers();
+    void DrawMarkers(ImDrawList* drawList) const;
+
+    static const int CELL_SIZE = 6;             // Pixels. Entities of a type within the same cell are drawn as one marker
+    static const int CLUSTER_BUCKETS = 3;       // Cluster marker sizes: 2-9, 10-99, 100+ entities
+
+    float m_range = 60.0f;                      // World units from the player to the edge of the radar
+
+    // Used by the marker builder only (worker thread when Draw() is given workers)
+    int m_gridSize = 0;
+    std::vector<Cell> m_cells;                  // m_gridSize * m_gridSize per entity type
+    std::vector<int> m_usedCells;               // Cells with count > 0, so clearing and scanning don't visit the whole grid
+
+    // Marker positions and colors, one array pair per batched draw call
+    std::vector<ImVec2> m_singleMin, m_singleMax;
+    std::vector<ImU32> m_singleColors;
+    std::vector<ImVec2> m_clusterCenters[CLUSTER_BUCKETS];
+    std::vector<ImU32> m_clusterColors[CLUSTER_BUCKETS];
+
+    std::atomic<int> m_visibleCount{ 0 };      // Written by the builder, read by the tooltip
+    std::atomic<int> m_markerCount{ 0 };
+};
@@ -0,0 +1,223 @@
+#include "session_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+static const char MBSS_MAGIC[4] = { 'M', 'B', 'S', 'S' };
+static const uint32_t MBSS_VERSION = 1;
+static const uint8_t RECORD_RATES = 1;
+static const uint8_t RECORD_SPOT = 2;
+static const uint8_t RECORD_MAP = 3;
+
+template <typename T>
+static void Put(std::string& out, T value)
+{
+    out.append((const char*)&value, sizeof(value));
+}
+
+static void PutRecord(std::string& out, uint8_t type, const std::string& payload)
+{
+    Put(out, type);
+    Put(out, (uint32_t)payload.size());
+    out += payload;
+}
+
+static int64_t FloorDiv(int64_t value, int64_t divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+void RateMeter::Reset(int64_t time)
+{
+    std::fill(m_buckets, m_buckets + BUCKET_COUNT, 0.0);
+    m_bucket = FloorDiv(time, BUCKET_MS);
+    m_windowSum = 0.0;
+    m_total = 0.0;
+    m_rate = 0.0;
+    m_rateTime = time;
+    m_start = time;
+}
+
+void RateMeter::Add(int64_t time, double amount)
+{
+    Advance(time);
+    m_buckets[m_bucket % BUCKET_COUNT] += amount;
+    m_windowSum += amount;
+    m_total += amount;
+
+    if (time > m_rateTime)
+    {
+        m_rate *= std::exp(-(double)(time - m_rateTime) / SMOOTHING_MS);
+        m_rateTime = time;
+    }
+    m_rate += amount / SMOOTHING_MS;
+}
+
+void RateMeter::Advance(int64_t time)
+{
+    const int64_t bucket = FloorDiv(time, BUCKET_MS);
+    if (bucket <= m_bucket)
+        return;
+
+    if (bucket - m_bucket >= BUCKET_COUNT)
+    {
+        std::fill(m_buckets, m_buckets + BUCKET_COUNT, 0.0);
+    }
+    else
+    {
+        for (int64_t n = m_bucket + 1; n <= bucket; n++)
+            m_buckets[n % BUCKET_COUNT] = 0.0;
+    }
+    m_bucket = bucket;
+
+    // Summed again rather than subtracted, so rounding errors don't accumulate over a long session
+    m_windowSum = 0.0;
+    for (double value : m_buckets)
+        m_windowSum += value;
+}
+
+double RateMeter::GetWindowRate(int64_t time) const
+{
+    const int64_t windowStart = std::max(m_start, (m_bucket - BUCKET_COUNT + 1) * BUCKET_MS);
+    const int64_t span = std::max<int64_t>(time - windowStart, (int64_t)BUCKET_MS);
+    return m_windowSum * 3600000.0 / span;
+}
+
+double RateMeter::GetSmoothedRate(int64_t time) const
+{
+    const double rate = time > m_rateTime ? m_rate * std::exp(-(double)(time - m_rateTime) / SMOOTHING_MS) : m_rate;
+
+    // The average starts at 0: divide by the weight the session has had so far, as if it had run at this rate before
+    const int64_t elapsed = std::max<int64_t>(time - m_start, (int64_t)BUCKET_MS);
+    const double weight = 1.0 - std::exp(-(double)elapsed / SMOOTHING_MS);
+    return rate / weight * 3600000.0;
+}
+
+size_t SessionStats::SpotHash::operator()(const Spot& spot) const
+{
+    uint64_t key = ((uint64_t)(uint32_t)spot.map << 32) ^ ((uint64_t)(uint16_t)spot.cellX << 16) ^ (uint16_t)spot.cellY;
+    key *= 0x9E3779B97F4A7C15ull;
+    return (size_t)(key ^ (key >> 32));
+}
+
+void SessionStats::Reset(int64_t time)
+{
+    for (RateMeter& meter : m_meters)
+        meter.Reset(time);
+    m_maps.clear();
+    m_spots.clear();
+    m_mapStats = nullptr;
+    m_spotStats = nullptr;
+    m_spot = {};
+    m_start = time;
+    m_lastTime = time;
+    m_hasPlayer = false;
+}
+
+void SessionStats::Update(int64_t time, int map, int x, int y, int health, int64_t experience)
+{
+    for (RateMeter& meter : m_meters)
+        meter.Advance(time);
+
+    // The time since the previous update was spent where the player was
+    if (m_spotStats && time > m_lastTime)
+    {
+        m_mapStats->timeMs += time - m_lastTime;
+        m_spotStats->timeMs += time - m_lastTime;
+    }
+    m_lastTime = std::max(m_lastTime, time);
+
+    const Spot spot = ToSpot(map, x, y);
+    if (!m_spotStats || !(spot == m_spot))
+    {
+        if (!m_mapStats || spot.map != m_spot.map)
+            m_mapStats = &m_maps[spot.map];
+        m_spotStats = &m_spots[spot];
+        m_spot = spot;
+    }
+
+    if (m_hasPlayer)
+    {
+        if (health < m_lastHealth)
+            Add(time, DamageTaken, m_lastHealth - health);
+        if (experience > m_lastExperience)
+            Add(time, Experience, (double)(experience - m_lastExperience));
+    }
+    m_lastHealth = health;
+    m_lastExperience = experience;
+    m_hasPlayer = true;
+}
+
+void SessionStats::OnLeftGame()
+{
+    m_mapStats = nullptr;
+    m_spotStats = nullptr;
+    m_hasPlayer = false;                // Possibly another character on return
+}
+
+void SessionStats::Add(int64_t time, Metric metric, double amount)
+{
+    m_meters[metric].Add(time, amount);
+    if (m_spotStats)
+    {
+        m_mapStats->values[metric] += amount;
+        m_spotStats->values[metric] += amount;
+    }
+}
+
+bool SessionStats::AppendLog(const std::string& path, int64_t time, int64_t wallTime, bool withSpots) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file)
+        return false;
+
+    std::string data;
+    file.seekp(0, std::ios::end);
+    if (file.tellp() == 0)
+    {
+        data.append(MBSS_MAGIC, sizeof(MBSS_MAGIC));
+        Put(data, MBSS_VERSION);
+    }
+
+    std::string payload;
+    Put(payload, wallTime);
+    Put(payload, GetElapsed(time));
+    for (const RateMeter& meter : m_meters)
+    {
+        Put(payload, meter.GetTotal());
+        Put(payload, meter.GetWindowRate(time));
+        Put(payload, meter.GetSmoothedRate(time));
+    }
+    PutRecord(data, RECORD_RATES, payload);
+
+    if (withSpots)
+    {
+        auto putBreakdown = [&](uint8_t type, const Spot& spot, const Breakdown& breakdown) {
+            payload.clear();
+            Put(payload, wallTime);
+            Put(payload, (int32_t)spot.map);
+            if (type == RECORD_SPOT)
+            {
+                Put(payload, (int32_t)spot.cellX);
+                Put(payload, (int32_t)spot.cellY);
+            }
+            Put(payload, breakdown.timeMs);
+            for (double value : breakdown.values)
+                Put(payload, value);
+            PutRecord(data, type, payload);
+        };
+        for (const auto& entry : m_maps)
+            putBreakdown(RECORD_MAP, { entry.first, 0, 0 }, entry.second);
+        for (const auto& entry : m_spots)
+            putBreakdown(RECORD_SPOT, entry.first, entry.second);
+    }
+
+    file.write(data.data(), data.size());
+    return (bool)file;
+}
+
+SessionStats::Spot SessionStats::ToSpot(int map, int x, int y)
+{
+    return { map, (int)FloorDiv(x, SPOT_SIZE), (int)FloorDiv(y, SPOT_SIZE) };
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Event rate over a sliding one hour window (60 one minute buckets) and an exponentially weighted rate, both O(1)
+// to update and to read. Times are ms of a monotonic clock.
+class RateMeter
+{
+public:
+    static const int BUCKET_COUNT = 60;
+    static const int BUCKET_MS = 60 * 1000;
+    static const int SMOOTHING_MS = 5 * 60 * 1000;     // EWMA time constant
+
+    void Reset(int64_t time);
+    void Add(int64_t time, double amount);
+    void Advance(int64_t time);         // Expires the buckets that left the window, at most once per bucket
+
+    double GetTotal() const { return m_total; }
+    double GetWindowTotal() const { return m_windowSum; }
+    // Per hour. Both cover at least one bucket, so the first seconds of a session don't extrapolate a single event
+    double GetWindowRate(int64_t time) const;      // Over the window as of the last Add/Advance
+    double GetSmoothedRate(int64_t time) const;    // EWMA, corrected for the time since Reset()
+
+private:
+    double m_buckets[BUCKET_COUNT] = {};
+    int64_t m_bucket = 0;               // Absolute index (time / BUCKET_MS) of the newest bucket
+    double m_windowSum = 0.0;
+    double m_total = 0.0;
+    double m_rate = 0.0;                // EWMA, per ms, as of m_rateTime
+    int64_t m_rateTime = 0;
+    int64_t m_start = 0;
+};
+
+// Farming statistics of the session: kills, experience, damage taken and potions, as totals, hourly rates and
+// per-map / per-spot breakdowns. Fed incrementally (per frame player state, per event counts), every update is O(1).
+class SessionStats
+{
+public:
+    enum Metric
+    {
+        Kills,
+        Experience,
+        DamageTaken,
+        HealthPotions,
+        ManaPotions,
+        METRIC_COUNT
+    };
+
+    // Spots are SPOT_SIZE x SPOT_SIZE tile cells of a map
+    static const int SPOT_SIZE = 16;
+
+    struct Spot
+    {
+        int map;
+        int cellX, cellY;
+
+        bool operator==(const Spot& other) const { return map == other.map && cellX == other.cellX && cellY == other.cellY; }
+    };
+
+    struct SpotHash
+    {
+        size_t operator()(const Spot& spot) const;
+    };
+
+    struct Breakdown
+    {
+        double values[METRIC_COUNT] = {};
+        int64_t timeMs = 0;             // Time the player spent there
+
+        double GetRate(Metric metric) const { return timeMs > 0 ? values[metric] * 3600000.0 / timeMs : 0.0; }
+    };
+
+    SessionStats() { Reset(0); }
+
+    void Reset(int64_t time);
+
+    // Once per frame while in game. Health lost since the previous call is damage taken, experience gained is counted
+    // (a drop, e.g. after a reset, isn't), and the elapsed time goes to the player's spot.
+    void Update(int64_t time, int map, int x, int y, int health, int64_t experience);
+    // While out of game (character select, reconnecting): no spot gets the events or the time until the next Update()
+    void OnLeftGame();
+    // Events (kills, potions), credited to the player's current spot
+    void Add(int64_t time, Metric metric, double amount = 1.0);
+
+    const RateMeter& GetMeter(Metric metric) const { return m_meters[metric]; }
+    int64_t GetElapsed(int64_t time) const { return time - m_start; }
+    bool HasSpot() const { return m_spotStats != nullptr; }
+    const Spot& GetCurrentSpot() const { return m_spot; }
+    const std::unordered_map<int, Breakdown>& GetMaps() const { return m_maps; }
+    const std::unordered_map<Spot, Breakdown, SpotHash>& GetSpots() const { return m_spots; }
+
+    // Appends a rates record (and, with 'withSpots', a record per map and per spot) to a binary stats log, creating
+    // it with its header if needed. Little-endian, no padding:
+    //   file:   "MBSS", u32 version, then records until the end of the file
+    //   record: u8 type, u32 payload size, payload
+    //   rates (type 1): i64 wall clock ms, i64 session ms, per metric f64 total, f64 window rate, f64 smoothed rate
+    //   spot (type 2):  i64 wall clock ms, i32 map, i32 cell x, i32 cell y, i64 time ms, per metric f64 total
+    //   map (type 3):   i64 wall clock ms, i32 map, i64 time ms, per metric f64 total
+    bool AppendLog(const std::string& path, int64_t time, int64_t wallTime, bool withSpots) const;
+
+private:
+    static Spot ToSpot(int map, int x, int y);
+
+    RateMeter m_meters[METRIC_COUNT];
+    std::unordered_map<int, Breakdown> m_maps;
+    std::unordered_map<Spot, Breakdown, SpotHash> m_spots;
+    Breakdown* m_mapStats = nullptr;    // Current map and spot, looked up only when they change (nodes don't move on rehash)
+    Breakdown* m_spotStats = nullptr;
+    Spot m_spot = {};
+
+    int64_t m_start = 0;
+    int64_t m_lastTime = 0;
+    bool m_hasPlayer = false;           // m_lastHealth / m_lastExperience are set
+    int m_lastHealth = 0;
+    int64_t m_lastExperience = 0;
+};
@@ -0,0 +1,113 @@
+#include "settings_writer.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <fstream>
+#include <sstream>
+
+SettingsWriter::~SettingsWriter()
+{
+    // Static instances are destroyed in DllMain (DLL_PROCESS_DETACH), where joining deadlocks on the loader lock: Stop()
+    // belongs to the unload path. A thread still running here is one the exiting process already killed.
+    if (m_thread.joinable())
+        m_thread.detach();
+}
+
+void SettingsWriter::Start(const std::string& path)
+{
+    Stop();
+    m_path = path;
+    m_stopping = false;
+    m_thread = std::thread(&SettingsWriter::ThreadMain, this);
+}
+
+void SettingsWriter::Stop()
+{
+    if (!m_thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+void SettingsWriter::Flush()
+{
+    // At process exit the writer thread is already gone, maybe killed holding a lock: take none that isn't free
+    std::unique_lock<std::mutex> fileLock(m_fileMutex, std::try_to_lock);
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+    if (!fileLock.owns_lock() || !lock.owns_lock() || !m_hasPending)
+        return;
+    m_hasPending = false;
+    if (m_pending == m_written)
+    {
+        m_skipCount++;
+    }
+    else if (WriteSnapshot(m_pending))
+    {
+        m_written.swap(m_pending);
+        m_writeCount++;
+    }
+}
+
+void SettingsWriter::Submit(const char* data, size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.assign(data, size);
+        m_hasPending = true;
+    }
+    m_condition.notify_one();
+}
+
+void SettingsWriter::ThreadMain()
+{
+    // Current file contents, so an unchanged first save doesn't rewrite it
+    {
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        std::ifstream file(m_path, std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        m_written = contents.str();
+    }
+
+    std::string snapshot;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_hasPending || m_stopping; });
+            if (!m_hasPending)
+                return;
+            snapshot.swap(m_pending);
+            m_hasPending = false;
+        }
+
+        std::lock_guard<std::mutex> fileLock(m_fileMutex);
+        if (snapshot == m_written)
+        {
+            m_skipCount++;
+            continue;
+        }
+        if (WriteSnapshot(snapshot))
+        {
+            m_written.swap(snapshot);
+            m_writeCount++;
+        }
+    }
+}
+
+bool SettingsWriter::WriteSnapshot(const std::string& data)
+{
+    // Write next to the target then rename over it, so a crash mid-write never leaves a truncated .ini
+    const std::string tempPath = m_path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(data.data(), data.size()) || !file.flush())
+            return false;
+    }
+    return MoveFileExA(tempPath.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+}
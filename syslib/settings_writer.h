@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Writes .ini snapshots on a background thread, so the render thread only serializes (SaveIniSettingsToMemory()).
+// The file is replaced atomically (temp file + rename) and left untouched when the snapshot equals the file contents.
+class SettingsWriter
+{
+public:
+    ~SettingsWriter();
+
+    void Start(const std::string& path);
+    void Stop();        // Writes the pending snapshot, if any, then joins the thread. Not from DllMain: see ~SettingsWriter()
+    void Flush();       // Writes the pending snapshot on the calling thread, without joining: for DllMain at process exit
+
+    // Replaces the pending snapshot: when saves come faster than the disk, only the latest one is written.
+    void Submit(const char* data, size_t size);
+
+    int GetWriteCount() const { return m_writeCount; }
+    int GetSkipCount() const { return m_skipCount; }
+
+private:
+    void ThreadMain();
+    bool WriteSnapshot(const std::string& data);
+
+    std::string m_path;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::string m_pending;
+    bool m_hasPending = false;
+    bool m_stopping = false;
+
+    std::mutex m_fileMutex;     // Held while the file is read or written, and for m_written
+    std::string m_written;      // Contents of the file after last write (or as found on start)
+    std::atomic<int> m_writeCount{ 0 };
+    std::atomic<int> m_skipCount{ 0 };
+};
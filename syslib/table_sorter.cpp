@@ -0,0 +1,146 @@
+#include "table_sorter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <thread>
+
+// Stable sort of row indices. Large inputs are split in chunks sorted on worker threads, then adjacent chunks are merged
+// pairwise (also in parallel). std::merge takes equal rows from the left chunk first, so the result matches std::stable_sort.
+template <typename Less>
+static void ParallelStableSort(std::vector<int>& order, Less less, int minRows, int maxThreads)
+{
+    const int count = (int)order.size();
+    const int threadCount = std::min((int)std::thread::hardware_concurrency(), maxThreads);
+    if (count < minRows || threadCount < 2)
+    {
+        std::stable_sort(order.begin(), order.end(), less);
+        return;
+    }
+
+    std::vector<int> bounds(threadCount + 1);
+    for (int i = 0; i <= threadCount; i++)
+        bounds[i] = (int)((long long)count * i / threadCount);
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; i++)
+        workers.emplace_back([&order, &bounds, &less, i]() { std::stable_sort(order.begin() + bounds[i], order.begin() + bounds[i + 1], less); });
+    std::stable_sort(order.begin() + bounds[0], order.begin() + bounds[1], less);
+    for (std::thread& worker : workers)
+        worker.join();
+
+    std::vector<int> buffer(count);
+    for (int width = 1; width < threadCount; width *= 2)
+    {
+        workers.clear();
+        for (int i = 0; i + width < threadCount; i += 2 * width)
+        {
+            const int begin = bounds[i];
+            const int middle = bounds[i + width];
+            const int end = bounds[std::min(i + 2 * width, threadCount)];
+            workers.emplace_back([&order, &buffer, &less, begin, middle, end]()
+            {
+                std::merge(order.begin() + begin, order.begin() + middle, order.begin() + middle, order.begin() + end, buffer.begin() + begin, less);
+                std::copy(buffer.begin() + begin, buffer.begin() + end, order.begin() + begin);
+            });
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+}
+
+void TableSorter::SetNumberColumn(int column, NumberKey key)
+{
+    if (column >= (int)m_columns.size())
+        m_columns.resize(column + 1);
+    m_columns[column].number = key;
+    m_columns[column].text = nullptr;
+    m_valid = false;
+}
+
+void TableSorter::SetTextColumn(int column, TextKey key)
+{
+    if (column >= (int)m_columns.size())
+        m_columns.resize(column + 1);
+    m_columns[column].number = nullptr;
+    m_columns[column].text = key;
+    m_valid = false;
+}
+
+bool TableSorter::Update(int rowCount, unsigned int generation)
+{
+    ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs();
+    const bool rowsChanged = !m_valid || rowCount != (int)m_order.size() || generation != m_generation;
+    if (!rowsChanged && (specs == nullptr || !specs->SpecsDirty))
+        return false;
+
+    m_generation = generation;
+    m_valid = true;
+    m_order.resize(rowCount);
+    std::iota(m_order.begin(), m_order.end(), 0);
+    if (specs != nullptr)
+    {
+        Sort(specs);
+        specs->SpecsDirty = false;
+    }
+    return true;
+}
+
+void TableSorter::ExtractKeys(const Column& column, std::vector<double>& values)
+{
+    const int rowCount = (int)m_order.size();
+    values.resize(rowCount);
+    if (column.number)
+    {
+        for (int row = 0; row < rowCount; row++)
+            values[row] = column.number(row);
+        return;
+    }
+
+    // Text: sort rows by text once, then compare ranks, so the main sort never compares strings
+    std::vector<const char*> texts(rowCount);
+    for (int row = 0; row < rowCount; row++)
+        texts[row] = column.text(row);
+    m_textOrder.resize(rowCount);
+    std::iota(m_textOrder.begin(), m_textOrder.end(), 0);
+    ParallelStableSort(m_textOrder, [&texts](int a, int b) { return strcmp(texts[a], texts[b]) < 0; }, PARALLEL_SORT_MIN_ROWS, MAX_SORT_THREADS);
+
+    int rank = 0;
+    for (int n = 0; n < rowCount; n++)
+    {
+        if (n > 0 && strcmp(texts[m_textOrder[n - 1]], texts[m_textOrder[n]]) != 0)
+            rank++;
+        values[m_textOrder[n]] = rank;
+    }
+}
+
+void TableSorter::Sort(const ImGuiTableSortSpecs* specs)
+{
+    m_keys.resize(specs->SpecsCount);
+    int keyCount = 0;
+    for (int n = 0; n < specs->SpecsCount; n++)
+    {
+        const ImGuiTableColumnSortSpecs& spec = specs->Specs[n];
+        if (spec.ColumnIndex >= (int)m_columns.size() || (!m_columns[spec.ColumnIndex].number && !m_columns[spec.ColumnIndex].text))
+            continue;
+        SortKey& key = m_keys[keyCount++];
+        ExtractKeys(m_columns[spec.ColumnIndex], key.values);
+        key.descending = (spec.SortDirection == ImGuiSortDirection_Descending);
+    }
+    m_keys.resize(keyCount);
+    if (keyCount == 0)
+        return;
+
+    const std::vector<SortKey>& keys = m_keys;
+    ParallelStableSort(m_order, [&keys](int a, int b)
+    {
+        for (const SortKey& key : keys)
+        {
+            const double valueA = key.values[a];
+            const double valueB = key.values[b];
+            if (valueA != valueB)
+                return key.descending ? valueA > valueB : valueA < valueB;
+        }
+        return false;
+    }, PARALLEL_SORT_MIN_ROWS, MAX_SORT_THREADS);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+
+// Sorted row order for an ImGui table with ImGuiTableFlags_Sortable.
+// Sorts a permutation of row indices instead of the rows, and only when the table sort specs or the rows change,
+// so drawing a large sorted table costs the same as drawing an unsorted one. Feed GetRow() from an ImGuiListClipper.
+class TableSorter
+{
+public:
+    // Sort key of a row in a column. Keys are read once per sort, comparisons only compare cached numbers.
+    using NumberKey = std::function<double(int row)>;
+    using TextKey = std::function<const char*(int row)>;
+
+    void SetNumberColumn(int column, NumberKey key);
+    void SetTextColumn(int column, TextKey key);
+
+    // Call every frame after TableSetupColumn(). 'generation' must change whenever rows are added, removed or modified.
+    // Returns true when the row order was rebuilt.
+    bool Update(int rowCount, unsigned int generation);
+
+    int GetRow(int displayIndex) const { return m_order[displayIndex]; }
+    int GetRowCount() const { return (int)m_order.size(); }
+
+private:
+    struct Column
+    {
+        NumberKey number;
+        TextKey text;
+    };
+
+    struct SortKey
+    {
+        std::vector<double> values;     // Per row: number, or rank of the text among all rows
+        bool descending;
+    };
+
+    void Sort(const ImGuiTableSortSpecs* specs);
+    void ExtractKeys(const Column& column, std::vector<double>& values);
+
+    static const int PARALLEL_SORT_MIN_ROWS = 16384;   // Below this, a single thread sorts faster than starting workers
+    static const int MAX_SORT_THREADS = 8;
+
+    std::vector<Column> m_columns;
+    std::vector<int> m_order;
+    std::vector<SortKey> m_keys;
+    std::vector<int> m_textOrder;       // Rows ordered by text, to rank text keys
+    unsigned int m_generation = 0;
+    bool m_valid = false;
+};
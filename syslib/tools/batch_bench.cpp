@@ -0,0 +1,201 @@
+// Benchmark and parity check of the batched ImDrawList primitives (AddRectFilledBatch(), AddQuadFilledBatch(),
+// AddCircleFilledBatch()) against one AddRectFilled()/AddQuadFilled()/AddCircleFilled() call per element.
+//
+// Each scenario fills a draw list with the same random elements (about 10% fully transparent) both ways, with and without
+// anti-aliased fill. Both must produce the same draw commands and indices, the same vertex colors and UVs, and vertex
+// positions within 1e-3 px (AA circles take their fringe from a precomputed ring, the rest is bit-exact). Time is the
+// best of several runs, in nanoseconds per element.
+//
+//   batch_bench [elements]     10000 by default. Exit code 1 if a batch differs from the single calls
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/batch_bench.cpp external/imgui/imgui.cpp external/imgui/imgui_draw.cpp
+//       external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o batch_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+static const int RUNS = 20;
+
+enum Shape { Rect, Quad, Circle };
+
+struct Scenario
+{
+    const char* name;
+    Shape shape;
+    float radius;
+    int segments;           // Circles, 0 for automatic
+};
+
+static const Scenario SCENARIOS[] =
+{
+    { "rect", Rect, 0.0f, 0 },
+    { "quad", Quad, 0.0f, 0 },
+    { "circle r=6.5", Circle, 6.5f, 0 },
+    { "circle r=40", Circle, 40.0f, 0 },
+    { "circle 12 seg", Circle, 10.0f, 12 },
+};
+
+struct Elements
+{
+    std::vector<ImVec2> min, max;   // Rects
+    std::vector<ImVec2> points;     // Quads, 4 per element
+    std::vector<ImVec2> centers;    // Circles
+    std::vector<ImU32> cols;
+};
+
+static Elements MakeElements(int count)
+{
+    std::mt19937 random(39);
+    auto coord = [&](float range) { return std::uniform_real_distribution<float>(0.0f, range)(random); };
+    Elements elements;
+    for (int n = 0; n < count; n++)
+    {
+        const ImVec2 a(coord(1200.0f), coord(650.0f));
+        elements.min.push_back(a);
+        elements.max.push_back(ImVec2(a.x + 2.0f + coord(60.0f), a.y + 2.0f + coord(60.0f)));
+        // Convex, clockwise on screen, as the radar's markers
+        const float size = 3.0f + coord(20.0f);
+        elements.points.push_back(ImVec2(a.x, a.y - size));
+        elements.points.push_back(ImVec2(a.x + size, a.y + coord(size * 0.5f)));
+        elements.points.push_back(ImVec2(a.x, a.y + size));
+        elements.points.push_back(ImVec2(a.x - size, a.y - coord(size * 0.5f)));
+        elements.centers.push_back(a);
+        const ImU32 alpha = (random() % 10 == 0) ? 0 : (ImU32)(random() % 255 + 1);
+        elements.cols.push_back((alpha << IM_COL32_A_SHIFT) | (random() & 0x00FFFFFF));
+    }
+    return elements;
+}
+
+static void ResetDrawList(ImDrawList& drawList, bool antiAliased)
+{
+    drawList._ResetForNewFrame();
+    drawList.Flags = antiAliased ? ImDrawListFlags_AntiAliasedFill : ImDrawListFlags_None;
+    drawList.PushTextureID(ImGui::GetIO().Fonts->TexID);
+    drawList.PushClipRect(ImVec2(0, 0), ImVec2(1280, 720));
+}
+
+static void Draw(ImDrawList& drawList, const Scenario& scenario, const Elements& elements, bool batch)
+{
+    const int count = (int)elements.cols.size();
+    switch (scenario.shape)
+    {
+    case Rect:
+        if (batch)
+            drawList.AddRectFilledBatch(elements.min.data(), elements.max.data(), elements.cols.data(), count);
+        else
+            for (int n = 0; n < count; n++)
+                drawList.AddRectFilled(elements.min[n], elements.max[n], elements.cols[n]);
+        break;
+    case Quad:
+        if (batch)
+            drawList.AddQuadFilledBatch(elements.points.data(), elements.cols.data(), count);
+        else
+            for (int n = 0; n < count; n++)
+                drawList.AddQuadFilled(elements.points[n * 4], elements.points[n * 4 + 1], elements.points[n * 4 + 2], elements.points[n * 4 + 3], elements.cols[n]);
+        break;
+    case Circle:
+        if (batch)
+            drawList.AddCircleFilledBatch(elements.centers.data(), scenario.radius, elements.cols.data(), count, scenario.segments);
+        else
+            for (int n = 0; n < count; n++)
+                drawList.AddCircleFilled(elements.centers[n], scenario.radius, elements.cols[n], scenario.segments);
+        break;
+    }
+}
+
+// Returns an error, or nullptr if both draw lists render the same
+static const char* Compare(const ImDrawList& a, const ImDrawList& b, float* maxDistance)
+{
+    if (a.CmdBuffer.Size != b.CmdBuffer.Size)
+        return "command count differs";
+    for (int n = 0; n < a.CmdBuffer.Size; n++)
+        if (a.CmdBuffer[n].ElemCount != b.CmdBuffer[n].ElemCount || a.CmdBuffer[n].VtxOffset != b.CmdBuffer[n].VtxOffset || a.CmdBuffer[n].IdxOffset != b.CmdBuffer[n].IdxOffset)
+            return "commands differ";
+    if (a.IdxBuffer.Size != b.IdxBuffer.Size || memcmp(a.IdxBuffer.Data, b.IdxBuffer.Data, a.IdxBuffer.size_in_bytes()) != 0)
+        return "indices differ";
+    if (a.VtxBuffer.Size != b.VtxBuffer.Size)
+        return "vertex count differs";
+    *maxDistance = 0.0f;
+    for (int n = 0; n < a.VtxBuffer.Size; n++)
+    {
+        const ImDrawVert& va = a.VtxBuffer[n];
+        const ImDrawVert& vb = b.VtxBuffer[n];
+        if (va.col != vb.col || va.uv.x != vb.uv.x || va.uv.y != vb.uv.y)
+            return "vertex colors or UVs differ";
+        *maxDistance = ImMax(*maxDistance, ImMax(fabsf(va.pos.x - vb.pos.x), fabsf(va.pos.y - vb.pos.y)));
+    }
+    return *maxDistance <= 1e-3f ? nullptr : "vertex positions differ";
+}
+
+static double TimePerElement(ImDrawList& drawList, const Scenario& scenario, const Elements& elements, bool antiAliased, bool batch)
+{
+    typedef std::chrono::steady_clock Clock;
+    double best = 0.0;
+    for (int run = 0; run < RUNS; run++)
+    {
+        ResetDrawList(drawList, antiAliased);
+        const Clock::time_point start = Clock::now();
+        Draw(drawList, scenario, elements, batch);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / elements.cols.size();
+        best = (run == 0) ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    const int count = argc > 1 ? std::max(atoi(argv[1]), 1) : 10000;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    ImGui::NewFrame();      // Sets up the shared data (circle segment table, fringe scale)
+
+    const Elements elements = MakeElements(count);
+    ImDrawList single(ImGui::GetDrawListSharedData());
+    ImDrawList batch(ImGui::GetDrawListSharedData());
+
+    bool ok = true;
+    printf("%d elements, best of %d runs, ns per element\n", count, RUNS);
+    printf("%-14s %-4s %9s %9s %8s %12s\n", "scenario", "AA", "single", "batch", "speedup", "max diff px");
+    for (const Scenario& scenario : SCENARIOS)
+    {
+        for (int antiAliased = 0; antiAliased < 2; antiAliased++)
+        {
+            // Rects have no anti-aliased fringe
+            if (scenario.shape == Rect && antiAliased)
+                continue;
+            ResetDrawList(single, antiAliased != 0);
+            Draw(single, scenario, elements, false);
+            ResetDrawList(batch, antiAliased != 0);
+            Draw(batch, scenario, elements, true);
+            float maxDistance = 0.0f;
+            const char* error = Compare(single, batch, &maxDistance);
+
+            const double singleNs = TimePerElement(single, scenario, elements, antiAliased != 0, false);
+            const double batchNs = TimePerElement(batch, scenario, elements, antiAliased != 0, true);
+            printf("%-14s %-4s %9.1f %9.1f %7.1fx %12.2g%s%s\n", scenario.name, antiAliased ? "on" : "off", singleNs, batchNs, singleNs / batchNs,
+                maxDistance, error ? " FAILED: " : "", error ? error : "");
+            ok = ok && !error;
+        }
+    }
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+// Offline tool for ImDrawData recordings (.mbdd, see draw_data_recorder.h). Needs no game, window or GPU.
+//
+//   draw_replay info <file>                Per-frame averages and peaks of lists, draw calls, vertices and indices
+//   draw_replay play <file> [loops]        Replays through a null backend and times it
+//   draw_replay diff <before> <after>      Compares two recordings frame by frame, exit code 1 if counts differ
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/draw_replay.cpp draw_data_recorder.cpp external/imgui/imgui.cpp
+//       external/imgui/imgui_draw.cpp external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -pthread -o draw_replay
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "draw_data_recorder.h"
+
+// What a backend would submit for a frame: same clipping and callback handling as imgui_impl_opengl2, without the GL calls
+struct NullFrameStats
+{
+    int issuedDrawCalls = 0;        // Draw calls left after discarding empty clip rects
+    long long triangles = 0;
+};
+
+// FNV-1a of all vertices and indices, to tell apart frames with the same counts
+static unsigned long long HashGeometry(const ImDrawData* drawData)
+{
+    unsigned long long hash = 14695981039346656037ull;
+    for (const ImDrawList* drawList : drawData->CmdLists)
+    {
+        const unsigned char* vtx = reinterpret_cast<const unsigned char*>(drawList->VtxBuffer.Data);
+        for (size_t i = 0; i < drawList->VtxBuffer.Size * sizeof(ImDrawVert); i++)
+            hash = (hash ^ vtx[i]) * 1099511628211ull;
+        const unsigned char* idx = reinterpret_cast<const unsigned char*>(drawList->IdxBuffer.Data);
+        for (size_t i = 0; i < drawList->IdxBuffer.Size * sizeof(ImDrawIdx); i++)
+            hash = (hash ^ idx[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static NullFrameStats NullRenderDrawData(const ImDrawData* drawData)
+{
+    NullFrameStats stats;
+    const ImVec2 clipOff = drawData->DisplayPos;
+    const ImVec2 clipScale = drawData->FramebufferScale;
+    const float fbHeight = drawData->DisplaySize.y * clipScale.y;
+    for (const ImDrawList* drawList : drawData->CmdLists)
+    {
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+        {
+            if (cmd.UserCallback != nullptr)
+                continue;
+            const ImVec2 clipMin((cmd.ClipRect.x - clipOff.x) * clipScale.x, (cmd.ClipRect.y - clipOff.y) * clipScale.y);
+            const ImVec2 clipMax((cmd.ClipRect.z - clipOff.x) * clipScale.x, (cmd.ClipRect.w - clipOff.y) * clipScale.y);
+            if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y || clipMin.y >= fbHeight || cmd.ElemCount == 0)
+                continue;
+            stats.issuedDrawCalls++;
+            stats.triangles += cmd.ElemCount / 3;
+        }
+    }
+    return stats;
+}
+
+static bool OpenOrReport(DrawDataPlayer& player, const char* path)
+{
+    if (player.Open(path))
+        return true;
+    fprintf(stderr, "%s\n", player.GetError().c_str());
+    return false;
+}
+
+static bool ReportError(const DrawDataPlayer& player)
+{
+    if (player.GetError().empty())
+        return false;
+    fprintf(stderr, "%s\n", player.GetError().c_str());
+    return true;
+}
+
+static int Info(const char* path)
+{
+    DrawDataPlayer player;
+    if (!OpenOrReport(player, path))
+        return 2;
+    DrawDataStats total, peak;
+    int frames = 0;
+    while (const ImDrawData* drawData = player.NextFrame())
+    {
+        const DrawDataStats stats = DrawDataStats::Measure(drawData);
+        total.listCount += stats.listCount;
+        total.drawCalls += stats.drawCalls;
+        total.vtxCount += stats.vtxCount;
+        total.idxCount += stats.idxCount;
+        peak.listCount = std::max(peak.listCount, stats.listCount);
+        peak.drawCalls = std::max(peak.drawCalls, stats.drawCalls);
+        peak.vtxCount = std::max(peak.vtxCount, stats.vtxCount);
+        peak.idxCount = std::max(peak.idxCount, stats.idxCount);
+        frames++;
+    }
+    if (ReportError(player))
+        return 2;
+    const double div = frames > 0 ? (double)frames : 1.0;
+    printf("%s: %d frames\n", path, frames);
+    printf("%-12s %12s %12s\n", "per frame", "average", "peak");
+    printf("%-12s %12.1f %12d\n", "lists", total.listCount / div, peak.listCount);
+    printf("%-12s %12.1f %12d\n", "draw calls", total.drawCalls / div, peak.drawCalls);
+    printf("%-12s %12.1f %12d\n", "vertices", total.vtxCount / div, peak.vtxCount);
+    printf("%-12s %12.1f %12d\n", "indices", total.idxCount / div, peak.idxCount);
+    return 0;
+}
+
+static int Play(const char* path, int loops)
+{
+    DrawDataPlayer player;
+    if (!OpenOrReport(player, path))
+        return 2;
+    typedef std::chrono::steady_clock Clock;
+    std::vector<double> frameTimes;
+    long long triangles = 0, issued = 0;
+    for (int loop = 0; loop < loops; loop++)
+    {
+        player.Rewind();
+        for (;;)
+        {
+            const Clock::time_point start = Clock::now();
+            const ImDrawData* drawData = player.NextFrame();
+            if (drawData == nullptr)
+                break;
+            const NullFrameStats stats = NullRenderDrawData(drawData);
+            frameTimes.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            triangles += stats.triangles;
+            issued += stats.issuedDrawCalls;
+        }
+        if (ReportError(player))
+            return 2;
+    }
+    if (frameTimes.empty())
+    {
+        printf("%s: no frames\n", path);
+        return 0;
+    }
+    std::sort(frameTimes.begin(), frameTimes.end());
+    double sum = 0.0;
+    for (double t : frameTimes)
+        sum += t;
+    const size_t count = frameTimes.size();
+    printf("%s: %zu frames replayed (%d loops), %.1f issued draw calls and %.1f triangles per frame\n",
+        path, count, loops, (double)issued / count, (double)triangles / count);
+    printf("read + null render per frame: avg %.1f us, median %.1f us, p99 %.1f us, max %.1f us\n",
+        sum / count, frameTimes[count / 2], frameTimes[std::min(count - 1, count * 99 / 100)], frameTimes.back());
+    return 0;
+}
+
+static void PrintDelta(const char* name, long long before, long long after, int frames)
+{
+    const double div = frames > 0 ? (double)frames : 1.0;
+    const double percent = before != 0 ? 100.0 * (after - before) / before : 0.0;
+    printf("%-12s %12.1f %12.1f %+9.1f%%\n", name, before / div, after / div, percent);
+}
+
+static int Diff(const char* pathBefore, const char* pathAfter)
+{
+    DrawDataPlayer before, after;
+    if (!OpenOrReport(before, pathBefore) || !OpenOrReport(after, pathAfter))
+        return 2;
+    long long totals[2][4] = {};
+    int frames = 0, countMismatches = 0, contentMismatches = 0;
+    for (;;)
+    {
+        const ImDrawData* a = before.NextFrame();
+        const ImDrawData* b = after.NextFrame();
+        if (a == nullptr || b == nullptr)
+        {
+            if (ReportError(before) || ReportError(after))
+                return 2;
+            if (a != nullptr || b != nullptr)
+                printf("recordings have different lengths, compared the first %d frames\n", frames);
+            break;
+        }
+        const DrawDataStats sa = DrawDataStats::Measure(a);
+        const DrawDataStats sb = DrawDataStats::Measure(b);
+        const int va[4] = { sa.listCount, sa.drawCalls, sa.vtxCount, sa.idxCount };
+        const int vb[4] = { sb.listCount, sb.drawCalls, sb.vtxCount, sb.idxCount };
+        for (int n = 0; n < 4; n++)
+        {
+            totals[0][n] += va[n];
+            totals[1][n] += vb[n];
+        }
+        if (memcmp(va, vb, sizeof(va)) != 0)
+        {
+            if (countMismatches < 20)
+                printf("frame %d: lists %d -> %d, draw calls %d -> %d, vertices %d -> %d, indices %d -> %d\n",
+                    frames, va[0], vb[0], va[1], vb[1], va[2], vb[2], va[3], vb[3]);
+            countMismatches++;
+        }
+        else if (HashGeometry(a) != HashGeometry(b))
+        {
+            contentMismatches++;
+        }
+        frames++;
+    }
+
+    printf("%d frames compared: %d with different counts, %d with same counts but different geometry\n",
+        frames, countMismatches, contentMismatches);
+    printf("%-12s %12s %12s %10s\n", "per frame", "before", "after", "change");
+    PrintDelta("lists", totals[0][0], totals[1][0], frames);
+    PrintDelta("draw calls", totals[0][1], totals[1][1], frames);
+    PrintDelta("vertices", totals[0][2], totals[1][2], frames);
+    PrintDelta("indices", totals[0][3], totals[1][3], frames);
+    return countMismatches > 0 ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "info") == 0)
+        return Info(argv[2]);
+    if (argc >= 3 && strcmp(argv[1], "play") == 0)
+        return Play(argv[2], argc >= 4 ? std::max(atoi(argv[3]), 1) : 1);
+    if (argc >= 4 && strcmp(argv[1], "diff") == 0)
+        return Diff(argv[2], argv[3]);
+    fprintf(stderr, "usage: draw_replay info <file>\n"
+                    "       draw_replay play <file> [loops]\n"
+                    "       draw_replay diff <before> <after>\n");
+    return 2;
+}
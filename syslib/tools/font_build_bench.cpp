@@ -0,0 +1,153 @@
+// Benchmark and parity check of the threaded ImFontAtlas::Build() (IMGUI_ENABLE_FONT_BUILD_THREADS, stb_truetype builder).
+//
+// For each font and glyph range set, builds the atlas with 1, 2, 4, 8 and 16 threads and reports
+// the best build time of several runs. Every threaded build must produce the same texture size, byte-identical alpha texels
+// and identical glyph tables as the single-threaded one. Rasterization is split in jobs of 128 glyphs: the CJK sets (about
+// 21,000 ideographs for chinese_full) run hundreds of jobs per font, provided the font has the glyphs.
+//
+//   font_build_bench [--runs N] [font.ttf ...]     Default font (ProggyClean) when no file is given. Exit code 1 on a mismatch
+//
+// Any font covering the CJK ranges exercises the multi-job path, e.g. Noto Sans CJK. None is shipped: the checks so far
+// used a test font made with fontTools (pip install fonttools) by mapping DejaVuSans glyphs onto the Hiragana/Katakana,
+// CJK Unified Ideographs and Hangul code points.
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/font_build_bench.cpp external/imgui/imgui.cpp external/imgui/imgui_draw.cpp
+//       external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -pthread -o font_build_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+#ifndef IMGUI_ENABLE_FONT_BUILD_THREADS
+#error font_build_bench needs IMGUI_ENABLE_FONT_BUILD_THREADS (imconfig.h)
+#endif
+
+static const float FONT_SIZE = 18.0f;
+static const int MAX_THREADS = 16;      // IM_FONT_BUILD_THREADS_MAX's default (imgui_draw.cpp)
+
+struct RangeSet
+{
+    const char* name;
+    const ImWchar* (ImFontAtlas::*ranges)();
+};
+
+static const RangeSet RANGE_SETS[] =
+{
+    { "default", &ImFontAtlas::GetGlyphRangesDefault },
+    { "cyrillic", &ImFontAtlas::GetGlyphRangesCyrillic },
+    { "japanese", &ImFontAtlas::GetGlyphRangesJapanese },
+    { "korean", &ImFontAtlas::GetGlyphRangesKorean },
+    { "chinese_full", &ImFontAtlas::GetGlyphRangesChineseFull },
+};
+
+// Output of a build, for comparison
+struct BuildResult
+{
+    double ms = 0.0;
+    int width = 0, height = 0;
+    int glyphs = 0;
+    std::vector<unsigned char> texels;
+    std::vector<ImFontGlyph> glyphTable;
+};
+
+static BuildResult Build(const char* path, const RangeSet& set, int threads)
+{
+    ImFontAtlas atlas;
+    atlas.FontBuilderThreadCount = threads;
+    ImFontConfig config;
+    config.SizePixels = FONT_SIZE;
+    const ImWchar* ranges = (atlas.*set.ranges)();
+    ImFont* font = path ? atlas.AddFontFromFileTTF(path, FONT_SIZE, &config, ranges) : atlas.AddFontDefault(&config);
+
+    BuildResult result;
+    if (!font)
+        return result;
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    atlas.Build();
+    result.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    result.width = atlas.TexWidth;
+    result.height = atlas.TexHeight;
+    result.glyphs = font->Glyphs.Size;
+    result.texels.assign(atlas.TexPixelsAlpha8, atlas.TexPixelsAlpha8 + atlas.TexWidth * atlas.TexHeight);
+    result.glyphTable.assign(font->Glyphs.begin(), font->Glyphs.end());
+    return result;
+}
+
+static bool SameOutput(const BuildResult& a, const BuildResult& b)
+{
+    return a.width == b.width && a.height == b.height && a.texels == b.texels && a.glyphTable.size() == b.glyphTable.size()
+        && memcmp(a.glyphTable.data(), b.glyphTable.data(), a.glyphTable.size() * sizeof(ImFontGlyph)) == 0;
+}
+
+int main(int argc, char** argv)
+{
+    int runs = 3;
+    std::vector<const char*> fonts;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--runs") == 0 && n + 1 < argc)
+            runs = std::max(atoi(argv[++n]), 1);
+        else
+            fonts.push_back(argv[n]);
+    }
+    if (fonts.empty())
+        fonts.push_back(nullptr);
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2)
+        threadCounts.push_back(threads);
+
+    printf("%u hardware threads, best of %d runs, %.0f px\n", std::thread::hardware_concurrency(), runs, FONT_SIZE);
+    printf("%-24s %-13s %7s %5s %10s", "font", "ranges", "glyphs", "jobs", "texture");
+    for (int threads : threadCounts)
+        printf(" %7dT", threads);
+    printf("\n");
+
+    bool ok = true;
+    for (const char* path : fonts)
+    {
+        const char* name = path ? (strrchr(path, '/') ? strrchr(path, '/') + 1 : path) : "ProggyClean";
+        for (const RangeSet& set : RANGE_SETS)
+        {
+            const BuildResult reference = Build(path, set, 1);
+            if (reference.texels.empty())
+            {
+                printf("%-24s %-13s failed to load\n", name, set.name);
+                ok = false;
+                continue;
+            }
+            char texture[32];
+            snprintf(texture, sizeof(texture), "%dx%d", reference.width, reference.height);
+            printf("%-24s %-13s %7d %5d %10s", name, set.name, reference.glyphs, (reference.glyphs + 127) / 128, texture);
+
+            std::string mismatches;
+            for (int threads : threadCounts)
+            {
+                double best = 0.0;
+                for (int run = 0; run < runs; run++)
+                {
+                    const BuildResult result = Build(path, set, threads);
+                    if (!SameOutput(result, reference))
+                        mismatches += " " + std::to_string(threads) + "T";
+                    best = (run == 0) ? result.ms : std::min(best, result.ms);
+                }
+                printf(" %6.1fms", best);
+            }
+            printf("%s\n", mismatches.empty() ? "" : (" MISMATCH" + mismatches).c_str());
+            ok = ok && mismatches.empty();
+        }
+    }
+    printf(ok ? "all builds identical to the single-threaded build\n" : "threaded builds differ\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+// Test and timings of the ImFontAtlas on-disk cache (ImFontAtlas::CacheFilename, ImFontAtlasBuildLoadCache() in imgui_draw.cpp).
+//
+// - cold:     Build() without a cache file rasterizes, then writes the file
+// - warm:     Build() with the file loads from it (TexLoadedFromCache). Texels, glyphs, custom rectangles, white pixel and line
+//             UVs, font metrics must match a build without cache
+// - fallback: the file is truncated, extended, corrupted (header fields, glyphs, texels) or made for other inputs. Build()
+//             must ignore it, rasterize an atlas identical to a build without cache, and rewrite a file the next Build() loads
+//
+// The atlas has two fonts and a custom glyph rectangle, like the menu's. Timings are the best of several runs.
+//
+//   font_cache_test [--runs N] [font.ttf]     Default font (ProggyClean) at two sizes when no file is given. Exit code 1 if a check fails
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/font_cache_test.cpp external/imgui/imgui.cpp external/imgui/imgui_draw.cpp
+//       external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -pthread -o font_cache_test
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+static const char* CACHE_FILENAME = "font_cache_test.cache";
+static const float FONT_SIZE = 18.0f;
+
+// Cache file layout, from ImFontAtlasCacheHeader and ImFontAtlasCacheFont (imgui_draw.cpp)
+static const size_t OFFSET_VERSION = 4;
+static const size_t OFFSET_KEY = 8;
+static const size_t OFFSET_CHECKSUM = 12;
+static const size_t OFFSET_TEX_WIDTH = 16;
+static const size_t HEADER_SIZE = 9 * 4 + sizeof(ImVec2) + (IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1) * sizeof(ImVec4);
+static const size_t FONT_RECORD_SIZE = 5 * 4;
+static const int FONTS_COUNT = 2;
+
+static int g_failures = 0;
+static const char* g_fontPath = nullptr;
+
+static bool Check(bool condition, const char* test, const char* what)
+{
+    if (!condition && g_failures++ < 20)
+        printf("%s: %s FAILED\n", test, what);
+    return condition;
+}
+
+typedef std::vector<unsigned char> Bytes;
+
+static Bytes ReadFile(const char* path)
+{
+    Bytes data;
+    if (FILE* f = fopen(path, "rb"))
+    {
+        unsigned char buffer[65536];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), f)) > 0)
+            data.insert(data.end(), buffer, buffer + read);
+        fclose(f);
+    }
+    return data;
+}
+
+static void WriteFile(const char* path, const Bytes& data)
+{
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr)
+    {
+        printf("can't write %s\n", path);
+        exit(1);
+    }
+    fwrite(data.data(), 1, data.size(), f);
+    fclose(f);
+}
+
+// Same inputs on every call, so the cache key is stable. 'padding' changes the inputs (and the key)
+static void SetupAtlas(ImFontAtlas& atlas, const char* cacheFilename, int padding = 1)
+{
+    atlas.CacheFilename = cacheFilename;
+    atlas.TexGlyphPadding = padding;
+    ImFontConfig config;
+    config.SizePixels = FONT_SIZE;
+    ImFont* font = g_fontPath ? atlas.AddFontFromFileTTF(g_fontPath, FONT_SIZE, &config, atlas.GetGlyphRangesCyrillic()) : atlas.AddFontDefault(&config);
+    config.SizePixels = FONT_SIZE * 2.0f;
+    atlas.AddFontDefault(&config);
+    atlas.AddCustomRectFontGlyph(font, 0xE000, 13, 13, 15.0f);
+}
+
+static double BuildMs(ImFontAtlas& atlas)
+{
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    atlas.Build();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool SameAtlas(ImFontAtlas& a, ImFontAtlas& b)
+{
+    unsigned char* pixelsA;
+    unsigned char* pixelsB;
+    int widthA, heightA, widthB, heightB;
+    a.GetTexDataAsAlpha8(&pixelsA, &widthA, &heightA);
+    b.GetTexDataAsAlpha8(&pixelsB, &widthB, &heightB);
+    if (widthA != widthB || heightA != heightB || memcmp(pixelsA, pixelsB, (size_t)widthA * heightA) != 0)
+        return false;
+    if (a.TexUvWhitePixel.x != b.TexUvWhitePixel.x || a.TexUvWhitePixel.y != b.TexUvWhitePixel.y
+        || memcmp(a.TexUvLines, b.TexUvLines, sizeof(a.TexUvLines)) != 0 || a.TexPixelsUseColors != b.TexPixelsUseColors)
+        return false;
+    if (a.CustomRects.Size != b.CustomRects.Size || a.Fonts.Size != b.Fonts.Size)
+        return false;
+    for (int n = 0; n < a.CustomRects.Size; n++)
+        if (a.CustomRects[n].X != b.CustomRects[n].X || a.CustomRects[n].Y != b.CustomRects[n].Y)
+            return false;
+    for (int n = 0; n < a.Fonts.Size; n++)
+    {
+        const ImFont* fontA = a.Fonts[n];
+        const ImFont* fontB = b.Fonts[n];
+        if (fontA->FontSize != fontB->FontSize || fontA->Ascent != fontB->Ascent || fontA->Descent != fontB->Descent
+            || fontA->MetricsTotalSurface != fontB->MetricsTotalSurface || fontA->Glyphs.Size != fontB->Glyphs.Size
+            || memcmp(fontA->Glyphs.Data, fontB->Glyphs.Data, fontA->Glyphs.size_in_bytes()) != 0)
+            return false;
+        if (fontA->IndexAdvanceX.Size != fontB->IndexAdvanceX.Size
+            || memcmp(fontA->IndexAdvanceX.Data, fontB->IndexAdvanceX.Data, fontA->IndexAdvanceX.size_in_bytes()) != 0)
+            return false;
+        if ((fontA->FallbackGlyph ? fontA->FallbackGlyph->Codepoint : 0) != (fontB->FallbackGlyph ? fontB->FallbackGlyph->Codepoint : 0))
+            return false;
+    }
+    return true;
+}
+
+struct Corruption
+{
+    const char* name;
+    std::function<void(Bytes&)> apply;
+};
+
+int main(int argc, char** argv)
+{
+    int runs = 5;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--runs") == 0 && n + 1 < argc)
+            runs = std::max(atoi(argv[++n]), 1);
+        else
+            g_fontPath = argv[n];
+    }
+    if (g_fontPath && ReadFile(g_fontPath).empty())
+    {
+        printf("can't load %s\n", g_fontPath);     // Checked here: without an ImGui context, AddFontFromFileTTF() can't report it
+        return 1;
+    }
+
+    // Reference: no cache
+    ImFontAtlas reference;
+    SetupAtlas(reference, nullptr);
+    double uncachedMs = 1e9;
+    for (int run = 0; run < runs; run++)
+    {
+        ImFontAtlas atlas;
+        SetupAtlas(atlas, nullptr);
+        uncachedMs = std::min(uncachedMs, BuildMs(atlas));
+    }
+    reference.Build();
+
+    // Cold: no file, rasterize then write it
+    double coldMs = 1e9;
+    for (int run = 0; run < runs; run++)
+    {
+        remove(CACHE_FILENAME);
+        ImFontAtlas atlas;
+        SetupAtlas(atlas, CACHE_FILENAME);
+        coldMs = std::min(coldMs, BuildMs(atlas));
+        Check(!atlas.TexLoadedFromCache, "cold", "rasterized");
+        Check(SameAtlas(atlas, reference), "cold", "same atlas as without cache");
+    }
+    const Bytes cache = ReadFile(CACHE_FILENAME);
+    if (!Check(cache.size() > HEADER_SIZE + FONTS_COUNT * FONT_RECORD_SIZE, "cold", "cache file written"))
+    {
+        printf("FAILED\n");
+        return 1;
+    }
+
+    // Warm: load from the file
+    double warmMs = 1e9;
+    for (int run = 0; run < runs; run++)
+    {
+        ImFontAtlas atlas;
+        SetupAtlas(atlas, CACHE_FILENAME);
+        warmMs = std::min(warmMs, BuildMs(atlas));
+        Check(atlas.TexLoadedFromCache, "warm", "loaded from cache");
+        Check(SameAtlas(atlas, reference), "warm", "same atlas as without cache");
+    }
+
+    // Fallback: every damaged file must be ignored, then replaced by a valid one
+    const size_t glyphsOffset = HEADER_SIZE + FONTS_COUNT * FONT_RECORD_SIZE;
+    const Corruption CORRUPTIONS[] =
+    {
+        { "empty file", [](Bytes& data) { data.clear(); } },
+        { "truncated header", [](Bytes& data) { data.resize(HEADER_SIZE - 1); } },
+        { "truncated font records", [](Bytes& data) { data.resize(HEADER_SIZE + FONT_RECORD_SIZE); } },
+        { "truncated glyphs", [=](Bytes& data) { data.resize(glyphsOffset + sizeof(ImFontGlyph) / 2); } },
+        { "truncated texels", [](Bytes& data) { data.pop_back(); } },
+        { "extra byte", [](Bytes& data) { data.push_back(0); } },
+        { "bad magic", [](Bytes& data) { data[0] ^= 0x01; } },
+        { "other version", [](Bytes& data) { data[OFFSET_VERSION] += 1; } },
+        { "other key", [](Bytes& data) { data[OFFSET_KEY] ^= 0x80; } },
+        { "bad checksum", [](Bytes& data) { data[OFFSET_CHECKSUM] ^= 0x01; } },
+        { "bad texture width", [](Bytes& data) { data[OFFSET_TEX_WIDTH] ^= 0x02; } },
+        { "glyph count", [](Bytes& data) { data[HEADER_SIZE + 4 * 4] += 1; } },
+        { "corrupted glyph", [=](Bytes& data) { data[glyphsOffset + 4] ^= 0x10; } },
+        { "corrupted texel", [](Bytes& data) { data[data.size() / 2 + data.size() / 4] ^= 0xFF; } },
+    };
+    for (const Corruption& corruption : CORRUPTIONS)
+    {
+        Bytes data = cache;
+        corruption.apply(data);
+        WriteFile(CACHE_FILENAME, data);
+        {
+            ImFontAtlas atlas;
+            SetupAtlas(atlas, CACHE_FILENAME);
+            atlas.Build();
+            Check(!atlas.TexLoadedFromCache, corruption.name, "cache ignored");
+            Check(SameAtlas(atlas, reference), corruption.name, "same atlas as without cache");
+        }
+        {
+            ImFontAtlas atlas;
+            SetupAtlas(atlas, CACHE_FILENAME);
+            atlas.Build();
+            Check(atlas.TexLoadedFromCache && SameAtlas(atlas, reference), corruption.name, "cache rewritten");
+        }
+    }
+
+    // Fallback: a valid file for other inputs (glyph padding)
+    {
+        const char* test = "other inputs";
+        WriteFile(CACHE_FILENAME, cache);
+        ImFontAtlas fresh;
+        SetupAtlas(fresh, nullptr, 2);
+        fresh.Build();
+        ImFontAtlas atlas;
+        SetupAtlas(atlas, CACHE_FILENAME, 2);
+        atlas.Build();
+        Check(!atlas.TexLoadedFromCache, test, "cache ignored");
+        Check(SameAtlas(atlas, fresh), test, "same atlas as without cache");
+    }
+    remove(CACHE_FILENAME);
+
+    printf("%s, %d fonts, %dx%d texture, cache file %.1f KB, best of %d runs\n", g_fontPath ? g_fontPath : "ProggyClean",
+        reference.Fonts.Size, reference.TexWidth, reference.TexHeight, cache.size() / 1024.0, runs);
+    printf("no cache %.2f ms, cold (build + write) %.2f ms, warm (load) %.2f ms, %.1fx faster\n", uncachedMs, coldMs, warmMs, coldMs / warmMs);
+    printf("%d corrupted files checked\n", (int)(sizeof(CORRUPTIONS) / sizeof(CORRUPTIONS[0])));
+    printf("%s\n", g_failures == 0 ? "ok" : "FAILED");
+    return g_failures == 0 ? 0 : 1;
+}
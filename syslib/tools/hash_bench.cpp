@@ -0,0 +1,249 @@
+// Parity check and benchmark of the slice-by-8 CRC32 ImHashData() and ImHashStr() (imgui.cpp) against the byte-at-a-time
+// versions they replaced, kept here as the reference.
+//
+// - parity: random buffers and strings (any length up to 300, unaligned starts, many '#' so "###" resets occur at every
+//           position, random seeds), hashed with an explicit size and as zero-terminated strings. Zero-terminated strings
+//           are also hashed right before a PROT_NONE page: ImHashStr() reads 8 bytes at a time past the first 8, and must
+//           not read across a page boundary
+// - bench:  IDs per second for typical labels and IDs, and MB/s on long buffers. Best of BENCH_RUNS, the two versions
+//           measured alternately so that CPU frequency changes affect both
+//
+//   hash_bench [parity|bench]      Both by default. Exit code 1 if a hash differs
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/hash_bench.cpp external/imgui/imgui.cpp external/imgui/imgui_draw.cpp
+//       external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o hash_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+#ifdef IMGUI_ENABLE_SSE4_2_CRC
+#error hash_bench checks the table CRC32, build without IMGUI_ENABLE_SSE4_2_CRC
+#endif
+
+// Reference: upstream Dear ImGui 1.91.9b, one table lookup per byte. Same polynomial as GCrc32LookupTable (CRC32c, or
+// CRC32 with IMGUI_USE_LEGACY_CRC32_ADLER), the table generated here
+#ifdef IMGUI_USE_LEGACY_CRC32_ADLER
+static const ImU32 CRC32_POLYNOMIAL = 0xEDB88320;
+#else
+static const ImU32 CRC32_POLYNOMIAL = 0x82F63B78;
+#endif
+static ImU32 g_crc32Table[256];
+
+static void InitReference()
+{
+    for (ImU32 i = 0; i < 256; i++)
+    {
+        ImU32 crc = i;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0 - (crc & 1)));
+        g_crc32Table[i] = crc;
+    }
+}
+
+// Not inlined, as ImHashData() and ImHashStr() aren't: a constant size would otherwise unroll the reference into the bench loop
+__attribute__((noinline)) static ImGuiID RefHashData(const void* data_p, size_t data_size, ImGuiID seed)
+{
+    ImU32 crc = ~seed;
+    const unsigned char* data = (const unsigned char*)data_p;
+    const unsigned char* data_end = data + data_size;
+    while (data < data_end)
+        crc = (crc >> 8) ^ g_crc32Table[(crc & 0xFF) ^ *data++];
+    return ~crc;
+}
+
+__attribute__((noinline)) static ImGuiID RefHashStr(const char* data_p, size_t data_size, ImGuiID seed)
+{
+    seed = ~seed;
+    ImU32 crc = seed;
+    const unsigned char* data = (const unsigned char*)data_p;
+    if (data_size != 0)
+    {
+        while (data_size-- != 0)
+        {
+            unsigned char c = *data++;
+            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = (crc >> 8) ^ g_crc32Table[(crc & 0xFF) ^ c];
+        }
+    }
+    else
+    {
+        while (unsigned char c = *data++)
+        {
+            if (c == '#' && data[0] == '#' && data[1] == '#')
+                crc = seed;
+            crc = (crc >> 8) ^ g_crc32Table[(crc & 0xFF) ^ c];
+        }
+    }
+    return ~crc;
+}
+
+static bool RunParity()
+{
+    std::mt19937 rng(33);
+    const int CASES = 300000;
+    const size_t MAX_LENGTH = 300;
+    std::vector<unsigned char> buffer(MAX_LENGTH + 16);
+    int failures = 0;
+
+    for (int n = 0; n < CASES && failures < 10; n++)   // Stops after 10 reports
+    {
+        const size_t offset = rng() % 8;
+        const size_t length = rng() % (MAX_LENGTH + 1);
+        const ImGuiID seed = (n % 4 == 0) ? 0 : rng();
+        const int hashPercent = (int)(rng() % 40);    // From no '#' to runs of them
+        unsigned char* data = buffer.data() + offset;
+        for (size_t i = 0; i < length; i++)
+            data[i] = ((int)(rng() % 100) < hashPercent) ? '#' : (unsigned char)(rng() % 255 + 1);
+        data[length] = 0;
+
+        if (ImHashData(data, length, seed) != RefHashData(data, length, seed))
+        {
+            printf("ImHashData differs: length %d, offset %d, seed %08X\n", (int)length, (int)offset, seed);
+            failures++;
+        }
+        if (length > 0 && ImHashStr((const char*)data, length, seed) != RefHashStr((const char*)data, length, seed))
+        {
+            printf("ImHashStr differs: length %d, offset %d, seed %08X\n", (int)length, (int)offset, seed);
+            failures++;
+        }
+        if (ImHashStr((const char*)data, 0, seed) != RefHashStr((const char*)data, 0, seed))
+        {
+            printf("ImHashStr (zero-terminated) differs: length %d, offset %d, seed %08X\n", (int)length, (int)offset, seed);
+            failures++;
+        }
+    }
+
+    // Strings ending at the last byte of a page, before a PROT_NONE one: any read past the page faults
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    unsigned char* pages = (unsigned char*)mmap(nullptr, pageSize * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED || mprotect(pages + pageSize, pageSize, PROT_NONE) != 0)
+    {
+        printf("no guard page\n");
+        return false;
+    }
+    for (size_t length = 0; length <= MAX_LENGTH && failures < 10; length++)
+    {
+        for (int n = 0; n < 64; n++)
+        {
+            const int hashPercent = n % 4 == 0 ? 0 : (int)(rng() % 40);
+            unsigned char* data = pages + pageSize - 1 - length;
+            for (size_t i = 0; i < length; i++)
+                data[i] = ((int)(rng() % 100) < hashPercent) ? '#' : (unsigned char)(rng() % 255 + 1);
+            data[length] = 0;
+            const ImGuiID seed = rng();
+            if (ImHashStr((const char*)data, 0, seed) != RefHashStr((const char*)data, 0, seed))
+            {
+                printf("ImHashStr (zero-terminated, page end) differs: length %d, seed %08X\n", (int)length, seed);
+                failures++;
+                break;
+            }
+        }
+    }
+    munmap(pages, pageSize * 2);
+
+    // Known values, as hashed by upstream
+    if (ImHashStr("Window") != RefHashStr("Window", 0, 0) || ImHashStr("label###id") != ImHashStr("###id")
+        || ImHashStr("Auto Pot###pot", 0, 1234) != RefHashStr("###pot", 0, 1234))
+    {
+        printf("### handling differs\n");
+        failures++;
+    }
+    printf("parity: %d random inputs, 3 hashes each, %d strings at a page end: %s\n", CASES, (int)(MAX_LENGTH + 1) * 64, failures ? "FAILED" : "ok");
+    return failures == 0;
+}
+
+typedef ImGuiID (*HashStrFunc)(const char*, size_t, ImGuiID);
+typedef ImGuiID (*HashDataFunc)(const void*, size_t, ImGuiID);
+
+static double MillionPerSecond(std::chrono::steady_clock::time_point start, double count)
+{
+    return count / std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void RunBench()
+{
+    typedef std::chrono::steady_clock Clock;
+    static const char* const LABELS[] = {
+        "##Child",
+        "Auto Pot",
+        "Limite de vida (%)##hp",
+        "Auto Pot###autopot_settings",
+        "Configurações de PvE/Ataque automático/Skills",
+        "Monstros ignorados na área de caça, separados por vírgula##ignore",
+    };
+    static const int ITERATIONS = 200000;
+    static const int BENCH_RUNS = 40;
+    volatile ImGuiID sink = 0;
+    (void)sink;
+
+    printf("%-70s %12s %12s\n", "ImHashStr, zero-terminated (M IDs/s)", "reference", "slice-by-8");
+    for (const char* label : LABELS)
+    {
+        double rates[2] = {};
+        const HashStrFunc funcs[2] = { RefHashStr, ImHashStr };
+        for (int run = 0; run < BENCH_RUNS; run++)
+        {
+            for (int f = 0; f < 2; f++)
+            {
+                const Clock::time_point start = Clock::now();
+                for (int n = 0; n < ITERATIONS; n++)
+                    sink = funcs[f](label, 0, (ImGuiID)n);
+                rates[f] = std::max(rates[f], MillionPerSecond(start, ITERATIONS));
+            }
+        }
+        std::string name = std::string("\"") + label + "\"";
+        printf("%-70s %12.1f %12.1f\n", name.c_str(), rates[0], rates[1]);
+    }
+
+    // PushID(int) and PushID(ptr) hash 4 and 8 bytes with ImHashData
+    printf("%-70s %12s %12s\n", "ImHashData (M IDs/s, MB/s for buffers)", "reference", "slice-by-8");
+    static const size_t SIZES[] = { 4, 8, 64, 4096 };
+    std::vector<unsigned char> buffer(4096);
+    for (size_t i = 0; i < buffer.size(); i++)
+        buffer[i] = (unsigned char)(i * 131);
+    for (size_t size : SIZES)
+    {
+        double rates[2] = {};
+        const HashDataFunc funcs[2] = { RefHashData, ImHashData };
+        const int iterations = (int)(ITERATIONS * 8 / (size + 4));
+        for (int run = 0; run < BENCH_RUNS; run++)
+        {
+            for (int f = 0; f < 2; f++)
+            {
+                const Clock::time_point start = Clock::now();
+                for (int n = 0; n < iterations; n++)
+                    sink = funcs[f](buffer.data(), size, (ImGuiID)n);
+                rates[f] = std::max(rates[f], MillionPerSecond(start, size >= 64 ? (double)iterations * size : iterations));
+            }
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "%d bytes%s", (int)size, size >= 64 ? " (MB/s)" : "");
+        printf("%-70s %12.1f %12.1f\n", name, rates[0], rates[1]);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    InitReference();
+    const bool parity = argc < 2 || strcmp(argv[1], "parity") == 0;
+    const bool bench = argc < 2 || strcmp(argv[1], "bench") == 0;
+    bool ok = true;
+    if (parity)
+        ok = RunParity();
+    if (bench)
+        RunBench();
+    return ok ? 0 : 1;
+}
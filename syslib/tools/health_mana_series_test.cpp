@@ -0,0 +1,189 @@
+// Test of HealthManaSeries (health_mana_series.cpp) against the plain list of samples it was fed:
+//
+// - codec:  extreme values (INT_MIN/INT_MAX, time jumps of years and steps of 0) round-trip through the column streams
+// - raw:    a simulated 3-day session at about 1 Hz (jitter, a clock step back, level ups, deaths, a 2-hour gap out of
+//           game). The retained raw samples must round-trip exactly, GetLast() must return the last one
+// - query:  random ranges from a minute to the whole session, answered from raw samples or any tier. Each point's count
+//           and min/max must match a scan of the samples it covers, its average within 1, and the points must cover
+//           every sample of the range
+// - memory: bytes per sample, against the 48-byte HealthManaPoint (tiers) and 24-byte Sample (raw) structs
+//
+//   health_mana_series_test    Exit code 1 if a check fails
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/health_mana_series_test.cpp health_mana_series.cpp -o health_mana_series_test
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "health_mana_series.h"
+
+typedef HealthManaSeries::Sample Sample;
+
+static const int64_t SESSION_START = 1700000000000LL;
+static const int SESSION_SAMPLES = 3 * 24 * 3600;
+static const int QUERIES = 300;
+
+static int g_failures = 0;
+
+static bool Check(bool condition, const char* test, const char* what)
+{
+    if (!condition && g_failures++ < 20)
+        printf("%s: %s FAILED\n", test, what);
+    return condition;
+}
+
+static bool SameSample(const Sample& a, const Sample& b)
+{
+    return a.time == b.time && a.health == b.health && a.maxHealth == b.maxHealth && a.mana == b.mana && a.maxMana == b.maxMana;
+}
+
+static void TestCodec()
+{
+    const char* test = "codec";
+    static const Sample SAMPLES[] = {
+        { 0, 0, 0, 0, 0 },
+        { 0, INT_MAX, INT_MAX, INT_MIN, INT_MAX },
+        { 1, INT_MIN, 1, INT_MAX, INT_MIN },
+        { 1, -1, -1, -1, -1 },
+        { 40LL * 365 * 24 * 3600 * 1000, 100, 100, 50, 50 },       // 40 years later
+        { 40LL * 365 * 24 * 3600 * 1000 + 3, 99, 100, 51, 50 },
+        { INT64_MAX / 4, 0, 100, 0, 50 },
+    };
+    const int count = (int)(sizeof(SAMPLES) / sizeof(SAMPLES[0]));
+
+    HealthManaSeries series;
+    for (int n = 0; n < count; n++)
+        series.Add(SAMPLES[n]);
+    std::vector<Sample> out;
+    series.GetRecentSamples(count, out);
+    bool same = (int)out.size() == count;
+    for (int n = 0; same && n < count; n++)
+        same = SameSample(out[n], SAMPLES[n]);
+    Check(same, test, "round trip");
+
+    series.Clear();
+    Sample last;
+    Check(!series.GetLast(last) && series.GetSampleCount() == 0, test, "cleared");
+}
+
+int main()
+{
+    TestCodec();
+
+    // A session with some of everything a game gives: jitter, level ups (max health/mana), deaths, an outage
+    std::mt19937 random(49);
+    HealthManaSeries series;
+    std::vector<Sample> samples;
+    samples.reserve(SESSION_SAMPLES);
+    int64_t time = SESSION_START;
+    int health = 5000, mana = 3000, maxHealth = 8000, maxMana = 4000;
+    double addNs = 0.0;
+    for (int n = 0; n < SESSION_SAMPLES; n++)
+    {
+        time += 900 + random() % 200;
+        if (n % 50000 == 7)
+            time -= 5000;                               // system_clock set back: Add() holds the time
+        if (n == SESSION_SAMPLES / 2)
+            time += 2 * 3600 * 1000;                    // Out of game for 2 hours
+        if (n % 40000 == 39999)
+        {
+            maxHealth += 120;
+            maxMana += 40;
+        }
+        health = (random() % 20000 == 0) ? 0 : std::max(0, std::min(maxHealth, health + (int)(random() % 401) - 200));
+        mana = std::max(0, std::min(maxMana, mana + (int)(random() % 101) - 50));
+
+        Sample sample = { time, health, maxHealth, mana, maxMana };
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        series.Add(sample);
+        addNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (!samples.empty() && sample.time < samples.back().time)
+            sample.time = samples.back().time;
+        samples.push_back(sample);
+    }
+
+    {
+        const char* test = "raw";
+        std::vector<Sample> recent;
+        series.GetRecentSamples(samples.size(), recent);
+        Check(recent.size() >= 65000 && recent.size() <= 65536, test, "65536 newest samples retained, in whole blocks");
+        bool same = true;
+        for (size_t n = 0; same && n < recent.size(); n++)
+            same = SameSample(recent[n], samples[samples.size() - recent.size() + n]);
+        Check(same, test, "round trip");
+        series.GetRecentSamples(500, recent);
+        Check(recent.size() == 500 && SameSample(recent.front(), samples[samples.size() - 500]), test, "most recent 500");
+        Sample last;
+        Check(series.GetLast(last) && SameSample(last, samples.back()), test, "last sample");
+        Check(series.GetSampleCount() == SESSION_SAMPLES, test, "sample count");
+    }
+
+    double queryUs = 0.0;
+    {
+        const char* test = "query";
+        static const int64_t SPANS[] = { 60 * 1000, 10 * 60 * 1000, 3600 * 1000, 24 * 3600 * 1000, 3 * 24 * 3600 * 1000 + 4 * 3600 * 1000 };
+        const auto byTime = [](const Sample& sample, int64_t t) { return sample.time < t; };
+        std::vector<HealthManaPoint> points;
+        for (int q = 0; q < QUERIES && g_failures < 20; q++)
+        {
+            const int64_t span = SPANS[q % 5];
+            const int64_t to = samples.back().time + 1 - (int64_t)(random() % 1000) * (span / 4000 + 1);
+            const int64_t from = to - span;
+            const size_t maxPoints = 50 + random() % 400;
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            series.Query(from, to, maxPoints, points);
+            queryUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+            const auto first = std::lower_bound(samples.begin(), samples.end(), from, byTime);
+            const auto last = std::lower_bound(samples.begin(), samples.end(), to, byTime);
+            if (first == last)
+            {
+                Check(points.empty(), test, "no samples, no points");
+                continue;
+            }
+            if (!Check(!points.empty() && points.size() <= maxPoints, test, "1 to maxPoints points"))
+                continue;
+
+            // Each point summarizes the next sampleCount samples from its time (a bucket, or a run of them, is complete)
+            int64_t covered = 0;
+            for (size_t n = 0; n < points.size(); n++)
+            {
+                const HealthManaPoint& point = points[n];
+                const int64_t end = (n + 1 < points.size()) ? points[n + 1].time : INT64_MAX;
+                int healthMin = INT_MAX, healthMax = INT_MIN, manaMin = INT_MAX, manaMax = INT_MIN, count = 0;
+                int64_t healthSum = 0, manaSum = 0;
+                for (auto sample = std::lower_bound(samples.begin(), samples.end(), point.time, byTime);
+                     sample != samples.end() && sample->time < end && count < point.sampleCount; ++sample, count++)
+                {
+                    healthMin = std::min(healthMin, sample->health);
+                    healthMax = std::max(healthMax, sample->health);
+                    manaMin = std::min(manaMin, sample->mana);
+                    manaMax = std::max(manaMax, sample->mana);
+                    healthSum += sample->health;
+                    manaSum += sample->mana;
+                }
+                if (!Check(count > 0 && count == point.sampleCount, test, "point sample count"))
+                    break;
+                Check(healthMin == point.healthMin && healthMax == point.healthMax && manaMin == point.manaMin && manaMax == point.manaMax,
+                    test, "point min/max");
+                Check(std::abs(healthSum / count - point.healthAvg) <= 1 && std::abs(manaSum / count - point.manaAvg) <= 1, test, "point average");
+                covered += point.sampleCount;
+            }
+            Check(covered >= last - first, test, "points cover the range");
+        }
+    }
+
+    const size_t memory = series.GetMemoryUsage();
+    printf("%d samples over 3 days: %.2f MB, %.1f bytes per sample (%.2f MB as Sample structs, %.2f MB as HealthManaPoints)\n",
+        SESSION_SAMPLES, memory / 1048576.0, (double)memory / SESSION_SAMPLES, SESSION_SAMPLES * sizeof(Sample) / 1048576.0,
+        SESSION_SAMPLES * sizeof(HealthManaPoint) / 1048576.0);
+    printf("Add %.0f ns, Query %.1f us on average\n", addNs / SESSION_SAMPLES, queryUs / QUERIES);
+    printf("%s\n", g_failures == 0 ? "ok" : "FAILED");
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,266 @@
+// Test of KeyBindings::Dispatch() (key_bindings.cpp): the events queued by the WndProc hook must reach either a bound
+// action or ImGui, once and in the order they were received. Checks the ImGui input queue (GImGui->InputEventsQueue)
+// after each dispatch:
+//
+// - unbound keys and characters reach ImGui in order, characters between the keys they were typed with
+// - a bound press runs its action once; its press, repeats, release and the characters it produces don't reach ImGui
+// - a binding with modifiers only fires with exactly those modifiers held
+// - while ImGui wants the keyboard (io.WantCaptureKeyboard) no action runs and bound keys reach ImGui
+// - WM_CHAR surrogate pairs are joined, WM_UNICHAR code points are passed as is
+// - focus loss releases held keys; a full queue drops and counts events
+//
+//   key_bindings_test          Exit code 1 if a check fails
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/key_bindings_test.cpp key_bindings.cpp input_queue.cpp external/imgui/imgui.cpp
+//       external/imgui/imgui_draw.cpp external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o key_bindings_test
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "key_bindings.h"
+#include "external/imgui/imgui_internal.h"
+
+// Windows virtual-key codes used below
+static const int KEY_LEFT = 0x25, KEY_END = 0x23, KEY_F5 = 0x74, KEY_A = 0x41, KEY_B = 0x42;
+static const int KEY_LCONTROL = 0xA2, KEY_LSHIFT = 0xA0;
+
+static int g_failures = 0;
+
+static void Check(bool condition, const char* test, const char* what)
+{
+    if (!condition)
+    {
+        printf("%s: %s FAILED\n", test, what);
+        g_failures++;
+    }
+}
+
+static void PushKey(InputQueue& queue, int virtualKey, ImGuiKey key, bool down, bool repeat = false)
+{
+    InputEvent event;
+    event.type = InputEvent::Key;
+    event.down = down;
+    event.repeat = repeat;
+    event.virtualKey = (unsigned char)virtualKey;
+    event.key = key;
+    queue.Push(event);
+}
+
+static void PushChar(InputQueue& queue, unsigned int character, bool utf16 = true)
+{
+    InputEvent event;
+    event.type = InputEvent::Char;
+    event.utf16 = utf16;
+    event.character = character;
+    queue.Push(event);
+}
+
+static void PushFocus(InputQueue& queue, bool focused)
+{
+    InputEvent event;
+    event.type = InputEvent::Focus;
+    event.down = focused;
+    queue.Push(event);
+}
+
+// ImGui's queued events as text, modifier keys left out: "A+ A- 'a' Left+ F0 ..."
+static std::string TakeImGuiEvents()
+{
+    ImGuiContext& g = *GImGui;
+    std::string text;
+    char buffer[32];
+    for (const ImGuiInputEvent& event : g.InputEventsQueue)
+    {
+        if (event.Type == ImGuiInputEventType_Key)
+        {
+            if (ImGui::IsLRModKey(event.Key.Key) || (event.Key.Key & ImGuiMod_Mask_))
+                continue;
+            snprintf(buffer, sizeof(buffer), "%s%c", ImGui::GetKeyName(event.Key.Key), event.Key.Down ? '+' : '-');
+        }
+        else if (event.Type == ImGuiInputEventType_Text)
+        {
+            if (event.Text.Char < 0x80)
+                snprintf(buffer, sizeof(buffer), "'%c'", (char)event.Text.Char);
+            else
+                snprintf(buffer, sizeof(buffer), "U+%X", event.Text.Char);
+        }
+        else if (event.Type == ImGuiInputEventType_Focus)
+        {
+            snprintf(buffer, sizeof(buffer), "F%d", event.AppFocused.Focused ? 1 : 0);
+        }
+        else
+        {
+            continue;
+        }
+        if (!text.empty())
+            text += ' ';
+        text += buffer;
+    }
+    g.InputEventsQueue.resize(0);
+    return text;
+}
+
+static void CheckEvents(const char* test, const std::string& expected)
+{
+    const std::string events = TakeImGuiEvents();
+    if (events != expected)
+    {
+        printf("%s: ImGui got \"%s\", expected \"%s\"\n", test, events.c_str(), expected.c_str());
+        g_failures++;
+    }
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+
+    int leftCount = 0, f5Count = 0, ctrlEndCount = 0;
+    KeyBindings bindings;
+    bindings.Bind(KEY_LEFT, KeyBindings::Mod_None, [&leftCount]() { leftCount++; });
+    bindings.Bind(KEY_F5, KeyBindings::Mod_None, [&f5Count]() { f5Count++; });
+    bindings.Bind(KEY_END, KeyBindings::Mod_Ctrl, [&ctrlEndCount]() { ctrlEndCount++; });
+
+    {
+        const char* test = "unbound keys";
+        InputQueue queue;
+        PushKey(queue, KEY_A, ImGuiKey_A, true);
+        PushChar(queue, 'a');
+        PushKey(queue, KEY_A, ImGuiKey_A, false);
+        PushKey(queue, KEY_LSHIFT, ImGuiKey_LeftShift, true);
+        PushKey(queue, KEY_B, ImGuiKey_B, true);
+        PushChar(queue, 'B');
+        PushKey(queue, KEY_B, ImGuiKey_B, true, true);
+        PushChar(queue, 'B');
+        PushKey(queue, KEY_B, ImGuiKey_B, false);
+        PushKey(queue, KEY_LSHIFT, ImGuiKey_LeftShift, false);
+        bindings.Dispatch(queue, io);
+        CheckEvents(test, "A+ 'a' A- B+ 'B' 'B' B-");
+        Check(!bindings.IsKeyDown(KEY_A) && !bindings.IsKeyDown(KEY_LSHIFT), test, "keys released");
+    }
+
+    {
+        const char* test = "bound key";
+        InputQueue queue;
+        PushKey(queue, KEY_A, ImGuiKey_A, true);
+        PushChar(queue, 'a');
+        PushKey(queue, KEY_A, ImGuiKey_A, false);
+        PushKey(queue, KEY_LEFT, ImGuiKey_LeftArrow, true);
+        PushKey(queue, KEY_LEFT, ImGuiKey_LeftArrow, true, true);
+        PushKey(queue, KEY_LEFT, ImGuiKey_LeftArrow, false);
+        PushKey(queue, KEY_F5, ImGuiKey_F5, true);
+        PushChar(queue, 't');           // Whatever a bound key produces as text goes with it
+        PushKey(queue, KEY_F5, ImGuiKey_F5, false);
+        PushChar(queue, 'x');           // Without a key press, as from an IME
+        PushKey(queue, KEY_B, ImGuiKey_B, true);
+        PushChar(queue, 'b');
+        PushKey(queue, KEY_B, ImGuiKey_B, false);
+        bindings.Dispatch(queue, io);
+        CheckEvents(test, "A+ 'a' A- 'x' B+ 'b' B-");
+        Check(leftCount == 1 && f5Count == 1, test, "actions run once");
+    }
+
+    {
+        const char* test = "modifiers";
+        InputQueue queue;
+        PushKey(queue, KEY_END, ImGuiKey_End, true);
+        PushKey(queue, KEY_END, ImGuiKey_End, false);
+        PushKey(queue, KEY_LCONTROL, ImGuiKey_LeftCtrl, true);
+        PushKey(queue, KEY_END, ImGuiKey_End, true);
+        PushKey(queue, KEY_END, ImGuiKey_End, false);
+        PushKey(queue, KEY_LSHIFT, ImGuiKey_LeftShift, true);
+        PushKey(queue, KEY_END, ImGuiKey_End, true);     // Ctrl+Shift+End: not bound
+        PushKey(queue, KEY_END, ImGuiKey_End, false);
+        PushKey(queue, KEY_LSHIFT, ImGuiKey_LeftShift, false);
+        PushKey(queue, KEY_LCONTROL, ImGuiKey_LeftCtrl, false);
+        bindings.Dispatch(queue, io);
+        CheckEvents(test, "End+ End- End+ End-");
+        Check(ctrlEndCount == 1, test, "Ctrl+End runs once");
+        Check(!bindings.IsKeyDown(KEY_LCONTROL) && !bindings.IsKeyDown(KEY_LSHIFT), test, "modifiers released");
+    }
+
+    {
+        const char* test = "WantCaptureKeyboard";
+        InputQueue queue;
+        io.WantCaptureKeyboard = true;      // As after a frame with a focused text field or keyboard navigation
+        PushKey(queue, KEY_LEFT, ImGuiKey_LeftArrow, true);
+        PushKey(queue, KEY_LEFT, ImGuiKey_LeftArrow, false);
+        PushKey(queue, KEY_F5, ImGuiKey_F5, true);
+        PushChar(queue, 't');
+        PushKey(queue, KEY_F5, ImGuiKey_F5, false);
+        bindings.Dispatch(queue, io);
+        CheckEvents(test, "LeftArrow+ LeftArrow- F5+ 't' F5-");
+        Check(leftCount == 1 && f5Count == 1, test, "no action run");
+
+        // A bound key pressed before ImGui took the keyboard is still released for the action, not for ImGui
+        io.WantCaptureKeyboard = false;
+        PushKey(queue, KEY_F5, ImGuiKey_F5, true);
+        bindings.Dispatch(queue, io);
+        io.WantCaptureKeyboard = true;
+        PushKey(queue, KEY_F5, ImGuiKey_F5, false);
+        PushKey(queue, KEY_A, ImGuiKey_A, true);
+        PushChar(queue, 'a');
+        PushKey(queue, KEY_A, ImGuiKey_A, false);
+        bindings.Dispatch(queue, io);
+        io.WantCaptureKeyboard = false;
+        CheckEvents(test, "A+ 'a' A-");
+        Check(f5Count == 2, test, "action before capture");
+    }
+
+    {
+        const char* test = "characters";
+        InputQueue queue;
+        PushChar(queue, 0xE9);                  // WM_CHAR in a non-Unicode window, after the code page conversion
+        PushChar(queue, 0xD83D);                // WM_CHAR surrogate pair
+        PushChar(queue, 0xDE00);
+        PushChar(queue, 0x1F600, false);        // WM_UNICHAR
+        bindings.Dispatch(queue, io);
+        // Without IMGUI_USE_WCHAR32, ImGui replaces code points above U+FFFF from UTF-16 by U+FFFD
+        char expected[64];
+        snprintf(expected, sizeof(expected), "U+E9 U+%X U+1F600", IM_UNICODE_CODEPOINT_MAX == 0xFFFF ? IM_UNICODE_CODEPOINT_INVALID : 0x1F600);
+        CheckEvents(test, expected);
+    }
+
+    {
+        const char* test = "focus";
+        InputQueue queue;
+        PushKey(queue, KEY_A, ImGuiKey_A, true);
+        PushKey(queue, KEY_LCONTROL, ImGuiKey_LeftCtrl, true);
+        PushKey(queue, KEY_LEFT, ImGuiKey_LeftArrow, true);     // Ctrl+Left: not bound
+        PushFocus(queue, false);                // Alt+Tab: the releases never come, ImGui clears its keys itself
+        PushFocus(queue, true);
+        PushKey(queue, KEY_LEFT, ImGuiKey_LeftArrow, true);     // Ctrl no longer held
+        PushKey(queue, KEY_LEFT, ImGuiKey_LeftArrow, false);
+        bindings.Dispatch(queue, io);
+        CheckEvents(test, "A+ LeftArrow+ F0 F1");
+        Check(!bindings.IsKeyDown(KEY_A) && !bindings.IsKeyDown(KEY_LCONTROL), test, "keys released");
+        Check(leftCount == 2, test, "bound key after focus loss");
+    }
+
+    {
+        const char* test = "full queue";
+        InputQueue queue;
+        int pushed = 0;
+        for (int n = 0; n < 300; n++)
+        {
+            InputEvent event;
+            event.type = InputEvent::Char;
+            event.utf16 = true;
+            event.character = 'x';
+            pushed += queue.Push(event) ? 1 : 0;
+        }
+        Check(pushed == 256 && queue.GetDroppedCount() == 300 - pushed, test, "drops counted");
+        bindings.Dispatch(queue, io);
+        Check((int)GImGui->InputEventsQueue.Size == pushed, test, "kept events dispatched");
+        TakeImGuiEvents();
+        InputEvent event;
+        Check(!queue.Pop(event), test, "queue emptied");
+    }
+
+    ImGui::DestroyContext();
+    printf("%s\n", g_failures == 0 ? "ok" : "FAILED");
+    return g_failures == 0 ? 0 : 1;
+}
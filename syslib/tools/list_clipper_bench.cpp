@@ -0,0 +1,393 @@
+// Test and benchmark of ImGuiListClipper::BeginVariableHeight() and ImGuiListClipperHeights (imgui.cpp), headless: ImGui
+// context with no platform or renderer backend.
+//
+// - heights: random Resize()/SetItemHeight()/Clear() on ImGuiListClipperHeights, with and without a DefaultHeight given
+//            up front, items measured again with another height after their first measurement. After each batch,
+//            GetItemPos() and FindItemAtPos() must match a linear scan of the heights, on the first and last items, the
+//            total height, item edges, out of range positions and random items
+// - clipper: ROW_COUNT rows of 1 to 4 text lines. Frames at the top, at random scroll positions in unmeasured areas
+//            and at the bottom. Each displayed row must be at its GetItemPos() offset, the rows must cover the visible
+//            area, and the first and last rows must be reached. Then some rows change height (as after a wrap width
+//            change): once displayed again, they must be measured with their new height
+// - bench:   per-frame time of a ROW_COUNT rows list, fixed height (Begin()) against variable height (scrolling, and
+//            jumping into unmeasured areas), and the cost of each ImGuiListClipperHeights operation at that size
+//
+//   list_clipper_bench [test|bench] [frames]       Both by default. Exit code 1 if a check fails
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/list_clipper_bench.cpp external/imgui/imgui.cpp external/imgui/imgui_draw.cpp
+//       external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o list_clipper_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+static const int ROW_COUNT = 1000000;
+static const float ROW_WIDTH = 300.0f;
+static const float LINE_HEIGHT = 13.0f;
+
+static int g_failures = 0;
+
+static bool Check(bool condition, const char* test, const char* what)
+{
+    if (!condition && g_failures++ < 20)
+        printf("%s: %s FAILED\n", test, what);
+    return condition;
+}
+
+// Reference: the heights as a plain array, positions by linear scan
+struct RefHeights
+{
+    float defaultHeight;
+    std::vector<float> heights;     // < 0.0f when not measured
+    std::vector<double> positions;  // positions[n] = sum of heights before item n, size() + 1 entries
+
+    void Update()
+    {
+        positions.resize(heights.size() + 1);
+        positions[0] = 0.0;
+        for (size_t n = 0; n < heights.size(); n++)
+            positions[n + 1] = positions[n] + (heights[n] >= 0.0f ? heights[n] : defaultHeight);
+    }
+
+    // Last item whose top is at or above pos, past zero-height items, as FindItemAtPos()
+    int FindItemAtPos(double pos) const
+    {
+        int item = 0;
+        while (item < (int)heights.size() && positions[item + 1] <= pos)
+            item++;
+        return item;
+    }
+};
+
+static void CheckHeights(const ImGuiListClipperHeights& heights, RefHeights& ref, std::mt19937& rng, const char* test)
+{
+    ref.Update();
+    const int count = (int)ref.heights.size();
+    if (!Check(heights.Heights.Size == count && heights.DefaultHeight == ref.defaultHeight, test, "items count and DefaultHeight"))
+        return;
+
+    // First, second, last items and the total height, then random ones
+    std::vector<int> items = { 0, 1, count - 1, count };
+    for (int n = 0; n < 40; n++)
+        items.push_back((int)(rng() % (count + 1)));
+    for (int item : items)
+    {
+        if (item < 0 || item > count)
+            continue;
+        const double pos = ref.positions[item];
+        if (!Check(heights.GetItemPos(item) == pos, test, "GetItemPos() matches linear scan"))
+            return;
+        if (item < count)
+            Check(heights.GetItemHeight(item) == (ref.heights[item] >= 0.0f ? ref.heights[item] : ref.defaultHeight), test, "GetItemHeight()");
+
+        // Top edge, just above it, middle of the item
+        const double probes[] = { pos, pos - 0.25, item < count ? (pos + ref.positions[item + 1]) * 0.5 : pos + 1.0 };
+        for (double probe : probes)
+            if (!Check(heights.FindItemAtPos(probe) == (probe < 0.0 ? 0 : ref.FindItemAtPos(probe)), test, "FindItemAtPos() matches linear scan"))
+                return;
+    }
+    Check(heights.FindItemAtPos(-100.0) == 0 && heights.GetTotalHeight() == ref.positions[count], test, "out of range positions");
+}
+
+static void TestHeights()
+{
+    const char* test = "heights";
+    std::mt19937 rng(34);
+    for (int run = 0; run < 40; run++)
+    {
+        // Half of the runs take DefaultHeight from the first measured item
+        const float defaultHeight = (run % 2) ? 0.0f : 17.0f;
+        ImGuiListClipperHeights heights(defaultHeight);
+        RefHeights ref = { defaultHeight, {}, {} };
+        for (int batch = 0; batch < 60 && g_failures == 0; batch++)
+        {
+            const int op = (int)(rng() % 10);
+            if (op == 0)
+            {
+                // Grow or shrink, as BeginVariableHeight() with a new items count
+                const int count = std::max(0, (int)ref.heights.size() + (int)(rng() % 3000) - 1000);
+                heights.Resize(count);
+                ref.heights.resize(count, -1.0f);
+            }
+            else if (op == 1 && batch % 7 == 0)
+            {
+                heights.Clear();
+                std::fill(ref.heights.begin(), ref.heights.end(), -1.0f);
+            }
+            else if (!ref.heights.empty())
+            {
+                // Measure items (multiples of 0.5, some 0), half of them already measured with another height
+                for (int n = 0; n < 200; n++)
+                {
+                    const int item = (int)(rng() % ref.heights.size());
+                    const float height = (rng() % 8 == 0) ? 0.0f : (float)(rng() % 200) * 0.5f;
+                    heights.SetItemHeight(item, height);
+                    ref.heights[item] = height;
+                    if (ref.defaultHeight <= 0.0f && height > 0.0f)
+                        ref.defaultHeight = height;
+                }
+            }
+            CheckHeights(heights, ref, rng, test);
+        }
+    }
+}
+
+static void CreateHeadlessContext()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.BackendPlatformName = "list_clipper_bench";
+    io.BackendRendererName = "null";
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+}
+
+// 1 to 4 lines, from a hash of the row and of the layout generation (a new generation changes some rows)
+static float RowHeight(int row, int generation)
+{
+    unsigned int hash = (unsigned int)row * 2654435761u;
+    if (generation > 0 && row % 5 == 0)
+        hash += (unsigned int)generation * 40503u;
+    return LINE_HEIGHT * (float)(1 + (hash >> 16) % 4);
+}
+
+struct DisplayedRow
+{
+    int row;
+    float y;            // Cursor when submitted
+    double expectedY;   // Clipper origin + GetItemPos(row) when submitted
+};
+
+struct Frame
+{
+    std::vector<DisplayedRow> rows;
+    ImRect clipRect;
+    float scrollY;
+    float scrollMaxY;
+};
+
+// One frame of the list, in a window of fixed size. 'scrollY' >= 0 scrolls there first.
+static Frame DrawList(ImGuiListClipperHeights* heights, int generation, float scrollY, bool record)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(50, 50), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(400, 500), ImGuiCond_Always);
+    if (scrollY >= 0.0f)
+        ImGui::SetNextWindowScroll(ImVec2(0.0f, scrollY));
+    ImGui::Begin("List", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+
+    Frame frame;
+    ImGuiListClipper clipper;
+    if (heights)
+        clipper.BeginVariableHeight(ROW_COUNT, heights);
+    else
+        clipper.Begin(ROW_COUNT, LINE_HEIGHT + ImGui::GetStyle().ItemSpacing.y);
+    while (clipper.Step())
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+        {
+            if (record)
+            {
+                const double expectedY = (double)clipper.StartPosY + clipper.StartSeekOffsetY + heights->GetItemPos(row);
+                frame.rows.push_back({ row, window->DC.CursorPos.y, expectedY });
+            }
+            ImGui::Dummy(ImVec2(ROW_WIDTH, heights ? RowHeight(row, generation) : LINE_HEIGHT));
+        }
+    frame.clipRect = window->ClipRect;
+    frame.scrollY = window->Scroll.y;
+    frame.scrollMaxY = window->ScrollMax.y;
+    ImGui::End();
+    ImGui::Render();
+    return frame;
+}
+
+static void CheckFrame(const Frame& frame, const ImGuiListClipperHeights& heights, int generation, const char* test)
+{
+    if (!Check(!frame.rows.empty(), test, "rows displayed"))
+        return;
+
+    // Rows are where the heights say, whether the clipper seeked to them or they follow the previous one. Positions are
+    // floats: at a million rows (tens of millions of pixels), a pixel or two off is float rounding.
+    const float spacing = ImGui::GetStyle().ItemSpacing.y;
+    bool placed = true;
+    for (const DisplayedRow& displayed : frame.rows)
+        placed &= std::fabs(displayed.y - displayed.expectedY) <= 2.0 + std::fabs(displayed.expectedY) * 1e-7;
+    Check(placed, test, "rows at their GetItemPos() offset");
+
+    // Rows measured as they are
+    bool measured = true;
+    for (const DisplayedRow& displayed : frame.rows)
+        measured &= heights.GetItemHeight(displayed.row) == RowHeight(displayed.row, generation) + spacing;
+    Check(measured, test, "displayed rows measured with their height");
+
+    // Visible rows: from the one at the top of the clip rect to the one at its bottom, without gap (row 0 is always
+    // displayed first, to measure it)
+    const DisplayedRow* first = nullptr;
+    const DisplayedRow* last = nullptr;
+    bool contiguous = true;
+    for (const DisplayedRow& displayed : frame.rows)
+    {
+        const float bottom = displayed.y + heights.GetItemHeight(displayed.row);
+        if (bottom <= frame.clipRect.Min.y || displayed.y >= frame.clipRect.Max.y)
+            continue;
+        contiguous &= last == nullptr || displayed.row == last->row + 1;
+        if (first == nullptr)
+            first = &displayed;
+        last = &displayed;
+    }
+    if (!Check(first != nullptr && contiguous, test, "visible rows contiguous"))
+        return;
+    Check(first->y <= frame.clipRect.Min.y + 0.5f || first->row == 0, test, "visible area covered at the top");
+    Check(last->y + heights.GetItemHeight(last->row) >= frame.clipRect.Max.y - 0.5f || last->row == ROW_COUNT - 1, test,
+        "visible area covered at the bottom");
+}
+
+static void TestClipper()
+{
+    const char* test = "clipper";
+    CreateHeadlessContext();
+    ImGuiListClipperHeights heights;
+    std::mt19937 rng(34);
+
+    // Top: row 0 at the top of the window
+    Frame frame = DrawList(&heights, 0, 0.0f, true);
+    CheckFrame(frame, heights, 0, test);
+    Check(frame.rows[0].row == 0 && frame.rows[0].y <= frame.clipRect.Min.y + ImGui::GetStyle().WindowPadding.y, test, "first row at the top");
+    Check(heights.DefaultHeight == RowHeight(0, 0) + ImGui::GetStyle().ItemSpacing.y, test, "DefaultHeight from row 0");
+
+    // Jumps into unmeasured areas, each followed by a few frames of scrolling
+    for (int jump = 0; jump < 100 && g_failures == 0; jump++)
+    {
+        frame = DrawList(&heights, 0, (float)(rng() % 1000) / 1000.0f * frame.scrollMaxY, true);
+        CheckFrame(frame, heights, 0, test);
+        for (int n = 0; n < 3; n++)
+        {
+            frame = DrawList(&heights, 0, frame.scrollY + (float)(rng() % 200) - 100.0f, true);
+            CheckFrame(frame, heights, 0, test);
+        }
+    }
+
+    // Bottom: the total height is known only once the last rows are measured, so the scroll limit may move a little
+    for (int n = 0; n < 3; n++)
+    {
+        frame = DrawList(&heights, 0, frame.scrollMaxY, true);
+        CheckFrame(frame, heights, 0, test);
+    }
+    Check(frame.rows.back().row == ROW_COUNT - 1 && frame.scrollY == frame.scrollMaxY, test, "last row reached at the bottom");
+
+    // Some rows change height, as after a wrap width change: displayed ones get measured again
+    const int generation = 1;
+    for (int jump = 0; jump < 20 && g_failures == 0; jump++)
+    {
+        const float scrollY = (jump == 0) ? 0.0f : (float)(rng() % 1000) / 1000.0f * frame.scrollMaxY;
+        DrawList(&heights, generation, scrollY, false);        // Measures the new heights
+        frame = DrawList(&heights, generation, -1.0f, true);
+        CheckFrame(frame, heights, generation, test);
+    }
+    ImGui::DestroyContext();
+}
+
+static void RunBench(int frames)
+{
+    typedef std::chrono::steady_clock Clock;
+    std::mt19937 rng(34);
+
+    // Heights operations at ROW_COUNT items, measured
+    {
+        ImGuiListClipperHeights heights;
+        heights.Resize(ROW_COUNT);
+        const int ops = 2000000;
+        std::vector<int> items(ops);
+        for (int& item : items)
+            item = (int)(rng() % ROW_COUNT);
+        volatile double sink = 0.0;
+        (void)sink;
+
+        Clock::time_point start = Clock::now();
+        for (int n = 0; n < ops; n++)
+            heights.SetItemHeight(items[n], 17.0f + (float)(n & 3) * 13.0f);
+        const double setNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+        start = Clock::now();
+        for (int n = 0; n < ops; n++)
+            sink = heights.GetItemPos(items[n]);
+        const double posNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+        const double total = heights.GetTotalHeight();
+        start = Clock::now();
+        for (int n = 0; n < ops; n++)
+            sink = heights.FindItemAtPos(total * items[n] / ROW_COUNT);
+        const double findNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+        start = Clock::now();
+        for (int n = 0; n < ops / 10; n++)
+            heights.Resize(ROW_COUNT + n + 1);
+        const double appendNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (ops / 10);
+        printf("ImGuiListClipperHeights, %d items: SetItemHeight %.0f ns, GetItemPos %.0f ns, FindItemAtPos %.0f ns, Resize(+1) %.0f ns\n",
+            ROW_COUNT, setNs, posNs, findNs, appendNs);
+    }
+
+    // Frames: fixed height as the baseline, variable height scrolling by about a page, variable height jumping to
+    // random places (mostly unmeasured rows). Median of 'frames' frames each, after a few warm-up ones.
+    struct Scenario { const char* name; bool variable; bool jump; };
+    static const Scenario SCENARIOS[] = {
+        { "fixed height, scrolling", false, false },
+        { "variable height, scrolling", true, false },
+        { "variable height, jumping", true, true },
+    };
+    printf("%d rows, us per frame (median):\n", ROW_COUNT);
+    for (const Scenario& scenario : SCENARIOS)
+    {
+        CreateHeadlessContext();
+        ImGuiListClipperHeights heights;
+        std::vector<double> times;
+        float scrollY = 0.0f, scrollMaxY = 0.0f;
+        for (int n = 0; n < frames + 10; n++)
+        {
+            float target = scrollY + 400.0f;
+            if (scenario.jump)
+                target = (float)(rng() % 1000) / 1000.0f * scrollMaxY;
+            if (target > scrollMaxY && n > 0)
+                target = 0.0f;
+            const Clock::time_point start = Clock::now();
+            const Frame frame = DrawList(scenario.variable ? &heights : nullptr, 0, target, false);
+            const double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            scrollY = frame.scrollY;
+            scrollMaxY = frame.scrollMaxY;
+            if (n >= 10)
+                times.push_back(elapsed);
+        }
+        std::sort(times.begin(), times.end());
+        printf("  %-30s %8.1f\n", scenario.name, times[times.size() / 2]);
+        ImGui::DestroyContext();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* mode = (argc >= 2 && (strcmp(argv[1], "test") == 0 || strcmp(argv[1], "bench") == 0)) ? argv[1] : nullptr;
+    const char* framesArg = (mode == nullptr) ? (argc >= 2 ? argv[1] : nullptr) : (argc >= 3 ? argv[2] : nullptr);
+    const int frames = framesArg ? std::max(1, atoi(framesArg)) : 200;
+
+    if (mode == nullptr || strcmp(mode, "test") == 0)
+    {
+        TestHeights();
+        TestClipper();
+        printf("test: %s\n", g_failures == 0 ? "ok" : "FAILED");
+    }
+    if (mode == nullptr || strcmp(mode, "bench") == 0)
+        RunBench(frames);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,646 @@
+// Test of the MinHook hook table and trampoline buffer (external/kiero/minhook/src): the target index (hook_index.c),
+// the hook API with queued changes (hook.c) and the block allocator (buffer.c), built for Linux on the stand-ins of
+// tools/win32. Hooks patch targets in a simulated address space, so nothing is executed.
+//
+// - index: random inserts, moves and removals against a map, small and growing tables, clusters wrapping around the
+//          end of the table; after each step every target is found at its position and every run is unbroken
+//          (backward shift deletion)
+// - hooks: random MH_CreateHook, MH_RemoveHook, MH_EnableHook/MH_DisableHook and MH_Queue*Hook + MH_ApplyQueued on a
+//          model of the expected state: same statuses, targets patched exactly when enabled, trampolines of live hooks
+//          intact, everything released by MH_Uninitialize
+// - buffer: AllocateBuffer()/FreeBuffer() through a mock provider (SetBufferProvider()) that counts calls and fails
+//           some allocations: slots within reach of their origin, distinct and left intact; blocks with room reused
+//           without probing the address space; at most MAX_EMPTY_BLOCKS empty blocks kept; NULL when nothing is in reach
+//
+//   minhook_test [seed]        Exit code 1 if a check fails
+//
+// Build on Linux (x64), from syslib/:
+//   g++ -std=c++14 -O2 -I. -Itools/win32 tools/minhook_test.cpp external/kiero/minhook/src/hook.c
+//       external/kiero/minhook/src/hook_index.c external/kiero/minhook/src/buffer.c
+//       external/kiero/minhook/src/trampoline.c external/kiero/minhook/src/hde/hde64.c -o minhook_test
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include "external/kiero/minhook/include/MinHook.h"
+#include "external/kiero/minhook/src/buffer.h"
+#include "external/kiero/minhook/src/hook_index.h"
+
+#if !defined(__x86_64__)
+#error "x64 only: the x86 trampolines need hde32 and a 32-bit address space"
+#endif
+
+static int g_failures = 0;
+
+static void Check(bool condition, const char* test, const char* what)
+{
+    if (!condition && g_failures++ < 20)
+        printf("%s: %s FAILED\n", test, what);
+}
+
+// Simulated address space: 4 GB in 64 KB granules, with a module in the middle holding the targets and the detour.
+// Granules are mapped for real when allocated, so the hooks can write to them.
+static const ULONG_PTR VM_BASE = 0x300000000000ULL;
+static const ULONG_PTR GRANULARITY = 0x10000;
+static const unsigned int GRANULES = 0x10000;
+static const ULONG_PTR MODULE_BASE = VM_BASE + 0x80000000ULL;
+static const unsigned int MODULE_GRANULES = 16;
+
+// Taken: mapped by someone else, one allocation per granule
+enum GranuleState : unsigned char { Free, Module, Allocated, Taken };
+
+static GranuleState g_granules[GRANULES];
+static std::map<ULONG_PTR, SIZE_T> g_allocations;
+
+static bool InSpace(ULONG_PTR address)
+{
+    return address >= VM_BASE && address < VM_BASE + (ULONG_PTR)GRANULES * GRANULARITY;
+}
+
+LPVOID VirtualAlloc(LPVOID address, SIZE_T size, DWORD, DWORD)
+{
+    const ULONG_PTR start = (ULONG_PTR)address;
+    if (!InSpace(start) || start % GRANULARITY != 0 || size > GRANULARITY || g_granules[(start - VM_BASE) / GRANULARITY] != Free)
+        return nullptr;
+    if (mmap(address, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != address)
+    {
+        printf("mmap failed at %p\n", address);
+        exit(2);
+    }
+    g_granules[(start - VM_BASE) / GRANULARITY] = Allocated;
+    g_allocations[start] = size;
+    return address;
+}
+
+BOOL VirtualFree(LPVOID address, SIZE_T, DWORD)
+{
+    auto allocation = g_allocations.find((ULONG_PTR)address);
+    if (allocation == g_allocations.end())
+        return FALSE;
+    munmap(address, allocation->second);
+    g_granules[(allocation->first - VM_BASE) / GRANULARITY] = Free;
+    g_allocations.erase(allocation);
+    return TRUE;
+}
+
+SIZE_T VirtualQuery(LPCVOID address, PMEMORY_BASIC_INFORMATION info, SIZE_T)
+{
+    const ULONG_PTR start = (ULONG_PTR)address;
+    if (!InSpace(start))
+        return 0;
+    const unsigned int granule = (unsigned int)((start - VM_BASE) / GRANULARITY);
+    const GranuleState state = g_granules[granule];
+    unsigned int end = granule + 1;
+    while (state != Allocated && end < GRANULES && g_granules[end] == state)
+        end++;
+    // A module is a single allocation
+    unsigned int begin = granule;
+    while (state == Module && begin > 0 && g_granules[begin - 1] == Module)
+        begin--;
+    memset(info, 0, sizeof(*info));
+    info->BaseAddress = (LPVOID)(VM_BASE + (ULONG_PTR)granule * GRANULARITY);
+    info->AllocationBase = (LPVOID)(VM_BASE + (ULONG_PTR)begin * GRANULARITY);
+    info->RegionSize = (ULONG_PTR)(end - granule) * GRANULARITY;
+    info->State = (state == Free) ? MEM_FREE : MEM_COMMIT;
+    info->Protect = (state == Module) ? PAGE_EXECUTE_READ : (state == Allocated) ? PAGE_EXECUTE_READWRITE : 0;
+    return sizeof(*info);
+}
+
+void GetSystemInfo(LPSYSTEM_INFO info)
+{
+    info->dwPageSize = 0x1000;
+    info->dwAllocationGranularity = (DWORD)GRANULARITY;
+    info->lpMinimumApplicationAddress = (LPVOID)GRANULARITY;
+    info->lpMaximumApplicationAddress = (LPVOID)0x7FFFFFFEFFFFULL;
+}
+
+//-------------------------------------------------------------------------
+// Index
+
+// Same hash as hook_index.c, to build collisions
+static UINT Home(LPVOID target, UINT bits)
+{
+    return (UINT)(((ULONG_PTR)target * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+}
+
+static bool CheckIndex(const HOOK_INDEX& index, const std::unordered_map<LPVOID, UINT>& model, const std::vector<LPVOID>& absent)
+{
+    if (index.size != model.size() || (index.pSlots != nullptr && index.size > (1u << index.bits) / 2))
+        return false;
+    for (const auto& entry : model)
+    {
+        if (HookIndexFind(&index, entry.first) != entry.second)
+            return false;
+    }
+    for (LPVOID target : absent)
+    {
+        if (model.count(target) == 0 && HookIndexFind(&index, target) != HOOK_INDEX_NOT_FOUND)
+            return false;
+    }
+    if (index.pSlots == nullptr)
+        return true;
+    // Every target is reachable from its home slot without crossing an empty slot
+    const UINT mask = (1u << index.bits) - 1;
+    UINT slots = 0;
+    for (UINT n = 0; n <= mask; n++)
+    {
+        if (index.pSlots[n].pTarget == nullptr)
+            continue;
+        slots++;
+        for (UINT i = Home(index.pSlots[n].pTarget, index.bits); i != n; i = (i + 1) & mask)
+        {
+            if (index.pSlots[i].pTarget == nullptr)
+                return false;
+        }
+    }
+    return slots == index.size;
+}
+
+static void TestIndex(std::mt19937& random)
+{
+    const char* test = "index";
+    const HANDLE heap = HeapCreate(0, 0, 0);
+
+    // Random operations on functions 16 bytes apart, through growth from the smallest table
+    {
+        HOOK_INDEX index = {};
+        std::unordered_map<LPVOID, UINT> model;
+        std::vector<LPVOID> pool;
+        for (int n = 0; n < 2000; n++)
+            pool.push_back((LPVOID)(0x7FF612340000ULL + (ULONG_PTR)n * 16));
+        bool ok = true;
+        for (int step = 0; step < 200000 && ok; step++)
+        {
+            LPVOID target = pool[random() % (step < 100000 ? 100 : pool.size())];
+            const unsigned int operation = random() % 10;
+            if (operation < 5 && model.count(target) == 0)
+            {
+                ok = HookIndexReserve(&index, heap, (UINT)model.size() + 1) != FALSE;
+                HookIndexInsert(&index, target, (UINT)step);
+                model[target] = (UINT)step;
+            }
+            else if (operation < 6 && model.count(target) != 0)
+            {
+                HookIndexMove(&index, target, (UINT)step);
+                model[target] = (UINT)step;
+            }
+            else
+            {
+                HookIndexRemove(&index, target);     // Also for targets not indexed
+                model.erase(target);
+            }
+            if (step % 97 == 0)
+                ok = ok && CheckIndex(index, model, pool);
+        }
+        ok = ok && CheckIndex(index, model, pool);
+        Check(ok, test, "random operations");
+        HookIndexFree(&index, heap);
+        Check(index.pSlots == nullptr && HookIndexFind(&index, pool[0]) == HOOK_INDEX_NOT_FOUND, test, "free");
+    }
+
+    // Clusters on the last slots, wrapping around to the first ones, emptied in every order
+    {
+        HOOK_INDEX index = {};
+        HookIndexReserve(&index, heap, 1);
+        const UINT bits = index.bits;
+        const UINT mask = (1u << bits) - 1;
+        std::vector<LPVOID> wrapping;
+        for (ULONG_PTR address = 0x7FF600000000ULL; wrapping.size() < 12; address += 16)
+        {
+            const UINT home = Home((LPVOID)address, bits);
+            if (home == mask || home == mask - 1 || home == 0)
+                wrapping.push_back((LPVOID)address);
+        }
+        bool ok = true;
+        for (int round = 0; round < 500 && ok; round++)
+        {
+            std::unordered_map<LPVOID, UINT> model;
+            std::shuffle(wrapping.begin(), wrapping.end(), random);
+            for (UINT n = 0; n < wrapping.size(); n++)
+            {
+                HookIndexInsert(&index, wrapping[n], n);
+                model[wrapping[n]] = n;
+            }
+            ok = index.bits == bits && CheckIndex(index, model, wrapping);
+            std::shuffle(wrapping.begin(), wrapping.end(), random);
+            for (LPVOID target : wrapping)
+            {
+                HookIndexRemove(&index, target);
+                model.erase(target);
+                ok = ok && CheckIndex(index, model, wrapping);
+            }
+        }
+        Check(ok, test, "clusters wrapping around the table");
+        HookIndexFree(&index, heap);
+    }
+    HeapDestroy(heap);
+}
+
+//-------------------------------------------------------------------------
+// Hooks
+
+static const int TARGET_COUNT = 96;     // Past the initial capacities of the entries and the index
+static const int TARGET_SIZE = 64;
+static const int PROLOGUE_SIZE = 8;
+
+struct HookModel
+{
+    bool created = false;
+    bool enabled = false;
+    bool queueEnable = false;
+    bool queueRemove = false;
+    LPBYTE trampoline = nullptr;
+};
+
+static LPBYTE g_module;
+static HookModel g_hooks[TARGET_COUNT];
+
+static LPBYTE Target(int n)
+{
+    return g_module + GRANULARITY + (ULONG_PTR)n * TARGET_SIZE;
+}
+
+// push rbp; mov rbp, rsp; sub rsp, n; then padding and ret. Different for each target, so trampolines can be told apart
+static void WritePrologue(LPBYTE code, int n)
+{
+    const BYTE prologue[PROLOGUE_SIZE] = { 0x55, 0x48, 0x89, 0xE5, 0x48, 0x83, 0xEC, (BYTE)n };
+    memcpy(code, prologue, PROLOGUE_SIZE);
+    memset(code + PROLOGUE_SIZE, 0x90, TARGET_SIZE - PROLOGUE_SIZE - 1);
+    code[TARGET_SIZE - 1] = 0xC3;
+}
+
+static bool CheckHooks()
+{
+    BYTE prologue[TARGET_SIZE];
+    for (int n = 0; n < TARGET_COUNT; n++)
+    {
+        const HookModel& hook = g_hooks[n];
+        const LPBYTE target = Target(n);
+        WritePrologue(prologue, n);
+        if (hook.created && hook.enabled)
+        {
+            // jmp rel32 to the relay, in a block of the simulated space
+            INT32 rel;
+            memcpy(&rel, target + 1, sizeof(rel));
+            const ULONG_PTR destination = (ULONG_PTR)target + 5 + rel;
+            if (target[0] != 0xE9 || !InSpace(destination) || g_granules[(destination - VM_BASE) / GRANULARITY] != Allocated
+                || memcmp(target + 5, prologue + 5, TARGET_SIZE - 5) != 0)
+                return false;
+        }
+        else if (memcmp(target, prologue, TARGET_SIZE) != 0)
+        {
+            return false;
+        }
+        if (hook.created && memcmp(hook.trampoline, prologue, PROLOGUE_SIZE) != 0)
+            return false;
+    }
+    return true;
+}
+
+// What MH_ApplyQueued() should do
+static void ApplyQueuedModel()
+{
+    for (HookModel& hook : g_hooks)
+    {
+        if (!hook.created)
+            continue;
+        const bool enable = hook.queueEnable && !hook.queueRemove;
+        if (hook.enabled != enable)
+            hook.enabled = hook.queueEnable = enable;
+        if (hook.queueRemove)
+            hook.created = false;
+    }
+}
+
+static void TestHooks(std::mt19937& random)
+{
+    const char* test = "hooks";
+    g_module = (LPBYTE)mmap((LPVOID)MODULE_BASE, MODULE_GRANULES * GRANULARITY, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (g_module != (LPBYTE)MODULE_BASE)
+    {
+        printf("%s: no module\n", test);
+        g_failures++;
+        return;
+    }
+    for (unsigned int n = 0; n < MODULE_GRANULES; n++)
+        g_granules[(MODULE_BASE - VM_BASE) / GRANULARITY + n] = Module;
+    const LPVOID detour = g_module;
+    g_module[0] = 0xC3;
+    for (int n = 0; n < TARGET_COUNT; n++)
+        WritePrologue(Target(n), n);
+
+    Check(MH_Initialize() == MH_OK, test, "MH_Initialize");
+    int operations[9] = {};
+    bool ok = true;
+    for (int step = 0; step < 100000 && ok; step++)
+    {
+        const int n = random() % TARGET_COUNT;
+        HookModel& hook = g_hooks[n];
+        const LPVOID target = Target(n);
+        const unsigned int operation = random() % 100;
+        MH_STATUS expected = hook.created ? MH_OK : MH_ERROR_NOT_CREATED;
+        MH_STATUS status;
+        if (operation < 15)
+        {
+            LPVOID original = nullptr;
+            expected = hook.created ? MH_ERROR_ALREADY_CREATED : MH_OK;
+            status = MH_CreateHook(target, detour, &original);
+            if (!hook.created && status == MH_OK)
+            {
+                hook = HookModel();
+                hook.created = true;
+                hook.trampoline = (LPBYTE)original;
+            }
+            operations[0]++;
+        }
+        else if (operation < 22)
+        {
+            status = MH_RemoveHook(target);
+            hook.created = false;
+            operations[1]++;
+        }
+        else if (operation < 40)
+        {
+            const bool enable = operation < 31;
+            status = enable ? MH_EnableHook(target) : MH_DisableHook(target);
+            if (hook.created && hook.enabled == enable)
+                expected = enable ? MH_ERROR_ENABLED : MH_ERROR_DISABLED;
+            else if (hook.created)
+                hook.enabled = hook.queueEnable = enable;
+            operations[2]++;
+        }
+        else if (operation < 70)
+        {
+            const bool enable = operation < 58;
+            status = enable ? MH_QueueEnableHook(target) : MH_QueueDisableHook(target);
+            if (hook.created)
+            {
+                hook.queueEnable = enable;
+                hook.queueRemove = false;
+            }
+            operations[3]++;
+        }
+        else if (operation < 85)
+        {
+            status = MH_QueueRemoveHook(target);
+            if (hook.created)
+                hook.queueRemove = true;
+            operations[4]++;
+        }
+        else if (operation < 98)
+        {
+            expected = MH_OK;
+            status = MH_ApplyQueued();
+            ApplyQueuedModel();
+            operations[5]++;
+        }
+        else
+        {
+            // Every hook at once
+            expected = MH_OK;
+            const unsigned int all = random() % 4;
+            if (all < 2)
+            {
+                status = all == 0 ? MH_QueueEnableHook(MH_ALL_HOOKS) : MH_QueueDisableHook(MH_ALL_HOOKS);
+                for (HookModel& any : g_hooks)
+                {
+                    any.queueEnable = all == 0;
+                    any.queueRemove = false;
+                }
+            }
+            else if (all == 2)
+            {
+                status = MH_QueueRemoveHook(MH_ALL_HOOKS);
+                for (HookModel& any : g_hooks)
+                    any.queueRemove = true;
+            }
+            else
+            {
+                // Hooks already enabled keep their queued state
+                status = MH_EnableHook(MH_ALL_HOOKS);
+                for (HookModel& any : g_hooks)
+                {
+                    if (!any.enabled)
+                        any.enabled = any.queueEnable = true;
+                }
+            }
+            operations[6]++;
+        }
+        if (status != expected)
+        {
+            printf("%s: step %d, operation %u on target %d: status %d, expected %d\n", test, step, operation, n, status, expected);
+            ok = false;
+        }
+        ok = ok && CheckHooks();
+    }
+    Check(ok, test, "random operations");
+
+    Check(MH_Uninitialize() == MH_OK, test, "MH_Uninitialize");
+    for (HookModel& hook : g_hooks)
+        hook.created = false;
+    Check(CheckHooks(), test, "targets restored");
+    Check(g_allocations.empty(), test, "trampoline blocks released");
+    printf("hooks: %d create, %d remove, %d enable/disable, %d queue enable/disable, %d queue remove, %d apply, %d all\n",
+        operations[0], operations[1], operations[2], operations[3], operations[4], operations[5], operations[6]);
+    munmap(g_module, MODULE_GRANULES * GRANULARITY);
+}
+
+//-------------------------------------------------------------------------
+// Buffer
+
+// Same as buffer.c
+static const ULONG_PTR MEMORY_BLOCK_SIZE = 0x1000;
+static const ULONG_PTR MAX_MEMORY_RANGE = 0x40000000;
+static const int MAX_EMPTY_BLOCKS = 4;
+
+static int g_providerAllocs, g_providerFrees, g_providerQueries;
+static int g_failEvery;         // Every n-th allocation fails, as if another thread took the region first
+
+static LPVOID MockAlloc(LPVOID address, SIZE_T size)
+{
+    if (g_failEvery != 0 && ++g_providerAllocs % g_failEvery == 0)
+        return nullptr;
+    if (g_failEvery == 0)
+        g_providerAllocs++;
+    return VirtualAlloc(address, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+}
+
+static VOID MockFree(LPVOID address)
+{
+    g_providerFrees++;
+    VirtualFree(address, 0, MEM_RELEASE);
+}
+
+static SIZE_T MockQuery(LPCVOID address, PMEMORY_BASIC_INFORMATION info)
+{
+    g_providerQueries++;
+    return VirtualQuery(address, info, sizeof(*info));
+}
+
+static const BUFFER_VM_PROVIDER MOCK_PROVIDER = { MockAlloc, MockFree, MockQuery, GetSystemInfo };
+
+static void SetGranules(ULONG_PTR start, ULONG_PTR end, GranuleState state)
+{
+    for (ULONG_PTR address = start; address < end; address += GRANULARITY)
+        g_granules[(address - VM_BASE) / GRANULARITY] = state;
+}
+
+// Each slot is filled with its own address, to catch slots handed out twice or overwritten by the allocator
+static void FillSlot(LPVOID slot)
+{
+    for (int n = 0; n < MEMORY_SLOT_SIZE; n += sizeof(LPVOID))
+        memcpy((LPBYTE)slot + n, &slot, sizeof(LPVOID));
+}
+
+static bool SlotIntact(LPVOID slot)
+{
+    for (int n = 0; n < MEMORY_SLOT_SIZE; n += sizeof(LPVOID))
+    {
+        if (memcmp((LPBYTE)slot + n, &slot, sizeof(LPVOID)) != 0)
+            return false;
+    }
+    return true;
+}
+
+static bool ValidSlot(LPVOID slot, LPVOID origin)
+{
+    const ULONG_PTR address = (ULONG_PTR)slot;
+    const ULONG_PTR distance = address > (ULONG_PTR)origin ? address - (ULONG_PTR)origin : (ULONG_PTR)origin - address;
+    return slot != nullptr && InSpace(address) && distance <= MAX_MEMORY_RANGE && address % MEMORY_SLOT_SIZE == 0
+        && address % MEMORY_BLOCK_SIZE >= MEMORY_SLOT_SIZE && address % GRANULARITY < MEMORY_BLOCK_SIZE
+        && g_granules[(address - VM_BASE) / GRANULARITY] == Allocated;
+}
+
+static void TestBuffer(std::mt19937& random)
+{
+    const char* test = "buffer";
+    memset(g_granules, Free, sizeof(g_granules));
+    SetBufferProvider(&MOCK_PROVIDER);
+    InitializeBuffer();
+
+    // Random allocations from 8 modules across the space, some crowded, and frees; every 3rd provider allocation fails
+    {
+        std::vector<ULONG_PTR> modules;
+        for (int n = 0; n < 8; n++)
+        {
+            const ULONG_PTR base = VM_BASE + 0x10000000ULL + (ULONG_PTR)n * 0x1E000000ULL;
+            modules.push_back(base);
+            SetGranules(base, base + 0x1000000, Module);
+            if (n % 2 == 1)
+                SetGranules(base - 0x4000000, base + 0x8000000, Taken);    // The nearest free granules are 64 MB away
+        }
+        g_failEvery = 3;
+        std::vector<LPVOID> live;
+        bool ok = true;
+        for (int step = 0; step < 200000 && ok; step++)
+        {
+            if (live.empty() || random() % 100 < (step < 100000 ? 60u : 40u))
+            {
+                const LPVOID origin = (LPVOID)(modules[random() % modules.size()] + random() % 0x1000000);
+                const LPVOID slot = AllocateBuffer(origin);
+                ok = ValidSlot(slot, origin);
+                if (ok)
+                {
+                    FillSlot(slot);
+                    live.push_back(slot);
+                }
+            }
+            else
+            {
+                const size_t n = random() % live.size();
+                ok = SlotIntact(live[n]);
+                FreeBuffer(live[n]);
+                live[n] = live.back();
+                live.pop_back();
+            }
+            if (step % 1000 == 0)
+            {
+                // Blocks with used slots, plus the empty ones kept
+                std::vector<ULONG_PTR> blocks;
+                for (LPVOID slot : live)
+                    blocks.push_back((ULONG_PTR)slot / MEMORY_BLOCK_SIZE);
+                std::sort(blocks.begin(), blocks.end());
+                const size_t usedBlocks = std::unique(blocks.begin(), blocks.end()) - blocks.begin();
+                ok = ok && g_allocations.size() <= usedBlocks + MAX_EMPTY_BLOCKS;
+            }
+        }
+        for (LPVOID slot : live)
+        {
+            ok = ok && SlotIntact(slot);
+            FreeBuffer(slot);
+        }
+        g_failEvery = 0;
+        Check(ok, test, "random allocations");
+        Check(g_allocations.size() <= (size_t)MAX_EMPTY_BLOCKS, test, "empty blocks released");
+        UninitializeBuffer();
+        Check(g_allocations.empty(), test, "UninitializeBuffer");
+        memset(g_granules, Free, sizeof(g_granules));
+    }
+
+    // A block with room, or an empty one kept, is reused without asking the provider
+    {
+        const ULONG_PTR module = VM_BASE + 0x80000000ULL;
+        SetGranules(module, module + 0x100000, Module);
+        const LPVOID origin = (LPVOID)(module + 0x1234);
+        const int slotsPerBlock = (int)((MEMORY_BLOCK_SIZE - MEMORY_SLOT_SIZE) / MEMORY_SLOT_SIZE);
+        std::vector<LPVOID> slots;
+        slots.push_back(AllocateBuffer(origin));
+        const int allocs = g_providerAllocs, queries = g_providerQueries;
+        for (int n = 1; n < slotsPerBlock; n++)
+            slots.push_back(AllocateBuffer(origin));
+        Check(g_providerAllocs == allocs && g_providerQueries == queries, test, "block with room reused");
+        slots.push_back(AllocateBuffer(origin));
+        Check(g_providerAllocs == allocs + 1 && g_allocations.size() == 2, test, "new block when full");
+        for (LPVOID slot : slots)
+            FreeBuffer(slot);
+        Check(g_allocations.size() == 2, test, "empty blocks kept");
+        const int frees = g_providerFrees;
+        const LPVOID slot = AllocateBuffer(origin);
+        Check(ValidSlot(slot, origin) && g_providerAllocs == allocs + 1 && g_providerFrees == frees, test, "empty block reused");
+        FreeBuffer(slot);
+        // The empty blocks kept are out of reach of a module 1.9 GB below
+        const ULONG_PTR farModule = VM_BASE + 0x8000000ULL;
+        SetGranules(farModule, farModule + 0x100000, Module);
+        const LPVOID farSlot = AllocateBuffer((LPVOID)farModule);
+        Check(ValidSlot(farSlot, (LPVOID)farModule) && g_providerAllocs == allocs + 2, test, "empty block out of reach");
+        FreeBuffer(farSlot);
+        UninitializeBuffer();
+        memset(g_granules, Free, sizeof(g_granules));
+    }
+
+    // Nothing free within reach, then a single granule 900 MB away
+    {
+        const ULONG_PTR module = VM_BASE + 0x80000000ULL;
+        const LPVOID origin = (LPVOID)(module + 0x1234);
+        SetGranules(VM_BASE, VM_BASE + (ULONG_PTR)GRANULES * GRANULARITY, Taken);
+        SetGranules(module, module + 0x100000, Module);
+        Check(AllocateBuffer(origin) == nullptr, test, "NULL out of reach");
+        const ULONG_PTR far = module - 0x38400000ULL;
+        SetGranules(far, far + GRANULARITY, Free);
+        const LPVOID slot = AllocateBuffer(origin);
+        Check(ValidSlot(slot, origin) && (ULONG_PTR)slot / GRANULARITY == far / GRANULARITY, test, "far granule");
+        FreeBuffer(slot);
+        UninitializeBuffer();
+        memset(g_granules, Free, sizeof(g_granules));
+    }
+
+    SetBufferProvider(nullptr);
+    printf("buffer: %d provider allocations, %d frees, %d queries\n", g_providerAllocs, g_providerFrees, g_providerQueries);
+}
+
+int main(int argc, char** argv)
+{
+    std::mt19937 random(argc > 1 ? (unsigned int)atoi(argv[1]) : 47);
+    TestIndex(random);
+    TestHooks(random);
+    TestBuffer(random);
+    printf("%s\n", g_failures == 0 ? "ok" : "FAILED");
+    return g_failures == 0 ? 0 : 1;
+}
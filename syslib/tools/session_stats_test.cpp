@@ -0,0 +1,322 @@
+// Test of RateMeter and SessionStats (session_stats.cpp) against brute-force computations over the list of events:
+//
+// - meter:  random events and idle advances, with gaps longer than the window. Total, window total and rate, and the
+//           EWMA (sum of each event's exponentially decayed weight, divided by the session's weight) must match
+// - steady: a constant 3600/h converges to 3600/h on both rates, and the first minutes aren't biased toward 0
+// - stats:  a walk over maps and spots with damage, experience (including drops) and kills, leaving the game once.
+//           Totals and every map and spot breakdown (values and time) must match
+// - log:    the .mbss file written by AppendLog() is parsed back: header, record sizes, and every rates, map and spot
+//           record must hold the values SessionStats reports
+//
+//   session_stats_test    Exit code 1 if a check fails
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/session_stats_test.cpp session_stats.cpp -o session_stats_test
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "session_stats.h"
+
+static const char* LOG_FILENAME = "session_stats_test.mbss";
+
+static int g_failures = 0;
+
+static bool Check(bool condition, const char* test, const char* what)
+{
+    if (!condition && g_failures++ < 20)
+        printf("%s: %s FAILED\n", test, what);
+    return condition;
+}
+
+static bool Near(double a, double b)
+{
+    return std::fabs(a - b) <= 1e-6 * std::max(1.0, std::fabs(b));
+}
+
+static int FloorDiv(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+struct Event
+{
+    int64_t time;
+    double amount;
+};
+
+static void TestMeter(std::mt19937_64& random)
+{
+    const char* test = "meter";
+    for (int trial = 0; trial < 200 && g_failures == 0; trial++)
+    {
+        RateMeter meter;
+        const int64_t start = 1000000 + random() % 100000;
+        meter.Reset(start);
+        std::vector<Event> events;
+        int64_t time = start;
+        for (int n = 0; n < 2000; n++)
+        {
+            time += random() % (trial % 2 ? 20000 : 3000);
+            if (random() % 5 == 0)
+                time += random() % 4000000;             // Up to 66 minutes idle
+            const double amount = 1.0 + random() % 5;
+            if (random() % 3)
+            {
+                meter.Add(time, amount);
+                events.push_back({ time, amount });
+            }
+            else
+            {
+                meter.Advance(time);
+            }
+            if (n % 37 != 0)
+                continue;
+
+            const int64_t windowStart = std::max(start, (time / RateMeter::BUCKET_MS - RateMeter::BUCKET_COUNT + 1) * RateMeter::BUCKET_MS);
+            double total = 0.0, windowTotal = 0.0, decayed = 0.0;
+            for (const Event& event : events)
+            {
+                total += event.amount;
+                if (event.time >= windowStart)
+                    windowTotal += event.amount;
+                decayed += event.amount / RateMeter::SMOOTHING_MS * std::exp(-(double)(time - event.time) / RateMeter::SMOOTHING_MS);
+            }
+            const double span = (double)std::max<int64_t>(time - windowStart, RateMeter::BUCKET_MS);
+            const double weight = 1.0 - std::exp(-(double)std::max<int64_t>(time - start, RateMeter::BUCKET_MS) / RateMeter::SMOOTHING_MS);
+            Check(Near(meter.GetTotal(), total), test, "total");
+            Check(Near(meter.GetWindowTotal(), windowTotal), test, "window total");
+            Check(Near(meter.GetWindowRate(time), windowTotal * 3600000.0 / span), test, "window rate");
+            Check(Near(meter.GetSmoothedRate(time), decayed / weight * 3600000.0), test, "smoothed rate");
+        }
+    }
+}
+
+static void TestSteady()
+{
+    const char* test = "steady";
+    RateMeter meter;
+    meter.Reset(0);
+    for (int64_t time = 1000; time <= 2 * 3600 * 1000; time += 1000)
+    {
+        meter.Add(time, 1.0);
+        if (time == 2 * 60 * 1000)
+            Check(std::fabs(meter.GetSmoothedRate(time) - 3600.0) < 100.0 && std::fabs(meter.GetWindowRate(time) - 3600.0) < 100.0,
+                test, "3600/h after 2 minutes");
+    }
+    Check(std::fabs(meter.GetWindowRate(2 * 3600 * 1000) - 3600.0) < 60.0, test, "window rate 3600/h");
+    Check(std::fabs(meter.GetSmoothedRate(2 * 3600 * 1000) - 3600.0) < 10.0, test, "smoothed rate 3600/h");
+}
+
+// Expected values of a map or spot
+struct Expected
+{
+    double values[SessionStats::METRIC_COUNT] = {};
+    int64_t timeMs = 0;
+};
+
+typedef std::tuple<int, int, int> SpotKey;
+
+static bool SameBreakdown(const SessionStats::Breakdown& breakdown, const Expected& expected)
+{
+    for (int metric = 0; metric < SessionStats::METRIC_COUNT; metric++)
+        if (!Near(breakdown.values[metric], expected.values[metric]))
+            return false;
+    return breakdown.timeMs == expected.timeMs;
+}
+
+template <typename T>
+static T Get(const std::vector<char>& data, size_t offset)
+{
+    T value;
+    memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+static void TestLog(const SessionStats& stats, int64_t time)
+{
+    const char* test = "log";
+    const int64_t WALL_TIME = 1700000000000LL;
+    remove(LOG_FILENAME);
+    Check(stats.AppendLog(LOG_FILENAME, time, WALL_TIME, false), test, "rates appended");
+    Check(stats.AppendLog(LOG_FILENAME, time, WALL_TIME + 1, true), test, "rates, maps and spots appended");
+
+    std::ifstream file(LOG_FILENAME, std::ios::binary);
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    remove(LOG_FILENAME);
+    if (!Check(data.size() >= 8 && memcmp(data.data(), "MBSS", 4) == 0 && Get<uint32_t>(data, 4) == 1, test, "header"))
+        return;
+
+    const size_t METRICS_SIZE = SessionStats::METRIC_COUNT * sizeof(double);
+    int records[4] = {};
+    size_t offset = 8;
+    while (offset + 5 <= data.size())
+    {
+        const uint8_t type = (uint8_t)data[offset];
+        const uint32_t size = Get<uint32_t>(data, offset + 1);
+        offset += 5;
+        const size_t expectedSize = type == 1 ? 16 + 3 * METRICS_SIZE : type == 2 ? 8 + 12 + 8 + METRICS_SIZE : 8 + 4 + 8 + METRICS_SIZE;
+        if (!Check(type >= 1 && type <= 3 && size == expectedSize && offset + size <= data.size(), test, "record type and size"))
+            return;
+        Check(Get<int64_t>(data, offset) == WALL_TIME + (records[1] > 0 ? 1 : 0), test, "wall clock time");
+
+        if (type == 1)
+        {
+            Check(Get<int64_t>(data, offset + 8) == stats.GetElapsed(time), test, "session time");
+            for (int metric = 0; metric < SessionStats::METRIC_COUNT; metric++)
+            {
+                const RateMeter& meter = stats.GetMeter((SessionStats::Metric)metric);
+                const size_t values = offset + 16 + metric * 3 * sizeof(double);
+                Check(Get<double>(data, values) == meter.GetTotal() && Get<double>(data, values + 8) == meter.GetWindowRate(time)
+                    && Get<double>(data, values + 16) == meter.GetSmoothedRate(time), test, "rates record");
+            }
+        }
+        else
+        {
+            SessionStats::Breakdown breakdown;
+            const int map = Get<int32_t>(data, offset + 8);
+            const size_t timeOffset = offset + (type == 2 ? 20 : 12);
+            breakdown.timeMs = Get<int64_t>(data, timeOffset);
+            memcpy(breakdown.values, data.data() + timeOffset + 8, METRICS_SIZE);
+
+            const SessionStats::Breakdown* stored = nullptr;
+            if (type == 2)
+            {
+                const SessionStats::Spot spot = { map, Get<int32_t>(data, offset + 12), Get<int32_t>(data, offset + 16) };
+                const auto found = stats.GetSpots().find(spot);
+                stored = found != stats.GetSpots().end() ? &found->second : nullptr;
+            }
+            else
+            {
+                const auto found = stats.GetMaps().find(map);
+                stored = found != stats.GetMaps().end() ? &found->second : nullptr;
+            }
+            Check(stored && stored->timeMs == breakdown.timeMs && memcmp(stored->values, breakdown.values, METRICS_SIZE) == 0,
+                test, type == 2 ? "spot record" : "map record");
+        }
+        records[type]++;
+        offset += size;
+    }
+    Check(offset == data.size(), test, "no trailing bytes");
+    Check(records[1] == 2 && records[2] == (int)stats.GetSpots().size() && records[3] == (int)stats.GetMaps().size(), test, "record counts");
+}
+
+int main()
+{
+    std::mt19937_64 random(50);
+    TestMeter(random);
+    TestSteady();
+
+    // A walk over a few maps at 10 Hz: damage every frame, experience with drops (e.g. a death penalty), kills
+    const char* test = "stats";
+    SessionStats stats;
+    stats.Reset(0);
+    std::map<SpotKey, Expected> spots;
+    std::map<int, Expected> maps;
+    double totals[SessionStats::METRIC_COUNT] = {};
+    int64_t time = 0, experience = 0, lastExperience = 0, lastTime = 0;
+    int map = 0, x = 100, y = 100, health = 100, lastHealth = 0;
+    bool inGame = false;
+    SpotKey spot;
+    for (int frame = 0; frame < 200000; frame++)
+    {
+        time += 100;
+        if (frame >= 90000 && frame < 95000)
+        {
+            // Out of game for 500 s: neither the time nor the events go to a spot
+            if (frame == 90000)
+                stats.OnLeftGame();
+            inGame = false;
+            lastTime = time;
+            continue;
+        }
+        if (random() % 1000 == 0)
+            map = (int)(random() % 4);
+        x += (int)(random() % 3) - 1;
+        y += (int)(random() % 3) - 1;
+        health = (int)(random() % 101);
+        experience = (random() % 50 == 0) ? experience / 2 : experience + (int64_t)(random() % 10);
+
+        if (inGame)
+        {
+            spots[spot].timeMs += time - lastTime;
+            maps[std::get<0>(spot)].timeMs += time - lastTime;
+        }
+        spot = SpotKey(map, FloorDiv(x, SessionStats::SPOT_SIZE), FloorDiv(y, SessionStats::SPOT_SIZE));
+        Expected& spotExpected = spots[spot];
+        Expected& mapExpected = maps[map];
+        if (inGame)
+        {
+            const double damage = std::max(lastHealth - health, 0);
+            const double gained = (double)std::max<int64_t>(experience - lastExperience, 0);
+            spotExpected.values[SessionStats::DamageTaken] += damage;
+            mapExpected.values[SessionStats::DamageTaken] += damage;
+            totals[SessionStats::DamageTaken] += damage;
+            spotExpected.values[SessionStats::Experience] += gained;
+            mapExpected.values[SessionStats::Experience] += gained;
+            totals[SessionStats::Experience] += gained;
+        }
+        inGame = true;
+        lastHealth = health;
+        lastExperience = experience;
+        lastTime = time;
+        stats.Update(time, map, x, y, health, experience);
+
+        if (random() % 10 == 0)
+        {
+            stats.Add(time, SessionStats::Kills);
+            spotExpected.values[SessionStats::Kills] += 1.0;
+            mapExpected.values[SessionStats::Kills] += 1.0;
+            totals[SessionStats::Kills] += 1.0;
+        }
+    }
+
+    for (int metric = 0; metric < SessionStats::METRIC_COUNT; metric++)
+        Check(Near(stats.GetMeter((SessionStats::Metric)metric).GetTotal(), totals[metric]), test, "metric total");
+    Check(stats.GetSpots().size() == spots.size() && stats.GetMaps().size() == maps.size(), test, "map and spot counts");
+    int64_t spotsTime = 0;
+    for (const auto& entry : stats.GetSpots())
+    {
+        const auto found = spots.find(SpotKey(entry.first.map, entry.first.cellX, entry.first.cellY));
+        Check(found != spots.end() && SameBreakdown(entry.second, found->second), test, "spot breakdown");
+        spotsTime += entry.second.timeMs;
+    }
+    for (const auto& entry : stats.GetMaps())
+    {
+        const auto found = maps.find(entry.first);
+        Check(found != maps.end() && SameBreakdown(entry.second, found->second), test, "map breakdown");
+    }
+    Check(spotsTime <= time - 5000 * 100, test, "time in spots excludes time out of game");
+
+    TestLog(stats, time);
+
+    // Per-frame cost
+    const int ITERATIONS = 5000000;
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    for (int n = 0; n < ITERATIONS; n++)
+    {
+        time += 10;
+        stats.Update(time, 0, (n >> 6) & 255, (n >> 14) & 255, n & 127, n);
+    }
+    const Clock::time_point middle = Clock::now();
+    double sink = 0.0;
+    for (int n = 0; n < ITERATIONS; n++)
+        sink += stats.GetMeter(SessionStats::Kills).GetWindowRate(time + n) + stats.GetMeter(SessionStats::Kills).GetSmoothedRate(time + n);
+    const Clock::time_point end = Clock::now();
+    printf("%d spots, %d maps. Update %.1f ns, window and smoothed rate %.1f ns (%g)\n", (int)spots.size(), (int)maps.size(),
+        std::chrono::duration<double, std::nano>(middle - start).count() / ITERATIONS,
+        std::chrono::duration<double, std::nano>(end - middle).count() / ITERATIONS, sink > 0.0 ? 1.0 : 0.0);
+    printf("%s\n", g_failures == 0 ? "ok" : "FAILED");
+    return g_failures == 0 ? 0 : 1;
+}
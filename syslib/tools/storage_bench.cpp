@@ -0,0 +1,255 @@
+// Test and benchmark of ImGuiStorage, in the mode it is compiled with: sorted array (default) or hash index
+// (IMGUI_USE_HASHED_STORAGE, see imconfig.h). Needs no ImGui context.
+//
+// - test:  random Set/Get/Ref accessors on int, float and pointer keys, SetAllInt(), pairs appended to Data[] then
+//          BuildSortByKey(), and Clear(), checked after every step against a std::unordered_map model
+// - bench: lookups (hits and misses), insertions into a storage of N keys, and filling N keys with SetInt(), for N = 1k, 100k, 1M
+//
+//   storage_bench [test|bench]         Both by default. Exit code 1 if the test fails
+//
+// Build on Linux, from syslib/, once per mode (the define must reach imgui.cpp too):
+//   g++ -std=c++14 -O2 -I. tools/storage_bench.cpp external/imgui/imgui.cpp external/imgui/imgui_draw.cpp
+//       external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o storage_bench_sorted
+//   g++ -std=c++14 -O2 -DIMGUI_USE_HASHED_STORAGE -I. tools/storage_bench.cpp external/imgui/imgui.cpp
+//       external/imgui/imgui_draw.cpp external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o storage_bench_hashed
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+
+#ifdef IMGUI_USE_HASHED_STORAGE
+static const char* MODE = "hashed";
+#else
+static const char* MODE = "sorted";
+#endif
+
+// Keys hold one type each, chosen by the key: int, float or pointer
+enum KeyType { IntKey, FloatKey, PtrKey };
+
+static KeyType GetKeyType(ImGuiID key)
+{
+    return (KeyType)(key % 3);
+}
+
+static bool SameValue(ImGuiID key, const ImGuiStoragePair& a, const ImGuiStoragePair& b)
+{
+    switch (GetKeyType(key))
+    {
+    case IntKey: return a.val_i == b.val_i;
+    case FloatKey: return memcmp(&a.val_f, &b.val_f, sizeof(float)) == 0;     // SetAllInt() may leave NaN bit patterns
+    default: return a.val_p == b.val_p;
+    }
+}
+
+typedef std::unordered_map<ImGuiID, ImGuiStoragePair> Model;
+
+static bool CheckAll(const ImGuiStorage& storage, const Model& model, int step)
+{
+    if ((size_t)storage.Data.Size != model.size())
+    {
+        printf("step %d: %d pairs, expected %d\n", step, storage.Data.Size, (int)model.size());
+        return false;
+    }
+    for (int n = 0; n < storage.Data.Size; n++)
+    {
+        const ImGuiStoragePair& pair = storage.Data[n];
+        auto it = model.find(pair.key);
+        if (it == model.end() || !SameValue(pair.key, pair, it->second))
+        {
+            printf("step %d: pair %08X differs\n", step, pair.key);
+            return false;
+        }
+#ifndef IMGUI_USE_HASHED_STORAGE
+        if (n > 0 && storage.Data[n - 1].key >= pair.key)
+        {
+            printf("step %d: Data[] not sorted at %d\n", step, n);
+            return false;
+        }
+#endif
+    }
+    return true;
+}
+
+static bool RunTest()
+{
+    std::mt19937 rng(1234);
+    ImGuiStorage storage;
+    Model model;
+    const int STEPS = 400000;
+    const ImGuiID KEY_RANGE = 20000;       // Small enough for plenty of hits
+    int pointerBase = 0;
+
+    for (int step = 0; step < STEPS; step++)
+    {
+        const ImGuiID key = rng() % KEY_RANGE + 1;
+        const int value = (int)(rng() % 1000);
+        const int op = (int)(rng() % 1000);
+        auto found = model.find(key);
+
+        if (op < 300)
+        {
+            // Set
+            ImGuiStoragePair& pair = model.emplace(key, ImGuiStoragePair(key, (void*)nullptr)).first->second;
+            switch (GetKeyType(key))
+            {
+            case IntKey: storage.SetInt(key, value); pair.val_i = value; break;
+            case FloatKey: storage.SetFloat(key, value * 0.5f); pair.val_f = value * 0.5f; break;
+            default: storage.SetVoidPtr(key, &pointerBase + value); pair.val_p = &pointerBase + value; break;
+            }
+        }
+        else if (op < 700)
+        {
+            // Get, with a default for missing keys
+            bool ok = true;
+            switch (GetKeyType(key))
+            {
+            case IntKey: ok = storage.GetInt(key, -7) == (found != model.end() ? found->second.val_i : -7); break;
+            case FloatKey:
+            {
+                const float expected = found != model.end() ? found->second.val_f : -7.0f;
+                const float got = storage.GetFloat(key, -7.0f);
+                ok = memcmp(&got, &expected, sizeof(float)) == 0;
+                break;
+            }
+            default: ok = storage.GetVoidPtr(key) == (found != model.end() ? found->second.val_p : nullptr); break;
+            }
+            if (!ok)
+            {
+                printf("step %d: Get %08X differs\n", step, key);
+                return false;
+            }
+        }
+        else if (op < 950)
+        {
+            // Ref: inserts the default when missing, then written through
+            ImGuiStoragePair& pair = model.emplace(key, ImGuiStoragePair(key, (void*)nullptr)).first->second;
+            if (found == model.end())
+            {
+                if (GetKeyType(key) == IntKey) pair.val_i = 3;
+                else if (GetKeyType(key) == FloatKey) pair.val_f = 3.0f;
+            }
+            bool ok = true;
+            switch (GetKeyType(key))
+            {
+            case IntKey: { int* ref = storage.GetIntRef(key, 3); ok = *ref == pair.val_i; *ref += value; pair.val_i += value; break; }
+            case FloatKey: { float* ref = storage.GetFloatRef(key, 3.0f); ok = memcmp(ref, &pair.val_f, sizeof(float)) == 0; *ref = value * 0.25f; pair.val_f = value * 0.25f; break; }
+            default: { void** ref = storage.GetVoidPtrRef(key, nullptr); ok = *ref == pair.val_p; *ref = &pointerBase + value; pair.val_p = &pointerBase + value; break; }
+            }
+            if (!ok)
+            {
+                printf("step %d: Ref %08X differs\n", step, key);
+                return false;
+            }
+        }
+        else if (op < 990)
+        {
+            // Bulk: append new pairs to Data[] directly, then BuildSortByKey() as the API describes
+            for (int n = 0; n < 50; n++)
+            {
+                const ImGuiID newKey = rng() % KEY_RANGE + 1;
+                if (model.count(newKey) || GetKeyType(newKey) != IntKey)
+                    continue;
+                storage.Data.push_back(ImGuiStoragePair(newKey, n));
+                model.emplace(newKey, ImGuiStoragePair(newKey, n));
+            }
+            storage.BuildSortByKey();
+        }
+        else if (op < 998)
+        {
+            storage.SetAllInt(value);
+            for (auto& entry : model)
+                entry.second.val_i = value;
+        }
+        else
+        {
+            storage.Clear();
+            model.clear();
+        }
+
+        if ((step % 5000 == 0 || op >= 950) && !CheckAll(storage, model, step))
+            return false;
+    }
+    const bool ok = CheckAll(storage, model, STEPS);
+    printf("test (%s): %d random operations, %d pairs at the end: %s\n", MODE, STEPS, storage.Data.Size, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+static double NsPerOp(std::chrono::steady_clock::time_point start, int count)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+static void RunBench()
+{
+    typedef std::chrono::steady_clock Clock;
+    static const int SIZES[] = { 1000, 100000, 1000000 };
+    static const int LOOKUPS = 1000000;
+    static const int INSERTS = 2000;
+    static const int MAX_SORTED_FILL = 100000;     // Filling 1M keys one by one in a sorted array takes minutes
+
+    printf("bench (%s), ns per operation\n", MODE);
+    printf("%9s %10s %10s %10s %14s\n", "keys", "hit", "miss", "insert", "fill (ms)");
+    for (int size : SIZES)
+    {
+        std::mt19937 rng(size);
+        std::vector<ImGuiID> keys(size);
+        for (ImGuiID& key : keys)
+            key = rng() | 1;            // Odd keys, so even keys miss
+
+        // Bulk build, the same in both modes
+        ImGuiStorage storage;
+        storage.Data.reserve(size + INSERTS);
+        for (ImGuiID key : keys)
+            storage.Data.push_back(ImGuiStoragePair(key, 1));
+        storage.BuildSortByKey();
+        storage.GetInt(0);
+
+        volatile int sink = 0;
+        Clock::time_point start = Clock::now();
+        for (int n = 0; n < LOOKUPS; n++)
+            sink = sink + storage.GetInt(keys[rng() % size]);
+        const double hit = NsPerOp(start, LOOKUPS);
+
+        start = Clock::now();
+        for (int n = 0; n < LOOKUPS; n++)
+            sink = sink + storage.GetInt(rng() & ~1u);
+        const double miss = NsPerOp(start, LOOKUPS);
+
+        start = Clock::now();
+        for (int n = 0; n < INSERTS; n++)
+            storage.SetInt(rng() & ~1u, n);
+        const double insert = NsPerOp(start, INSERTS);
+
+        char fill[32] = "skipped";
+#ifndef IMGUI_USE_HASHED_STORAGE
+        if (size <= MAX_SORTED_FILL)
+#endif
+        {
+            ImGuiStorage filled;
+            start = Clock::now();
+            for (ImGuiID key : keys)
+                filled.SetInt(key, 1);
+            snprintf(fill, sizeof(fill), "%.1f", std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        printf("%9d %10.1f %10.1f %10.1f %14s\n", size, hit, miss, insert, fill);
+    }
+    (void)MAX_SORTED_FILL;
+}
+
+int main(int argc, char** argv)
+{
+    const bool test = argc < 2 || strcmp(argv[1], "test") == 0;
+    const bool bench = argc < 2 || strcmp(argv[1], "bench") == 0;
+    bool ok = true;
+    if (test)
+        ok = RunTest();
+    if (bench)
+        RunBench();
+    return ok ? 0 : 1;
+}
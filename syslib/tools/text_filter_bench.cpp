@@ -0,0 +1,326 @@
+// Parity check and benchmark of ImGuiTextFilter::PassFilter() with ImStristrLower() and of ImTextFilterPassLines()
+// (imgui.cpp) against the PassFilter() they replaced, which called ImStristr() on each term. Kept here as the reference.
+//
+// - parity: ImStristrLower() against ImStristr() on random haystacks of a small mixed-case alphabet (unaligned starts,
+//           every length up to 100, needles of 1 to 8 characters), also right before a PROT_NONE page: the SSE2 loop
+//           reads 16 bytes at a time and must not read past the haystack. Then the filters below on both corpora, per
+//           line and in bulk over random line ranges: the match sets must be the same as the reference's
+// - bench:  MB/s of filtering each corpus, per line and in bulk. Best of BENCH_RUNS, the versions measured alternately
+//           so that CPU frequency changes affect all of them
+//
+// Corpora (generated, MB is the size argument, 8 by default):
+// - log:  LogConsole-like lines of about 70 characters, mixed case, some in Portuguese (UTF-8)
+// - long: lines of 1 to 4 KB, as for a dumped packet or a stack trace
+//
+//   text_filter_bench [parity|bench] [MB]      Both by default. Exit code 1 if a match set differs
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/text_filter_bench.cpp external/imgui/imgui.cpp external/imgui/imgui_draw.cpp
+//       external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o text_filter_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+// Filters as typed in the log console: case folding, several terms, excludes, UTF-8, single characters, no match
+static const char* const FILTERS[] = {
+    "error",
+    "ERROR",
+    "WaRn",
+    "goblin,dragon",
+    "Dragão Vermelho",
+    "-debug",
+    "info,-goblin",
+    "-Item,-Exp,-Hit",
+    "ção",
+    "a",
+    "zzz",
+    "damage: 1",
+    " , ,exp",
+    "0x7F,0X3e",
+};
+static const int FILTER_COUNT = (int)(sizeof(FILTERS) / sizeof(FILTERS[0]));
+
+// Reference: upstream Dear ImGui 1.91.9b PassFilter(), ImStristr() on each term
+__attribute__((noinline)) static bool RefPassFilter(const ImGuiTextFilter& filter, const char* text, const char* text_end)
+{
+    if (filter.Filters.Size == 0)
+        return true;
+    for (const ImGuiTextFilter::ImGuiTextRange& f : filter.Filters)
+    {
+        if (f.empty())
+            continue;
+        if (f.b[0] == '-')
+        {
+            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
+                return false;
+        }
+        else
+        {
+            if (ImStristr(text, text_end, f.b, f.e) != NULL)
+                return true;
+        }
+    }
+    return filter.CountGrep == 0;
+}
+
+// ImStristr() compares the needle past haystack_end: a match running over the end is no match
+static const char* RefStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
+{
+    const char* match = ImStristr(haystack, haystack_end, needle, needle_end);
+    return (match != NULL && match + (needle_end - needle) <= haystack_end) ? match : NULL;
+}
+
+struct Corpus
+{
+    const char* name;
+    std::string text;
+    ImGuiTextIndex index;
+};
+
+static void GenerateLog(std::mt19937& rng, size_t bytes, Corpus& corpus)
+{
+    static const char* const LEVELS[] = { "INFO ", "info ", "Debug", "WARN ", "Warning", "ERROR", "error" };
+    static const char* const MESSAGES[] = {
+        "Player Fulano hit Goblin for damage: %d",
+        "Dragão Vermelho apareceu em Lorencia (%d, 120)",
+        "Exp +%d, next level in 3 min",
+        "Item dropped: Jewel of Bless x%d",
+        "Configuração salva em mubot.ini (%d bytes)",
+        "packet 0x7F3E len %d ok",
+        "Auto Pot: used Large Healing Potion, HP %d%%",
+        "Connection lost, retrying in %d s",
+        "dragon BREATH hits for %d",
+        "Skill Twisting Slash on 3 targets, combo %d",
+    };
+    char line[256];
+    while (corpus.text.size() < bytes)
+    {
+        const int length = snprintf(line, sizeof(line), "[%02d:%02d:%02d] %s ", (int)(rng() % 24), (int)(rng() % 60), (int)(rng() % 60),
+            LEVELS[rng() % 7]);
+        snprintf(line + length, sizeof(line) - length, MESSAGES[rng() % 10], (int)(rng() % 10000));
+        corpus.text += line;
+        corpus.text += '\n';
+    }
+}
+
+static void GenerateLong(std::mt19937& rng, size_t bytes, Corpus& corpus)
+{
+    static const char* const WORDS[] = { "0x7f", "frame", "Goblin", "ERR", "dragon", "slot", "Exp", "não", "hit", "Warn", "a", "=", "00" };
+    while (corpus.text.size() < bytes)
+    {
+        const size_t end = corpus.text.size() + 1024 + rng() % 3072;
+        while (corpus.text.size() < end)
+        {
+            corpus.text += WORDS[rng() % 13];
+            corpus.text += ' ';
+        }
+        corpus.text += '\n';
+    }
+}
+
+static void BuildFilter(ImGuiTextFilter& filter, const char* text)
+{
+    ImStrncpy(filter.InputBuf, text, IM_ARRAYSIZE(filter.InputBuf));
+    filter.Build();
+}
+
+static bool RunParity(std::vector<Corpus>& corpora)
+{
+    std::mt19937 rng(31);
+    int failures = 0;
+
+    // Alphabet with both cases of the needle letters, '\n' and UTF-8 bytes
+    static const char ALPHABET[] = "aAbBcCzZ@[`{\n\xC3\xA7\xE3";
+    const int alphabetSize = (int)sizeof(ALPHABET) - 1;
+    std::vector<char> buffer(128 + 16);
+    int cases = 0;
+    for (int n = 0; n < 400000 && failures < 10; n++, cases++)
+    {
+        const int offset = (int)(rng() % 16);
+        const int length = (int)(rng() % 101);
+        char* haystack = buffer.data() + offset;
+        for (int i = 0; i < length; i++)
+            haystack[i] = ALPHABET[rng() % (n % 2 ? 4 : alphabetSize)];   // Half of them with only "aAbB", for many hits
+        haystack[length] = 0;
+        char needle[9];
+        const int needleLength = 1 + (int)(rng() % 8);
+        for (int i = 0; i < needleLength; i++)
+            needle[i] = ImToLower(ALPHABET[rng() % (n % 2 ? 4 : alphabetSize)]);
+        needle[needleLength] = 0;
+        if (ImStristrLower(haystack, haystack + length, needle, needle + needleLength) != RefStristr(haystack, haystack + length, needle, needle + needleLength))
+        {
+            printf("ImStristrLower differs: haystack length %d, offset %d, needle \"%s\"\n", length, offset, needle);
+            failures++;
+        }
+    }
+
+    // Haystacks ending at the last byte of a page, before a PROT_NONE one: any read past the end faults
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    char* pages = (char*)mmap(nullptr, pageSize * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED || mprotect(pages + pageSize, pageSize, PROT_NONE) != 0)
+    {
+        printf("no guard page\n");
+        return false;
+    }
+    for (int length = 0; length <= 100 && failures < 10; length++)
+    {
+        for (int n = 0; n < 64; n++, cases++)
+        {
+            char* haystack = pages + pageSize - length;
+            for (int i = 0; i < length; i++)
+                haystack[i] = ALPHABET[rng() % 4];
+            const char needle[] = { "ab"[rng() % 2], "ab"[rng() % 2], "ab"[rng() % 2] };
+            const int needleLength = 1 + n % 3;
+            // ImStristr() itself reads past the end: the reference runs on a zero-terminated copy
+            memcpy(buffer.data(), haystack, length);
+            buffer[length] = 0;
+            const char* match = RefStristr(buffer.data(), buffer.data() + length, needle, needle + needleLength);
+            if (ImStristrLower(haystack, haystack + length, needle, needle + needleLength) != (match ? haystack + (match - buffer.data()) : NULL))
+            {
+                printf("ImStristrLower (page end) differs: haystack length %d\n", length);
+                failures++;
+                break;
+            }
+        }
+    }
+    munmap(pages, pageSize * 2);
+    printf("parity: ImStristrLower, %d haystacks: %s\n", cases, failures ? "FAILED" : "ok");
+
+    // Filters on the corpora, per line and in bulk
+    ImBitVector matches;
+    for (Corpus& corpus : corpora)
+    {
+        const char* buf = corpus.text.c_str();
+        const int lineCount = corpus.index.size();
+        std::vector<char> expected(lineCount);
+        for (const char* filterText : FILTERS)
+        {
+            ImGuiTextFilter filter;
+            BuildFilter(filter, filterText);
+            int lineFailures = 0;
+            for (int line = 0; line < lineCount; line++)
+            {
+                const char* begin = corpus.index.get_line_begin(buf, line);
+                const char* end = corpus.index.get_line_end(buf, line);
+                expected[line] = RefPassFilter(filter, begin, end);
+                if (filter.PassFilter(begin, end) != (bool)expected[line] && lineFailures++ == 0)
+                    printf("%s: PassFilter(\"%s\") differs on line %d\n", corpus.name, filterText, line);
+            }
+
+            // The whole corpus, then random ranges including the first and last lines
+            int rangeFailures = 0;
+            for (int range = 0; range < 20; range++)
+            {
+                int lineBegin = 0, lineEnd = lineCount;
+                if (range > 0)
+                {
+                    lineBegin = (range == 1) ? 0 : (int)(rng() % lineCount);
+                    lineEnd = (range == 2) ? lineCount : std::min(lineCount, lineBegin + 1 + (int)(rng() % 5000));
+                }
+                matches.Create(lineEnd - lineBegin);
+                const int count = ImTextFilterPassLines(&filter, buf, &corpus.index, lineBegin, lineEnd, &matches);
+                int expectedCount = 0;
+                bool same = true;
+                for (int line = lineBegin; line < lineEnd; line++)
+                {
+                    expectedCount += expected[line];
+                    same &= matches.TestBit(line - lineBegin) == (bool)expected[line];
+                }
+                if ((!same || count != expectedCount) && rangeFailures++ == 0)
+                    printf("%s: ImTextFilterPassLines(\"%s\") differs on lines %d-%d\n", corpus.name, filterText, lineBegin, lineEnd);
+            }
+            failures += lineFailures + rangeFailures;
+        }
+        printf("parity: %s corpus, %d filters per line and on 20 line ranges: %s\n", corpus.name, FILTER_COUNT, failures ? "FAILED" : "ok");
+    }
+    return failures == 0;
+}
+
+static void RunBench(std::vector<Corpus>& corpora)
+{
+    typedef std::chrono::steady_clock Clock;
+    static const int BENCH_RUNS = 7;
+    static const int VERSIONS = 3;
+    volatile int sink = 0;
+    (void)sink;
+
+    ImBitVector matches;
+    for (Corpus& corpus : corpora)
+    {
+        const char* buf = corpus.text.c_str();
+        const int lineCount = corpus.index.size();
+        char title[80];
+        snprintf(title, sizeof(title), "%s corpus, %.1f MB, %d lines (MB/s)", corpus.name, corpus.text.size() / 1048576.0, lineCount);
+        printf("%-50s %10s %10s %10s\n", title, "reference", "per line", "bulk");
+        for (const char* filterText : FILTERS)
+        {
+            ImGuiTextFilter filter;
+            BuildFilter(filter, filterText);
+            double rates[VERSIONS] = {};
+            for (int run = 0; run < BENCH_RUNS; run++)
+            {
+                for (int version = 0; version < VERSIONS; version++)
+                {
+                    const Clock::time_point start = Clock::now();
+                    int count = 0;
+                    if (version == 2)
+                    {
+                        matches.Create(lineCount);      // Clears the bits
+                        count = ImTextFilterPassLines(&filter, buf, &corpus.index, 0, lineCount, &matches);
+                    }
+                    else
+                    {
+                        for (int line = 0; line < lineCount; line++)
+                        {
+                            const char* begin = corpus.index.get_line_begin(buf, line);
+                            const char* end = corpus.index.get_line_end(buf, line);
+                            count += (version == 0) ? RefPassFilter(filter, begin, end) : filter.PassFilter(begin, end);
+                        }
+                    }
+                    sink = count;
+                    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                    rates[version] = std::max(rates[version], corpus.text.size() / 1048576.0 / seconds);
+                }
+            }
+            const std::string name = std::string("  \"") + filterText + "\"";
+            printf("%-50s %10.0f %10.0f %10.0f\n", name.c_str(), rates[0], rates[1], rates[2]);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* mode = (argc >= 2 && !isdigit((unsigned char)argv[1][0])) ? argv[1] : NULL;
+    const char* size = (argc >= 2 && mode == NULL) ? argv[1] : (argc >= 3 ? argv[2] : "8");
+    const size_t bytes = (size_t)(atof(size) * 1048576.0);
+    const bool parity = mode == NULL || strcmp(mode, "parity") == 0;
+    const bool bench = mode == NULL || strcmp(mode, "bench") == 0;
+
+    std::mt19937 rng(31);
+    std::vector<Corpus> corpora(2);
+    corpora[0].name = "log";
+    GenerateLog(rng, bytes, corpora[0]);
+    corpora[1].name = "long";
+    GenerateLong(rng, bytes, corpora[1]);
+    for (Corpus& corpus : corpora)
+        corpus.index.append(corpus.text.c_str(), 0, (int)corpus.text.size());
+
+    bool ok = true;
+    if (parity)
+        ok = RunParity(corpora);
+    if (bench)
+        RunBench(corpora);
+    return ok ? 0 : 1;
+}
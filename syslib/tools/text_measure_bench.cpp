@@ -0,0 +1,240 @@
+// Benchmark and checks of the text measurement cache (ImGuiTextMeasureCache in imgui_internal.h), headless: ImGui context
+// with no platform or renderer backend.
+//
+// Scenarios, each run with the cache off then on:
+//   log_lines   10,000 log lines, each drawn with TextWrapped() in a scrolling child, as a wrapped log view without a clipper
+//   log_block   the same 10,000 lines as one wrapped TextUnformatted() block
+// Frames of both runs must produce the same vertices and indices. A collision check then builds two texts of the same
+// length with the same hash key and verifies each is measured as itself.
+//
+//   text_measure_bench [frames]        Exit code 1 if a check fails
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/text_measure_bench.cpp external/imgui/imgui.cpp external/imgui/imgui_draw.cpp
+//       external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o text_measure_bench
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+static const int LINE_COUNT = 10000;
+static const int WARMUP_FRAMES = 10;
+
+struct Scenario
+{
+    const char* name;
+    bool block;
+};
+
+static const Scenario SCENARIOS[] =
+{
+    { "log_lines", false },
+    { "log_block", true },
+};
+
+struct RunResult
+{
+    std::vector<double> frameTimes;             // Microseconds, NewFrame() to Render()
+    std::vector<unsigned long long> hashes;     // Geometry of each frame
+};
+
+// FNV-1a of all vertices and indices, as tools/draw_replay
+static unsigned long long HashGeometry(const ImDrawData* drawData)
+{
+    unsigned long long hash = 14695981039346656037ull;
+    for (const ImDrawList* drawList : drawData->CmdLists)
+    {
+        const unsigned char* vtx = reinterpret_cast<const unsigned char*>(drawList->VtxBuffer.Data);
+        for (size_t i = 0; i < drawList->VtxBuffer.Size * sizeof(ImDrawVert); i++)
+            hash = (hash ^ vtx[i]) * 1099511628211ull;
+        const unsigned char* idx = reinterpret_cast<const unsigned char*>(drawList->IdxBuffer.Data);
+        for (size_t i = 0; i < drawList->IdxBuffer.Size * sizeof(ImDrawIdx); i++)
+            hash = (hash ^ idx[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+static void CreateHeadlessContext()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.BackendPlatformName = "text_measure_bench";
+    io.BackendRendererName = "null";
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+}
+
+static std::vector<std::string> MakeLog()
+{
+    static const char* const MESSAGES[] = {
+        "Monstro derrotado, experiência +%d",
+        "Item coletado: Jewel of Bless (%d), inventário com espaço para mais itens depois da última coleta",
+        "Auto Pot: Usando poção de vida, %d restantes. Vida abaixo do limite configurado durante o combate com vários monstros",
+        "Skill %d usada",
+    };
+    std::vector<std::string> lines;
+    char line[256];
+    for (int n = 0; n < LINE_COUNT; n++)
+    {
+        const int length = snprintf(line, sizeof(line), "[%02d:%02d:%02d] ", n / 3600 % 24, n / 60 % 60, n % 60);
+        snprintf(line + length, sizeof(line) - length, MESSAGES[n * 7 % 4], n * 13 % 5000);
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static RunResult Run(const Scenario& scenario, const std::vector<std::string>& lines, const std::string& block, bool cache, int frames)
+{
+    CreateHeadlessContext();
+    GImGui->TextMeasureCache.Enabled = cache;
+    ImGuiIO& io = ImGui::GetIO();
+
+    RunResult result;
+    typedef std::chrono::steady_clock Clock;
+    for (int frame = 0; frame < WARMUP_FRAMES + frames; frame++)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        // Scroll through the log with the wheel, so different lines are visible
+        io.AddMousePosEvent(300.0f, 300.0f);
+        if (frame % 4 == 0)
+            io.AddMouseWheelEvent(0.0f, frame % 200 < 100 ? -5.0f : 5.0f);
+        const Clock::time_point start = Clock::now();
+
+        ImGui::NewFrame();
+        ImGui::SetNextWindowSize(ImVec2(500, 400), ImGuiCond_Always);
+        ImGui::SetNextWindowPos(ImVec2(50, 50), ImGuiCond_Always);
+        ImGui::Begin("Log", nullptr, ImGuiWindowFlags_NoResize);
+        ImGui::BeginChild("LogScroll", ImVec2(0, 0), ImGuiChildFlags_Borders);
+        if (scenario.block)
+        {
+            ImGui::PushTextWrapPos(0.0f);
+            ImGui::TextUnformatted(block.data(), block.data() + block.size());
+            ImGui::PopTextWrapPos();
+        }
+        else
+        {
+            for (const std::string& line : lines)
+                ImGui::TextWrapped("%s", line.c_str());
+        }
+        ImGui::EndChild();
+        ImGui::End();
+        ImGui::Render();
+
+        const double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        if (frame < WARMUP_FRAMES)
+            continue;
+        result.frameTimes.push_back(elapsed);
+        result.hashes.push_back(HashGeometry(ImGui::GetDrawData()));
+    }
+    ImGui::DestroyContext();
+    return result;
+}
+
+// Two different texts of the same length hashing to the same cache key must each be measured as themselves
+static bool CheckCollision()
+{
+    CreateHeadlessContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+
+    // Same key as TextMeasureCacheQuery() for unwrapped text: 32-bit keys collide after ~2^16 texts. The default font is
+    // monospaced, so texts with newlines at different places are used to get different sizes.
+    ImFont* font = ImGui::GetFont();
+    const float fontSize = ImGui::GetFontSize();
+    struct { ImFont* Font; float FontSize; float WrapWidth; } params = { font, fontSize, 0.0f };
+    const ImGuiID seed = ImHashData(&params, sizeof(params));
+    auto measure = [&](const std::string& text) {
+        const ImVec2 size = font->CalcTextSizeA(fontSize, FLT_MAX, 0.0f, text.c_str());
+        return ImVec2(IM_TRUNC(size.x + 0.99999f), size.y);
+    };
+    std::unordered_map<ImGuiID, std::string> seen;
+    std::string first, second;
+    unsigned long long random = 1;
+    for (int n = 0; n < 4000000 && first.empty(); n++)
+    {
+        static const char LETTERS[] = "abcdefghijklmnopqrstuvwxyz\n\n\n\n\n\n";
+        std::string text(IMGUI_TEXT_MEASURE_CACHE_MIN_LEN, ' ');
+        for (char& c : text)
+        {
+            random = random * 6364136223846793005ull + 1442695040888963407ull;
+            c = LETTERS[(random >> 33) % (sizeof(LETTERS) - 1)];
+        }
+        auto it = seen.emplace(ImHashData(text.data(), text.size(), seed), text);
+        if (it.second || it.first->second == text)
+            continue;
+        const ImVec2 a = measure(it.first->second), b = measure(text);
+        if (a.x != b.x || a.y != b.y)
+        {
+            first = it.first->second;
+            second = text;
+        }
+    }
+
+    bool ok = !first.empty();
+    if (ok)
+    {
+        // The second lookup hits the bucket of the first text
+        const ImVec2 firstSize = ImGui::CalcTextSize(first.c_str());
+        const ImVec2 secondSize = ImGui::CalcTextSize(second.c_str());
+        const ImVec2 expected = measure(second);
+        ok = secondSize.x == expected.x && secondSize.y == expected.y;
+        printf("collision: key %08X, %.0fx%.0f then %.0fx%.0f px (expected %.0fx%.0f): %s\n", ImHashData(first.data(), first.size(), seed),
+            firstSize.x, firstSize.y, secondSize.x, secondSize.y, expected.x, expected.y, ok ? "ok" : "FAILED");
+    }
+    else
+    {
+        printf("collision: none found\n");
+    }
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return ok;
+}
+
+static void PrintTimes(const char* name, const char* mode, std::vector<double> times)
+{
+    std::sort(times.begin(), times.end());
+    double sum = 0.0;
+    for (double t : times)
+        sum += t;
+    printf("%-10s %-6s %9.1f %9.1f %9.1f\n", name, mode, sum / times.size() / 1000.0, times[times.size() / 2] / 1000.0,
+        times[std::min(times.size() - 1, times.size() * 99 / 100)] / 1000.0);
+}
+
+int main(int argc, char** argv)
+{
+    const int frames = argc > 1 ? std::max(atoi(argv[1]), 1) : 300;
+    const std::vector<std::string> lines = MakeLog();
+    std::string block;
+    for (const std::string& line : lines)
+        block += line + "\n";
+
+    bool ok = true;
+    printf("%d lines, %d frames per run after %d warm-up frames\n", LINE_COUNT, frames, WARMUP_FRAMES);
+    printf("%-10s %-6s %9s %9s %9s\n", "scenario", "cache", "avg ms", "p50 ms", "p99 ms");
+    for (const Scenario& scenario : SCENARIOS)
+    {
+        const RunResult off = Run(scenario, lines, block, false, frames);
+        const RunResult on = Run(scenario, lines, block, true, frames);
+        PrintTimes(scenario.name, "off", off.frameTimes);
+        PrintTimes(scenario.name, "on", on.frameTimes);
+        if (off.hashes != on.hashes)
+        {
+            printf("%s: geometry differs with the cache\n", scenario.name);
+            ok = false;
+        }
+    }
+    ok = CheckCollision() && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,494 @@
+// Randomized tests and benchmark of the concave polygon triangulators of imgui_draw.cpp: ImTriangulatorMonotone
+// (monotone decomposition, used from IM_DRAWLIST_CONCAVE_MONOTONE_MIN_POINTS points) against ImTriangulator (ear clipping).
+//
+// - test:  random simple polygons (star-shaped, 2-opt untangled, 2-opt on a grid so many vertices share a y, combs,
+//          stairs, spirals, repeated points), in both orientations. The monotone triangulation must not fall back, and
+//          must have N-2 triangles with valid indices, all wound as ImTriangulator's (ImTriangleIsClockwise()), the area of
+//          the polygon, and cover random sample points once inside the polygon and never outside. The ear clipper is
+//          checked the same way and its failures counted, not failed: it only flips its vertex list when it finds no ear,
+//          so a counter-clockwise polygon with a reflex vertex gets triangles outside it (upstream behaviour).
+//          Self-intersecting input must fall back or give N-2 triangles, and AddConcavePolyFilled() must write the expected
+//          index counts with and without anti-aliasing.
+// - bench: microseconds per triangulation, ear clipping vs monotone, for several shapes and vertex counts
+//
+//   triangulate_bench [test|bench]     Both by default. Exit code 1 if a test fails
+//
+// The triangulators are internal to imgui_draw.cpp, which is compiled as part of this file: don't link it again.
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/triangulate_bench.cpp external/imgui/imgui.cpp external/imgui/imgui_tables.cpp
+//       external/imgui/imgui_widgets.cpp -o triangulate_bench
+
+#include "external/imgui/imgui_draw.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+typedef std::vector<ImVec2> Polygon;
+
+static std::mt19937 g_random(38);
+
+static float Random(float min, float max)
+{
+    return std::uniform_real_distribution<float>(min, max)(g_random);
+}
+
+//-----------------------------------------------------------------------------
+// Polygons
+//-----------------------------------------------------------------------------
+
+static Polygon MakeStar(int count, bool integer)
+{
+    Polygon polygon(count);
+    for (int i = 0; i < count; i++)
+    {
+        const float angle = (i + Random(0.0f, 0.9f)) * 6.2831853f / count;
+        const float radius = Random(50.0f, 500.0f);
+        polygon[i] = ImVec2(600.0f + cosf(angle) * radius, 600.0f + sinf(angle) * radius);
+        if (integer)
+            polygon[i] = ImVec2(floorf(polygon[i].x), floorf(polygon[i].y));
+    }
+    return polygon;
+}
+
+static double Cross(const ImVec2& o, const ImVec2& a, const ImVec2& b)
+{
+    return ((double)a.x - o.x) * ((double)b.y - o.y) - ((double)a.y - o.y) * ((double)b.x - o.x);
+}
+
+static bool SegmentsCross(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d)
+{
+    const double d1 = Cross(a, b, c), d2 = Cross(a, b, d), d3 = Cross(c, d, a), d4 = Cross(c, d, b);
+    return d1 != 0 && d2 != 0 && d3 != 0 && d4 != 0 && (d1 > 0) != (d2 > 0) && (d3 > 0) != (d4 > 0);
+}
+
+// Random points, untangled by 2-opt moves into a simple polygon with many reflex vertices. 'grid' snaps to a coarse grid,
+// so many vertices share a y.
+static Polygon MakeTwoOpt(int count, bool grid)
+{
+    Polygon polygon(count);
+    for (ImVec2& point : polygon)
+    {
+        point = ImVec2(Random(0.0f, 1000.0f), Random(0.0f, 1000.0f));
+        if (grid)
+            point = ImVec2(floorf(point.x / 50.0f) * 50.0f, floorf(point.y / 50.0f) * 50.0f + point.x * 0.001f);
+    }
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (int i = 0; i < count; i++)
+            for (int j = i + 2; j < count; j++)
+                if (!(i == 0 && j == count - 1) && SegmentsCross(polygon[i], polygon[i + 1], polygon[j], polygon[(j + 1) % count]))
+                {
+                    std::reverse(polygon.begin() + i + 1, polygon.begin() + j + 1);
+                    changed = true;
+                }
+    }
+    return polygon;
+}
+
+static Polygon MakeComb(int teeth, bool vertical)
+{
+    Polygon polygon;
+    polygon.push_back(ImVec2(0, 0));
+    for (int t = 0; t < teeth; t++)
+    {
+        const float x = t * 10.0f;
+        if (t > 0)
+            polygon.push_back(ImVec2(x, 20));
+        polygon.push_back(ImVec2(x, 300));
+        polygon.push_back(ImVec2(x + 5, 300));
+        polygon.push_back(ImVec2(x + 5, 20));
+    }
+    polygon.back().y = 0;
+    if (vertical)
+        for (ImVec2& point : polygon)
+            std::swap(point.x, point.y);
+    return polygon;
+}
+
+// Rectilinear staircase, with collinear points on the horizontal edges
+static Polygon MakeStairs(int steps)
+{
+    Polygon polygon;
+    for (int s = 0; s < steps; s++)
+    {
+        polygon.push_back(ImVec2(s * 10.0f, s * 10.0f));
+        polygon.push_back(ImVec2(s * 10.0f + 5, s * 10.0f));
+        polygon.push_back(ImVec2(s * 10.0f + 10, s * 10.0f));
+    }
+    polygon.push_back(ImVec2(steps * 10.0f, steps * 10.0f));
+    polygon.push_back(ImVec2(0, steps * 10.0f));
+    return polygon;
+}
+
+static Polygon MakeSpiral(int count)
+{
+    Polygon outer, inner;
+    for (int i = 0; i < count / 2; i++)
+    {
+        const float t = i * 0.05f;
+        const float radius = 20.0f + t * 15.0f;
+        outer.push_back(ImVec2(cosf(t) * radius, sinf(t) * radius));
+        inner.push_back(ImVec2(cosf(t) * (radius - 8.0f), sinf(t) * (radius - 8.0f)));
+    }
+    outer.insert(outer.end(), inner.rbegin(), inner.rend());
+    return outer;
+}
+
+// Star with repeated consecutive points, as path joins produce
+static Polygon MakeDuplicates(int count)
+{
+    Polygon polygon = MakeStar(count, count % 2 == 0);
+    for (int r = 0; r < 1 + count % 4; r++)
+    {
+        const int at = (int)(g_random() % polygon.size());
+        polygon.insert(polygon.begin() + at, polygon[at]);
+    }
+    if (count % 5 == 0)
+        polygon.push_back(polygon[0]);
+    return polygon;
+}
+
+static bool OnSegment(const ImVec2& a, const ImVec2& b, const ImVec2& q)
+{
+    return Cross(a, b, q) == 0 && q.x >= ImMin(a.x, b.x) && q.x <= ImMax(a.x, b.x) && q.y >= ImMin(a.y, b.y) && q.y <= ImMax(a.y, b.y);
+}
+
+// Strictly simple: edges only touch their neighbours, at the shared vertex. Generators can produce a few that aren't.
+static bool IsSimple(const Polygon& polygon)
+{
+    const int count = (int)polygon.size();
+    for (int i = 0; i < count; i++)
+    {
+        const ImVec2& a = polygon[i];
+        const ImVec2& b = polygon[(i + 1) % count];
+        if (a.x == b.x && a.y == b.y)
+            return false;
+        for (int j = i + 1; j < count; j++)
+        {
+            const ImVec2& c = polygon[j];
+            const ImVec2& d = polygon[(j + 1) % count];
+            if (j == i + 1)
+            {
+                if (OnSegment(c, d, a) || OnSegment(a, b, d))
+                    return false;
+            }
+            else if ((j + 1) % count == i)
+            {
+                if (OnSegment(c, d, b) || OnSegment(a, b, c))
+                    return false;
+            }
+            else if (SegmentsCross(a, b, c, d) || OnSegment(a, b, c) || OnSegment(a, b, d) || OnSegment(c, d, a) || OnSegment(c, d, b))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static double GetArea(const Polygon& polygon)
+{
+    double area = 0.0;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+        area += (double)polygon[j].x * polygon[i].y - (double)polygon[i].x * polygon[j].y;
+    return fabs(area) * 0.5;
+}
+
+static bool Contains(const Polygon& polygon, const ImVec2& q)
+{
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+    {
+        const ImVec2& a = polygon[i];
+        const ImVec2& b = polygon[j];
+        if ((a.y > q.y) != (b.y > q.y) && q.x < (b.x - a.x) * (q.y - a.y) / (b.y - a.y) + a.x)
+            inside = !inside;
+    }
+    return inside;
+}
+
+//-----------------------------------------------------------------------------
+// Triangulators
+//-----------------------------------------------------------------------------
+
+typedef std::vector<unsigned int> Triangles;
+
+static std::vector<char> g_scratch;
+
+static bool TriangulateMonotone(const Polygon& polygon, Triangles& triangles)
+{
+    g_scratch.resize(ImTriangulatorMonotone::EstimateScratchBufferSize((int)polygon.size()) + sizeof(ImVec2));
+    ImTriangulatorMonotone triangulator;
+    if (!triangulator.Triangulate(polygon.data(), (int)polygon.size(), g_scratch.data()))
+        return false;
+    triangles.assign(triangulator._Triangles, triangulator._Triangles + triangulator._TrianglesCount * 3);
+    return true;
+}
+
+static void TriangulateEars(const Polygon& polygon, Triangles& triangles)
+{
+    g_scratch.resize(ImTriangulator::EstimateScratchBufferSize((int)polygon.size()) + sizeof(ImVec2));
+    ImTriangulator triangulator;
+    triangulator.Init(polygon.data(), (int)polygon.size(), g_scratch.data());
+    triangles.clear();
+    unsigned int triangle[3];
+    while (triangulator._TrianglesLeft > 0)
+    {
+        triangulator.GetNextTriangle(triangle);
+        triangles.insert(triangles.end(), triangle, triangle + 3);
+    }
+}
+
+// Twice the signed area: the sign gives the winding
+static double GetTriangleArea2(const Polygon& polygon, const unsigned int* triangle)
+{
+    return Cross(polygon[triangle[0]], polygon[triangle[1]], polygon[triangle[2]]);
+}
+
+//-----------------------------------------------------------------------------
+// Test
+//-----------------------------------------------------------------------------
+
+struct ShapeResult
+{
+    int polygons = 0;
+    int skipped = 0;        // Not strictly simple
+    int failures = 0;
+    int earFailures = 0;    // Informative, see the header comment
+};
+
+// Returns an error, or nullptr if 'triangles' is a valid triangulation of 'polygon'
+static const char* CheckTriangles(const Polygon& polygon, const Triangles& triangles)
+{
+    const int count = (int)polygon.size();
+    if ((int)triangles.size() != (count - 2) * 3)
+        return "not N-2 triangles";
+    for (unsigned int index : triangles)
+        if (index >= (unsigned int)count)
+            return "index out of range";
+
+    double scale = 1.0;
+    for (const ImVec2& point : polygon)
+        scale = ImMax(scale, (double)ImMax(fabsf(point.x), fabsf(point.y)));
+    double area = 0.0;
+    for (size_t i = 0; i < triangles.size(); i += 3)
+    {
+        // Zero-area triangles (repeated or collinear points) have no winding
+        const double area2 = GetTriangleArea2(polygon, &triangles[i]);
+        if (area2 < -1e-6 * scale * scale)
+            return "counter-clockwise triangle";
+        area += fabs(area2) * 0.5;
+    }
+    const double polygonArea = GetArea(polygon);
+    if (fabs(area - polygonArea) > 1e-4 * polygonArea + 1e-3)
+        return "area differs from the polygon";
+
+    // Random samples in the bounding box: covered by one triangle inside the polygon, by none outside. Samples on edges
+    // can go either way, so a couple of misses are allowed.
+    ImVec2 min(FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX);
+    for (const ImVec2& point : polygon)
+    {
+        min = ImMin(min, point);
+        max = ImMax(max, point);
+    }
+    int misses = 0;
+    for (int s = 0; s < 500; s++)
+    {
+        const ImVec2 q(Random(min.x, max.x), Random(min.y, max.y));
+        int covered = 0;
+        for (size_t i = 0; i < triangles.size(); i += 3)
+            if (GetTriangleArea2(polygon, &triangles[i]) != 0.0 && ImTriangleContainsPoint(polygon[triangles[i]], polygon[triangles[i + 1]], polygon[triangles[i + 2]], q))
+                covered++;
+        if (covered != (Contains(polygon, q) ? 1 : 0))
+            misses++;
+    }
+    if (misses > 2)
+        return "coverage differs from the polygon";
+    return nullptr;
+}
+
+static void Check(const char* shape, Polygon polygon, ShapeResult& result, bool requireSimple = true)
+{
+    for (int orientation = 0; orientation < 2; orientation++)
+    {
+        if (orientation == 1)
+            std::reverse(polygon.begin(), polygon.end());
+        if (requireSimple && !IsSimple(polygon))
+        {
+            result.skipped++;
+            continue;
+        }
+        result.polygons++;
+        Triangles triangles;
+        const char* error = TriangulateMonotone(polygon, triangles) ? CheckTriangles(polygon, triangles) : "fell back to ear clipping";
+        if (error && result.failures++ < 3)
+            printf("  %s, %d points: %s\n", shape, (int)polygon.size(), error);
+        TriangulateEars(polygon, triangles);
+        if (CheckTriangles(polygon, triangles))
+            result.earFailures++;
+    }
+}
+
+static bool Report(const char* shape, const ShapeResult& result)
+{
+    printf("%-14s %6d %8d %8d %10d\n", shape, result.polygons, result.skipped, result.failures, result.earFailures);
+    return result.failures == 0;
+}
+
+static bool CheckDrawList()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    ImGui::NewFrame();
+
+    bool ok = true;
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    for (int antiAliased = 0; antiAliased < 2; antiAliased++)
+    {
+        if (antiAliased)
+            drawList->Flags |= ImDrawListFlags_AntiAliasedFill;
+        else
+            drawList->Flags &= ~ImDrawListFlags_AntiAliasedFill;
+        for (int count : { 5, 31, 32, 400, 3000 })
+        {
+            const Polygon polygon = MakeStar(count, false);
+            const int idxStart = drawList->IdxBuffer.Size, vtxStart = drawList->VtxBuffer.Size;
+            drawList->AddConcavePolyFilled(polygon.data(), count, IM_COL32_WHITE);
+            const int idxCount = drawList->IdxBuffer.Size - idxStart, vtxCount = drawList->VtxBuffer.Size - vtxStart;
+            if (idxCount != (count - 2) * 3 + (antiAliased ? count * 6 : 0) || vtxCount != count * (antiAliased ? 2 : 1))
+            {
+                printf("  AddConcavePolyFilled(), %d points, anti-aliased %d: %d indices, %d vertices\n", count, antiAliased, idxCount, vtxCount);
+                ok = false;
+            }
+        }
+    }
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    printf("%-14s %s\n", "draw list", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+static bool RunTest()
+{
+    bool ok = true;
+    ShapeResult result;
+    printf("%-14s %6s %8s %8s %10s\n", "shape", "tested", "skipped", "failed", "ear wrong");
+    for (int k = 0; k < 400; k++)
+        Check("star", MakeStar(3 + k % 200, k % 3 == 0), result);
+    ok = Report("star", result) && ok;
+
+    result = ShapeResult();
+    for (int k = 0; k < 150; k++)
+        Check("2-opt", MakeTwoOpt(3 + k % 120, false), result);
+    ok = Report("2-opt", result) && ok;
+
+    result = ShapeResult();
+    for (int k = 0; k < 100; k++)
+        Check("2-opt grid", MakeTwoOpt(4 + k % 100, true), result);
+    ok = Report("2-opt grid", result) && ok;
+
+    result = ShapeResult();
+    for (int k = 1; k < 60; k++)
+    {
+        Check("comb", MakeComb(k, false), result);
+        Check("comb", MakeComb(k, true), result);
+        Check("stairs", MakeStairs(k), result);
+    }
+    ok = Report("rectilinear", result) && ok;
+
+    result = ShapeResult();
+    for (int k = 10; k < 400; k += 13)
+        Check("spiral", MakeSpiral(k), result);
+    ok = Report("spiral", result) && ok;
+
+    result = ShapeResult();
+    for (int k = 0; k < 200; k++)
+        Check("duplicates", MakeDuplicates(5 + k % 60), result, false);
+    ok = Report("duplicates", result) && ok;
+
+    // Self-intersecting: not supported, but must not crash or write a wrong triangle count
+    int fallbacks = 0, triangulated = 0, wrong = 0;
+    for (int k = 0; k < 500; k++)
+    {
+        Polygon polygon(4 + k % 50);
+        for (ImVec2& point : polygon)
+            point = ImVec2(Random(0, 100), Random(0, 100));
+        Triangles triangles;
+        if (!TriangulateMonotone(polygon, triangles))
+            fallbacks++;
+        else if (triangles.size() == (polygon.size() - 2) * 3)
+            triangulated++;
+        else
+            wrong++;
+    }
+    printf("%-14s %6d: %d fell back, %d triangulated, %d wrong count\n", "intersecting", 500, fallbacks, triangulated, wrong);
+    ok = wrong == 0 && ok;
+
+    ok = CheckDrawList() && ok;
+    printf("test: %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Benchmark
+//-----------------------------------------------------------------------------
+
+static double Time(const Polygon& polygon, bool monotone)
+{
+    // Enough runs for ~20 ms of ear clipping, which is quadratic
+    const int count = (int)polygon.size();
+    const int runs = ImMax(3, 4000000 / (count * count + 1000));
+    Triangles triangles;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        if (monotone)
+            TriangulateMonotone(polygon, triangles);
+        else
+            TriangulateEars(polygon, triangles);
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+static void PrintTime(const char* shape, const Polygon& polygon)
+{
+    const double ears = Time(polygon, false);
+    const double monotone = Time(polygon, true);
+    printf("%-8s %7d %12.2f %12.2f %8.1fx\n", shape, (int)polygon.size(), ears, monotone, ears / monotone);
+}
+
+static void RunBench()
+{
+    printf("bench: us per triangulation, monotone used from %d points\n", IM_DRAWLIST_CONCAVE_MONOTONE_MIN_POINTS);
+    printf("%-8s %7s %12s %12s %9s\n", "shape", "points", "ear clip", "monotone", "speedup");
+    for (int count : { 8, 16, 24, 32, 48, 64, 128, 256, 1024, 4096 })
+        PrintTime("star", MakeStar(count, false));
+    for (int teeth : { 4, 16, 64, 256, 1024 })
+        PrintTime("comb", MakeComb(teeth, false));
+    for (int count : { 64, 512, 4096 })
+        PrintTime("spiral", MakeSpiral(count));
+}
+
+int main(int argc, char** argv)
+{
+    const bool test = argc < 2 || strcmp(argv[1], "test") == 0;
+    const bool bench = argc < 2 || strcmp(argv[1], "bench") == 0;
+    bool ok = true;
+    if (test)
+        ok = RunTest();
+    if (bench)
+        RunBench();
+    return ok ? 0 : 1;
+}
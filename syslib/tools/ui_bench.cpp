@@ -0,0 +1,334 @@
+// Headless benchmark of the overlay's menu: ImGui context with no platform or renderer backend, scripted mouse and
+// keyboard input, simulated bot state. Reports CPU time, geometry, draw calls and ImGui allocations per frame.
+//
+// Frames are drawn by the DLL's own MuBot::RenderMenu() (mubot_menu.cpp), fed through MenuSources with simulated data
+// instead of the game: learning events, HP/MP history, session statistics, radar snapshot, PvP statistics. Scenarios
+// cover the main menu (full, with every section open, and compact) and the PvE and PvP menus. The allocator isn't
+// installed, only its frame arena is used, so the "Memória" section shows zeros.
+//
+//   ui_bench [frames] [--record]       --record also writes ui_bench_<scenario>.mbdd for tools/draw_replay
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -I. tools/ui_bench.cpp mubot_menu.cpp log_console.cpp table_sorter.cpp radar_widget.cpp
+//       worker_draw_lists.cpp draw_data_recorder.cpp imgui_allocator.cpp health_mana_series.cpp session_stats.cpp
+//       external/imgui/imgui.cpp external/imgui/imgui_draw.cpp external/imgui/imgui_tables.cpp
+//       external/imgui/imgui_widgets.cpp -pthread -o ui_bench
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mubot_menu.h"
+#include "draw_data_recorder.h"
+#include "health_mana_series.h"
+#include "imgui_allocator.h"
+#include "session_stats.h"
+#include "worker_draw_lists.h"
+#include "external/imgui/imgui_internal.h"
+
+using namespace MuBot;
+
+struct Scenario
+{
+    const char* name;
+    MenuState state;
+    MenuSize size;
+    int logLines;
+    const char* const* openHeaders;     // Null-terminated, opened after the first frame
+};
+
+static const char* const MAIN_HEADERS[] = { "Eventos de Aprendizado", "Histórico HP/MP", "Estatísticas da Sessão", "Radar", "Memória", "Gravação de Frames", "Log", nullptr };
+static const char* const PVE_HEADERS[] = { "Configuração de Skills", nullptr };
+static const char* const PVP_HEADERS[] = { "Combos", "Estatísticas", nullptr };
+
+static const Scenario SCENARIOS[] =
+{
+    { "full_10", MenuState::Main, MenuSize::Full, 10, MAIN_HEADERS },
+    { "full_10000", MenuState::Main, MenuSize::Full, 10000, MAIN_HEADERS },
+    { "compact", MenuState::Main, MenuSize::Compact, 10, MAIN_HEADERS },
+    { "pve", MenuState::PvE, MenuSize::Full, 10, PVE_HEADERS },
+    { "pvp", MenuState::PvP, MenuSize::Full, 10, PVP_HEADERS },
+};
+
+static const char* MENU_WINDOW = "MuBot v1.0";      // As in RenderMenu()
+static const int WARMUP_FRAMES = 30;
+static const int EVENT_COUNT = 500;
+static const int ENTITY_COUNT = 2000;
+static const int SKILL_COUNT = 30;
+static const int64_t FRAME_MS = 16;
+static const int64_t HISTORY_MS = 2 * 3600 * 1000;     // HP/MP samples, one per second
+static const int64_t WALL_START = 1700000000000LL;
+
+// ImGui allocations, counted from any thread (worker layers allocate too)
+static std::atomic<int> g_allocCount{ 0 };
+static std::atomic<size_t> g_allocBytes{ 0 };
+
+static void* CountingAlloc(size_t size, void*)
+{
+    g_allocCount++;
+    g_allocBytes += size;
+    return malloc(size);
+}
+
+static void CountingFree(void* ptr, void*)
+{
+    free(ptr);
+}
+
+// Bot state the menu draws from, in place of the game and the bot's systems
+class SimulatedBot
+{
+public:
+    explicit SimulatedBot(const Scenario& scenario)
+    {
+        static const char* const TYPES[] = { "Monstro", "Item", "Vida", "Mana", "Nível" };
+        const std::chrono::system_clock::time_point start = std::chrono::system_clock::time_point(std::chrono::milliseconds(WALL_START));
+        for (int n = 0; n < EVENT_COUNT; n++)
+            m_events.push_back({ start + std::chrono::seconds(n * 7919 % EVENT_COUNT), TYPES[n % 5], "Evento " + std::to_string(n * 31 % 997) });
+
+        for (int64_t time = WALL_START - HISTORY_MS; time < WALL_START; time += 1000)
+        {
+            const int phase = (int)(time / 1000 % 120);
+            m_healthMana.Add({ time, 400 + phase * 4, 900, 300 - phase, 400 });
+        }
+
+        // A session walking through a few spots, killing as it goes
+        m_sessionStats.Reset(0);
+        for (int step = 0; step < 3600; step++)
+        {
+            const int64_t time = step * 1000LL;
+            m_sessionStats.Update(time, step / 1200, 120 + step / 40 % 60, 80 + step / 90 % 40, 900 - step % 300, 1000000 + step * 150);
+            if (step % 7 == 0)
+                m_sessionStats.Add(time, SessionStats::Kills);
+            if (step % 45 == 0)
+                m_sessionStats.Add(time, SessionStats::HealthPotions);
+        }
+
+        std::shared_ptr<WorldSnapshot> snapshot = std::make_shared<WorldSnapshot>();
+        unsigned int seed = 12345;
+        for (int n = 0; n < ENTITY_COUNT; n++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            const int x = (int)(seed >> 8) % 200 - 100;
+            seed = seed * 1103515245u + 12345u;
+            const int y = (int)(seed >> 8) % 200 - 100;
+            snapshot->entities.push_back({ x, y, n % 4 == 0 ? WorldSnapshot::Item : WorldSnapshot::Monster });
+        }
+
+        m_config.learningMode = true;
+        m_config.pveEnabled = scenario.state == MenuState::PvE;
+        m_config.pvpEnabled = scenario.state == MenuState::PvP;
+        m_config.autoReset = m_config.autoPot = m_config.autoShield = true;
+        for (int n = 0; n < SKILL_COUNT; n++)
+        {
+            m_config.skillList.push_back("Skill " + std::to_string(n));
+            m_config.skillDelays.push_back(500 + n * 100);
+            m_config.skillKeys.push_back(0x70 + n % 12);
+            m_config.combos.push_back("Combo " + std::to_string(n));
+        }
+
+        m_sources.config = &m_config;
+        m_sources.license.usuario = "bench";
+        m_sources.license.validadeStr = "31/12/2099";
+        m_sources.license.quantidadePCs = 1;
+        m_sources.events = &m_events;
+        m_sources.healthMana = &m_healthMana;
+        m_sources.sessionStats = &m_sessionStats;
+        m_sources.resetSessionStats = [this]() { m_sessionStats.Reset(m_sources.time); };
+        m_sources.allocator = &m_allocator;
+        m_sources.workers = &m_workers;
+        m_sources.recorder = &m_recorder;
+        m_sources.licenseValid = true;
+        m_sources.daysRemaining = 30;
+        m_sources.eventsGeneration = 1;
+        m_sources.pvpStatistics.totalDamage = 125000.0f;
+        m_sources.pvpStatistics.wins = 42;
+        m_sources.pvpStatistics.deaths = 17;
+        m_sources.snapshot = snapshot;
+        SetMenuSources(&m_sources);
+    }
+
+    // Per-frame part of the sources, as mubot.cpp's RenderFrame()
+    void BeginFrame(int frame)
+    {
+        m_allocator.NewFrame();
+        m_sources.time = 3600 * 1000LL + frame * FRAME_MS;
+        m_sources.wallTime = WALL_START + frame * FRAME_MS;
+    }
+
+    WorkerDrawLists& GetWorkers() { return m_workers; }
+    DrawDataRecorder& GetRecorder() { return m_recorder; }
+
+private:
+    BotConfig m_config;
+    std::vector<GameEvent> m_events;
+    HealthManaSeries m_healthMana;
+    SessionStats m_sessionStats;
+    ImGuiAllocator m_allocator;
+    WorkerDrawLists m_workers;
+    DrawDataRecorder m_recorder;
+    MenuSources m_sources;
+};
+
+static void OpenHeaders(const char* const* labels)
+{
+    // CollapsingHeader() keeps its open state in the window storage, under its ID
+    ImGuiWindow* window = ImGui::FindWindowByName(MENU_WINDOW);
+    for (; window != nullptr && *labels != nullptr; labels++)
+        window->StateStorage.SetInt(ImHashStr(*labels, 0, window->ID), 1);
+}
+
+// The "Tipo" header of the learning events table, if it's visible
+static bool FindClickTarget(ImVec2* target)
+{
+    ImGuiWindow* window = ImGui::FindWindowByName(MENU_WINDOW);
+    ImGuiTable* table = window != nullptr ? ImGui::TableFindByID(ImHashStr("LearningEvents", 0, window->ID)) : nullptr;
+    if (table == nullptr || table->LastFrameActive != ImGui::GetFrameCount())
+        return false;
+    *target = ImVec2(table->Columns[1].MinX + 4, table->OuterRect.Min.y + 4);
+    return window->InnerClipRect.Contains(*target);
+}
+
+// Scripted input for frame 'frame', queued before NewFrame() like a platform backend would
+static void FeedInput(ImGuiIO& io, const Scenario& scenario, int frame)
+{
+    // Every second, click the "Tipo" header of the events table (re-sort). Otherwise the mouse sweeps the menu
+    // diagonally, so hover states and tooltips change every frame. Nothing else is clicked: the menu state stays put.
+    const int clickFrame = frame % 60;
+    ImVec2 target;
+    if (clickFrame >= 10 && clickFrame <= 12 && FindClickTarget(&target))
+    {
+        io.AddMousePosEvent(target.x, target.y);
+        if (clickFrame != 10)
+            io.AddMouseButtonEvent(ImGuiMouseButton_Left, clickFrame == 11);
+    }
+    else
+    {
+        const float t = (float)(frame % 120) / 120.0f;
+        const ImVec2 size = scenario.size == MenuSize::Full ? ImVec2(500, 400) : ImVec2(300, 200);
+        io.AddMousePosEvent(50.0f + size.x * t, 50.0f + size.y * (1.0f - t));
+    }
+    if (frame % 30 == 0)
+        io.AddMouseWheelEvent(0.0f, frame % 60 == 0 ? -1.0f : 1.0f);
+    if (frame % 90 == 45)
+    {
+        io.AddKeyEvent(ImGuiKey_DownArrow, true);
+        io.AddKeyEvent(ImGuiKey_DownArrow, false);
+    }
+}
+
+struct ScenarioResult
+{
+    std::vector<double> frameTimes;    // Microseconds, NewFrame() to merged draw data
+    double vtxCount = 0, idxCount = 0, drawCalls = 0, allocCount = 0, allocBytes = 0;
+};
+
+static ScenarioResult RunScenario(const Scenario& scenario, int frames, bool record)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.BackendPlatformName = "ui_bench";
+    io.BackendRendererName = "null";
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    ImGui::StyleColorsDark();
+
+    ScenarioResult result;
+    {
+        SimulatedBot bot(scenario);
+        SetMenuState(scenario.state);
+        if (GetMenuSize() != scenario.size)
+            ToggleMenuSize();
+        ClearLog();
+        for (int n = 0; n < scenario.logLines; n++)
+            LogMessage("Monstro derrotado, experiência +" + std::to_string(n * 13 % 5000));
+
+        bot.GetWorkers().Start(0);
+        if (record)
+            bot.GetRecorder().Start(std::string("ui_bench_") + scenario.name + ".mbdd");
+
+        typedef std::chrono::steady_clock Clock;
+        for (int frame = 0; frame < WARMUP_FRAMES + frames; frame++)
+        {
+            if (frame == 1)
+                OpenHeaders(scenario.openHeaders);
+            io.DeltaTime = 1.0f / 60.0f;
+            FeedInput(io, scenario, frame);
+            LogMessage("Item coletado: Jewel of Bless (" + std::to_string(frame) + ")");     // The bot logs as it plays
+            bot.BeginFrame(frame);
+            const int allocCount = g_allocCount;
+            const size_t allocBytes = g_allocBytes;
+            const Clock::time_point start = Clock::now();
+
+            ImGui::NewFrame();
+            RenderMenu();
+            ImGui::Render();
+            bot.GetWorkers().EndFrame(ImGui::GetDrawData());
+
+            const double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            bot.GetRecorder().Record(ImGui::GetDrawData());
+            if (frame < WARMUP_FRAMES)
+                continue;
+            const DrawDataStats stats = DrawDataStats::Measure(ImGui::GetDrawData());
+            result.frameTimes.push_back(elapsed);
+            result.vtxCount += stats.vtxCount;
+            result.idxCount += stats.idxCount;
+            result.drawCalls += stats.drawCalls;
+            result.allocCount += g_allocCount - allocCount;
+            result.allocBytes += (double)(g_allocBytes - allocBytes);
+        }
+        bot.GetRecorder().Stop();
+        bot.GetWorkers().Stop();
+        if (GetCurrentState() != scenario.state)
+            printf("%s: menu left its state, the scripted input clicked something else\n", scenario.name);
+    }
+    ImGui::DestroyContext();
+
+    result.vtxCount /= frames;
+    result.idxCount /= frames;
+    result.drawCalls /= frames;
+    result.allocCount /= frames;
+    result.allocBytes /= frames;
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    int frames = 600;
+    bool record = false;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--record") == 0)
+            record = true;
+        else
+            frames = std::max(atoi(argv[n]), 1);
+    }
+    ImGui::SetAllocatorFunctions(CountingAlloc, CountingFree, nullptr);
+
+    printf("%d frames per scenario after %d warm-up frames\n", frames, WARMUP_FRAMES);
+    printf("%-15s %9s %9s %9s %9s %9s %10s %11s\n", "scenario", "avg us", "p50 us", "p99 us", "vertices", "indices", "draw calls", "allocs (KB)");
+    for (const Scenario& scenario : SCENARIOS)
+    {
+        ScenarioResult result = RunScenario(scenario, frames, record);
+        std::vector<double>& times = result.frameTimes;
+        std::sort(times.begin(), times.end());
+        double sum = 0.0;
+        for (double t : times)
+            sum += t;
+        printf("%-15s %9.1f %9.1f %9.1f %9.0f %9.0f %10.1f %5.2f (%.1f)\n", scenario.name, sum / times.size(),
+            times[times.size() / 2], times[std::min(times.size() - 1, times.size() * 99 / 100)],
+            result.vtxCount, result.idxCount, result.drawCalls, result.allocCount, result.allocBytes / 1024.0);
+    }
+    return 0;
+}
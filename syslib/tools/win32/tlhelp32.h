@@ -0,0 +1,22 @@
+// Linux stand-in for <tlhelp32.h> (see windows.h): the thread snapshot always fails, so MinHook sees no other thread.
+
+#pragma once
+
+#include <windows.h>
+
+#define TH32CS_SNAPTHREAD 0x00000004
+
+typedef struct
+{
+    DWORD dwSize;
+    DWORD cntUsage;
+    DWORD th32ThreadID;
+    DWORD th32OwnerProcessID;
+    LONG tpBasePri;
+    LONG tpDeltaPri;
+    DWORD dwFlags;
+} THREADENTRY32;
+
+static inline HANDLE CreateToolhelp32Snapshot(DWORD, DWORD) { return INVALID_HANDLE_VALUE; }
+static inline BOOL Thread32First(HANDLE, THREADENTRY32*) { return FALSE; }
+static inline BOOL Thread32Next(HANDLE, THREADENTRY32*) { return FALSE; }
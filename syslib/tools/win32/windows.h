@@ -0,0 +1,129 @@
+// Linux stand-in for <windows.h>, for the tools that build the MinHook sources (add -Itools/win32). Only declares
+// what those sources use. The heap maps to malloc, and no other thread is ever seen (tlhelp32.h), so Freeze() has
+// nothing to suspend. The virtual memory functions are left to each tool, which simulates an address space.
+
+#pragma once
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WINAPI
+#define TRUE 1
+#define FALSE 0
+#define UNREFERENCED_PARAMETER(P) (void)(P)
+#define FIELD_OFFSET(type, field) offsetof(type, field)
+
+typedef void VOID;
+typedef int BOOL;
+typedef long LONG;
+typedef unsigned int UINT;
+typedef uint32_t DWORD;
+typedef DWORD* LPDWORD;
+typedef uint64_t DWORD64;
+typedef unsigned char BYTE;
+typedef BYTE* LPBYTE;
+typedef int8_t INT8;
+typedef int16_t INT16;
+typedef int32_t INT32;
+typedef int64_t INT64;
+typedef uint8_t UINT8;
+typedef uint16_t UINT16;
+typedef uint32_t UINT32;
+typedef UINT32* PUINT32;
+typedef uint64_t UINT64;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t DWORD_PTR;
+typedef size_t SIZE_T;
+typedef void* LPVOID;
+typedef const void* LPCVOID;
+typedef void* HANDLE;
+typedef void* HMODULE;
+typedef void* FARPROC;
+typedef const char* LPCSTR;
+typedef const wchar_t* LPCWSTR;
+
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+
+// Heap
+#define HEAP_ZERO_MEMORY 0x08
+
+static inline HANDLE HeapCreate(DWORD, SIZE_T, SIZE_T) { return (HANDLE)1; }
+static inline BOOL HeapDestroy(HANDLE) { return TRUE; }
+static inline LPVOID HeapAlloc(HANDLE, DWORD flags, SIZE_T size) { return (flags & HEAP_ZERO_MEMORY) ? calloc(1, size) : malloc(size); }
+static inline LPVOID HeapReAlloc(HANDLE, DWORD, LPVOID p, SIZE_T size) { return realloc(p, size); }
+static inline BOOL HeapFree(HANDLE, DWORD, LPVOID p) { free(p); return TRUE; }
+
+// Virtual memory, defined by the tool
+#define MEM_COMMIT 0x1000
+#define MEM_RESERVE 0x2000
+#define MEM_RELEASE 0x8000
+#define MEM_FREE 0x10000
+#define PAGE_EXECUTE 0x10
+#define PAGE_EXECUTE_READ 0x20
+#define PAGE_EXECUTE_READWRITE 0x40
+#define PAGE_EXECUTE_WRITECOPY 0x80
+
+typedef struct
+{
+    LPVOID BaseAddress;
+    LPVOID AllocationBase;
+    DWORD AllocationProtect;
+    SIZE_T RegionSize;
+    DWORD State;
+    DWORD Protect;
+    DWORD Type;
+} MEMORY_BASIC_INFORMATION, *PMEMORY_BASIC_INFORMATION;
+
+typedef struct
+{
+    DWORD dwPageSize;
+    LPVOID lpMinimumApplicationAddress;
+    LPVOID lpMaximumApplicationAddress;
+    DWORD dwAllocationGranularity;
+} SYSTEM_INFO, *LPSYSTEM_INFO;
+
+LPVOID VirtualAlloc(LPVOID address, SIZE_T size, DWORD allocationType, DWORD protect);
+BOOL VirtualFree(LPVOID address, SIZE_T size, DWORD freeType);
+SIZE_T VirtualQuery(LPCVOID address, PMEMORY_BASIC_INFORMATION info, SIZE_T length);
+void GetSystemInfo(LPSYSTEM_INFO info);
+
+// The simulated memory is always writable
+static inline BOOL VirtualProtect(LPVOID, SIZE_T, DWORD protect, LPDWORD oldProtect) { *oldProtect = protect; return TRUE; }
+static inline BOOL FlushInstructionCache(HANDLE, LPCVOID, SIZE_T) { return TRUE; }
+
+// Processes and threads
+#define THREAD_SUSPEND_RESUME 0x0002
+#define THREAD_GET_CONTEXT 0x0008
+#define THREAD_SET_CONTEXT 0x0010
+#define THREAD_QUERY_INFORMATION 0x0040
+#define CONTEXT_CONTROL 0x1
+
+typedef struct
+{
+    DWORD ContextFlags;
+#if defined(__x86_64__)
+    DWORD64 Rip;
+#else
+    DWORD Eip;
+#endif
+} CONTEXT;
+
+static inline HANDLE GetCurrentProcess(void) { return (HANDLE)(intptr_t)-1; }
+static inline DWORD GetCurrentProcessId(void) { return 1; }
+static inline DWORD GetCurrentThreadId(void) { return 1; }
+static inline HANDLE OpenThread(DWORD, BOOL, DWORD) { return NULL; }
+static inline DWORD SuspendThread(HANDLE) { return (DWORD)-1; }
+static inline DWORD ResumeThread(HANDLE) { return (DWORD)-1; }
+static inline BOOL GetThreadContext(HANDLE, CONTEXT*) { return FALSE; }
+static inline BOOL SetThreadContext(HANDLE, const CONTEXT*) { return FALSE; }
+static inline BOOL CloseHandle(HANDLE) { return TRUE; }
+static inline void Sleep(DWORD) {}
+static inline LONG InterlockedCompareExchange(volatile LONG* target, LONG exchange, LONG comparand) { return __sync_val_compare_and_swap(target, comparand, exchange); }
+static inline LONG InterlockedExchange(volatile LONG* target, LONG value) { return __sync_lock_test_and_set(target, value); }
+
+// Modules: none to look up
+static inline HMODULE GetModuleHandleW(LPCWSTR) { return NULL; }
+static inline FARPROC GetProcAddress(HMODULE, LPCSTR) { return NULL; }
@@ -0,0 +1,254 @@
+// Test and benchmark of WorkerDrawLists (worker_draw_lists.cpp): layers built on worker threads must match the same
+// layers built inline, frame after frame, and be merged at the right place in the draw data.
+//
+// - test:  two windows, A with several layers and B (in front of A) with one. For 1, 2, 4 and 8 threads over 20 frames:
+//          vertices, indices and clip rects equal to the inline build, each layer right after its window's draw list,
+//          CmdListsCount and TotalVtxCount updated, layers of A clipped to their rect. Then Start()/Stop() cycles with
+//          random layer counts. Worth running under ThreadSanitizer too (second build line)
+// - bench: frame time (NewFrame() to EndFrame()) with 8 heavy layers, for 0 (inline) to 8 threads. Only meaningful with
+//          as many cores as threads
+//
+//   worker_draw_lists_bench [test|bench]       Both by default. Exit code 1 if the test fails
+//
+// Build on Linux, from syslib/:
+//   g++ -std=c++14 -O2 -pthread -I. tools/worker_draw_lists_bench.cpp worker_draw_lists.cpp external/imgui/imgui.cpp
+//       external/imgui/imgui_draw.cpp external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o worker_draw_lists_bench
+//   g++ -std=c++14 -O1 -g -fsanitize=thread -I. tools/worker_draw_lists_bench.cpp worker_draw_lists.cpp external/imgui/imgui.cpp
+//       external/imgui/imgui_draw.cpp external/imgui/imgui_tables.cpp external/imgui/imgui_widgets.cpp -o worker_draw_lists_tsan
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "worker_draw_lists.h"
+
+static const int TEST_FRAMES = 20;
+static const int TEST_LAYERS = 6;
+static const int BENCH_FRAMES = 15;
+static const int BENCH_LAYERS = 8;
+static const ImVec2 LAYER_MIN(50, 50);
+static const ImVec2 LAYER_MAX(400, 300);
+
+// Circles, concave stars (through the shared data's TempBuffer) and text (through the font atlas), as the radar draws
+static void HeavyLayer(ImDrawList* drawList, unsigned seed, int work)
+{
+    unsigned random = seed * 2654435761u;
+    auto next = [&random](unsigned range) { random = random * 1103515245u + 12345u; return (random >> 8) % range; };
+    for (int n = 0; n < work; n++)
+    {
+        const ImVec2 center((float)next(800), (float)next(600));
+        drawList->AddCircleFilled(center, 3.0f + next(20), IM_COL32(next(256), 100, 200, 255));
+        if (n % 16 != 0)
+            continue;
+        ImVec2 points[40];
+        for (int k = 0; k < 40; k++)
+        {
+            const float angle = k * 6.2831853f / 40;
+            const float radius = (k & 1) ? 10.0f : 25.0f;
+            points[k] = ImVec2(center.x + cosf(angle) * radius, center.y + sinf(angle) * radius);
+        }
+        drawList->AddConcavePolyFilled(points, 40, IM_COL32(255, 255, 0, 128));
+        drawList->AddText(center, IM_COL32_WHITE, "Lorencia 123");
+    }
+}
+
+struct LayerOutput
+{
+    std::vector<ImDrawVert> vertices;
+    std::vector<ImDrawIdx> indices;
+    std::vector<ImVec4> clipRects;
+};
+
+// Renders one frame. Returns false if the draw data is wrong; 'layers' receives the layers' draw lists in draw order
+static bool RunFrame(WorkerDrawLists& workers, int layerCount, int work, std::vector<LayerOutput>* layers)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(10, 10));
+    ImGui::SetNextWindowSize(ImVec2(500, 400));
+    ImGui::Begin("A");
+    ImDrawList* anchorA = ImGui::GetWindowDrawList();
+    for (int n = 0; n < layerCount; n++)
+    {
+        const unsigned seed = n + 1;
+        workers.Submit(LAYER_MIN, LAYER_MAX, [seed, work](ImDrawList* drawList) { HeavyLayer(drawList, seed, work); });
+        ImGui::Text("Camada %d", n);   // The window keeps drawing while workers build
+    }
+    ImGui::End();
+    ImGui::SetNextWindowPos(ImVec2(300, 200));
+    ImGui::SetNextWindowSize(ImVec2(300, 300));
+    ImGui::Begin("B");
+    ImGui::Text("Na frente de A");
+    ImDrawList* anchorB = ImGui::GetWindowDrawList();
+    workers.Submit(ImVec2(0, 0), ImVec2(2000, 2000), [](ImDrawList* drawList) { HeavyLayer(drawList, 99, 50); });
+    ImGui::End();
+    ImGui::Render();
+
+    ImDrawData* drawData = ImGui::GetDrawData();
+    const int listCount = drawData->CmdListsCount;
+    workers.EndFrame(drawData);
+
+    int totalVertices = 0;
+    for (ImDrawList* drawList : drawData->CmdLists)
+        totalVertices += drawList->VtxBuffer.Size;
+    if (drawData->CmdListsCount != drawData->CmdLists.Size || drawData->CmdListsCount != listCount + layerCount + 1 || totalVertices != drawData->TotalVtxCount)
+    {
+        printf("draw data counts not updated\n");
+        return false;
+    }
+
+    // A, A's layers, B, B's layer
+    int indexA = -1, indexB = -1;
+    for (int n = 0; n < drawData->CmdLists.Size; n++)
+    {
+        if (drawData->CmdLists[n] == anchorA) indexA = n;
+        if (drawData->CmdLists[n] == anchorB) indexB = n;
+    }
+    if (indexA < 0 || indexB != indexA + layerCount + 1 || indexB + 1 >= drawData->CmdLists.Size)
+    {
+        printf("layers out of place: A at %d, B at %d, %d layers\n", indexA, indexB, layerCount);
+        return false;
+    }
+
+    if (layers)
+        layers->clear();
+    for (int n = indexA + 1; n <= indexB + 1; n++)
+    {
+        if (n == indexB)
+            continue;
+        const ImDrawList* drawList = drawData->CmdLists[n];
+        LayerOutput output;
+        output.vertices.assign(drawList->VtxBuffer.begin(), drawList->VtxBuffer.end());
+        output.indices.assign(drawList->IdxBuffer.begin(), drawList->IdxBuffer.end());
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+        {
+            output.clipRects.push_back(cmd.ClipRect);
+            if (n < indexB && (cmd.ClipRect.x < LAYER_MIN.x || cmd.ClipRect.y < LAYER_MIN.y || cmd.ClipRect.z > LAYER_MAX.x || cmd.ClipRect.w > LAYER_MAX.y))
+            {
+                printf("layer %d not clipped to its rect\n", n - indexA - 1);
+                return false;
+            }
+        }
+        if (layers)
+            layers->push_back(output);
+    }
+    return true;
+}
+
+static bool SameLayers(const std::vector<LayerOutput>& a, const std::vector<LayerOutput>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t n = 0; n < a.size(); n++)
+    {
+        if (a[n].vertices.size() != b[n].vertices.size() || a[n].indices != b[n].indices || a[n].clipRects.size() != b[n].clipRects.size())
+            return false;
+        if (memcmp(a[n].vertices.data(), b[n].vertices.data(), a[n].vertices.size() * sizeof(ImDrawVert)) != 0
+            || memcmp(a[n].clipRects.data(), b[n].clipRects.data(), a[n].clipRects.size() * sizeof(ImVec4)) != 0)
+            return false;
+    }
+    return true;
+}
+
+static bool RunTest()
+{
+    std::vector<LayerOutput> reference;
+    {
+        WorkerDrawLists inlineWorkers;
+        if (!RunFrame(inlineWorkers, TEST_LAYERS, 300, &reference))
+            return false;
+    }
+
+    bool ok = true;
+    static const int THREAD_COUNTS[] = { 1, 2, 4, 8 };
+    for (int threads : THREAD_COUNTS)
+    {
+        WorkerDrawLists workers;
+        workers.Start(threads);
+        std::vector<LayerOutput> layers;
+        int frame = 0;
+        for (; frame < TEST_FRAMES; frame++)
+        {
+            if (!RunFrame(workers, TEST_LAYERS, 300, &layers))
+                break;
+            if (!SameLayers(layers, reference))
+            {
+                printf("frame %d: layers differ from the inline build\n", frame);
+                break;
+            }
+        }
+        workers.Stop();     // The destructor detaches, as in the DLL
+        printf("test: %d threads, %d frames: %s\n", threads, TEST_FRAMES, frame == TEST_FRAMES ? "ok" : "FAILED");
+        ok = ok && frame == TEST_FRAMES;
+    }
+
+    // Start()/Stop() with layers of varying count and size, including frames without layers for A
+    for (int cycle = 0; cycle < 30 && ok; cycle++)
+    {
+        WorkerDrawLists workers;
+        workers.Start(1 + cycle % 4);
+        for (int frame = 0; frame < 5 && ok; frame++)
+            ok = RunFrame(workers, (cycle * 7 + frame) % 9, 20, nullptr);
+        // Start() on running threads stops them first
+        workers.Start(1 + (cycle + 2) % 4);
+        if (ok)
+            ok = RunFrame(workers, cycle % 9, 20, nullptr);
+        workers.Stop();
+    }
+    printf("test: 30 start/stop cycles: %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+static void RunBench()
+{
+    typedef std::chrono::steady_clock Clock;
+    static const int THREAD_COUNTS[] = { 0, 1, 2, 4, 8 };
+    printf("bench: %d layers, best of %d frames, %u hardware threads\n", BENCH_LAYERS, BENCH_FRAMES, std::thread::hardware_concurrency());
+    printf("%8s %12s %8s\n", "threads", "ms/frame", "speedup");
+    double inlineMs = 0.0;
+    for (int threads : THREAD_COUNTS)
+    {
+        WorkerDrawLists workers;
+        if (threads > 0)
+            workers.Start(threads);
+        double best = 0.0;
+        for (int frame = 0; frame < BENCH_FRAMES; frame++)
+        {
+            const Clock::time_point start = Clock::now();
+            RunFrame(workers, BENCH_LAYERS, 2000, nullptr);
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            best = (frame == 0) ? ms : std::min(best, ms);
+        }
+        workers.Stop();
+        if (threads == 0)
+            inlineMs = best;
+        printf("%8d %12.2f %7.2fx\n", threads, best, inlineMs / best);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    const bool test = argc < 2 || strcmp(argv[1], "test") == 0;
+    const bool bench = argc < 2 || strcmp(argv[1], "bench") == 0;
+    bool ok = true;
+    if (test)
+        ok = RunTest();
+    if (bench)
+        RunBench();
+
+    ImGui::DestroyContext();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+#include "worker_draw_lists.h"
+
+#include <algorithm>
+
+// Glyphs rasterized on demand write to the font atlas from FindGlyph(), which workers call through AddText()
+static bool HasStaticGlyphs()
+{
+    return !(ImGui::GetIO().Fonts->Flags & ImFontAtlasFlags_DynamicGlyphs);
+}
+
+WorkerDrawLists::~WorkerDrawLists()
+{
+    // No join in DllMain, as ~SettingsWriter()
+    for (std::thread& thread : m_threads)
+        thread.detach();
+}
+
+void WorkerDrawLists::Start(int threadCount)
+{
+    Stop();
+    if (threadCount <= 0)
+        threadCount = std::max((int)std::thread::hardware_concurrency() - 1, 0);
+    IM_ASSERT((threadCount == 0 || HasStaticGlyphs()) && "Worker draw lists need a font atlas without ImFontAtlasFlags_DynamicGlyphs");
+    m_stopping = false;
+    for (int i = 0; i < threadCount; i++)
+        m_threads.emplace_back(&WorkerDrawLists::ThreadMain, this);
+}
+
+void WorkerDrawLists::Stop()
+{
+    if (m_threads.empty())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workCondition.notify_all();
+    for (std::thread& thread : m_threads)
+        thread.join();
+    m_threads.clear();
+}
+
+void WorkerDrawLists::Submit(const ImVec2& clipMin, const ImVec2& clipMax, Builder builder)
+{
+    ImDrawList* anchor = ImGui::GetWindowDrawList();
+    if (m_layerCount == (int)m_layers.size())
+        m_layers.push_back(std::unique_ptr<Layer>(new Layer()));
+    Layer& layer = *m_layers[m_layerCount++];
+    layer.anchor = anchor;
+    layer.builder = std::move(builder);
+
+    // Fresh copy of the context's shared data (current font, flags, tessellation tables), keeping our own scratch buffer
+    ImVector<ImVec2> tempBuffer;
+    tempBuffer.swap(layer.sharedData.TempBuffer);
+    layer.sharedData = *ImGui::GetDrawListSharedData();
+    layer.sharedData.TempBuffer.swap(tempBuffer);
+
+    const ImVec4& clip = anchor->_CmdHeader.ClipRect;
+    ImDrawList& drawList = layer.drawList;
+    drawList._ResetForNewFrame();
+    drawList.PushTextureID(anchor->_CmdHeader.TextureId);
+    drawList.PushClipRect(ImVec2(std::max(clipMin.x, clip.x), std::max(clipMin.y, clip.y)), ImVec2(std::min(clipMax.x, clip.z), std::min(clipMax.y, clip.w)));
+
+    if (m_threads.empty())
+    {
+        Build(layer);
+        return;
+    }
+    IM_ASSERT(HasStaticGlyphs() && "Worker draw lists need a font atlas without ImFontAtlasFlags_DynamicGlyphs");
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(&layer);
+        m_pending++;
+    }
+    m_workCondition.notify_one();
+}
+
+void WorkerDrawLists::Build(Layer& layer)
+{
+    layer.builder(&layer.drawList);
+    layer.builder = nullptr;    // Release captures on the worker, not at the next Submit()
+}
+
+void WorkerDrawLists::ThreadMain()
+{
+    // The context's debug allocation counters belong to the render thread
+    ImGui::DebugAllocHookSetThreadEnabled(false);
+    for (;;)
+    {
+        Layer* layer = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCondition.wait(lock, [this]() { return !m_queue.empty() || m_stopping; });
+            if (m_queue.empty())
+                return;
+            layer = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        Build(*layer);
+
+        bool frameDone = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            frameDone = (--m_pending == 0);
+        }
+        if (frameDone)
+            m_doneCondition.notify_one();
+    }
+}
+
+void WorkerDrawLists::EndFrame(ImDrawData* drawData)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCondition.wait(lock, [this]() { return m_pending == 0; });
+    }
+    const int layerCount = m_layerCount;
+    m_layerCount = 0;
+    if (layerCount == 0 || drawData == nullptr || !drawData->Valid)
+        return;
+
+    // Rebuild the list order with each layer after its window's draw list. Layers whose window isn't rendered are dropped.
+    m_mergedLists.resize(0);
+    m_mergedLists.reserve(drawData->CmdLists.Size + layerCount);
+    for (ImDrawList* drawList : drawData->CmdLists)
+    {
+        m_mergedLists.push_back(drawList);
+        for (int n = 0; n < layerCount; n++)
+        {
+            Layer& layer = *m_layers[n];
+            if (layer.anchor != drawList)
+                continue;
+            layer.drawList._PopUnusedDrawCmd();
+            ImGui::AddDrawListToDrawDataEx(drawData, &m_mergedLists, &layer.drawList);
+        }
+    }
+    drawData->CmdLists.swap(m_mergedLists);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "external/imgui/imgui.h"
+#include "external/imgui/imgui_internal.h"
+
+// Draw lists filled on worker threads while the render thread keeps building the UI, for expensive custom layers
+// (radar, graphs, heatmaps). Each layer has its own ImDrawList and its own copy of ImDrawListSharedData, taken on
+// the render thread at Submit(): the copy owns the TempBuffer scratch that ImDrawList writes to. Workers still share
+// the lookup tables and the font atlas. Text is only safe without ImFontAtlasFlags_DynamicGlyphs: with it, FindGlyph()
+// stamps the glyph's last use and rasterizes missing glyphs into the atlas, so Start() and Submit() assert it's off.
+// EndFrame() inserts every layer right after the draw list of the window that submitted it, so a layer covers its
+// window's contents but stays under windows and popups in front of it.
+class WorkerDrawLists
+{
+public:
+    using Builder = std::function<void(ImDrawList* drawList)>;
+
+    ~WorkerDrawLists();
+
+    void Start(int threadCount);        // 0: one thread per core but one. Without threads, Submit() runs builders inline
+                                        // After the fonts are set up
+    void Stop();                        // Joins the threads. Not from DllMain, as SettingsWriter::Stop()
+
+    // Between ImGui::Begin() and End(): 'builder' fills a draw list clipped to [clipMin, clipMax] and to the current clip rect.
+    // It runs on a worker, so it must only use data it owns or captures by value (e.g. a shared_ptr to a snapshot).
+    void Submit(const ImVec2& clipMin, const ImVec2& clipMax, Builder builder);
+
+    // After ImGui::Render(): waits for this frame's layers and adds them to the draw data.
+    void EndFrame(ImDrawData* drawData);
+
+    int GetThreadCount() const { return (int)m_threads.size(); }
+
+private:
+    struct Layer
+    {
+        ImDrawListSharedData sharedData;
+        ImDrawList drawList{ &sharedData };
+        ImDrawList* anchor = nullptr;   // Window draw list this layer is drawn after
+        Builder builder;
+    };
+
+    void ThreadMain();
+    static void Build(Layer& layer);
+
+    std::vector<std::thread> m_threads;
+    std::vector<std::unique_ptr<Layer>> m_layers;   // Kept across frames, so draw lists keep their capacity
+    int m_layerCount = 0;                           // Layers submitted this frame
+    ImVector<ImDrawList*> m_mergedLists;            // Swapped with ImDrawData::CmdLists by EndFrame()
+
+    std::mutex m_mutex;
+    std::condition_variable m_workCondition;
+    std::condition_variable m_doneCondition;
+    std::deque<Layer*> m_queue;
+    int m_pending = 0;                              // Submitted this frame and not built yet
+    bool m_stopping = false;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+// Positions gathered by one GameReader::Update(). Published as an immutable snapshot: readers keep their
+// shared_ptr as long as they need it, and the next Update() publishes a new one instead of modifying it.
+struct WorldSnapshot
+{
+    enum EntityType : unsigned char
+    {
+        Monster,
+        Item
+    };
+
+    struct Entity
+    {
+        int x, y;
+        EntityType type;
+    };
+
+    int playerX = 0, playerY = 0;
+    std::vector<Entity> entities;
+    unsigned int generation = 0;
+};